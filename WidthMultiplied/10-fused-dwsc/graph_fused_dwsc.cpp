@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+#include "utils/CommonGraphOptions.h"
+#include "utils/GraphUtils.h"
+#include "utils/Utils.h"
+
+#include "common/FusedDwscCheck.h"
+#include "common/SweepOptions.h"
+#include "common/SweepRunner.h"
+#include "common/SweepUtils.h"
+
+#include <streamline_annotate.h>
+
+using namespace arm_compute;
+using namespace arm_compute::utils;
+using namespace arm_compute::graph::frontend;
+using namespace arm_compute::graph_utils;
+using namespace width_multiplied;
+
+/** Example checking and benchmarking the fused depthwise-separable blocks of MobileNet over the width multiplier
+ *
+ * The fused kernel is first checked against a scalar reference over both layouts and the shapes its
+ * code paths depend on (see check_fused_dwsc), and the example stops on any mismatch. Every (width,
+ * resolution) point of MobileNet is then run without fusion and with every block fused, and the
+ * speed-up of the fused variants is printed with the agreement of their output with the unfused one.
+ *
+ * @param[in] argc Number of arguments
+ * @param[in] argv Arguments
+ */
+class GraphFusedDwscExample : public Example
+{
+public:
+    GraphFusedDwscExample()
+        : cmd_parser(), common_opts(cmd_parser), sweep_opts(cmd_parser), common_params(), sweep_params(), variants()
+    {
+        // Add check-only option
+        check_only_opt = cmd_parser.add_option<ToggleOption>("check-only");
+        check_only_opt->set_help("Only check the fused kernel against the scalar reference, without running the benchmark");
+    }
+    bool do_setup(int argc, char **argv) override
+    {
+        // Parse arguments
+        cmd_parser.parse(argc, argv);
+        ANNOTATE_SETUP;
+        ANNOTATE_DEFINE;
+
+        // Consume common parameters
+        common_params = consume_common_graph_parameters(common_opts);
+        sweep_params  = consume_sweep_parameters(sweep_opts);
+
+        // Return when help menu is requested
+        if(common_params.help)
+        {
+            cmd_parser.print_help(argv[0]);
+            return false;
+        }
+
+        // Compare both executions of the usual MobileNet widths unless asked otherwise
+        if(!sweep_opts.width->is_set())
+        {
+            sweep_params.widths = { 0.25f, 0.5f, 0.75f, 1.f };
+        }
+        if(!sweep_opts.fused_dwsc->is_set())
+        {
+            sweep_params.dwsc_fusions = { parse_dwsc_fusion("none"), parse_dwsc_fusion("all") };
+        }
+
+        // Create the width x resolution grid
+        variants = make_variant_grid({ "mobilenet" }, sweep_params.widths, sweep_params.resolutions, sweep_params.roundings, sweep_params.batches, sweep_params.batch_norms,
+                                     sweep_params.dwsc_fusions, sweep_params.channel_shuffles, sweep_params.grouped_convs, sweep_params.asymmetric_convs);
+
+        // Checks
+        for(const auto &variant : variants)
+        {
+            validate_variant(common_params, variant, sweep_params.channel_selection);
+        }
+
+        // Print parameter values
+        std::cout << common_params << std::endl;
+        std::cout << sweep_params << std::endl;
+
+        return true;
+    }
+    void do_run() override
+    {
+        const unsigned int failures = check_fused_dwsc(std::cout);
+        ARM_COMPUTE_EXIT_ON_MSG(failures > 0, "The fused kernel does not match the reference");
+        if(check_only_opt->is_set() && check_only_opt->value())
+        {
+            return;
+        }
+
+        SweepRunner runner(common_params, sweep_params);
+        runner.run(variants);
+        runner.print_results(std::cout);
+        runner.write_results();
+    }
+
+private:
+    CommandLineParser         cmd_parser;
+    CommonGraphOptions        common_opts;
+    SweepOptions              sweep_opts;
+    ToggleOption             *check_only_opt{ nullptr };
+    CommonGraphParams         common_params;
+    SweepParams               sweep_params;
+    std::vector<GraphVariant> variants;
+};
+
+/** Main program for the fused depthwise-separable block check and benchmark
+ *
+ * @note To list all the possible arguments execute the binary appended with the --help option
+ *
+ * @param[in] argc Number of arguments
+ * @param[in] argv Arguments
+ */
+int main(int argc, char **argv)
+{
+    return arm_compute::utils::run_example<GraphFusedDwscExample>(argc, argv);
+}
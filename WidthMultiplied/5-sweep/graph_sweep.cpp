@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+#include "utils/CommonGraphOptions.h"
+#include "utils/GraphUtils.h"
+#include "utils/Utils.h"
+
+#include "common/MultiStreamRunner.h"
+#include "common/SweepOptions.h"
+#include "common/SweepRunner.h"
+#include "common/SweepUtils.h"
+
+#include <streamline_annotate.h>
+
+using namespace arm_compute;
+using namespace arm_compute::utils;
+using namespace arm_compute::graph::frontend;
+using namespace arm_compute::graph_utils;
+using namespace width_multiplied;
+
+/** Example sweeping several graph families over width and resolution multipliers in one process
+ *
+ * Every (model, width, resolution) combination is built, finalized, timed and torn down in turn,
+ * so the backend runtime is only initialized once for the whole sweep.
+ *
+ * @param[in] argc Number of arguments
+ * @param[in] argv Arguments
+ */
+class GraphSweepExample : public Example
+{
+public:
+    GraphSweepExample()
+        : cmd_parser(), common_opts(cmd_parser), sweep_opts(cmd_parser), common_params(), sweep_params(), variants()
+    {
+        // Add model option
+        model_opt = cmd_parser.add_option<ListOption<std::string>>("model");
+        model_opt->set_help("Comma separated list of graphs to sweep: mobilenet, googlenet, resnet50, vgg16, squeezenext, sp_resnet, sp_shufflenet, sp_sqznext, gconv_g<n> or .prototxt files (default: mobilenet)");
+    }
+    bool do_setup(int argc, char **argv) override
+    {
+        // Parse arguments
+        cmd_parser.parse(argc, argv);
+        ANNOTATE_SETUP;
+        ANNOTATE_DEFINE;
+
+        // Consume common parameters
+        common_params = consume_common_graph_parameters(common_opts);
+        sweep_params  = consume_sweep_parameters(sweep_opts);
+
+        // Return when help menu is requested
+        if(common_params.help)
+        {
+            cmd_parser.print_help(argv[0]);
+            return false;
+        }
+
+        // Create the model x width x resolution grid
+        const std::vector<std::string> models = model_opt->is_set() ? model_opt->value() : std::vector<std::string>{ "mobilenet" };
+        variants                              = make_variant_grid(models, sweep_params.widths, sweep_params.resolutions, sweep_params.roundings, sweep_params.batches, sweep_params.batch_norms,
+                                                                  sweep_params.dwsc_fusions, sweep_params.channel_shuffles, sweep_params.grouped_convs, sweep_params.asymmetric_convs);
+
+        // Checks
+        for(const auto &variant : variants)
+        {
+            validate_variant(common_params, variant, sweep_params.channel_selection);
+        }
+
+        // Print parameter values
+        std::cout << common_params << std::endl;
+        std::cout << sweep_params << std::endl;
+
+        return true;
+    }
+    void do_run() override
+    {
+        if(sweep_params.streams > 1)
+        {
+            MultiStreamRunner runner(common_params, sweep_params);
+            runner.run(variants);
+            runner.print_results(std::cout);
+            runner.write_results();
+            return;
+        }
+        SweepRunner runner(common_params, sweep_params);
+        runner.run(variants);
+        runner.print_results(std::cout);
+        runner.write_results();
+    }
+
+private:
+    CommandLineParser         cmd_parser;
+    CommonGraphOptions        common_opts;
+    SweepOptions              sweep_opts;
+    ListOption<std::string>  *model_opt{ nullptr };
+    CommonGraphParams         common_params;
+    SweepParams               sweep_params;
+    std::vector<GraphVariant> variants;
+};
+
+/** Main program for the width/resolution sweep
+ *
+ * @note To list all the possible arguments execute the binary appended with the --help option
+ *
+ * @param[in] argc Number of arguments
+ * @param[in] argv Arguments
+ */
+int main(int argc, char **argv)
+{
+    return arm_compute::utils::run_example<GraphSweepExample>(argc, argv);
+}
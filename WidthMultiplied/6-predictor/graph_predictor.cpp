@@ -0,0 +1,275 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+#include "utils/CommonGraphOptions.h"
+#include "utils/GraphUtils.h"
+#include "utils/Utils.h"
+
+#include "common/GraphBuilders.h"
+#include "common/LatencyPredictor.h"
+#include "common/SweepUtils.h"
+
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
+
+using namespace arm_compute;
+using namespace arm_compute::utils;
+using namespace arm_compute::graph::frontend;
+using namespace arm_compute::graph_utils;
+using namespace width_multiplied;
+
+/** Example predicting the latency of width/resolution variants from measured sweeps
+ *
+ * Fits a per-layer latency model on the per-layer CSV files written by the sweeps (--layer-csv),
+ * optionally calibrated with their summary CSV files (--csv), then predicts the latency of every
+ * point of the requested grid, without running it, and reports the largest configuration of each
+ * graph family that fits in the latency budget.
+ *
+ * @param[in] argc Number of arguments
+ * @param[in] argv Arguments
+ */
+class GraphPredictorExample : public Example
+{
+public:
+    GraphPredictorExample()
+        : cmd_parser(), common_opts(cmd_parser), common_params(), variants()
+    {
+        model_opt      = cmd_parser.add_option<ListOption<std::string>>("model");
+        width_opt      = cmd_parser.add_option<ListOption<float>>("width");
+        resolution_opt = cmd_parser.add_option<ListOption<unsigned int>>("resolution");
+        rounding_opt   = cmd_parser.add_option<ListOption<std::string>>("channel-rounding");
+        layer_csv_opt  = cmd_parser.add_option<ListOption<std::string>>("layer-csv");
+        sweep_csv_opt  = cmd_parser.add_option<ListOption<std::string>>("sweep-csv");
+        budget_opt     = cmd_parser.add_option<SimpleOption<float>>("budget", 0.f);
+        output_csv_opt = cmd_parser.add_option<SimpleOption<std::string>>("csv");
+        model_opt->set_help("Comma separated list of graphs to predict: mobilenet, googlenet, resnet50, vgg16, squeezenext, sp_resnet, sp_shufflenet, sp_sqznext, gconv_g<n> or .prototxt files (default: mobilenet)");
+        width_opt->set_help("Comma separated list of width multipliers to predict (default: 0.25 to 2.0 in steps of 0.125)");
+        resolution_opt->set_help("Comma separated list of input resolutions to predict (default: 128,160,192,224)");
+        rounding_opt->set_help("Comma separated list of channel roundings to predict: truncate, multiple-<n>, make-divisible[-<n>] (default: truncate)");
+        layer_csv_opt->set_help("Comma separated list of per-layer CSV files written by the sweeps with --layer-csv, used to fit the model");
+        sweep_csv_opt->set_help("Comma separated list of summary CSV files written by the sweeps with --csv, used to calibrate the end-to-end latency");
+        budget_opt->set_help("Latency budget in milliseconds (0 to only print the predictions)");
+        output_csv_opt->set_help("File to write the predictions to, as CSV");
+    }
+    bool do_setup(int argc, char **argv) override
+    {
+        // Parse arguments
+        cmd_parser.parse(argc, argv);
+
+        // Consume common parameters
+        common_params = consume_common_graph_parameters(common_opts);
+
+        // Return when help menu is requested
+        if(common_params.help)
+        {
+            cmd_parser.print_help(argv[0]);
+            return false;
+        }
+
+        // Checks
+        ARM_COMPUTE_EXIT_ON_MSG(!layer_csv_opt->is_set(), "At least one per-layer CSV file is needed to fit the model (--layer-csv)");
+
+        // Read the measured sweeps
+        std::vector<LayerSample> samples;
+        for(const auto &file : layer_csv_opt->value())
+        {
+            ARM_COMPUTE_EXIT_ON_MSG(!read_layer_samples(file, samples), "Cannot read the per-layer CSV files");
+        }
+        ARM_COMPUTE_EXIT_ON_MSG(samples.empty(), "The per-layer CSV files contain no layer");
+        if(sweep_csv_opt->is_set())
+        {
+            for(const auto &file : sweep_csv_opt->value())
+            {
+                ARM_COMPUTE_EXIT_ON_MSG(!read_sweep_latencies(file, latencies), "Cannot read the summary CSV files");
+            }
+        }
+        predictor.fit(samples, latencies);
+        training_samples = samples;
+
+        // Create the model x width x resolution x rounding grid
+        std::vector<float> widths;
+        for(unsigned int i = 2; i <= 16; ++i)
+        {
+            widths.push_back(i * 0.125f);
+        }
+        std::vector<ChannelRounding> roundings(1);
+        if(rounding_opt->is_set())
+        {
+            roundings.clear();
+            for(const auto &name : rounding_opt->value())
+            {
+                roundings.push_back(parse_channel_rounding(name));
+            }
+        }
+        const std::vector<unsigned int> resolutions = resolution_opt->is_set() ? resolution_opt->value() : std::vector<unsigned int>{ 128U, 160U, 192U, 224U };
+        models                                      = model_opt->is_set() ? model_opt->value() : std::vector<std::string>{ "mobilenet" };
+        variants                                    = make_variant_grid(models, width_opt->is_set() ? width_opt->value() : widths, resolutions, roundings);
+        for(const auto &variant : variants)
+        {
+            validate_variant(common_params, variant);
+        }
+
+        // Print parameter values
+        std::cout << common_params << std::endl;
+        std::cout << "Training layers : " << samples.size() << std::endl;
+        std::cout << "Budget (ms) : " << budget_opt->value() << std::endl;
+
+        return true;
+    }
+    void do_run() override
+    {
+        predictor.print(std::cout);
+        std::cout << std::endl;
+        print_training_error();
+
+        // Predict every variant of the grid
+        std::vector<double>   predictions;
+        std::vector<uint64_t> macs;
+        for(const auto &variant : variants)
+        {
+            const std::vector<LayerFeatures> layers = analyze_variant(common_params, variant);
+            LayerCost                        total;
+            for(const auto &layer : layers)
+            {
+                total += layer.cost;
+            }
+            predictions.push_back(predictor.predict(layers));
+            macs.push_back(total.macs);
+        }
+
+        const float budget = budget_opt->value();
+        std::cout << std::left << std::setw(12) << "model" << std::setw(8) << "width" << std::setw(12) << "resolution" << std::setw(19) << "rounding"
+                  << std::right << std::setw(10) << "MMACs" << std::setw(14) << "predicted(ms)" << std::endl;
+        for(size_t i = 0; i < variants.size(); ++i)
+        {
+            std::stringstream row;
+            row << std::left << std::setw(12) << variants[i].model << std::setw(8) << variants[i].width << std::setw(12) << variants[i].resolution
+                << std::setw(19) << to_string(variants[i].rounding) << std::right << std::fixed << std::setprecision(3) << std::setw(10) << macs[i] / 1e6 << std::setw(14) << predictions[i]
+                << ((budget > 0 && predictions[i] <= budget) ? "  *" : "");
+            std::cout << row.str() << std::endl;
+        }
+        std::cout << std::endl;
+
+        // Largest configuration (in MACs) of each family that fits in the budget
+        if(budget > 0)
+        {
+            std::map<std::string, size_t> best;
+            for(size_t i = 0; i < variants.size(); ++i)
+            {
+                const auto it = best.find(variants[i].model);
+                if(predictions[i] <= budget && (it == best.end() || macs[i] > macs[it->second]))
+                {
+                    best[variants[i].model] = i;
+                }
+            }
+            for(const auto &model : models)
+            {
+                const auto it = best.find(model);
+                if(it == best.end())
+                {
+                    std::cout << model << " : no configuration fits in " << budget << " ms" << std::endl;
+                }
+                else
+                {
+                    std::cout << model << " : largest configuration within " << budget << " ms is " << variants[it->second] << " (predicted " << predictions[it->second]
+                              << " ms)" << std::endl;
+                }
+            }
+        }
+
+        if(output_csv_opt->is_set())
+        {
+            write_predictions(output_csv_opt->value(), predictions, macs);
+        }
+    }
+
+private:
+    void print_training_error() const
+    {
+        // Predicts the measured variants from their own measured layers
+        std::map<std::string, std::vector<LayerFeatures>> layers;
+        std::map<std::string, double>                     layer_sums;
+        for(const auto &sample : training_samples)
+        {
+            layers[variant_key(sample.variant)].push_back(sample.features);
+            layer_sums[variant_key(sample.variant)] += sample.time_ms;
+        }
+
+        double total_error = 0;
+        for(const auto &variant : layers)
+        {
+            const auto   latency   = latencies.find(variant.first);
+            const double measured  = (latency != latencies.end()) ? latency->second : layer_sums[variant.first] * predictor.scale();
+            const double predicted = predictor.predict(variant.second);
+            total_error += std::fabs(predicted - measured) / measured;
+            std::cout << variant.first << " : measured " << measured << " ms, fitted " << predicted << " ms" << std::endl;
+        }
+        std::cout << "Mean absolute error on the measured variants : " << 100.0 * total_error / layers.size() << "%" << std::endl
+                  << std::endl;
+    }
+
+    void write_predictions(const std::string &filename, const std::vector<double> &predictions, const std::vector<uint64_t> &macs) const
+    {
+        std::ofstream ofs(filename);
+        ARM_COMPUTE_EXIT_ON_MSG(!ofs.is_open(), "Cannot open the output CSV file");
+        ofs << "model,width,resolution,rounding,macs,predicted_ms\n";
+        for(size_t i = 0; i < variants.size(); ++i)
+        {
+            ofs << variants[i].model << "," << variants[i].width << "," << variants[i].resolution << "," << variants[i].rounding << "," << macs[i] << "," << predictions[i] << "\n";
+        }
+    }
+
+    CommandLineParser              cmd_parser;
+    CommonGraphOptions             common_opts;
+    ListOption<std::string>       *model_opt{ nullptr };
+    ListOption<float>             *width_opt{ nullptr };
+    ListOption<unsigned int>      *resolution_opt{ nullptr };
+    ListOption<std::string>       *rounding_opt{ nullptr };
+    ListOption<std::string>       *layer_csv_opt{ nullptr };
+    ListOption<std::string>       *sweep_csv_opt{ nullptr };
+    SimpleOption<float>           *budget_opt{ nullptr };
+    SimpleOption<std::string>     *output_csv_opt{ nullptr };
+    CommonGraphParams              common_params;
+    std::vector<std::string>       models{};
+    std::vector<GraphVariant>      variants;
+    std::vector<LayerSample>       training_samples{};
+    std::map<std::string, double>  latencies{};
+    LatencyPredictor               predictor{};
+};
+
+/** Main program for the latency predictor
+ *
+ * @note To list all the possible arguments execute the binary appended with the --help option
+ *
+ * @param[in] argc Number of arguments
+ * @param[in] argv Arguments
+ */
+int main(int argc, char **argv)
+{
+    return arm_compute::utils::run_example<GraphPredictorExample>(argc, argv);
+}
@@ -0,0 +1,342 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "arm_compute/graph.h"
+#include "arm_compute/runtime/CL/CLScheduler.h"
+#include "support/ToolchainSupport.h"
+#include "utils/CommonGraphOptions.h"
+#include "utils/GraphUtils.h"
+#include "utils/Utils.h"
+
+#include "common/Calibration.h"
+#include "common/Cifar10.h"
+#include "common/GraphBuilders.h"
+#include "common/GraphExecutor.h"
+#include "common/LatencyStats.h"
+#include "common/Quantization.h"
+#include "common/SweepUtils.h"
+#include "common/WarmupDetector.h"
+
+#include <chrono>
+#include <iomanip>
+#include <memory>
+#include <set>
+#include <vector>
+
+using namespace arm_compute;
+using namespace arm_compute::utils;
+using namespace arm_compute::graph::frontend;
+using namespace arm_compute::graph_utils;
+using namespace width_multiplied;
+
+/** Accuracy and latency of a graph on the test images */
+struct Evaluation
+{
+    double       accuracy{ 0 };          /**< Top-1 accuracy, in [0, 1] */
+    LatencyStats stats{};                /**< Latency of a batch */
+    unsigned int warmup_iterations{ 0 }; /**< Untimed runs before the timed ones */
+};
+
+/** Example calibrating the int8 execution of the CIFAR-10 simple models
+ *
+ * Runs the F32 graph of a model, batch normalizations folded, on a calibration subset of the
+ * CIFAR-10 test batch, records the range of the weights and of the output of every layer
+ * (min/max, or percentiles of their histogram), and writes the QASYMM8 quantization of every
+ * layer as a calibration file. Then builds the QASYMM8 graph with that file and reports the
+ * top-1 accuracy and the latency of both graphs on the following test images, each graph being
+ * warmed up on them first as in the sweep.
+ *
+ * @param[in] argc Number of arguments
+ * @param[in] argv Arguments
+ */
+class GraphCalibrationExample : public Example
+{
+public:
+    GraphCalibrationExample()
+        : cmd_parser(), common_opts(cmd_parser), common_params()
+    {
+        model_opt       = cmd_parser.add_option<SimpleOption<std::string>>("model", "sp_resnet");
+        width_opt       = cmd_parser.add_option<SimpleOption<float>>("width", 1.f);
+        cifar_opt       = cmd_parser.add_option<SimpleOption<std::string>>("cifar");
+        mean_opt        = cmd_parser.add_option<SimpleOption<std::string>>("mean");
+        calibration_opt = cmd_parser.add_option<SimpleOption<unsigned int>>("calibration-images", 500U);
+        test_opt        = cmd_parser.add_option<SimpleOption<unsigned int>>("test-images", 2000U);
+        batch_opt       = cmd_parser.add_option<SimpleOption<unsigned int>>("batch", 1U);
+        method_opt      = cmd_parser.add_option<EnumOption<CalibrationMethod>>("method", std::set<CalibrationMethod> { CalibrationMethod::MinMax, CalibrationMethod::Percentile }, CalibrationMethod::Percentile);
+        percentile_opt  = cmd_parser.add_option<SimpleOption<float>>("percentile", 99.99f);
+        output_opt      = cmd_parser.add_option<SimpleOption<std::string>>("calibration-csv", "calibration.csv");
+        warmup_opt      = cmd_parser.add_option<SimpleOption<unsigned int>>("warmup", 10U);
+        window_opt      = cmd_parser.add_option<SimpleOption<unsigned int>>("warmup-window", 5U);
+        tolerance_opt   = cmd_parser.add_option<SimpleOption<float>>("warmup-tolerance", 0.05f);
+        warmup_max_opt  = cmd_parser.add_option<SimpleOption<unsigned int>>("warmup-max", 200U);
+        model_opt->set_help("Model to calibrate: sp_resnet, sp_shufflenet, sp_sqznext (default: sp_resnet)");
+        width_opt->set_help("Width multiplier, 1.0 only with trained weights (--data)");
+        cifar_opt->set_help("CIFAR-10 binary batch with the calibration and test images, e.g. test_batch.bin");
+        mean_opt->set_help("Mean image the model was trained with, as a 3x32x32 .npy file (default: mean of the loaded images)");
+        calibration_opt->set_help("Number of images, from the first one, run to calibrate the activation ranges");
+        test_opt->set_help("Number of images, after the calibration ones, run to compare the accuracy and latency of both graphs");
+        batch_opt->set_help("Images per run");
+        method_opt->set_help("Range of the activations: minmax, or the percentiles keeping --percentile % of the values");
+        percentile_opt->set_help("Percentage of the activation values kept by the percentile method, the outliers being split between both ends");
+        output_opt->set_help("Calibration file to write, in the format of --quantization of graph_sweep");
+        warmup_opt->set_help("Fixed number of untimed runs of each graph before its test runs. When not set, runs until the latency is steady");
+        window_opt->set_help("Number of runs per sliding window of the adaptive warm-up");
+        tolerance_opt->set_help("Maximum relative change between the median latency of two consecutive windows");
+        warmup_max_opt->set_help("Maximum number of adaptive warm-up runs");
+    }
+    bool do_setup(int argc, char **argv) override
+    {
+        // Parse arguments
+        cmd_parser.parse(argc, argv);
+
+        // Consume common parameters
+        common_params = consume_common_graph_parameters(common_opts);
+
+        // Return when help menu is requested
+        if(common_params.help)
+        {
+            cmd_parser.print_help(argv[0]);
+            return false;
+        }
+
+        // Checks
+        ARM_COMPUTE_EXIT_ON_MSG(!cifar_opt->is_set(), "A CIFAR-10 batch file is needed (--cifar)");
+        ARM_COMPUTE_EXIT_ON_MSG(!is_cifar_model(model_opt->value()), "Unknown model, expected one of sp_resnet, sp_shufflenet, sp_sqznext");
+        ARM_COMPUTE_EXIT_ON_MSG(calibration_opt->value() == 0 || test_opt->value() == 0, "The calibration and test images must not be empty");
+        ARM_COMPUTE_EXIT_ON_MSG(percentile_opt->value() <= 50.f || percentile_opt->value() > 100.f, "The percentile must be in (50, 100]");
+
+        // Both graphs share the variant, the float one with its batch normalizations folded like the QASYMM8 one
+        variant.model          = model_opt->value();
+        variant.width          = width_opt->value();
+        variant.resolution     = 32U;
+        variant.batch          = batch_opt->value();
+        variant.batch_norm     = BatchNormMode::Folded;
+        float_params           = common_params;
+        int8_params            = common_params;
+        float_params.data_type = DataType::F32;
+        int8_params.data_type  = DataType::QASYMM8;
+        validate_variant(float_params, variant);
+        validate_variant(int8_params, variant);
+
+        // Load the images
+        dataset.load(cifar_opt->value(), calibration_opt->value() + test_opt->value());
+        ARM_COMPUTE_EXIT_ON_MSG(dataset.size() <= calibration_opt->value(), "The CIFAR-10 file has no image left after the calibration ones");
+        feed = arm_compute::support::cpp14::make_unique<Cifar10Feed>(dataset, mean_opt->is_set() ? load_cifar10_mean(mean_opt->value()) : dataset.mean());
+
+        // Print parameter values
+        std::cout << common_params << std::endl;
+        std::cout << "Model : " << variant.model << " width=" << variant.width << " batch=" << variant.batch << std::endl;
+        std::cout << "Images : " << calibration_opt->value() << " calibration, " << dataset.size() - calibration_opt->value() << " test" << std::endl;
+        std::cout << "Method : " << method_opt->value();
+        if(method_opt->value() == CalibrationMethod::Percentile)
+        {
+            std::cout << " " << percentile_opt->value();
+        }
+        std::cout << std::endl;
+        if(warmup_opt->is_set())
+        {
+            std::cout << "Warm-up iterations : " << warmup_opt->value() << std::endl;
+        }
+        else
+        {
+            std::cout << "Warm-up : adaptive (window " << window_opt->value() << ", tolerance " << tolerance_opt->value() << ", max " << warmup_max_opt->value() << ")" << std::endl;
+        }
+
+        return true;
+    }
+    void do_run() override
+    {
+        const size_t calibration_images = calibration_opt->value();
+        const size_t test_images        = dataset.size() - calibration_images;
+
+        // Calibrate and evaluate the float graph
+        Evaluation float_eval;
+        {
+            Calibrator                        calibrator;
+            Stream                            graph(0, get_graph_name(variant.model));
+            std::unique_ptr<IWorkloadMutator> workload_mutator = create_graph(graph, float_params, variant);
+            observe_weight_ranges(graph.graph(), calibrator);
+            attach_cifar10_feed(graph.graph(), *feed);
+
+            GraphExecutor                   executor;
+            arm_compute::graph::PassManager pm = arm_compute::graph::create_default_pass_manager(common_params.target);
+            executor.finalize(graph.graph(), common_params.target, make_graph_config(common_params), pm, workload_mutator.get());
+
+            ActivationRangeObserver observer(calibrator, executor.workload());
+            feed->reset(0, calibration_images);
+            run_images(executor, calibration_images, &observer);
+            calibrator.add_images(calibration_images);
+            if(method_opt->value() == CalibrationMethod::Percentile)
+            {
+                calibrator.start_histograms();
+                feed->reset(0, calibration_images);
+                run_images(executor, calibration_images, &observer);
+            }
+            calibrator.write(output_opt->value(), method_opt->value(), percentile_opt->value());
+            std::cout << "Calibration written to " << output_opt->value() << std::endl;
+
+            float_eval = evaluate(executor, calibration_images, test_images);
+        }
+
+        // Quantize with the calibration and evaluate the QASYMM8 graph
+        Evaluation int8_eval;
+        {
+            QuantizationParams::get().configure(output_opt->value());
+            Stream                            graph(0, get_graph_name(variant.model));
+            std::unique_ptr<IWorkloadMutator> workload_mutator = create_graph(graph, int8_params, variant);
+            attach_cifar10_feed(graph.graph(), *feed);
+
+            GraphExecutor                   executor;
+            arm_compute::graph::PassManager pm = arm_compute::graph::create_default_pass_manager(common_params.target);
+            executor.finalize(graph.graph(), common_params.target, make_graph_config(common_params), pm, workload_mutator.get());
+
+            int8_eval = evaluate(executor, calibration_images, test_images);
+        }
+
+        std::cout << std::endl
+                  << "Test images : " << test_images << std::endl;
+        std::cout << std::left << std::setw(10) << "graph" << std::right << std::setw(12) << "top-1(%)" << std::setw(16) << "mean batch(ms)"
+                  << std::setw(18) << "median batch(ms)" << std::setw(14) << "images/s" << std::setw(8) << "warmup" << std::endl;
+        print_evaluation("F32", float_eval);
+        print_evaluation("QASYMM8", int8_eval);
+        std::cout << std::fixed << std::setprecision(2) << "Accuracy change : " << 100.0 * (int8_eval.accuracy - float_eval.accuracy) << " points" << std::endl;
+        if(int8_eval.stats.median > 0)
+        {
+            std::cout << "Speed-up : " << float_eval.stats.median / int8_eval.stats.median << "x" << std::endl;
+        }
+    }
+
+private:
+    static double elapsed_ms(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void sync() const
+    {
+        if(common_params.target == Target::CL)
+        {
+            CLScheduler::get().sync();
+        }
+    }
+
+    /** Runs every image of the feed once, returning the latency of every run */
+    std::vector<double> run_images(GraphExecutor &executor, size_t images, ITaskListener *listener = nullptr)
+    {
+        const size_t        runs = (images + variant.batch - 1) / variant.batch;
+        std::vector<double> samples;
+        samples.reserve(runs);
+        for(size_t i = 0; i < runs; ++i)
+        {
+            const auto run_start = std::chrono::steady_clock::now();
+            executor.run(listener);
+            sync();
+            samples.push_back(elapsed_ms(run_start));
+        }
+        return samples;
+    }
+
+    /** Runs a graph until its latency is steady, or a fixed number of times with --warmup, returning the number of runs */
+    unsigned int warm_up(GraphExecutor &executor)
+    {
+        if(warmup_opt->is_set())
+        {
+            for(unsigned int i = 0; i < warmup_opt->value(); ++i) // warming up
+            {
+                executor.run();
+            }
+            sync();
+            return warmup_opt->value();
+        }
+
+        // Run until the median latency of two consecutive windows agrees within the tolerance
+        WarmupDetector detector(window_opt->value(), tolerance_opt->value(), warmup_max_opt->value());
+        while(!detector.done())
+        {
+            const auto run_start = std::chrono::steady_clock::now();
+            executor.run();
+            sync();
+            detector.add_sample(elapsed_ms(run_start));
+        }
+        if(!detector.converged())
+        {
+            std::cout << "Warning: latency did not settle within " << detector.iterations() << " warm-up runs" << std::endl;
+        }
+        return detector.iterations();
+    }
+
+    /** Warms the graph up on the test images, then runs them, timing every run */
+    Evaluation evaluate(GraphExecutor &executor, size_t first_image, size_t images)
+    {
+        Evaluation evaluation;
+        feed->reset(first_image, images);
+        evaluation.warmup_iterations = warm_up(executor);
+        feed->reset(first_image, images);
+        evaluation.stats    = compute_latency_stats(run_images(executor, images));
+        evaluation.accuracy = feed->accuracy();
+        return evaluation;
+    }
+
+    void print_evaluation(const std::string &name, const Evaluation &evaluation) const
+    {
+        const double images_per_s = (evaluation.stats.mean > 0) ? 1000.0 * variant.batch / evaluation.stats.mean : 0.0;
+        std::cout << std::left << std::setw(10) << name << std::right << std::fixed << std::setprecision(2) << std::setw(12) << 100.0 * evaluation.accuracy
+                  << std::setprecision(3) << std::setw(16) << evaluation.stats.mean << std::setw(18) << evaluation.stats.median << std::setprecision(1) << std::setw(14)
+                  << images_per_s << std::setw(8) << evaluation.warmup_iterations << std::endl;
+    }
+
+    CommandLineParser              cmd_parser;
+    CommonGraphOptions             common_opts;
+    SimpleOption<std::string>     *model_opt{ nullptr };
+    SimpleOption<float>           *width_opt{ nullptr };
+    SimpleOption<std::string>     *cifar_opt{ nullptr };
+    SimpleOption<std::string>     *mean_opt{ nullptr };
+    SimpleOption<unsigned int>    *calibration_opt{ nullptr };
+    SimpleOption<unsigned int>    *test_opt{ nullptr };
+    SimpleOption<unsigned int>    *batch_opt{ nullptr };
+    EnumOption<CalibrationMethod> *method_opt{ nullptr };
+    SimpleOption<float>           *percentile_opt{ nullptr };
+    SimpleOption<std::string>     *output_opt{ nullptr };
+    SimpleOption<unsigned int>    *warmup_opt{ nullptr };
+    SimpleOption<unsigned int>    *window_opt{ nullptr };
+    SimpleOption<float>           *tolerance_opt{ nullptr };
+    SimpleOption<unsigned int>    *warmup_max_opt{ nullptr };
+    CommonGraphParams              common_params;
+    CommonGraphParams              float_params{};
+    CommonGraphParams              int8_params{};
+    GraphVariant                   variant{};
+    Cifar10Dataset                 dataset{};
+    std::unique_ptr<Cifar10Feed>   feed{ nullptr };
+};
+
+/** Main program for the int8 calibration of the CIFAR-10 models
+ *
+ * @note To list all the possible arguments execute the binary appended with the --help option
+ *
+ * @param[in] argc Number of arguments
+ * @param[in] argv Arguments
+ */
+int main(int argc, char **argv)
+{
+    return arm_compute::utils::run_example<GraphCalibrationExample>(argc, argv);
+}
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+#include "utils/CommonGraphOptions.h"
+#include "utils/GraphUtils.h"
+#include "utils/Utils.h"
+
+#include "common/SweepOptions.h"
+#include "common/SweepRunner.h"
+#include "common/SweepUtils.h"
+
+#include <streamline_annotate.h>
+
+using namespace arm_compute;
+using namespace arm_compute::utils;
+using namespace arm_compute::graph::frontend;
+using namespace arm_compute::graph_utils;
+using namespace width_multiplied;
+
+/** Example benchmarking the grouped 1x1 convolutions over the number of groups and the width multiplier
+ *
+ * Every (groups, width, resolution) point of the gconv_g<n> benchmark graph is run with its grouped
+ * convolutions split into one convolution per group by the frontend and batched into one NEON dispatch,
+ * then the speed-up of the batched ones is printed for every point.
+ *
+ * @param[in] argc Number of arguments
+ * @param[in] argv Arguments
+ */
+class GraphGroupedConvExample : public Example
+{
+public:
+    GraphGroupedConvExample()
+        : cmd_parser(), common_opts(cmd_parser), sweep_opts(cmd_parser), common_params(), sweep_params(), variants()
+    {
+        // Add groups option
+        groups_opt = cmd_parser.add_option<ListOption<unsigned int>>("groups");
+        groups_opt->set_help("Comma separated list of the numbers of groups of the grouped 1x1 convolutions (default: 1,2,3,4,8)");
+    }
+    bool do_setup(int argc, char **argv) override
+    {
+        // Parse arguments
+        cmd_parser.parse(argc, argv);
+        ANNOTATE_SETUP;
+        ANNOTATE_DEFINE;
+
+        // Consume common parameters
+        common_params = consume_common_graph_parameters(common_opts);
+        sweep_params  = consume_sweep_parameters(sweep_opts);
+
+        // Return when help menu is requested
+        if(common_params.help)
+        {
+            cmd_parser.print_help(argv[0]);
+            return false;
+        }
+
+        // Compare both executions of several widths unless asked otherwise
+        if(!sweep_opts.width->is_set())
+        {
+            sweep_params.widths = { 0.5f, 1.f, 2.f };
+        }
+        if(!sweep_opts.grouped_conv->is_set())
+        {
+            sweep_params.grouped_convs = { GroupedConvMode::Split, GroupedConvMode::Batched };
+        }
+
+        // Create the groups x width x resolution grid
+        const std::vector<unsigned int> groups = groups_opt->is_set() ? groups_opt->value() : std::vector<unsigned int> { 1U, 2U, 3U, 4U, 8U };
+        std::vector<std::string>        models;
+        for(unsigned int num_groups : groups)
+        {
+            ARM_COMPUTE_EXIT_ON_MSG(num_groups == 0U, "Number of groups must be positive");
+            models.push_back("gconv_g" + arm_compute::support::cpp11::to_string(num_groups));
+        }
+        variants = make_variant_grid(models, sweep_params.widths, sweep_params.resolutions, sweep_params.roundings, sweep_params.batches, sweep_params.batch_norms,
+                                     sweep_params.dwsc_fusions, sweep_params.channel_shuffles, sweep_params.grouped_convs);
+
+        // Checks
+        for(const auto &variant : variants)
+        {
+            validate_variant(common_params, variant, sweep_params.channel_selection);
+        }
+
+        // Print parameter values
+        std::cout << common_params << std::endl;
+        std::cout << sweep_params << std::endl;
+
+        return true;
+    }
+    void do_run() override
+    {
+        SweepRunner runner(common_params, sweep_params);
+        runner.run(variants);
+        runner.print_results(std::cout);
+        runner.write_results();
+    }
+
+private:
+    CommandLineParser         cmd_parser;
+    CommonGraphOptions        common_opts;
+    SweepOptions              sweep_opts;
+    ListOption<unsigned int> *groups_opt{ nullptr };
+    CommonGraphParams         common_params;
+    SweepParams               sweep_params;
+    std::vector<GraphVariant> variants;
+};
+
+/** Main program for the grouped convolution benchmark
+ *
+ * @note To list all the possible arguments execute the binary appended with the --help option
+ *
+ * @param[in] argc Number of arguments
+ * @param[in] argv Arguments
+ */
+int main(int argc, char **argv)
+{
+    return arm_compute::utils::run_example<GraphGroupedConvExample>(argc, argv);
+}
@@ -0,0 +1,644 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_ASYMMETRIC_CONV_H__
+#define __WIDTH_MULTIPLIED_ASYMMETRIC_CONV_H__
+
+#include "arm_compute/core/Error.h"
+#include "arm_compute/core/Helpers.h"
+#include "arm_compute/core/ITensor.h"
+#include "arm_compute/core/NEON/INEKernel.h"
+#include "arm_compute/core/Types.h"
+#include "arm_compute/core/Utils.h"
+#include "arm_compute/core/Window.h"
+#include "arm_compute/core/utils/misc/Cast.h"
+#include "arm_compute/graph.h"
+#include "arm_compute/runtime/IFunction.h"
+#include "arm_compute/runtime/NEON/NEScheduler.h"
+#include "support/ToolchainSupport.h"
+
+#include "common/GraphExecutor.h"
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif /* __ARM_NEON */
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace width_multiplied
+{
+/** How the 1xK and Kx1 convolutions of a graph are executed */
+enum class AsymmetricConvMode
+{
+    Gemm,   /**< By the convolution function of the backend, im2col and GEMM on NEON */
+    Direct, /**< By @ref NEAsymmetricConvLayer, a direct convolution along the long side of the kernel */
+};
+
+/** Stream operator to print an asymmetric convolution mode
+ *
+ * @param[out] os   Output stream
+ * @param[in]  mode Mode to print
+ *
+ * @return Modified output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, AsymmetricConvMode mode)
+{
+    switch(mode)
+    {
+        case AsymmetricConvMode::Direct:
+            os << "direct";
+            break;
+        case AsymmetricConvMode::Gemm:
+        default:
+            os << "gemm";
+            break;
+    }
+    return os;
+}
+
+/** Stream operator to read an asymmetric convolution mode
+ *
+ * @param[in]  is   Input stream
+ * @param[out] mode Mode read
+ *
+ * @return Modified input stream
+ */
+inline std::istream &operator>>(std::istream &is, AsymmetricConvMode &mode)
+{
+    std::string value;
+    is >> value;
+    if(value == "gemm")
+    {
+        mode = AsymmetricConvMode::Gemm;
+    }
+    else if(value == "direct")
+    {
+        mode = AsymmetricConvMode::Direct;
+    }
+    else
+    {
+        is.setstate(std::ios::failbit);
+    }
+    return is;
+}
+
+/** Parses an asymmetric convolution mode, as written in the sweep CSV files
+ *
+ * @param[in] name Name of the mode, empty in the files written before the asymmetric convolution column
+ *
+ * @return The mode, gemm if the name is empty or unknown
+ */
+inline AsymmetricConvMode parse_asymmetric_conv_mode(const std::string &name)
+{
+    std::stringstream  ss(name);
+    AsymmetricConvMode mode = AsymmetricConvMode::Gemm;
+    ss >> mode;
+    return ss.fail() ? AsymmetricConvMode::Gemm : mode;
+}
+
+/** Checks whether a kernel size is 1xK or Kx1 with K above 1
+ *
+ * @param[in] kernel_width  Kernel width
+ * @param[in] kernel_height Kernel height
+ *
+ * @return True for the asymmetric kernels run by @ref NEAsymmetricConvKernel
+ */
+inline bool is_asymmetric_kernel(size_t kernel_width, size_t kernel_height)
+{
+    return (kernel_width == 1 && kernel_height > 1) || (kernel_height == 1 && kernel_width > 1);
+}
+
+/** NEON kernel running a 1xK or Kx1 convolution directly, without im2col
+ *
+ * im2col copies every input value K times for these kernels before a GEMM whose depth is only K times
+ * the input channels, so most of the time goes into memory traffic. This kernel reads the input where
+ * it is instead, the K taps being K shifted rows (1xK) or K consecutive rows (Kx1).
+ *
+ * In NCHW, 4 output channels by 4 pixels are accumulated in registers, every input vector loaded being
+ * used by the 4 channels; the border pixels, whose taps reach into the padding, and the strided
+ * convolutions are computed one by one. In NHWC, 4 output channels of a pixel are accumulated at a
+ * time, one tap and input channel after the other. The rows of the output are split between the
+ * threads. F32, any stride and padding.
+ */
+class NEAsymmetricConvKernel final : public arm_compute::INEKernel
+{
+public:
+    const char *name() const override
+    {
+        return "NEAsymmetricConvKernel";
+    }
+    /** Default constructor */
+    NEAsymmetricConvKernel()
+        : _input(nullptr), _output(nullptr), _weights(nullptr), _bias(nullptr), _conv_info(), _in_strides(), _out_strides(), _in_width(0), _in_height(0), _out_width(0),
+          _inputs(0), _outputs(0), _taps(0), _horizontal(true), _nhwc(false)
+    {
+    }
+    /** Initialise the kernel
+     *
+     * @param[in]  input         Input of the convolution, F32
+     * @param[in]  weights       Weights packed as returned by @ref pack_weights for the layout of the input
+     * @param[in]  bias          Bias, one value per output channel
+     * @param[out] output        Output of the convolution, F32, same layout as the input
+     * @param[in]  kernel_width  Kernel width, 1 or K
+     * @param[in]  kernel_height Kernel height, K or 1
+     * @param[in]  conv_info     Strides and padding of the convolution
+     */
+    void configure(const arm_compute::ITensor *input, const float *weights, const float *bias, arm_compute::ITensor *output, size_t kernel_width, size_t kernel_height,
+                   const arm_compute::PadStrideInfo &conv_info)
+    {
+        using namespace arm_compute;
+        ARM_COMPUTE_ERROR_ON(!is_asymmetric_kernel(kernel_width, kernel_height));
+
+        const DataLayout layout = input->info()->data_layout();
+        const size_t     idx_w  = get_data_layout_dimension_index(layout, DataLayoutDimension::WIDTH);
+        const size_t     idx_h  = get_data_layout_dimension_index(layout, DataLayoutDimension::HEIGHT);
+        const size_t     idx_c  = get_data_layout_dimension_index(layout, DataLayoutDimension::CHANNEL);
+        const size_t     idx_n  = get_data_layout_dimension_index(layout, DataLayoutDimension::BATCHES);
+
+        _input       = input;
+        _output      = output;
+        _weights     = weights;
+        _bias        = bias;
+        _conv_info   = conv_info;
+        _in_strides  = { input->info()->strides_in_bytes()[idx_w], input->info()->strides_in_bytes()[idx_h], input->info()->strides_in_bytes()[idx_c], input->info()->strides_in_bytes()[idx_n] };
+        _out_strides = { output->info()->strides_in_bytes()[idx_w], output->info()->strides_in_bytes()[idx_h], output->info()->strides_in_bytes()[idx_c], output->info()->strides_in_bytes()[idx_n] };
+        _in_width    = input->info()->dimension(idx_w);
+        _in_height   = input->info()->dimension(idx_h);
+        _out_width   = output->info()->dimension(idx_w);
+        _inputs      = input->info()->dimension(idx_c);
+        _outputs     = output->info()->dimension(idx_c);
+        _taps        = std::max(kernel_width, kernel_height);
+        _horizontal  = kernel_height == 1;
+        _nhwc        = layout == DataLayout::NHWC;
+
+        // Rows along Y, the images of the batch along Z
+        Window win;
+        win.set(Window::DimX, Window::Dimension(0, 1, 1));
+        win.set(Window::DimY, Window::Dimension(0, output->info()->dimension(idx_h), 1));
+        win.set(Window::DimZ, Window::Dimension(0, output->info()->dimension(idx_n), 1));
+        INEKernel::configure(win);
+    }
+    /** Packs the weights of a 1xK or Kx1 convolution for the kernel
+     *
+     * @param[in]  weights Weights, F32, shape (kernel width, kernel height, input channels, output channels) in the layout of the tensor
+     * @param[in]  nhwc    True to pack for a NHWC input: [tap][input channel][output channel], else [output channel][input channel][tap]
+     * @param[out] values  Packed weights
+     */
+    static void pack_weights(const arm_compute::ITensor *weights, bool nhwc, std::vector<float> &values)
+    {
+        using namespace arm_compute;
+
+        const DataLayout layout     = weights->info()->data_layout();
+        const size_t     idx_w      = get_data_layout_dimension_index(layout, DataLayoutDimension::WIDTH);
+        const size_t     idx_h      = get_data_layout_dimension_index(layout, DataLayoutDimension::HEIGHT);
+        const size_t     idx_c      = get_data_layout_dimension_index(layout, DataLayoutDimension::CHANNEL);
+        const size_t     idx_n      = get_data_layout_dimension_index(layout, DataLayoutDimension::BATCHES);
+        const bool       horizontal = weights->info()->dimension(idx_h) == 1;
+        const size_t     taps       = std::max(weights->info()->dimension(idx_w), weights->info()->dimension(idx_h));
+        const size_t     inputs     = weights->info()->dimension(idx_c);
+        const size_t     outputs    = weights->info()->dimension(idx_n);
+        values.resize(taps * inputs * outputs);
+        for(size_t co = 0; co < outputs; ++co)
+        {
+            for(size_t ci = 0; ci < inputs; ++ci)
+            {
+                for(size_t k = 0; k < taps; ++k)
+                {
+                    Coordinates id;
+                    id.set(idx_w, horizontal ? k : 0);
+                    id.set(idx_h, horizontal ? 0 : k);
+                    id.set(idx_c, ci);
+                    id.set(idx_n, co);
+                    const size_t index = nhwc ? (k * inputs + ci) * outputs + co : (co * inputs + ci) * taps + k;
+                    values[index]      = *reinterpret_cast<const float *>(weights->ptr_to_element(id));
+                }
+            }
+        }
+    }
+
+    // Inherited methods overridden:
+    void run(const arm_compute::Window &window, const arm_compute::ThreadInfo &info) override
+    {
+        using namespace arm_compute;
+        ARM_COMPUTE_UNUSED(info);
+
+        const Window::Dimension &rows    = window[Window::DimY];
+        const Window::Dimension &batches = window[Window::DimZ];
+        for(int batch = batches.start(); batch < batches.end(); ++batch)
+        {
+            const uint8_t *in  = _input->buffer() + _input->info()->offset_first_element_in_bytes() + batch * _in_strides.batch;
+            uint8_t       *out = _output->buffer() + _output->info()->offset_first_element_in_bytes() + batch * _out_strides.batch;
+            for(int y = rows.start(); y < rows.end(); y += rows.step())
+            {
+                if(_nhwc)
+                {
+                    run_nhwc_row(in, out + y * _out_strides.y, y);
+                }
+                else
+                {
+                    run_nchw_row(in, out + y * _out_strides.y, y);
+                }
+            }
+        }
+    }
+
+private:
+    struct Strides
+    {
+        size_t x;
+        size_t y;
+        size_t channel;
+        size_t batch;
+    };
+
+    /** Input row and column offsets of a tap */
+    int tap_dx(size_t k) const
+    {
+        return _horizontal ? static_cast<int>(k) : 0;
+    }
+    int tap_dy(size_t k) const
+    {
+        return _horizontal ? 0 : static_cast<int>(k);
+    }
+
+    /** Input row read by a tap for an output row, -1 when it is in the padding */
+    int input_row(int y, size_t k) const
+    {
+        const int iy = y * static_cast<int>(_conv_info.stride().second) - static_cast<int>(_conv_info.pad_top()) + tap_dy(k);
+        return (iy >= 0 && iy < static_cast<int>(_in_height)) ? iy : -1;
+    }
+
+    /** Input column read by a tap for an output column, -1 when it is in the padding */
+    int input_column(size_t x, size_t k) const
+    {
+        const int ix = static_cast<int>(x * _conv_info.stride().first) - static_cast<int>(_conv_info.pad_left()) + tap_dx(k);
+        return (ix >= 0 && ix < static_cast<int>(_in_width)) ? ix : -1;
+    }
+
+    void run_nchw_row(const uint8_t *in, uint8_t *out_row, int y) const
+    {
+        size_t co = 0;
+        for(; co + 4 <= _outputs; co += 4)
+        {
+            run_nchw_block<4>(in, out_row, y, co);
+        }
+        for(; co < _outputs; ++co)
+        {
+            run_nchw_block<1>(in, out_row, y, co);
+        }
+    }
+
+    /** Computes N output channels of a row, 4 pixels at a time between the borders for unit strides */
+    template <size_t N>
+    void run_nchw_block(const uint8_t *in, uint8_t *out_row, int y, size_t co) const
+    {
+        const float *weights = _weights + co * _inputs * _taps;
+        float       *dst[N];
+        for(size_t n = 0; n < N; ++n)
+        {
+            dst[n] = reinterpret_cast<float *>(out_row + (co + n) * _out_strides.channel);
+        }
+
+        // Pixels whose taps all read inside the input row
+        const size_t pad_left   = _conv_info.pad_left();
+        const size_t x_begin    = std::min(pad_left, _out_width);
+        const bool   vectorized = _conv_info.stride().first == 1;
+
+        size_t x = 0;
+        for(; x < (vectorized ? x_begin : _out_width); ++x)
+        {
+            compute_nchw_pixel<N>(in, dst, weights, y, co, x);
+        }
+#ifdef __ARM_NEON
+        if(vectorized)
+        {
+            const size_t last_tap = _horizontal ? _taps - 1 : 0;
+            const size_t x_end    = (_in_width + pad_left > last_tap) ? std::max(x_begin, std::min(_out_width, _in_width + pad_left - last_tap)) : x_begin;
+            for(; x + 4 <= x_end; x += 4)
+            {
+                float32x4_t acc[N];
+                for(size_t n = 0; n < N; ++n)
+                {
+                    acc[n] = vdupq_n_f32(_bias[co + n]);
+                }
+                for(size_t k = 0; k < _taps; ++k)
+                {
+                    const int iy = input_row(y, k);
+                    if(iy < 0)
+                    {
+                        continue;
+                    }
+                    const uint8_t *row = in + iy * _in_strides.y + (x - pad_left + tap_dx(k)) * sizeof(float);
+                    for(size_t ci = 0; ci < _inputs; ++ci)
+                    {
+                        const float32x4_t value = vld1q_f32(reinterpret_cast<const float *>(row + ci * _in_strides.channel));
+                        for(size_t n = 0; n < N; ++n)
+                        {
+                            acc[n] = vmlaq_n_f32(acc[n], value, weights[(n * _inputs + ci) * _taps + k]);
+                        }
+                    }
+                }
+                for(size_t n = 0; n < N; ++n)
+                {
+                    vst1q_f32(dst[n] + x, acc[n]);
+                }
+            }
+        }
+#endif /* __ARM_NEON */
+        for(; x < _out_width; ++x)
+        {
+            compute_nchw_pixel<N>(in, dst, weights, y, co, x);
+        }
+    }
+
+    template <size_t N>
+    void compute_nchw_pixel(const uint8_t *in, float *const *dst, const float *weights, int y, size_t co, size_t x) const
+    {
+        float sum[N];
+        for(size_t n = 0; n < N; ++n)
+        {
+            sum[n] = _bias[co + n];
+        }
+        for(size_t k = 0; k < _taps; ++k)
+        {
+            const int iy = input_row(y, k);
+            const int ix = input_column(x, k);
+            if(iy < 0 || ix < 0)
+            {
+                continue;
+            }
+            const uint8_t *pixel = in + iy * _in_strides.y + ix * sizeof(float);
+            for(size_t ci = 0; ci < _inputs; ++ci)
+            {
+                const float value = *reinterpret_cast<const float *>(pixel + ci * _in_strides.channel);
+                for(size_t n = 0; n < N; ++n)
+                {
+                    sum[n] += value * weights[(n * _inputs + ci) * _taps + k];
+                }
+            }
+        }
+        for(size_t n = 0; n < N; ++n)
+        {
+            dst[n][x] = sum[n];
+        }
+    }
+
+    void run_nhwc_row(const uint8_t *in, uint8_t *out_row, int y) const
+    {
+        for(size_t x = 0; x < _out_width; ++x)
+        {
+            float *out = reinterpret_cast<float *>(out_row + x * _out_strides.x);
+            size_t co  = 0;
+#ifdef __ARM_NEON
+            for(; co + 4 <= _outputs; co += 4)
+            {
+                float32x4_t acc = vld1q_f32(_bias + co);
+                for(size_t k = 0; k < _taps; ++k)
+                {
+                    const int iy = input_row(y, k);
+                    const int ix = input_column(x, k);
+                    if(iy < 0 || ix < 0)
+                    {
+                        continue;
+                    }
+                    const float *pixel   = reinterpret_cast<const float *>(in + iy * _in_strides.y + ix * _in_strides.x);
+                    const float *weights = _weights + k * _inputs * _outputs + co;
+                    for(size_t ci = 0; ci < _inputs; ++ci)
+                    {
+                        acc = vmlaq_n_f32(acc, vld1q_f32(weights + ci * _outputs), pixel[ci]);
+                    }
+                }
+                vst1q_f32(out + co, acc);
+            }
+#endif /* __ARM_NEON */
+            for(; co < _outputs; ++co)
+            {
+                float sum = _bias[co];
+                for(size_t k = 0; k < _taps; ++k)
+                {
+                    const int iy = input_row(y, k);
+                    const int ix = input_column(x, k);
+                    if(iy < 0 || ix < 0)
+                    {
+                        continue;
+                    }
+                    const float *pixel = reinterpret_cast<const float *>(in + iy * _in_strides.y + ix * _in_strides.x);
+                    for(size_t ci = 0; ci < _inputs; ++ci)
+                    {
+                        sum += _weights[(k * _inputs + ci) * _outputs + co] * pixel[ci];
+                    }
+                }
+                out[co] = sum;
+            }
+        }
+    }
+
+    const arm_compute::ITensor *_input;
+    arm_compute::ITensor       *_output;
+    const float                *_weights;
+    const float                *_bias;
+    arm_compute::PadStrideInfo  _conv_info;
+    Strides                     _in_strides;
+    Strides                     _out_strides;
+    size_t                      _in_width;
+    size_t                      _in_height;
+    size_t                      _out_width;
+    size_t                      _inputs;
+    size_t                      _outputs;
+    size_t                      _taps;
+    bool                        _horizontal;
+    bool                        _nhwc;
+};
+
+/** Function running a 1xK or Kx1 convolution with @ref NEAsymmetricConvKernel
+ *
+ * The weights and bias are packed when the function is prepared, after which their tensors are
+ * marked as unused so that the graph releases them.
+ */
+class NEAsymmetricConvLayer final : public arm_compute::IFunction
+{
+public:
+    /** Default constructor */
+    NEAsymmetricConvLayer()
+        : _kernel(), _replaced(), _weights_tensor(nullptr), _bias_tensor(nullptr), _weights(), _bias(), _nhwc(false), _is_prepared(false)
+    {
+    }
+    /** Set the input and output tensors
+     *
+     * @param[in]  input     Input of the convolution, F32
+     * @param[in]  weights   Weights, shape (kernel width, kernel height, input channels, output channels) in the layout of the input, 1xK or Kx1
+     * @param[in]  bias      Bias, nullptr for none
+     * @param[out] output    Output of the convolution
+     * @param[in]  conv_info Strides and padding of the convolution
+     * @param[in]  replaced  (Optional) Function of the layer the convolution replaces, never run but kept alive as its memory is registered with the memory managers of the graph
+     */
+    void configure(const arm_compute::ITensor *input, const arm_compute::ITensor *weights, const arm_compute::ITensor *bias, arm_compute::ITensor *output,
+                   const arm_compute::PadStrideInfo &conv_info, std::unique_ptr<arm_compute::IFunction> replaced = nullptr)
+    {
+        using namespace arm_compute;
+
+        const DataLayout layout = weights->info()->data_layout();
+        const size_t     width  = weights->info()->dimension(get_data_layout_dimension_index(layout, DataLayoutDimension::WIDTH));
+        const size_t     height = weights->info()->dimension(get_data_layout_dimension_index(layout, DataLayoutDimension::HEIGHT));
+        const size_t     inputs = weights->info()->dimension(get_data_layout_dimension_index(layout, DataLayoutDimension::CHANNEL));
+        const size_t     count  = weights->info()->dimension(get_data_layout_dimension_index(layout, DataLayoutDimension::BATCHES));
+
+        _replaced       = std::move(replaced);
+        _weights_tensor = weights;
+        _bias_tensor    = bias;
+        _nhwc           = input->info()->data_layout() == DataLayout::NHWC;
+        _weights.resize(std::max(width, height) * inputs * count);
+        _bias.resize(count);
+        _kernel.configure(input, _weights.data(), _bias.data(), output, width, height, conv_info);
+    }
+
+    // Inherited methods overridden:
+    void run() override
+    {
+        prepare();
+        arm_compute::NEScheduler::get().schedule(&_kernel, arm_compute::Window::DimY);
+    }
+    void prepare() override
+    {
+        if(_is_prepared)
+        {
+            return;
+        }
+        NEAsymmetricConvKernel::pack_weights(_weights_tensor, _nhwc, _weights);
+        for(size_t co = 0; co < _bias.size(); ++co)
+        {
+            _bias[co] = (_bias_tensor != nullptr) ? *reinterpret_cast<const float *>(_bias_tensor->ptr_to_element(arm_compute::Coordinates(co))) : 0.f;
+        }
+        _weights_tensor->mark_as_unused();
+        if(_bias_tensor != nullptr)
+        {
+            _bias_tensor->mark_as_unused();
+        }
+        _is_prepared = true;
+    }
+
+private:
+    NEAsymmetricConvKernel                  _kernel;
+    std::unique_ptr<arm_compute::IFunction> _replaced;
+    const arm_compute::ITensor             *_weights_tensor;
+    const arm_compute::ITensor             *_bias_tensor;
+    std::vector<float>                      _weights;
+    std::vector<float>                      _bias;
+    bool                                    _nhwc;
+    bool                                    _is_prepared;
+};
+
+/** Runs the F32 1xK and Kx1 convolutions of a graph with @ref NEAsymmetricConvLayer
+ *
+ * Once the functions are configured and the constant tensors filled, mutate() replaces the function
+ * of every such NEON convolution whose weights and bias come straight from constant nodes. The task
+ * keeps its node, so the profiler reports the direct convolution under the name of the layer.
+ */
+class AsymmetricConvMutator final : public IWorkloadMutator
+{
+public:
+    /** Default constructor */
+    AsymmetricConvMutator()
+        : _replaced(0)
+    {
+    }
+    /** Number of convolutions replaced by the last call to mutate() */
+    unsigned int replaced() const
+    {
+        return _replaced;
+    }
+
+    // Inherited methods overridden:
+    void mutate(arm_compute::graph::Graph &g, arm_compute::graph::ExecutionWorkload &workload) override
+    {
+        using namespace arm_compute::graph;
+
+        _replaced = 0;
+        for(auto &task : workload.tasks)
+        {
+            INode *node = task.node;
+            if(node == nullptr || node->type() != NodeType::ConvolutionLayer || node->assigned_target() != Target::NEON
+               || node->output(0)->desc().data_type != arm_compute::DataType::F32 || !is_asymmetric_convolution(*node) || !has_const_input(g, *node, 1)
+               || (node->input(2) != nullptr && !has_const_input(g, *node, 2)))
+            {
+                continue;
+            }
+            auto layer = arm_compute::support::cpp14::make_unique<NEAsymmetricConvLayer>();
+            layer->configure(tensor_of(node->input(0)), tensor_of(node->input(1)), tensor_of(node->input(2)), tensor_of(node->output(0)),
+                             arm_compute::utils::cast::polymorphic_downcast<ConvolutionLayerNode *>(node)->convolution_info(), std::move(task.task));
+            task.task = std::move(layer);
+            ++_replaced;
+        }
+    }
+
+    /** Checks whether the weights of a convolution node are 1xK or Kx1
+     *
+     * @param[in] node Convolution node
+     *
+     * @return True if the kernel is asymmetric
+     */
+    static bool is_asymmetric_convolution(const arm_compute::graph::INode &node)
+    {
+        using namespace arm_compute::graph;
+        const TensorDescriptor &weights = node.input(1)->desc();
+        return is_asymmetric_kernel(get_dimension_size(weights, arm_compute::DataLayoutDimension::WIDTH), get_dimension_size(weights, arm_compute::DataLayoutDimension::HEIGHT));
+    }
+
+private:
+    static arm_compute::ITensor *tensor_of(arm_compute::graph::Tensor *tensor)
+    {
+        return (tensor != nullptr && tensor->handle() != nullptr) ? &tensor->handle()->tensor() : nullptr;
+    }
+
+    static bool has_const_input(arm_compute::graph::Graph &g, const arm_compute::graph::INode &node, size_t idx)
+    {
+        const arm_compute::graph::Edge *edge = g.edge(node.input_edge_id(idx));
+        return edge != nullptr && edge->producer() != nullptr && edge->producer()->type() == arm_compute::graph::NodeType::Const;
+    }
+
+    unsigned int _replaced;
+};
+
+/** Prepares the execution of the 1xK and Kx1 convolutions of a graph
+ *
+ * @param[in] mode How to execute the asymmetric convolutions
+ *
+ * @return The mutator to pass to @ref GraphExecutor::finalize(), nullptr in the gemm mode
+ */
+inline std::unique_ptr<IWorkloadMutator> apply_asymmetric_conv_mode(AsymmetricConvMode mode)
+{
+    if(mode == AsymmetricConvMode::Gemm)
+    {
+        return nullptr;
+    }
+    return std::unique_ptr<IWorkloadMutator>(arm_compute::support::cpp14::make_unique<AsymmetricConvMutator>());
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_ASYMMETRIC_CONV_H__ */
@@ -0,0 +1,548 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_BATCH_NORM_FOLDING_H__
+#define __WIDTH_MULTIPLIED_BATCH_NORM_FOLDING_H__
+
+#include "arm_compute/core/Helpers.h"
+#include "arm_compute/core/ITensor.h"
+#include "arm_compute/core/Types.h"
+#include "arm_compute/core/Utils.h"
+#include "arm_compute/core/Window.h"
+#include "arm_compute/core/utils/misc/Cast.h"
+#include "arm_compute/graph.h"
+#include "arm_compute/runtime/Tensor.h"
+#include "support/ToolchainSupport.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace width_multiplied
+{
+/** How the batch normalizations following a convolution are executed */
+enum class BatchNormMode
+{
+    Unfused, /**< As separate layers, one more pass over every activation tensor */
+    Folded,  /**< Folded into the weights and bias of the convolution when the graph is built */
+};
+
+/** Stream operator to print a batch normalization mode
+ *
+ * @param[out] os   Output stream
+ * @param[in]  mode Mode to print
+ *
+ * @return Modified output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, BatchNormMode mode)
+{
+    os << (mode == BatchNormMode::Folded ? "folded" : "unfused");
+    return os;
+}
+
+/** Stream operator to read a batch normalization mode
+ *
+ * @param[in]  is   Input stream
+ * @param[out] mode Mode read
+ *
+ * @return Modified input stream
+ */
+inline std::istream &operator>>(std::istream &is, BatchNormMode &mode)
+{
+    std::string value;
+    is >> value;
+    if(value == "unfused")
+    {
+        mode = BatchNormMode::Unfused;
+    }
+    else if(value == "folded")
+    {
+        mode = BatchNormMode::Folded;
+    }
+    else
+    {
+        is.setstate(std::ios::failbit);
+    }
+    return is;
+}
+
+/** Applies a function to every element of a F32 or F16 tensor
+ *
+ * @param[in,out] tensor      Tensor to update, mapped
+ * @param[in]     channel_dim Dimension of the channels
+ * @param[in]     function    Function of the current value and the channel of the element, returning the new value
+ */
+template <typename F>
+void transform_channels(arm_compute::ITensor &tensor, size_t channel_dim, F &&function)
+{
+    using namespace arm_compute;
+
+    Window window;
+    window.use_tensor_dimensions(tensor.info()->tensor_shape());
+    Iterator it(&tensor, window);
+    if(tensor.info()->data_type() == DataType::F16)
+    {
+        execute_window_loop(window, [&](const Coordinates & id)
+        {
+            half *value = reinterpret_cast<half *>(it.ptr());
+            *value      = static_cast<half>(function(static_cast<float>(*value), id[channel_dim]));
+        },
+        it);
+    }
+    else
+    {
+        execute_window_loop(window, [&](const Coordinates & id)
+        {
+            float *value = reinterpret_cast<float *>(it.ptr());
+            *value       = function(*value, id[channel_dim]);
+        },
+        it);
+    }
+}
+
+/** Parameters of a batch normalization folded into a convolution
+ *
+ * The parameters are read from the accessors of the batch normalization the first time the
+ * weights or the bias of the convolution are filled, into temporary tensors, so the graph never
+ * allocates them. Folding turns BN(conv(x, W) + b) into conv(x, W * s) + (b * s + t), with
+ * s = gamma / sqrt(var + epsilon) and t = beta - mean * s per output channel.
+ */
+class BatchNormFolding
+{
+public:
+    /** Constructor
+     *
+     * @param[in] epsilon  Epsilon of the batch normalization
+     * @param[in] desc     Descriptor of the parameters, one value per channel
+     * @param[in] mean     Accessor of the mean
+     * @param[in] var      Accessor of the variance
+     * @param[in] beta     Accessor of beta, nullptr for 0
+     * @param[in] gamma    Accessor of gamma, nullptr for 1
+     */
+    BatchNormFolding(float epsilon, const arm_compute::graph::TensorDescriptor &desc, std::unique_ptr<arm_compute::graph::ITensorAccessor> mean,
+                     std::unique_ptr<arm_compute::graph::ITensorAccessor> var, std::unique_ptr<arm_compute::graph::ITensorAccessor> beta,
+                     std::unique_ptr<arm_compute::graph::ITensorAccessor> gamma)
+        : _epsilon(epsilon), _desc(desc), _mean(std::move(mean)), _var(std::move(var)), _beta(std::move(beta)), _gamma(std::move(gamma)), _scale(), _shift()
+    {
+    }
+    /** Scale of every output channel */
+    const std::vector<float> &scale()
+    {
+        load();
+        return _scale;
+    }
+    /** Shift of every output channel */
+    const std::vector<float> &shift()
+    {
+        load();
+        return _shift;
+    }
+
+private:
+    std::vector<float> read(arm_compute::graph::ITensorAccessor *accessor, float default_value) const
+    {
+        const size_t       channels = _desc.shape.total_size();
+        std::vector<float> values(channels, default_value);
+        if(accessor == nullptr)
+        {
+            return values;
+        }
+        // Zeroed first, so that an accessor leaving the tensor as allocated gives zeros rather than garbage.
+        // The parameters of a quantized graph are read in F32, as the graph folds them before quantizing
+        const arm_compute::DataType data_type = arm_compute::is_data_type_float(_desc.data_type) ? _desc.data_type : arm_compute::DataType::F32;
+        arm_compute::Tensor         tensor;
+        tensor.allocator()->init(arm_compute::TensorInfo(_desc.shape, 1, data_type));
+        tensor.allocator()->allocate();
+        std::memset(tensor.buffer(), 0, tensor.info()->total_size());
+        accessor->access_tensor(tensor);
+        transform_channels(tensor, 0, [&](float value, size_t channel)
+        {
+            values[channel] = value;
+            return value;
+        });
+        return values;
+    }
+
+    void load()
+    {
+        if(!_scale.empty())
+        {
+            return;
+        }
+        const std::vector<float> mean  = read(_mean.get(), 0.f);
+        const std::vector<float> var   = read(_var.get(), 1.f);
+        const std::vector<float> beta  = read(_beta.get(), 0.f);
+        const std::vector<float> gamma = read(_gamma.get(), 1.f);
+        _scale.resize(mean.size());
+        _shift.resize(mean.size());
+        for(size_t c = 0; c < mean.size(); ++c)
+        {
+            _scale[c] = gamma[c] / std::sqrt(var[c] + _epsilon);
+            _shift[c] = beta[c] - mean[c] * _scale[c];
+        }
+    }
+
+    float                                                _epsilon;
+    arm_compute::graph::TensorDescriptor                 _desc;
+    std::unique_ptr<arm_compute::graph::ITensorAccessor> _mean;
+    std::unique_ptr<arm_compute::graph::ITensorAccessor> _var;
+    std::unique_ptr<arm_compute::graph::ITensorAccessor> _beta;
+    std::unique_ptr<arm_compute::graph::ITensorAccessor> _gamma;
+    std::vector<float>                                   _scale;
+    std::vector<float>                                   _shift;
+};
+
+/** Accessor filling the weights of a convolution with a batch normalization folded in */
+class FoldedWeightsAccessor final : public arm_compute::graph::ITensorAccessor
+{
+public:
+    /** Constructor
+     *
+     * @param[in] weights     Accessor of the original weights, nullptr to scale the tensor as allocated
+     * @param[in] folding     Folded batch normalization
+     * @param[in] channel_dim Dimension of the output channels in the weights
+     */
+    FoldedWeightsAccessor(std::unique_ptr<arm_compute::graph::ITensorAccessor> weights, std::shared_ptr<BatchNormFolding> folding, size_t channel_dim)
+        : _weights(std::move(weights)), _folding(std::move(folding)), _channel_dim(channel_dim)
+    {
+    }
+    /** Allow instances of this class to be move constructed */
+    FoldedWeightsAccessor(FoldedWeightsAccessor &&) = default;
+
+    // Inherited methods overriden:
+    bool access_tensor(arm_compute::ITensor &tensor) override
+    {
+        if(_weights != nullptr)
+        {
+            _weights->access_tensor(tensor);
+        }
+        const std::vector<float> &scale = _folding->scale();
+        transform_channels(tensor, _channel_dim, [&](float value, size_t channel)
+        {
+            return value * scale[channel];
+        });
+        return true;
+    }
+
+private:
+    std::unique_ptr<arm_compute::graph::ITensorAccessor> _weights;
+    std::shared_ptr<BatchNormFolding>                    _folding;
+    size_t                                               _channel_dim;
+};
+
+/** Accessor filling the bias of a convolution with a batch normalization folded in */
+class FoldedBiasAccessor final : public arm_compute::graph::ITensorAccessor
+{
+public:
+    /** Constructor
+     *
+     * @param[in] bias          Accessor of the original bias, nullptr if the convolution had none
+     * @param[in] folding       Folded batch normalization
+     * @param[in] first_channel (Optional) Channel of the batch normalization of the first element of the bias, for a group of a grouped convolution
+     */
+    FoldedBiasAccessor(std::unique_ptr<arm_compute::graph::ITensorAccessor> bias, std::shared_ptr<BatchNormFolding> folding, size_t first_channel = 0)
+        : _bias(std::move(bias)), _folding(std::move(folding)), _first_channel(first_channel)
+    {
+    }
+    /** Allow instances of this class to be move constructed */
+    FoldedBiasAccessor(FoldedBiasAccessor &&) = default;
+
+    // Inherited methods overriden:
+    bool access_tensor(arm_compute::ITensor &tensor) override
+    {
+        const bool has_bias = _bias != nullptr;
+        if(has_bias)
+        {
+            _bias->access_tensor(tensor);
+        }
+        const std::vector<float> &scale = _folding->scale();
+        const std::vector<float> &shift = _folding->shift();
+        transform_channels(tensor, 0, [&](float value, size_t channel)
+        {
+            return (has_bias ? value * scale[_first_channel + channel] : 0.f) + shift[_first_channel + channel];
+        });
+        return true;
+    }
+
+private:
+    std::unique_ptr<arm_compute::graph::ITensorAccessor> _bias;
+    std::shared_ptr<BatchNormFolding>                    _folding;
+    size_t                                               _first_channel;
+};
+
+/** Returns the constant tensor feeding an input of a node, through the split of the parameters of a grouped convolution
+ *
+ * @param[in] g    Graph of the node
+ * @param[in] node Node to get the input of
+ * @param[in] idx  Index of the input
+ *
+ * @return The output tensor of the constant node, nullptr if the input is not constant
+ */
+inline arm_compute::graph::Tensor *get_const_source(arm_compute::graph::Graph &g, const arm_compute::graph::INode &node, size_t idx)
+{
+    using namespace arm_compute::graph;
+    const Edge *edge     = g.edge(node.input_edge_id(idx));
+    INode      *producer = (edge != nullptr) ? edge->producer() : nullptr;
+    while(producer != nullptr && producer->type() == NodeType::SplitLayer)
+    {
+        edge     = g.edge(producer->input_edge_id(0));
+        producer = (edge != nullptr) ? edge->producer() : nullptr;
+    }
+    return (producer != nullptr && producer->type() == NodeType::Const) ? producer->output(0) : nullptr;
+}
+
+/** Graph mutator folding every batch normalization into the convolution feeding it
+ *
+ * A batch normalization is folded when it is the only consumer of a F32 or F16 convolution or
+ * depthwise convolution whose weights (and bias, if any) are constant, or of the concatenation of
+ * the groups of a grouped convolution, which the frontend splits into one convolution per group. QASYMM8 convolutions are
+ * folded into on request: their accessors then fill F32 tensors, quantized by the caller (see
+ * @ref QuantizationMutator). Its parameter nodes are
+ * removed and its consumers are connected to the convolution; a convolution without bias gets a
+ * constant bias node. Runs on the graph as built by the frontend, before the targets are assigned
+ * and the tensors configured, and before NodeFusionMutator merges batch normalizations with the
+ * activations that follow them. ACL 18.08 has no such folding pass, and the weights are scaled when
+ * their accessors fill them, so the trained and synthetic weights are both folded.
+ */
+class BatchNormFoldingMutator final : public arm_compute::graph::IGraphMutator
+{
+public:
+    /** Constructor
+     *
+     * @param[in] convolutions (Optional) Convolutions to fold into, all of them if empty
+     * @param[in] quantized    (Optional) Also fold into QASYMM8 convolutions
+     */
+    explicit BatchNormFoldingMutator(std::vector<arm_compute::graph::NodeID> convolutions = std::vector<arm_compute::graph::NodeID>(), bool quantized = false)
+        : _convolutions(std::move(convolutions)), _quantized(quantized), _folded(0)
+    {
+    }
+    /** Number of batch normalizations folded so far */
+    unsigned int folded() const
+    {
+        return _folded;
+    }
+
+    // Inherited methods overriden:
+    virtual void mutate(arm_compute::graph::Graph &g) override
+    {
+        using namespace arm_compute::graph;
+
+        // Constant bias nodes are appended while iterating
+        for(NodeID id = 0; id < g.nodes().size(); ++id)
+        {
+            INode *node = g.node(id);
+            if(node == nullptr || node->type() != NodeType::BatchNormalizationLayer)
+            {
+                continue;
+            }
+            auto       *bn_node    = arm_compute::utils::cast::polymorphic_downcast<BatchNormalizationLayerNode *>(node);
+            const Edge *input_edge = g.edge(bn_node->input_edge_id(0));
+            INode      *conv_node  = (input_edge != nullptr) ? input_edge->producer() : nullptr;
+            if(conv_node == nullptr || bn_node->fused_activation().enabled() || !is_foldable(g, *conv_node)
+               || (!_convolutions.empty() && std::find(_convolutions.begin(), _convolutions.end(), conv_node->id()) == _convolutions.end()))
+            {
+                continue;
+            }
+
+            // Move the accessors of the parameters to the folding
+            const TensorDescriptor            param_desc = bn_node->input(1)->desc();
+            std::shared_ptr<BatchNormFolding> folding    = std::make_shared<BatchNormFolding>(bn_node->epsilon(), param_desc, extract_accessor(*bn_node, 1),
+                                                                                              extract_accessor(*bn_node, 2), extract_accessor(*bn_node, 3),
+                                                                                              extract_accessor(*bn_node, 4));
+            if(conv_node->type() == NodeType::ConcatenateLayer)
+            {
+                fold_groups(g, *conv_node, folding, param_desc);
+            }
+            else
+            {
+                arm_compute::graph::Tensor *weights     = conv_node->input(1);
+                const size_t                channel_dim = get_dimension_idx(weights->desc(), conv_node->type() == NodeType::ConvolutionLayer ? arm_compute::DataLayoutDimension::BATCHES : arm_compute::DataLayoutDimension::CHANNEL);
+                weights->set_accessor(arm_compute::support::cpp14::make_unique<FoldedWeightsAccessor>(weights->extract_accessor(), folding, channel_dim));
+                arm_compute::graph::Tensor *bias = conv_node->input(2);
+                if(bias == nullptr)
+                {
+                    bias = add_bias(g, *conv_node, param_desc);
+                }
+                bias->set_accessor(arm_compute::support::cpp14::make_unique<FoldedBiasAccessor>(bias->extract_accessor(), folding));
+            }
+
+            // Remove the batch normalization and its parameters, and feed its consumers from the convolution
+            std::vector<NodeIdxPair> consumers;
+            for(const auto &output_edge_id : bn_node->output_edges())
+            {
+                const Edge *output_edge = g.edge(output_edge_id);
+                if(output_edge != nullptr)
+                {
+                    consumers.push_back({ output_edge->consumer_id(), output_edge->consumer_idx() });
+                }
+            }
+            std::vector<NodeID> param_nodes;
+            for(size_t idx = 1; idx < bn_node->num_inputs(); ++idx)
+            {
+                const Edge *param_edge = g.edge(bn_node->input_edge_id(idx));
+                if(param_edge != nullptr)
+                {
+                    param_nodes.push_back(param_edge->producer_id());
+                }
+            }
+            std::unique_ptr<ITensorAccessor> output_accessor = bn_node->output(0)->extract_accessor();
+            const NodeID                     conv_id         = conv_node->id();
+            g.remove_node(bn_node->id());
+            for(NodeID param_node : param_nodes)
+            {
+                g.remove_node(param_node);
+            }
+            for(const auto &consumer : consumers)
+            {
+                g.add_connection(conv_id, 0, consumer.node_id, consumer.index);
+            }
+            g.node(conv_id)->output(0)->set_accessor(std::move(output_accessor));
+            ++_folded;
+        }
+    }
+    const char *name() override
+    {
+        return "BatchNormFoldingMutator";
+    }
+
+private:
+    static std::unique_ptr<arm_compute::graph::ITensorAccessor> extract_accessor(arm_compute::graph::INode &node, size_t idx)
+    {
+        arm_compute::graph::Tensor *tensor = node.input(idx);
+        return (tensor != nullptr) ? tensor->extract_accessor() : nullptr;
+    }
+
+    static bool is_const_input(arm_compute::graph::Graph &g, const arm_compute::graph::INode &node, size_t idx)
+    {
+        const arm_compute::graph::Edge *edge = g.edge(node.input_edge_id(idx));
+        return edge != nullptr && edge->producer() != nullptr && edge->producer()->type() == arm_compute::graph::NodeType::Const;
+    }
+
+    static arm_compute::graph::Tensor *add_bias(arm_compute::graph::Graph &g, arm_compute::graph::INode &conv_node, const arm_compute::graph::TensorDescriptor &desc)
+    {
+        const arm_compute::graph::NodeID bias_nid = g.add_node<arm_compute::graph::ConstNode>(desc);
+        g.node(bias_nid)->set_name(conv_node.name() + "/FoldedBias");
+        g.add_connection(bias_nid, 0, conv_node.id(), 2);
+        return conv_node.input(2);
+    }
+
+    /** Returns the convolutions of the groups of a grouped convolution, as built by the frontend, empty if the node is not one */
+    static std::vector<arm_compute::graph::INode *> get_groups(arm_compute::graph::Graph &g, const arm_compute::graph::INode &concat_node)
+    {
+        using namespace arm_compute::graph;
+        std::vector<INode *>              groups;
+        const arm_compute::graph::Tensor *weights = nullptr;
+        for(size_t idx = 0; idx < concat_node.num_inputs(); ++idx)
+        {
+            const Edge *edge  = g.edge(concat_node.input_edge_id(idx));
+            INode      *group = (edge != nullptr) ? edge->producer() : nullptr;
+            if(group == nullptr || group->type() != NodeType::ConvolutionLayer || group->output_edges().size() != 1 || get_const_source(g, *group, 1) == nullptr
+               || (weights != nullptr && get_const_source(g, *group, 1) != weights) || (group->input(2) != nullptr && get_const_source(g, *group, 2) == nullptr))
+            {
+                return std::vector<INode *>();
+            }
+            weights = get_const_source(g, *group, 1);
+            groups.push_back(group);
+        }
+        return groups;
+    }
+
+    /** Folds a batch normalization into the shared weights and the biases of the groups of a grouped convolution */
+    static void fold_groups(arm_compute::graph::Graph &g, arm_compute::graph::INode &concat_node, const std::shared_ptr<BatchNormFolding> &folding,
+                            const arm_compute::graph::TensorDescriptor &param_desc)
+    {
+        using namespace arm_compute::graph;
+        const std::vector<INode *> groups = get_groups(g, concat_node);
+
+        // The groups split the weights along the output channels, which the folding scales as a whole
+        arm_compute::graph::Tensor *weights     = get_const_source(g, *groups.front(), 1);
+        const size_t                channel_dim = get_dimension_idx(weights->desc(), arm_compute::DataLayoutDimension::BATCHES);
+        weights->set_accessor(arm_compute::support::cpp14::make_unique<FoldedWeightsAccessor>(weights->extract_accessor(), folding, channel_dim));
+
+        arm_compute::graph::Tensor *bias = get_const_source(g, *groups.front(), 2);
+        if(bias != nullptr)
+        {
+            bias->set_accessor(arm_compute::support::cpp14::make_unique<FoldedBiasAccessor>(bias->extract_accessor(), folding));
+            return;
+        }
+        size_t first_channel = 0;
+        for(INode *group : groups)
+        {
+            TensorDescriptor group_desc = param_desc;
+            group_desc.shape            = arm_compute::TensorShape(get_dimension_size(group->output(0)->desc(), arm_compute::DataLayoutDimension::CHANNEL));
+            add_bias(g, *group, group_desc)->set_accessor(arm_compute::support::cpp14::make_unique<FoldedBiasAccessor>(nullptr, folding, first_channel));
+            first_channel += group_desc.shape.total_size();
+        }
+    }
+
+    bool is_foldable(arm_compute::graph::Graph &g, const arm_compute::graph::INode &conv_node) const
+    {
+        using namespace arm_compute::graph;
+        if(conv_node.type() == NodeType::ConcatenateLayer)
+        {
+            const std::vector<INode *> groups = get_groups(g, conv_node);
+            return !groups.empty() && conv_node.output_edges().size() == 1 && is_foldable_type(conv_node.output(0)->desc().data_type);
+        }
+        if(conv_node.type() != NodeType::ConvolutionLayer && conv_node.type() != NodeType::DepthwiseConvolutionLayer)
+        {
+            return false;
+        }
+        return conv_node.output_edges().size() == 1 && is_foldable_type(conv_node.output(0)->desc().data_type)
+               && is_const_input(g, conv_node, 1)
+               && (conv_node.input(2) == nullptr || is_const_input(g, conv_node, 2));
+    }
+
+    bool is_foldable_type(arm_compute::DataType data_type) const
+    {
+        return data_type == arm_compute::DataType::F32 || data_type == arm_compute::DataType::F16 || (_quantized && data_type == arm_compute::DataType::QASYMM8);
+    }
+
+    std::vector<arm_compute::graph::NodeID> _convolutions;
+    bool                                    _quantized;
+    unsigned int                            _folded;
+};
+
+/** Folds the batch normalizations of a graph if requested
+ *
+ * @param[in,out] g    Graph built by the frontend, not finalized yet
+ * @param[in]     mode Batch normalization mode
+ *
+ * @return Number of batch normalizations folded
+ */
+inline unsigned int apply_batch_norm_mode(arm_compute::graph::Graph &g, BatchNormMode mode)
+{
+    if(mode != BatchNormMode::Folded)
+    {
+        return 0;
+    }
+    BatchNormFoldingMutator mutator;
+    mutator.mutate(g);
+    return mutator.folded();
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_BATCH_NORM_FOLDING_H__ */
@@ -0,0 +1,526 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_CAFFE_GRAPH_H__
+#define __WIDTH_MULTIPLIED_CAFFE_GRAPH_H__
+
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+#include "utils/CommonGraphOptions.h"
+#include "utils/GraphUtils.h"
+
+#include "common/Cifar10.h"
+#include "common/Prototxt.h"
+#include "common/SweepUtils.h"
+
+#include <algorithm>
+#include <array>
+#include <map>
+#include <numeric>
+#include <string>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Checks whether a model is a Caffe prototxt to import rather than a graph family
+ *
+ * @param[in] model Graph family name or path to a .prototxt file
+ *
+ * @return True if the model ends with .prototxt
+ */
+inline bool is_caffe_prototxt(const std::string &model)
+{
+    const std::string extension = ".prototxt";
+    return model.size() > extension.size() && model.compare(model.size() - extension.size(), extension.size(), extension) == 0;
+}
+
+/** Returns the name of the model of a Caffe prototxt: its file name without the directory, the .prototxt
+ * extension and the _train_test or _deploy suffix (e.g. sp_shufflenet for sp_shufflenet_train_test.prototxt)
+ *
+ * @param[in] prototxt Path to the .prototxt file
+ *
+ * @return Model name
+ */
+inline std::string get_caffe_model_name(const std::string &prototxt)
+{
+    std::string name = prototxt.substr(prototxt.find_last_of('/') + 1);
+    name             = name.substr(0, name.size() - std::string(".prototxt").size());
+    for(const std::string suffix : { "_train_test", "_deploy" })
+    {
+        if(name.size() > suffix.size() && name.compare(name.size() - suffix.size(), suffix.size(), suffix) == 0)
+        {
+            return name.substr(0, name.size() - suffix.size());
+        }
+    }
+    return name;
+}
+
+/** Builds the network of a Caffe prototxt into a graph stream for a given width and resolution multiplier
+ *
+ * The layers run in the test phase are imported in file order: Data and Input, Convolution (depthwise when it
+ * has one group per channel), BatchNorm with the Scale that follows it, ReLU, Eltwise sums, InnerProduct,
+ * ShuffleChannel, Pooling, Dropout (skipped) and Softmax or SoftmaxWithLoss, which becomes the output of the
+ * graph. Accuracy layers are ignored and any other layer exits with an error. The blobs are tracked by name,
+ * so in-place layers and branches are supported.
+ *
+ * The trained weights are the blobs of the caffemodel saved as .npy files in /cnn_data/<model>_model/, named
+ * as for @ref CifarGraphBuilder, <model> being given by @ref get_caffe_model_name. The input is preprocessed
+ * with the mean_value of the data layer. A mean_file is a binaryproto, so it is read instead as mean.npy, a
+ * 3x32x32 mean image saved next to the weights, and averaged per channel; it is ignored without trained weights.
+ *
+ * @note The channel counts of the convolutions are scaled by the width multiplier and, when the network has
+ *       grouped convolutions, rounded down to multiples of their largest group count, so that every branch
+ *       of an Eltwise layer keeps the same count. The fully connected layers are not scaled.
+ */
+class CaffeGraphBuilder
+{
+public:
+    /** Constructor
+     *
+     * @param[in] graph         Stream to add the layers to
+     * @param[in] common_params Common graph parameters
+     */
+    CaffeGraphBuilder(arm_compute::graph::frontend::Stream &graph, const arm_compute::utils::CommonGraphParams &common_params)
+        : graph(graph), common_params(common_params), data_path(), depth_scale(1.f, ChannelRounding()), group_multiple(1U), blobs()
+    {
+    }
+    /** Adds the whole network, from input to output layer, to the stream
+     *
+     * @param[in] variant Path to the prototxt, width, resolution and batch size to build
+     */
+    void create_graph(const GraphVariant &variant)
+    {
+        using namespace arm_compute::graph::frontend;
+
+        const PrototxtMessage net = parse_prototxt(variant.model);
+
+        // Get trainable parameters data path
+        data_path = common_params.data_path.empty() ? "" : common_params.data_path + "/cnn_data/" + get_caffe_model_name(variant.model) + "_model/";
+
+        // Scale the channel counts by the width multiplier
+        depth_scale = ChannelScaler(variant.width, variant.rounding);
+
+        std::vector<const PrototxtMessage *> layers;
+        for(const PrototxtMessage *layer : net.get_messages("layer"))
+        {
+            if(in_test_phase(*layer))
+            {
+                layers.push_back(layer);
+            }
+        }
+        group_multiple = largest_group(layers);
+
+        graph << common_params.target
+              << common_params.fast_math_hint;
+
+        // Deploy prototxts may declare their input outside of any layer
+        if(net.has("input"))
+        {
+            add_input(net.get("input"), variant, nullptr);
+        }
+
+        std::string output_name;
+        Blob        output;
+        for(size_t i = 0; i < layers.size(); ++i)
+        {
+            const PrototxtMessage &layer = *layers[i];
+            const std::string      type  = layer.get("type");
+            if(type == "Data" || type == "Input" || type == "ImageData")
+            {
+                add_input(layer.get("top"), variant, layer.message("transform_param"));
+            }
+            else if(type == "Convolution")
+            {
+                add_convolution(layer);
+            }
+            else if(type == "BatchNorm")
+            {
+                // A BatchNorm layer is followed by the Scale layer holding its gamma and beta
+                const bool has_scale = i + 1 < layers.size() && layers[i + 1]->get("type") == "Scale" && layers[i + 1]->get("bottom") == layer.get("top");
+                add_batch_normalization(layer, has_scale ? layers[++i] : nullptr);
+            }
+            else if(type == "ReLU")
+            {
+                add_relu(layer);
+            }
+            else if(type == "Eltwise")
+            {
+                add_eltwise(layer);
+            }
+            else if(type == "InnerProduct")
+            {
+                add_inner_product(layer);
+            }
+            else if(type == "ShuffleChannel")
+            {
+                add_shuffle_channel(layer);
+            }
+            else if(type == "Pooling")
+            {
+                add_pooling(layer);
+            }
+            else if(type == "Dropout")
+            {
+                set_top(layer, bottom(layer));
+            }
+            else if(type == "Softmax" || type == "SoftmaxWithLoss")
+            {
+                output_name = layer.get("name");
+                output      = bottom(layer);
+            }
+            else
+            {
+                ARM_COMPUTE_EXIT_ON_MSG(type != "Accuracy", "Unsupported layer %s of type %s in %s", layer.get("name").c_str(), type.c_str(), variant.model.c_str());
+            }
+        }
+
+        // Without a softmax, the output is the last layer
+        if(output_name.empty())
+        {
+            graph << OutputLayer(get_recorded_output_accessor(common_params, 5));
+            return;
+        }
+        graph.forward_tail(output.node);
+        graph << SoftmaxLayer().set_name(output_name)
+              << OutputLayer(get_recorded_output_accessor(common_params, 5));
+    }
+
+private:
+    /** Node producing a blob and its channel count */
+    struct Blob
+    {
+        arm_compute::graph::NodeID node{ arm_compute::graph::EmptyNodeID }; /**< Last node writing the blob */
+        unsigned int               channels{ 0U };                          /**< Channel count in the graph */
+        unsigned int               trained_channels{ 0U };                  /**< Channel count in the prototxt */
+    };
+
+    arm_compute::graph::frontend::Stream        &graph;
+    const arm_compute::utils::CommonGraphParams &common_params;
+    std::string                                 data_path;
+    ChannelScaler                               depth_scale;
+    unsigned int                                group_multiple;
+    std::map<std::string, Blob>                 blobs;
+
+    static bool in_test_phase(const PrototxtMessage &layer)
+    {
+        for(const PrototxtMessage *include : layer.get_messages("include"))
+        {
+            if(include->has("phase") && include->get("phase") != "TEST")
+            {
+                return false;
+            }
+        }
+        for(const PrototxtMessage *exclude : layer.get_messages("exclude"))
+        {
+            if(exclude->get("phase") == "TEST")
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static unsigned int largest_group(const std::vector<const PrototxtMessage *> &layers)
+    {
+        unsigned int largest = 1U;
+        for(const PrototxtMessage *layer : layers)
+        {
+            const PrototxtMessage *param = layer->message("convolution_param");
+            if(layer->get("type") == "Convolution" && param != nullptr)
+            {
+                const unsigned int groups = param->get_uint("group", 1U);
+                // Depthwise convolutions follow the channel count of their input
+                if(groups != param->get_uint("num_output", 0U))
+                {
+                    largest = std::max(largest, groups);
+                }
+            }
+        }
+        return largest;
+    }
+
+    /** Returns a spatial parameter (kernel_size, pad, stride) of a layer, from its _h or _w field if set, else from its repeated field */
+    static unsigned int spatial_param(const PrototxtMessage &param, const std::string &name, bool height, unsigned int default_value)
+    {
+        const std::string name_hw = (name == "kernel_size" ? "kernel" : name) + (height ? "_h" : "_w");
+        if(param.has(name_hw))
+        {
+            return param.get_uint(name_hw, default_value);
+        }
+        // A single value applies to both dimensions, else the height comes first
+        return param.get_uint(name, default_value, (height || param.count(name) < 2) ? 0 : 1);
+    }
+
+    static arm_compute::PadStrideInfo pad_stride_info(const PrototxtMessage &param, arm_compute::DimensionRoundingType rounding = arm_compute::DimensionRoundingType::FLOOR)
+    {
+        return arm_compute::PadStrideInfo(spatial_param(param, "stride", false, 1U), spatial_param(param, "stride", true, 1U),
+                                          spatial_param(param, "pad", false, 0U), spatial_param(param, "pad", true, 0U), rounding);
+    }
+
+    const Blob &bottom(const PrototxtMessage &layer, size_t index = 0) const
+    {
+        const std::string name = layer.get("bottom", "", index);
+        const auto        blob = blobs.find(name);
+        ARM_COMPUTE_EXIT_ON_MSG(blob == blobs.end(), "Unknown bottom blob \"%s\" of layer %s", name.c_str(), layer.get("name").c_str());
+        return blob->second;
+    }
+
+    void set_top(const PrototxtMessage &layer, const Blob &blob)
+    {
+        blobs[layer.get("top")] = blob;
+    }
+
+    /** Records the last node added to the stream as the top blob of a layer */
+    void set_top(const PrototxtMessage &layer, unsigned int channels, unsigned int trained_channels)
+    {
+        Blob blob;
+        blob.node             = graph.tail_node();
+        blob.channels         = channels;
+        blob.trained_channels = trained_channels;
+        set_top(layer, blob);
+    }
+
+    /** Moves the tail of the stream to the first bottom blob of a layer, which the next layer added reads */
+    const Blob &read_bottom(const PrototxtMessage &layer)
+    {
+        const Blob &blob = bottom(layer);
+        graph.forward_tail(blob.node);
+        return blob;
+    }
+
+    /** Scales the channel count of a convolution, keeping it a multiple of the group counts of the network */
+    unsigned int scale_depth(unsigned int channels) const
+    {
+        const unsigned int scaled = depth_scale(channels);
+        if(group_multiple > 1U && channels % group_multiple == 0U)
+        {
+            return std::max(group_multiple, scaled / group_multiple * group_multiple);
+        }
+        return scaled;
+    }
+
+    std::unique_ptr<arm_compute::graph::ITensorAccessor> weights(const std::string &file) const
+    {
+        return get_mapped_weights_accessor(data_path, file);
+    }
+
+    void add_input(const std::string &name, const GraphVariant &variant, const PrototxtMessage *transform_param)
+    {
+        using namespace arm_compute::graph::frontend;
+        using namespace arm_compute::graph_utils;
+
+        ARM_COMPUTE_EXIT_ON_MSG(blobs.count(name) != 0, "The network has more than one input");
+
+        // Create a preprocessor object subtracting the mean_file or mean_value of the data layer, if any
+        std::array<float, 3> mean_rgb{ { 0.f, 0.f, 0.f } };
+        if(transform_param != nullptr && transform_param->has("mean_file"))
+        {
+            if(!data_path.empty())
+            {
+                const std::vector<float> mean  = load_cifar10_mean(data_path + "mean.npy");
+                const size_t             plane = mean.size() / mean_rgb.size();
+                for(size_t c = 0; c < mean_rgb.size(); ++c)
+                {
+                    mean_rgb[c] = std::accumulate(mean.begin() + c * plane, mean.begin() + (c + 1) * plane, 0.f) / plane;
+                }
+            }
+        }
+        else if(transform_param != nullptr)
+        {
+            for(size_t c = 0; c < mean_rgb.size(); ++c)
+            {
+                // A single mean_value applies to every channel
+                mean_rgb[c] = transform_param->get_float("mean_value", 0.f, transform_param->count("mean_value") > 1 ? c : 0);
+            }
+        }
+        std::unique_ptr<IPreprocessor> preprocessor = arm_compute::support::cpp14::make_unique<CaffePreproccessor>(mean_rgb,
+                                                                                                                   false /* Do not convert to BGR */);
+
+        // Create input descriptor
+        const TensorShape tensor_shape     = permute_shape(TensorShape(variant.resolution, variant.resolution, 3U, variant.batch), DataLayout::NCHW, common_params.data_layout);
+        TensorDescriptor  input_descriptor = TensorDescriptor(tensor_shape, common_params.data_type).set_layout(common_params.data_layout);
+
+        graph << InputLayer(input_descriptor, get_input_accessor(common_params, std::move(preprocessor), false /* Do not convert to BGR */));
+
+        Blob blob;
+        blob.node             = graph.tail_node();
+        blob.channels         = 3U;
+        blob.trained_channels = 3U;
+        blobs[name]           = blob;
+    }
+
+    void add_convolution(const PrototxtMessage &layer)
+    {
+        const std::string      name  = layer.get("name");
+        const PrototxtMessage *param = layer.message("convolution_param");
+        ARM_COMPUTE_EXIT_ON_MSG(param == nullptr, "Convolution %s has no convolution_param", name.c_str());
+        ARM_COMPUTE_EXIT_ON_MSG(param->get_uint("dilation", 1U) != 1U, "Convolution %s: dilated convolutions are not supported", name.c_str());
+
+        const Blob &input = read_bottom(layer);
+
+        const unsigned int num_output  = param->get_uint("num_output", 0U);
+        const unsigned int num_groups  = param->get_uint("group", 1U);
+        const unsigned int conv_width  = spatial_param(*param, "kernel_size", false, 0U);
+        const unsigned int conv_height = spatial_param(*param, "kernel_size", true, 0U);
+        const bool         has_bias    = param->get_bool("bias_term", true);
+        auto               bias        = has_bias ? weights(name + "_b.npy") : std::unique_ptr<arm_compute::graph::ITensorAccessor>(nullptr);
+        ARM_COMPUTE_EXIT_ON_MSG(num_output == 0U || conv_width == 0U || conv_height == 0U, "Convolution %s needs num_output and kernel_size", name.c_str());
+
+        if(num_groups > 1U && num_groups == num_output && num_groups == input.trained_channels)
+        {
+            graph << arm_compute::graph::frontend::DepthwiseConvolutionLayer(conv_width, conv_height, weights(name + "_w.npy"), std::move(bias), pad_stride_info(*param)).set_name(name);
+            set_top(layer, input.channels, num_output);
+            return;
+        }
+
+        const unsigned int ofm = scale_depth(num_output);
+        ARM_COMPUTE_EXIT_ON_MSG(input.channels % num_groups != 0U || ofm % num_groups != 0U,
+                                "Convolution %s: %u input and %u output channels cannot be split into %u groups at this width", name.c_str(), input.channels, ofm, num_groups);
+        graph << arm_compute::graph::frontend::ConvolutionLayer(conv_width, conv_height, ofm, weights(name + "_w.npy"), std::move(bias), pad_stride_info(*param), num_groups).set_name(name);
+        set_top(layer, ofm, num_output);
+    }
+
+    void add_batch_normalization(const PrototxtMessage &batch_norm, const PrototxtMessage *scale)
+    {
+        const std::string      name    = batch_norm.get("name");
+        const PrototxtMessage *param   = batch_norm.message("batch_norm_param");
+        const float            epsilon = param != nullptr ? param->get_float("eps", 0.00001f) : 0.00001f;
+
+        // Without a Scale layer, or without its bias, gamma is 1 and beta 0
+        std::unique_ptr<arm_compute::graph::ITensorAccessor> gamma(nullptr);
+        std::unique_ptr<arm_compute::graph::ITensorAccessor> beta(nullptr);
+        if(scale != nullptr)
+        {
+            const PrototxtMessage *scale_param = scale->message("scale_param");
+            gamma                              = weights(scale->get("name") + "_w.npy");
+            if(scale_param != nullptr && scale_param->get_bool("bias_term", false))
+            {
+                beta = weights(scale->get("name") + "_b.npy");
+            }
+        }
+
+        const Blob input = read_bottom(batch_norm);
+        graph << arm_compute::graph::frontend::BatchNormalizationLayer(weights(name + "_mean.npy"), weights(name + "_var.npy"), std::move(gamma), std::move(beta), epsilon).set_name(name);
+        set_top(scale != nullptr ? *scale : batch_norm, input.channels, input.trained_channels);
+    }
+
+    void add_relu(const PrototxtMessage &layer)
+    {
+        using namespace arm_compute::graph::frontend;
+
+        const PrototxtMessage *param          = layer.message("relu_param");
+        const float            negative_slope = param != nullptr ? param->get_float("negative_slope", 0.f) : 0.f;
+
+        const Blob input = read_bottom(layer);
+        graph << ActivationLayer(negative_slope != 0.f ? ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::LEAKY_RELU, negative_slope)
+                                 : ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU))
+              .set_name(layer.get("name"));
+        set_top(layer, input.channels, input.trained_channels);
+    }
+
+    void add_eltwise(const PrototxtMessage &layer)
+    {
+        using namespace arm_compute::graph::frontend;
+
+        const std::string      name  = layer.get("name");
+        const PrototxtMessage *param = layer.message("eltwise_param");
+        ARM_COMPUTE_EXIT_ON_MSG(param != nullptr && param->get("operation", "SUM") != "SUM", "Eltwise %s: only SUM is supported", name.c_str());
+        for(size_t i = 0; param != nullptr && i < param->count("coeff"); ++i)
+        {
+            ARM_COMPUTE_EXIT_ON_MSG(param->get_float("coeff", 1.f, i) != 1.f, "Eltwise %s: coefficients are not supported", name.c_str());
+        }
+        ARM_COMPUTE_EXIT_ON_MSG(layer.count("bottom") < 2, "Eltwise %s needs at least two bottom blobs", name.c_str());
+
+        // The inputs are added two by two
+        Blob sum = bottom(layer);
+        for(size_t i = 1; i < layer.count("bottom"); ++i)
+        {
+            const Blob &input = bottom(layer, i);
+            ARM_COMPUTE_EXIT_ON_MSG(input.channels != sum.channels, "Eltwise %s: the inputs have %u and %u channels", name.c_str(), sum.channels, input.channels);
+
+            graph.forward_tail(sum.node);
+            SubStream left(graph);
+            graph.forward_tail(input.node);
+            SubStream right(graph);
+            graph << BranchLayer(BranchMergeMethod::ADD, std::move(left), std::move(right)).set_name(i + 1 < layer.count("bottom") ? name + "_" + std::to_string(i) : name);
+            sum.node = graph.tail_node();
+        }
+        set_top(layer, sum);
+    }
+
+    void add_inner_product(const PrototxtMessage &layer)
+    {
+        const std::string      name  = layer.get("name");
+        const PrototxtMessage *param = layer.message("inner_product_param");
+        ARM_COMPUTE_EXIT_ON_MSG(param == nullptr || param->get_uint("num_output", 0U) == 0U, "InnerProduct %s needs num_output", name.c_str());
+
+        const unsigned int num_outputs = param->get_uint("num_output", 0U);
+        auto               bias        = param->get_bool("bias_term", true) ? weights(name + "_b.npy") : std::unique_ptr<arm_compute::graph::ITensorAccessor>(nullptr);
+
+        read_bottom(layer);
+        graph << arm_compute::graph::frontend::FullyConnectedLayer(num_outputs, weights(name + "_w.npy"), std::move(bias)).set_name(name);
+        set_top(layer, num_outputs, num_outputs);
+    }
+
+    void add_shuffle_channel(const PrototxtMessage &layer)
+    {
+        const std::string      name       = layer.get("name");
+        const PrototxtMessage *param      = layer.message("shuffle_channel_param");
+        const unsigned int     num_groups = param != nullptr ? param->get_uint("group", 1U) : 1U;
+
+        const Blob input = read_bottom(layer);
+        ARM_COMPUTE_EXIT_ON_MSG(num_groups == 0U || input.channels % num_groups != 0U, "ShuffleChannel %s: %u channels cannot be split into %u groups at this width",
+                                name.c_str(), input.channels, num_groups);
+        graph << arm_compute::graph::frontend::ChannelShuffleLayer(num_groups).set_name(name);
+        set_top(layer, input.channels, input.trained_channels);
+    }
+
+    void add_pooling(const PrototxtMessage &layer)
+    {
+        using namespace arm_compute::graph::frontend;
+
+        const std::string      name  = layer.get("name");
+        const PrototxtMessage *param = layer.message("pooling_param");
+        ARM_COMPUTE_EXIT_ON_MSG(param == nullptr, "Pooling %s has no pooling_param", name.c_str());
+        ARM_COMPUTE_EXIT_ON_MSG(param->get("pool", "MAX") != "MAX" && param->get("pool", "MAX") != "AVE", "Pooling %s: only MAX and AVE pooling are supported", name.c_str());
+
+        const PoolingType  pool_type = param->get("pool", "MAX") == "MAX" ? PoolingType::MAX : PoolingType::AVG;
+        const unsigned int pool_size = spatial_param(*param, "kernel_size", false, 0U);
+        ARM_COMPUTE_EXIT_ON_MSG(!param->get_bool("global_pooling", false) && (pool_size == 0U || pool_size != spatial_param(*param, "kernel_size", true, 0U)),
+                                "Pooling %s needs a square kernel_size", name.c_str());
+
+        const Blob input = read_bottom(layer);
+        if(param->get_bool("global_pooling", false))
+        {
+            graph << PoolingLayer(PoolingLayerInfo(pool_type)).set_name(name);
+        }
+        else
+        {
+            // Caffe rounds the output size up
+            graph << PoolingLayer(PoolingLayerInfo(pool_type, pool_size, pad_stride_info(*param, DimensionRoundingType::CEIL))).set_name(name);
+        }
+        set_top(layer, input.channels, input.trained_channels);
+    }
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_CAFFE_GRAPH_H__ */
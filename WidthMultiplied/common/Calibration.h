@@ -0,0 +1,464 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_CALIBRATION_H__
+#define __WIDTH_MULTIPLIED_CALIBRATION_H__
+
+#include "arm_compute/core/Error.h"
+#include "arm_compute/core/Helpers.h"
+#include "arm_compute/core/ITensor.h"
+#include "arm_compute/core/Types.h"
+#include "arm_compute/core/Window.h"
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+
+#include "common/BatchNormFolding.h"
+#include "common/GraphExecutor.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <istream>
+#include <limits>
+#include <map>
+#include <memory>
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace width_multiplied
+{
+/** How the range of an activation tensor is taken from the values observed on the calibration images */
+enum class CalibrationMethod
+{
+    MinMax,     /**< From the smallest to the largest value */
+    Percentile, /**< Between two percentiles of the values, clipping the outliers */
+};
+
+/** Stream operator to print a calibration method
+ *
+ * @param[out] os     Output stream
+ * @param[in]  method Method to print
+ *
+ * @return Modified output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, CalibrationMethod method)
+{
+    os << (method == CalibrationMethod::Percentile ? "percentile" : "minmax");
+    return os;
+}
+
+/** Stream operator to read a calibration method
+ *
+ * @param[in]  is     Input stream
+ * @param[out] method Method read
+ *
+ * @return Modified input stream
+ */
+inline std::istream &operator>>(std::istream &is, CalibrationMethod &method)
+{
+    std::string value;
+    is >> value;
+    if(value == "minmax")
+    {
+        method = CalibrationMethod::MinMax;
+    }
+    else if(value == "percentile")
+    {
+        method = CalibrationMethod::Percentile;
+    }
+    else
+    {
+        is.setstate(std::ios::failbit);
+    }
+    return is;
+}
+
+/** Range of the values of a tensor, with their histogram once the range is known */
+struct ValueRange
+{
+    float                 min{ std::numeric_limits<float>::max() };    /**< Smallest value */
+    float                 max{ std::numeric_limits<float>::lowest() }; /**< Largest value */
+    std::vector<uint64_t> histogram{};                                 /**< Counts of the values in equal bins over [min, max] */
+
+    /** Returns true if no value was added */
+    bool empty() const
+    {
+        return min > max;
+    }
+    /** Returns the value below which a percentage of the values of the histogram lie
+     *
+     * @param[in] percent Percentage in [0, 100]
+     *
+     * @return The upper bound of the bin reaching the percentage, interpolated linearly
+     */
+    float percentile(double percent) const
+    {
+        uint64_t total = 0;
+        for(uint64_t count : histogram)
+        {
+            total += count;
+        }
+        if(total == 0)
+        {
+            return (percent < 50.0) ? min : max;
+        }
+        const double target     = total * percent / 100.0;
+        const float  bin_width  = (max - min) / histogram.size();
+        uint64_t     cumulative = 0;
+        for(size_t bin = 0; bin < histogram.size(); ++bin)
+        {
+            if(cumulative + histogram[bin] >= target && histogram[bin] > 0)
+            {
+                const double fraction = (target - cumulative) / histogram[bin];
+                return min + bin_width * (bin + static_cast<float>(fraction));
+            }
+            cumulative += histogram[bin];
+        }
+        return max;
+    }
+};
+
+/** Per-layer ranges of the weights and activations of a F32 graph, written as the quantization of its QASYMM8 graph
+ *
+ * The activations are observed in two passes over the calibration images: the first one records
+ * their range, the second one their histogram over that range, used by the percentile method.
+ * The weights are observed once, when loaded. Every range is widened to include 0, so that the
+ * zero padding is exact, and mapped to the 256 levels of QASYMM8.
+ */
+class Calibrator
+{
+public:
+    /** Constructor
+     *
+     * @param[in] bins (Optional) Number of bins of the histograms
+     */
+    explicit Calibrator(size_t bins = 2048)
+        : _bins(bins), _histogram_pass(false), _images(0), _names(), _activations(), _weights()
+    {
+    }
+    /** Starts the histogram pass, once every calibration image was run once */
+    void start_histograms()
+    {
+        _histogram_pass = true;
+        for(auto &activation : _activations)
+        {
+            activation.second.histogram.assign(_bins, 0);
+        }
+    }
+    /** Counts the images of the calibration pass */
+    void add_images(size_t images)
+    {
+        if(!_histogram_pass)
+        {
+            _images += images;
+        }
+    }
+    /** Number of calibration images */
+    size_t images() const
+    {
+        return _images;
+    }
+    /** Observes the values of an activation tensor
+     *
+     * @param[in] name   Name of the layer producing the tensor, "input" for the input of the graph
+     * @param[in] tensor F32 tensor, mapped
+     */
+    void add_activations(const std::string &name, arm_compute::ITensor &tensor)
+    {
+        ValueRange &range = find(_activations, name);
+        if(!_histogram_pass)
+        {
+            update_range(range, tensor);
+            return;
+        }
+        if(range.histogram.empty() || range.empty())
+        {
+            return;
+        }
+        const float scale = (range.max > range.min) ? range.histogram.size() / (range.max - range.min) : 0.f;
+        for_each_value(tensor, [&](float value)
+        {
+            const float  position = (value - range.min) * scale;
+            const size_t bin      = static_cast<size_t>(std::min(std::max(position, 0.f), static_cast<float>(range.histogram.size() - 1)));
+            range.histogram[bin]++;
+        });
+    }
+    /** Observes the values of the weights of a layer
+     *
+     * @param[in] name   Name of the layer
+     * @param[in] tensor F32 weights, mapped
+     */
+    void add_weights(const std::string &name, arm_compute::ITensor &tensor)
+    {
+        update_range(find(_weights, name), tensor);
+    }
+    /** Quantization of the activations of a layer
+     *
+     * @param[in] name    Name of the layer, "input" for the input of the graph
+     * @param[in] method  How the range is taken from the values
+     * @param[in] percent Percentage of the values kept by the percentile method, the outliers being split between both ends
+     *
+     * @return The quantization, empty if the layer was not observed
+     */
+    arm_compute::QuantizationInfo activation_quantization(const std::string &name, CalibrationMethod method, double percent) const
+    {
+        const auto it = _activations.find(name);
+        if(it == _activations.end() || it->second.empty())
+        {
+            return arm_compute::QuantizationInfo();
+        }
+        const ValueRange &range = it->second;
+        if(method == CalibrationMethod::Percentile && !range.histogram.empty())
+        {
+            const double tail = (100.0 - percent) / 2.0;
+            return quantization(range.percentile(tail), range.percentile(100.0 - tail));
+        }
+        return quantization(range.min, range.max);
+    }
+    /** Quantization of the weights of a layer
+     *
+     * @param[in] name Name of the layer
+     *
+     * @return The quantization, empty if the weights of the layer were not observed
+     */
+    arm_compute::QuantizationInfo weights_quantization(const std::string &name) const
+    {
+        const auto it = _weights.find(name);
+        return (it == _weights.end() || it->second.empty()) ? arm_compute::QuantizationInfo() : quantization(it->second.min, it->second.max);
+    }
+    /** Writes the quantization of every observed layer as a calibration file of @ref QuantizationParams
+     *
+     * @param[in] filename File to write
+     * @param[in] method   How the ranges of the activations are taken from the values
+     * @param[in] percent  Percentage of the values kept by the percentile method
+     */
+    void write(const std::string &filename, CalibrationMethod method, double percent) const
+    {
+        std::ofstream ofs(filename);
+        ARM_COMPUTE_EXIT_ON_MSG(!ofs.is_open(), "Cannot open the calibration file %s", filename.c_str());
+        ofs << "# " << method;
+        if(method == CalibrationMethod::Percentile)
+        {
+            ofs << " " << percent;
+        }
+        ofs << " calibration over " << _images << " images\n";
+        ofs << "layer,weights_scale,weights_offset,output_scale,output_offset\n";
+        ofs.precision(9);
+        for(const auto &name : _names)
+        {
+            ofs << name << "," << to_csv(weights_quantization(name)) << "," << to_csv(activation_quantization(name, method, percent)) << "\n";
+        }
+    }
+
+private:
+    ValueRange &find(std::map<std::string, ValueRange> &ranges, const std::string &name)
+    {
+        if(std::find(_names.begin(), _names.end(), name) == _names.end())
+        {
+            _names.push_back(name);
+        }
+        return ranges[name];
+    }
+
+    template <typename F>
+    static void for_each_value(arm_compute::ITensor &tensor, F &&function)
+    {
+        using namespace arm_compute;
+
+        const ITensorInfo &info = *tensor.info();
+        ARM_COMPUTE_EXIT_ON_MSG(info.data_type() != DataType::F32, "Only F32 graphs can be calibrated");
+        Window window;
+        window.use_tensor_dimensions(info.tensor_shape());
+        Iterator it(&tensor, window);
+        execute_window_loop(window, [&](const Coordinates &)
+        {
+            function(*reinterpret_cast<const float *>(it.ptr()));
+        },
+        it);
+    }
+
+    static void update_range(ValueRange &range, arm_compute::ITensor &tensor)
+    {
+        for_each_value(tensor, [&](float value)
+        {
+            range.min = std::min(range.min, value);
+            range.max = std::max(range.max, value);
+        });
+    }
+
+    static arm_compute::QuantizationInfo quantization(float min, float max)
+    {
+        // Include 0 so that it is represented exactly
+        const float low   = std::min(min, 0.f);
+        const float high  = std::max(max, 0.f);
+        const float scale = (high > low) ? (high - low) / 255.f : 1.f;
+        const int   offset = static_cast<int>(std::lround(-low / scale));
+        return arm_compute::QuantizationInfo(scale, std::min(std::max(offset, 0), 255));
+    }
+
+    static std::string to_csv(const arm_compute::QuantizationInfo &qinfo)
+    {
+        return qinfo.empty() ? "," : std::to_string(qinfo.scale) + "," + std::to_string(qinfo.offset);
+    }
+
+    size_t                            _bins;
+    bool                              _histogram_pass;
+    size_t                            _images;
+    std::vector<std::string>          _names;
+    std::map<std::string, ValueRange> _activations;
+    std::map<std::string, ValueRange> _weights;
+};
+
+/** Observes the activations of a F32 graph for a @ref Calibrator
+ *
+ * Observes the input of the graph before the first task, and the output of every layer whose
+ * output gets its own quantization in the QASYMM8 graph (convolutions, depthwise convolutions,
+ * fully connected layers, element-wise additions and the concatenations of grouped convolutions)
+ * right after its task, before an in-place
+ * activation overwrites it. OpenCL tensors are mapped, which waits for the queue.
+ */
+class ActivationRangeObserver final : public ITaskListener
+{
+public:
+    /** Constructor
+     *
+     * @param[in] calibrator Calibrator to feed, must outlive the observer
+     * @param[in] workload   Workload of the finalized graph to observe
+     */
+    ActivationRangeObserver(Calibrator &calibrator, const arm_compute::graph::ExecutionWorkload &workload)
+        : _calibrator(calibrator), _workload(workload)
+    {
+    }
+
+    // Inherited methods overridden:
+    void on_task_start(const arm_compute::graph::ExecutionTask &task) override
+    {
+        if(!_workload.tasks.empty() && &task == &_workload.tasks.front())
+        {
+            for(auto *input : _workload.inputs)
+            {
+                observe("input", input);
+            }
+        }
+    }
+    void on_task_end(const arm_compute::graph::ExecutionTask &task) override
+    {
+        using namespace arm_compute::graph;
+        const INode *node = task.node;
+        if(node == nullptr || node->num_outputs() == 0)
+        {
+            return;
+        }
+        switch(node->type())
+        {
+            case NodeType::ConvolutionLayer:
+            case NodeType::DepthwiseConvolutionLayer:
+            case NodeType::FullyConnectedLayer:
+            case NodeType::EltwiseLayer:
+            case NodeType::ConcatenateLayer:
+                observe(node->name(), node->output(0));
+                break;
+            default:
+                break;
+        }
+    }
+
+private:
+    void observe(const std::string &name, arm_compute::graph::Tensor *tensor)
+    {
+        if(tensor == nullptr || tensor->handle() == nullptr)
+        {
+            return;
+        }
+        tensor->handle()->map(true);
+        _calibrator.add_activations(name, tensor->handle()->tensor());
+        tensor->handle()->unmap();
+    }
+
+    Calibrator                                  &_calibrator;
+    const arm_compute::graph::ExecutionWorkload &_workload;
+};
+
+/** Accessor observing the weights filled by another accessor for a @ref Calibrator */
+class WeightRangeAccessor final : public arm_compute::graph::ITensorAccessor
+{
+public:
+    /** Constructor
+     *
+     * @param[in] calibrator Calibrator to feed, must outlive the accessor
+     * @param[in] name       Name of the layer of the weights
+     * @param[in] accessor   Accessor filling the weights
+     */
+    WeightRangeAccessor(Calibrator &calibrator, std::string name, std::unique_ptr<arm_compute::graph::ITensorAccessor> accessor)
+        : _calibrator(calibrator), _name(std::move(name)), _accessor(std::move(accessor))
+    {
+    }
+    /** Allow instances of this class to be move constructed */
+    WeightRangeAccessor(WeightRangeAccessor &&) = default;
+
+    // Inherited methods overriden:
+    bool access_tensor(arm_compute::ITensor &tensor) override
+    {
+        const bool filled = _accessor == nullptr || _accessor->access_tensor(tensor);
+        _calibrator.add_weights(_name, tensor);
+        return filled;
+    }
+
+private:
+    Calibrator                                          &_calibrator;
+    std::string                                          _name;
+    std::unique_ptr<arm_compute::graph::ITensorAccessor> _accessor;
+};
+
+/** Observes the weights of the convolutions, depthwise convolutions and fully connected layers of a graph when they are loaded
+ *
+ * The weights shared by the groups of a grouped convolution are observed under the name of the
+ * first group, the layer @ref QuantizationMutator takes their quantization from.
+ *
+ * @param[in,out] g          Graph built by the frontend, batch normalizations folded, not finalized yet
+ * @param[in]     calibrator Calibrator to feed, must outlive the graph
+ */
+inline void observe_weight_ranges(arm_compute::graph::Graph &g, Calibrator &calibrator)
+{
+    using namespace arm_compute::graph;
+    std::set<TensorID> observed;
+    for(NodeID id = 0; id < g.nodes().size(); ++id)
+    {
+        INode *node = g.node(id);
+        if(node == nullptr
+           || (node->type() != NodeType::ConvolutionLayer && node->type() != NodeType::DepthwiseConvolutionLayer && node->type() != NodeType::FullyConnectedLayer))
+        {
+            continue;
+        }
+        arm_compute::graph::Tensor *weights = get_const_source(g, *node, 1);
+        if(weights != nullptr && observed.insert(weights->id()).second)
+        {
+            weights->set_accessor(arm_compute::support::cpp14::make_unique<WeightRangeAccessor>(calibrator, node->name(), weights->extract_accessor()));
+        }
+    }
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_CALIBRATION_H__ */
@@ -0,0 +1,195 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_CHANNEL_ROUNDING_H__
+#define __WIDTH_MULTIPLIED_CHANNEL_ROUNDING_H__
+
+#include "arm_compute/core/Error.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <string>
+
+namespace width_multiplied
+{
+/** Rounding of the channel counts scaled by a width multiplier */
+struct ChannelRounding
+{
+    /** Available rounding modes */
+    enum class Mode
+    {
+        Truncate,      /**< Truncate the scaled count, as the original graphs */
+        Multiple,      /**< Round to the nearest multiple of the divisor */
+        MakeDivisible, /**< MobileNet's make_divisible: nearest multiple of the divisor, not less than 90% of the scaled count */
+    };
+
+    Mode         mode{ Mode::Truncate }; /**< Rounding mode */
+    unsigned int divisor{ 1U };          /**< Divisor of the rounded counts, unused when truncating */
+};
+
+/** Equality operator
+ *
+ * @param[in] a First rounding
+ * @param[in] b Second rounding
+ *
+ * @return True if both roundings give the same channel counts
+ */
+inline bool operator==(const ChannelRounding &a, const ChannelRounding &b)
+{
+    return a.mode == b.mode && (a.mode == ChannelRounding::Mode::Truncate || a.divisor == b.divisor);
+}
+
+/** Converts a channel rounding to its command line name
+ *
+ * @param[in] rounding Rounding to convert
+ *
+ * @return "truncate", "multiple-<divisor>" or "make-divisible-<divisor>"
+ */
+inline std::string to_string(const ChannelRounding &rounding)
+{
+    switch(rounding.mode)
+    {
+        case ChannelRounding::Mode::Multiple:
+            return "multiple-" + std::to_string(rounding.divisor);
+        case ChannelRounding::Mode::MakeDivisible:
+            return "make-divisible-" + std::to_string(rounding.divisor);
+        case ChannelRounding::Mode::Truncate:
+        default:
+            return "truncate";
+    }
+}
+
+/** Stream operator to print a channel rounding
+ *
+ * @param[out] os       Output stream
+ * @param[in]  rounding Rounding to print
+ *
+ * @return Modified output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, const ChannelRounding &rounding)
+{
+    os << to_string(rounding);
+    return os;
+}
+
+/** Parses a channel rounding
+ *
+ * Accepts "truncate", "multiple-<n>" (or just "<n>") and "make-divisible[-<n>]" (divisor 8 when omitted).
+ *
+ * @param[in] name Name to parse
+ *
+ * @return Parsed rounding
+ */
+inline ChannelRounding parse_channel_rounding(const std::string &name)
+{
+    const std::string multiple       = "multiple-";
+    const std::string make_divisible = "make-divisible";
+
+    ChannelRounding rounding;
+    std::string     divisor;
+    if(name == "truncate")
+    {
+        return rounding;
+    }
+    else if(name.compare(0, make_divisible.size(), make_divisible) == 0)
+    {
+        rounding.mode = ChannelRounding::Mode::MakeDivisible;
+        divisor       = (name.size() == make_divisible.size()) ? "8" : name.substr(make_divisible.size() + 1);
+    }
+    else
+    {
+        rounding.mode = ChannelRounding::Mode::Multiple;
+        divisor       = (name.compare(0, multiple.size(), multiple) == 0) ? name.substr(multiple.size()) : name;
+    }
+    ARM_COMPUTE_EXIT_ON_MSG(divisor.empty() || divisor.find_first_not_of("0123456789") != std::string::npos, "Unknown channel rounding");
+    rounding.divisor = std::stoul(divisor);
+    ARM_COMPUTE_EXIT_ON_MSG(rounding.divisor == 0, "The channel divisor must be positive");
+    return rounding;
+}
+
+/** Scales a channel count by a width multiplier and rounds it
+ *
+ * @param[in] channels Channel count of the full width graph
+ * @param[in] width    Width multiplier
+ * @param[in] rounding Rounding of the scaled count
+ *
+ * @return Scaled channel count, at least 1 (at least the divisor when rounding to a multiple)
+ */
+inline unsigned int scale_channels(unsigned int channels, float width, const ChannelRounding &rounding)
+{
+    const float exact = channels * width;
+    switch(rounding.mode)
+    {
+        case ChannelRounding::Mode::Multiple:
+        {
+            const auto multiples = static_cast<unsigned int>(std::round(exact / rounding.divisor));
+            return std::max(multiples, 1U) * rounding.divisor;
+        }
+        case ChannelRounding::Mode::MakeDivisible:
+        {
+            // Same as the reference: int(v + divisor / 2) // divisor * divisor, bumped up when it loses more than 10%
+            const unsigned int d       = rounding.divisor;
+            unsigned int       rounded = std::max(d, static_cast<unsigned int>(exact + d / 2.f) / d * d);
+            if(rounded < 0.9f * exact)
+            {
+                rounded += d;
+            }
+            return rounded;
+        }
+        case ChannelRounding::Mode::Truncate:
+        default:
+            return std::max(static_cast<unsigned int>(exact), 1U);
+    }
+}
+
+/** Scales the channel counts of a graph by a width multiplier with a given rounding */
+class ChannelScaler
+{
+public:
+    /** Constructor
+     *
+     * @param[in] width    Width multiplier
+     * @param[in] rounding Rounding of the scaled counts
+     */
+    ChannelScaler(float width, const ChannelRounding &rounding)
+        : _width(width), _rounding(rounding)
+    {
+    }
+    /** Scales a channel count
+     *
+     * @param[in] channels Channel count of the full width graph
+     *
+     * @return Scaled and rounded channel count
+     */
+    unsigned int operator()(unsigned int channels) const
+    {
+        return scale_channels(channels, _width, _rounding);
+    }
+
+private:
+    float           _width;
+    ChannelRounding _rounding;
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_CHANNEL_ROUNDING_H__ */
@@ -0,0 +1,690 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_CHANNEL_SHUFFLE_H__
+#define __WIDTH_MULTIPLIED_CHANNEL_SHUFFLE_H__
+
+#include "arm_compute/core/Error.h"
+#include "arm_compute/core/Helpers.h"
+#include "arm_compute/core/ITensor.h"
+#include "arm_compute/core/NEON/INEKernel.h"
+#include "arm_compute/core/Types.h"
+#include "arm_compute/core/Utils.h"
+#include "arm_compute/core/Window.h"
+#include "arm_compute/core/utils/misc/Cast.h"
+#include "arm_compute/graph.h"
+#include "arm_compute/runtime/IFunction.h"
+#include "arm_compute/runtime/NEON/NEScheduler.h"
+#include "support/ToolchainSupport.h"
+
+#include "common/BatchNormFolding.h"
+#include "common/GraphExecutor.h"
+#include "common/GroupedPointwise.h"
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif /* __ARM_NEON */
+
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace width_multiplied
+{
+/** How the channel shuffles of a graph are executed */
+enum class ChannelShuffleMode
+{
+    Acl,   /**< By the channel shuffle function of the backend */
+    Neon,  /**< By @ref NEChannelShuffle, one copy pass per shuffle */
+    Fused, /**< As a permuted read of the grouped 1x1 convolution that follows, @ref NEChannelShuffle for the others */
+};
+
+/** Stream operator to print a channel shuffle mode
+ *
+ * @param[out] os   Output stream
+ * @param[in]  mode Mode to print
+ *
+ * @return Modified output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, ChannelShuffleMode mode)
+{
+    switch(mode)
+    {
+        case ChannelShuffleMode::Neon:
+            os << "neon";
+            break;
+        case ChannelShuffleMode::Fused:
+            os << "fused";
+            break;
+        case ChannelShuffleMode::Acl:
+        default:
+            os << "acl";
+            break;
+    }
+    return os;
+}
+
+/** Stream operator to read a channel shuffle mode
+ *
+ * @param[in]  is   Input stream
+ * @param[out] mode Mode read
+ *
+ * @return Modified input stream
+ */
+inline std::istream &operator>>(std::istream &is, ChannelShuffleMode &mode)
+{
+    std::string value;
+    is >> value;
+    if(value == "acl")
+    {
+        mode = ChannelShuffleMode::Acl;
+    }
+    else if(value == "neon")
+    {
+        mode = ChannelShuffleMode::Neon;
+    }
+    else if(value == "fused")
+    {
+        mode = ChannelShuffleMode::Fused;
+    }
+    else
+    {
+        is.setstate(std::ios::failbit);
+    }
+    return is;
+}
+
+/** Parses a channel shuffle mode, as written in the sweep CSV files
+ *
+ * @param[in] name Name of the mode, empty in the files written before the channel shuffle column
+ *
+ * @return The mode, acl if the name is empty or unknown
+ */
+inline ChannelShuffleMode parse_channel_shuffle_mode(const std::string &name)
+{
+    std::stringstream  ss(name);
+    ChannelShuffleMode mode = ChannelShuffleMode::Acl;
+    ss >> mode;
+    return ss.fail() ? ChannelShuffleMode::Acl : mode;
+}
+
+/** Returns the input channel a channel shuffle copies to an output channel
+ *
+ * The channels are seen as a (groups, channels / groups) matrix which is transposed, as in ShuffleNet.
+ *
+ * @param[in] channel    Output channel
+ * @param[in] channels   Number of channels
+ * @param[in] num_groups Number of groups
+ *
+ * @return Input channel
+ */
+inline unsigned int shuffled_channel_source(unsigned int channel, unsigned int channels, unsigned int num_groups)
+{
+    return (channel % num_groups) * (channels / num_groups) + channel / num_groups;
+}
+
+/** NEON kernel shuffling the channels of a tensor
+ *
+ * In NCHW every output channel is a copy of an input plane, one memcpy per plane when its rows are
+ * contiguous, the channels being split between the threads. In NHWC the channels of every pixel are
+ * transposed from (groups, channels / groups) to (channels / groups, groups): for 2, 3 or 4 groups of
+ * 32-bit values, one vector is loaded from each group and the vectors are stored interleaved with
+ * vst2q, vst3q or vst4q. The rows are split between the threads. Any data type.
+ */
+class NEChannelShuffleKernel final : public arm_compute::INEKernel
+{
+public:
+    const char *name() const override
+    {
+        return "NEChannelShuffleKernel";
+    }
+    /** Default constructor */
+    NEChannelShuffleKernel()
+        : _input(nullptr), _output(nullptr), _in_strides(), _out_strides(), _width(0), _height(0), _channels(0), _num_groups(1), _element_size(0), _nhwc(false)
+    {
+    }
+    /** Initialise the kernel
+     *
+     * @param[in]  input      Input tensor
+     * @param[out] output     Output tensor, same shape, data type and layout as the input
+     * @param[in]  num_groups Number of groups, dividing the number of channels
+     */
+    void configure(const arm_compute::ITensor *input, arm_compute::ITensor *output, unsigned int num_groups)
+    {
+        using namespace arm_compute;
+
+        const DataLayout layout = input->info()->data_layout();
+        const size_t     idx_w  = get_data_layout_dimension_index(layout, DataLayoutDimension::WIDTH);
+        const size_t     idx_h  = get_data_layout_dimension_index(layout, DataLayoutDimension::HEIGHT);
+        const size_t     idx_c  = get_data_layout_dimension_index(layout, DataLayoutDimension::CHANNEL);
+        const size_t     idx_n  = get_data_layout_dimension_index(layout, DataLayoutDimension::BATCHES);
+
+        _input        = input;
+        _output       = output;
+        _in_strides   = { input->info()->strides_in_bytes()[idx_w], input->info()->strides_in_bytes()[idx_h], input->info()->strides_in_bytes()[idx_c], input->info()->strides_in_bytes()[idx_n] };
+        _out_strides  = { output->info()->strides_in_bytes()[idx_w], output->info()->strides_in_bytes()[idx_h], output->info()->strides_in_bytes()[idx_c], output->info()->strides_in_bytes()[idx_n] };
+        _width        = input->info()->dimension(idx_w);
+        _height       = input->info()->dimension(idx_h);
+        _channels     = input->info()->dimension(idx_c);
+        _num_groups   = num_groups;
+        _element_size = input->info()->element_size();
+        _nhwc         = layout == DataLayout::NHWC;
+        ARM_COMPUTE_ERROR_ON(num_groups == 0 || _channels % num_groups != 0);
+
+        // Channels (NCHW) or rows (NHWC) along Y, the images of the batch along Z
+        Window win;
+        win.set(Window::DimX, Window::Dimension(0, 1, 1));
+        win.set(Window::DimY, Window::Dimension(0, _nhwc ? _height : _channels, 1));
+        win.set(Window::DimZ, Window::Dimension(0, input->info()->dimension(idx_n), 1));
+        INEKernel::configure(win);
+    }
+
+    // Inherited methods overridden:
+    void run(const arm_compute::Window &window, const arm_compute::ThreadInfo &info) override
+    {
+        using namespace arm_compute;
+        ARM_COMPUTE_UNUSED(info);
+
+        const Window::Dimension &lines   = window[Window::DimY];
+        const Window::Dimension &batches = window[Window::DimZ];
+        for(int batch = batches.start(); batch < batches.end(); ++batch)
+        {
+            const uint8_t *in  = _input->buffer() + _input->info()->offset_first_element_in_bytes() + batch * _in_strides.batch;
+            uint8_t       *out = _output->buffer() + _output->info()->offset_first_element_in_bytes() + batch * _out_strides.batch;
+            for(int line = lines.start(); line < lines.end(); line += lines.step())
+            {
+                if(_nhwc)
+                {
+                    shuffle_row(in + line * _in_strides.y, out + line * _out_strides.y);
+                }
+                else
+                {
+                    copy_plane(in + shuffled_channel_source(line, _channels, _num_groups) * _in_strides.channel, out + line * _out_strides.channel);
+                }
+            }
+        }
+    }
+
+private:
+    struct Strides
+    {
+        size_t x;
+        size_t y;
+        size_t channel;
+        size_t batch;
+    };
+
+    void copy_plane(const uint8_t *in, uint8_t *out) const
+    {
+        const size_t row_bytes = _width * _element_size;
+        if(_in_strides.y == row_bytes && _out_strides.y == row_bytes)
+        {
+            std::memcpy(out, in, row_bytes * _height);
+            return;
+        }
+        for(size_t y = 0; y < _height; ++y)
+        {
+            std::memcpy(out + y * _out_strides.y, in + y * _in_strides.y, row_bytes);
+        }
+    }
+
+    void shuffle_row(const uint8_t *in_row, uint8_t *out_row) const
+    {
+        const size_t group_channels = _channels / _num_groups;
+        for(size_t x = 0; x < _width; ++x)
+        {
+            const uint8_t *in  = in_row + x * _in_strides.x;
+            uint8_t       *out = out_row + x * _out_strides.x;
+            size_t         k   = 0;
+#ifdef __ARM_NEON
+            if(_element_size == 4)
+            {
+                k = interleave(reinterpret_cast<const float *>(in), reinterpret_cast<float *>(out), group_channels);
+            }
+#endif /* __ARM_NEON */
+            for(; k < group_channels; ++k)
+            {
+                for(size_t group = 0; group < _num_groups; ++group)
+                {
+                    std::memcpy(out + (k * _num_groups + group) * _element_size, in + (group * group_channels + k) * _element_size, _element_size);
+                }
+            }
+        }
+    }
+
+#ifdef __ARM_NEON
+    /** Interleaves the channels of 2, 3 or 4 groups four by four, returning the number of channels per group done */
+    size_t interleave(const float *in, float *out, size_t group_channels) const
+    {
+        size_t k = 0;
+        switch(_num_groups)
+        {
+            case 2:
+                for(; k + 4 <= group_channels; k += 4)
+                {
+                    float32x4x2_t v;
+                    v.val[0] = vld1q_f32(in + k);
+                    v.val[1] = vld1q_f32(in + group_channels + k);
+                    vst2q_f32(out + k * 2, v);
+                }
+                break;
+            case 3:
+                for(; k + 4 <= group_channels; k += 4)
+                {
+                    float32x4x3_t v;
+                    v.val[0] = vld1q_f32(in + k);
+                    v.val[1] = vld1q_f32(in + group_channels + k);
+                    v.val[2] = vld1q_f32(in + 2 * group_channels + k);
+                    vst3q_f32(out + k * 3, v);
+                }
+                break;
+            case 4:
+                for(; k + 4 <= group_channels; k += 4)
+                {
+                    float32x4x4_t v;
+                    v.val[0] = vld1q_f32(in + k);
+                    v.val[1] = vld1q_f32(in + group_channels + k);
+                    v.val[2] = vld1q_f32(in + 2 * group_channels + k);
+                    v.val[3] = vld1q_f32(in + 3 * group_channels + k);
+                    vst4q_f32(out + k * 4, v);
+                }
+                break;
+            default:
+                break;
+        }
+        return k;
+    }
+#endif /* __ARM_NEON */
+
+    const arm_compute::ITensor *_input;
+    arm_compute::ITensor       *_output;
+    Strides                     _in_strides;
+    Strides                     _out_strides;
+    size_t                      _width;
+    size_t                      _height;
+    size_t                      _channels;
+    size_t                      _num_groups;
+    size_t                      _element_size;
+    bool                        _nhwc;
+};
+
+/** Function running a channel shuffle with @ref NEChannelShuffleKernel */
+class NEChannelShuffle final : public arm_compute::IFunction
+{
+public:
+    /** Default constructor */
+    NEChannelShuffle()
+        : _kernel(), _replaced()
+    {
+    }
+    /** Set the input and output tensors
+     *
+     * @param[in]  input      Input tensor
+     * @param[out] output     Output tensor, same shape, data type and layout as the input
+     * @param[in]  num_groups Number of groups, dividing the number of channels
+     * @param[in]  replaced   (Optional) Function of the layer the shuffle replaces, never run but kept alive as its memory is registered with the memory managers of the graph
+     */
+    void configure(const arm_compute::ITensor *input, arm_compute::ITensor *output, unsigned int num_groups, std::unique_ptr<arm_compute::IFunction> replaced = nullptr)
+    {
+        _replaced = std::move(replaced);
+        _kernel.configure(input, output, num_groups);
+    }
+
+    // Inherited methods overridden:
+    void run() override
+    {
+        arm_compute::NEScheduler::get().schedule(&_kernel, arm_compute::Window::DimY);
+    }
+
+private:
+    NEChannelShuffleKernel                  _kernel;
+    std::unique_ptr<arm_compute::IFunction> _replaced;
+};
+
+/** Accessor filling a per-channel parameter as if the channel shuffle before its layer had been moved after it
+ *
+ * A layer working channel by channel (depthwise convolution, batch normalization, activation) commutes
+ * with a channel shuffle once its parameters are permuted: the parameters of output channel c of the
+ * shuffle go to its input channel @ref shuffled_channel_source(c).
+ */
+class ChannelPermutationAccessor final : public arm_compute::graph::ITensorAccessor
+{
+public:
+    /** Constructor
+     *
+     * @param[in] parameters  Accessor of the original parameters, nullptr to permute the tensor as allocated
+     * @param[in] num_groups  Groups of the channel shuffle
+     * @param[in] channel_dim Dimension of the channels in the parameters
+     */
+    ChannelPermutationAccessor(std::unique_ptr<arm_compute::graph::ITensorAccessor> parameters, unsigned int num_groups, size_t channel_dim)
+        : _parameters(std::move(parameters)), _num_groups(num_groups), _channel_dim(channel_dim)
+    {
+    }
+    /** Allow instances of this class to be move constructed */
+    ChannelPermutationAccessor(ChannelPermutationAccessor &&) = default;
+
+    // Inherited methods overriden:
+    bool access_tensor(arm_compute::ITensor &tensor) override
+    {
+        using namespace arm_compute;
+
+        if(_parameters != nullptr)
+        {
+            _parameters->access_tensor(tensor);
+        }
+
+        // Copy the elements, then write every element of channel c to channel source(c)
+        const TensorShape   &shape        = tensor.info()->tensor_shape();
+        const size_t         element_size = tensor.info()->element_size();
+        const unsigned int   channels     = shape[_channel_dim];
+        std::vector<uint8_t> values(shape.total_size() * element_size);
+        Window               window;
+        window.use_tensor_dimensions(shape);
+        Iterator it(&tensor, window);
+        size_t   index = 0;
+        execute_window_loop(window, [&](const Coordinates &)
+        {
+            std::memcpy(values.data() + index++ * element_size, it.ptr(), element_size);
+        },
+        it);
+        index = 0;
+        execute_window_loop(window, [&](const Coordinates & id)
+        {
+            Coordinates destination = id;
+            destination.set(_channel_dim, shuffled_channel_source(id[_channel_dim], channels, _num_groups));
+            std::memcpy(tensor.ptr_to_element(destination), values.data() + index++ * element_size, element_size);
+        });
+        return true;
+    }
+
+private:
+    std::unique_ptr<arm_compute::graph::ITensorAccessor> _parameters;
+    unsigned int                                         _num_groups;
+    size_t                                               _channel_dim;
+};
+
+/** Executes the channel shuffles of a graph with @ref NEChannelShuffle, or fuses them into the grouped 1x1 convolutions that follow
+ *
+ * In the fused mode, prepare() looks for every F32 channel shuffle followed by a grouped 1x1
+ * convolution, possibly through layers working channel by channel: depthwise convolutions,
+ * batch normalizations and activations, as in the ShuffleNet unit. The shuffle is removed from the
+ * graph, the parameters of the layers in between are permuted so that they can run before it,
+ * and the grouped convolution, which the frontend splits into one convolution per group, is
+ * recorded. Once the functions are configured, mutate() runs it with replace_grouped_pointwise(),
+ * reading its input through the permutation of the shuffle.
+ *
+ * The other channel shuffles, and every one of them in the neon mode, run with @ref NEChannelShuffle
+ * in place of the function of the backend.
+ */
+class ChannelShuffleMutator final : public IWorkloadMutator
+{
+public:
+    /** Constructor
+     *
+     * @param[in] mode How to execute the channel shuffles, neon or fused
+     */
+    explicit ChannelShuffleMutator(ChannelShuffleMode mode)
+        : _mode(mode), _blocks(), _fused(0), _replaced(0)
+    {
+    }
+    /** Fuses the channel shuffles of a graph into the grouped convolutions that follow, in the fused mode
+     *
+     * @param[in,out] g Graph built by the frontend, not finalized yet
+     *
+     * @return Number of channel shuffles fused
+     */
+    unsigned int prepare(arm_compute::graph::Graph &g)
+    {
+        using namespace arm_compute::graph;
+
+        if(_mode != ChannelShuffleMode::Fused)
+        {
+            return 0;
+        }
+        std::vector<NodeID> shuffles;
+        for(auto &node : g.nodes())
+        {
+            if(node != nullptr && node->type() == NodeType::ChannelShuffleLayer && node->output(0)->desc().data_type == arm_compute::DataType::F32)
+            {
+                shuffles.push_back(node->id());
+            }
+        }
+        for(NodeID nid : shuffles)
+        {
+            INode               *shuffle = g.node(nid);
+            std::vector<INode *> between;
+            INode               *next = consumer(g, *shuffle);
+            while(is_channelwise(g, next))
+            {
+                between.push_back(next);
+                next = consumer(g, *next);
+            }
+            if(!is_grouped_pointwise(g, next))
+            {
+                continue;
+            }
+
+            const unsigned int num_groups = arm_compute::utils::cast::polymorphic_downcast<ChannelShuffleLayerNode *>(shuffle)->num_groups();
+            for(INode *node : between)
+            {
+                permute_parameters(g, *node, num_groups);
+            }
+            Block block;
+            block.split      = next->id();
+            block.num_groups = num_groups;
+            _blocks.push_back(block);
+            bypass(g, nid);
+        }
+        return _blocks.size();
+    }
+    /** Number of channel shuffles fused by the last call to mutate() */
+    unsigned int fused() const
+    {
+        return _fused;
+    }
+    /** Number of channel shuffles run by @ref NEChannelShuffle since the last call to mutate() */
+    unsigned int replaced() const
+    {
+        return _replaced;
+    }
+
+    // Inherited methods overridden:
+    void mutate(arm_compute::graph::Graph &g, arm_compute::graph::ExecutionWorkload &workload) override
+    {
+        using namespace arm_compute::graph;
+
+        _fused    = 0;
+        _replaced = 0;
+        for(const auto &block : _blocks)
+        {
+            fuse(g, workload, block);
+            ++_fused;
+        }
+        for(auto &task : workload.tasks)
+        {
+            if(task.node == nullptr || task.node->type() != NodeType::ChannelShuffleLayer || task.node->assigned_target() != Target::NEON)
+            {
+                continue;
+            }
+            auto layer = arm_compute::support::cpp14::make_unique<NEChannelShuffle>();
+            layer->configure(tensor_of(task.node->input(0)), tensor_of(task.node->output(0)),
+                             arm_compute::utils::cast::polymorphic_downcast<ChannelShuffleLayerNode *>(task.node)->num_groups(), std::move(task.task));
+            task.task = std::move(layer);
+            ++_replaced;
+        }
+    }
+
+private:
+    struct Block
+    {
+        arm_compute::graph::NodeID split{ arm_compute::graph::EmptyNodeID };
+        unsigned int               num_groups{ 1 };
+    };
+
+    static arm_compute::ITensor *tensor_of(arm_compute::graph::Tensor *tensor)
+    {
+        return (tensor != nullptr && tensor->handle() != nullptr) ? &tensor->handle()->tensor() : nullptr;
+    }
+
+    /** Only consumer of the output of a node, nullptr if it has several */
+    static arm_compute::graph::INode *consumer(arm_compute::graph::Graph &g, const arm_compute::graph::INode &node)
+    {
+        if(node.output_edges().size() != 1)
+        {
+            return nullptr;
+        }
+        const arm_compute::graph::Edge *edge = g.edge(*node.output_edges().begin());
+        return (edge != nullptr) ? edge->consumer() : nullptr;
+    }
+
+    /** Constant node feeding an input of a node, nullptr if the input is not constant or the constant has other consumers */
+    static arm_compute::graph::INode *const_input(arm_compute::graph::Graph &g, const arm_compute::graph::INode &node, size_t idx)
+    {
+        using namespace arm_compute::graph;
+        const Edge *edge     = g.edge(node.input_edge_id(idx));
+        INode      *producer = (edge != nullptr) ? edge->producer() : nullptr;
+        return (producer != nullptr && producer->type() == NodeType::Const && producer->output_edges().size() == 1) ? producer : nullptr;
+    }
+
+    /** Checks whether a node works channel by channel with constant parameters, so that a channel shuffle can be moved after it */
+    static bool is_channelwise(arm_compute::graph::Graph &g, const arm_compute::graph::INode *node)
+    {
+        using namespace arm_compute::graph;
+        if(node == nullptr || node->output(0)->desc().data_type != arm_compute::DataType::F32)
+        {
+            return false;
+        }
+        switch(node->type())
+        {
+            case NodeType::ActivationLayer:
+                return true;
+            case NodeType::DepthwiseConvolutionLayer:
+                // One output channel per input channel
+                if(get_dimension_size(node->input(1)->desc(), arm_compute::DataLayoutDimension::CHANNEL)
+                   != get_dimension_size(node->input(0)->desc(), arm_compute::DataLayoutDimension::CHANNEL))
+                {
+                    return false;
+                }
+                break;
+            case NodeType::BatchNormalizationLayer:
+                break;
+            default:
+                return false;
+        }
+        for(size_t idx = 1; idx < node->num_inputs(); ++idx)
+        {
+            if(node->input(idx) != nullptr && const_input(g, *node, idx) == nullptr)
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /** Wraps the accessors of the constant parameters of a channel by channel layer in a @ref ChannelPermutationAccessor */
+    static void permute_parameters(arm_compute::graph::Graph &g, arm_compute::graph::INode &node, unsigned int num_groups)
+    {
+        using namespace arm_compute::graph;
+        for(size_t idx = 1; idx < node.num_inputs(); ++idx)
+        {
+            INode *param_node = (node.input(idx) != nullptr) ? const_input(g, node, idx) : nullptr;
+            if(param_node == nullptr)
+            {
+                continue;
+            }
+            arm_compute::graph::Tensor *param       = param_node->output(0);
+            const size_t                channel_dim = (node.type() == NodeType::DepthwiseConvolutionLayer && idx == 1) ? get_dimension_idx(param->desc(), arm_compute::DataLayoutDimension::CHANNEL) : 0;
+            param->set_accessor(arm_compute::support::cpp14::make_unique<ChannelPermutationAccessor>(param->extract_accessor(), num_groups, channel_dim));
+        }
+    }
+
+    /** Replaces the tasks of a grouped convolution with one @ref NEGroupedPointwiseLayer reading its input through a channel shuffle */
+    static void fuse(arm_compute::graph::Graph &g, arm_compute::graph::ExecutionWorkload &workload, const Block &block)
+    {
+        using namespace arm_compute::graph;
+
+        INode *split = g.node(block.split);
+        ARM_COMPUTE_EXIT_ON_MSG(split == nullptr || split->assigned_target() != Target::NEON, "Fused channel shuffles need the NEON target");
+        const unsigned int        channels = get_dimension_size(split->input(0)->desc(), arm_compute::DataLayoutDimension::CHANNEL);
+        std::vector<unsigned int> input_channels(channels);
+        for(unsigned int c = 0; c < channels; ++c)
+        {
+            input_channels[c] = shuffled_channel_source(c, channels, block.num_groups);
+        }
+        ARM_COMPUTE_EXIT_ON_MSG(!replace_grouped_pointwise(g, workload, block.split, std::move(input_channels)), "Grouped convolution without tasks");
+    }
+
+    /** Removes a node with one input and one output, feeding its consumers from its producer */
+    static void bypass(arm_compute::graph::Graph &g, arm_compute::graph::NodeID nid)
+    {
+        using namespace arm_compute::graph;
+        INode                   *node         = g.node(nid);
+        const Edge              *input_edge   = g.edge(node->input_edge_id(0));
+        const NodeID             producer     = input_edge->producer_id();
+        const size_t             producer_idx = input_edge->producer_idx();
+        std::vector<NodeIdxPair> consumers;
+        for(const auto &output_edge_id : node->output_edges())
+        {
+            const Edge *output_edge = g.edge(output_edge_id);
+            if(output_edge != nullptr)
+            {
+                consumers.push_back({ output_edge->consumer_id(), output_edge->consumer_idx() });
+            }
+        }
+        g.remove_node(nid);
+        for(const auto &consumer : consumers)
+        {
+            g.add_connection(producer, producer_idx, consumer.node_id, consumer.index);
+        }
+    }
+
+    ChannelShuffleMode _mode;
+    std::vector<Block> _blocks;
+    unsigned int       _fused;
+    unsigned int       _replaced;
+};
+
+/** Prepares the execution of the channel shuffles of a graph
+ *
+ * @param[in,out] g    Graph built by the frontend, not finalized yet
+ * @param[in]     mode How to execute the channel shuffles
+ *
+ * @return The mutator to pass to @ref GraphExecutor::finalize(), nullptr in the acl mode
+ */
+inline std::unique_ptr<IWorkloadMutator> apply_channel_shuffle_mode(arm_compute::graph::Graph &g, ChannelShuffleMode mode)
+{
+    if(mode == ChannelShuffleMode::Acl)
+    {
+        return nullptr;
+    }
+    std::unique_ptr<ChannelShuffleMutator> mutator = arm_compute::support::cpp14::make_unique<ChannelShuffleMutator>(mode);
+    mutator->prepare(g);
+    return std::unique_ptr<IWorkloadMutator>(std::move(mutator));
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_CHANNEL_SHUFFLE_H__ */
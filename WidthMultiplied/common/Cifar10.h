@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_CIFAR10_H__
+#define __WIDTH_MULTIPLIED_CIFAR10_H__
+
+#include "arm_compute/core/Error.h"
+#include "arm_compute/core/Helpers.h"
+#include "arm_compute/core/ITensor.h"
+#include "arm_compute/core/Types.h"
+#include "arm_compute/core/Window.h"
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+
+#include "common/WeightStore.h"
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Images and labels of a CIFAR-10 binary batch
+ *
+ * Every record of a batch file (e.g. test_batch.bin) is a label byte followed by the 32x32 image
+ * as three planes of 1024 bytes, red first, the order the simple_models were trained with.
+ */
+class Cifar10Dataset
+{
+public:
+    static constexpr size_t width       = 32;                       /**< Width and height of the images */
+    static constexpr size_t channels    = 3;                        /**< Channels of the images */
+    static constexpr size_t image_size  = width * width * channels; /**< Bytes of an image */
+    static constexpr size_t num_classes = 10;                       /**< Number of classes */
+
+    /** Loads a batch file, exits with an error if it cannot be read
+     *
+     * @param[in] filename   CIFAR-10 binary batch file
+     * @param[in] max_images (Optional) Maximum number of images to load, 0 for all of them
+     */
+    void load(const std::string &filename, size_t max_images = 0)
+    {
+        std::ifstream ifs(filename, std::ios::binary);
+        ARM_COMPUTE_EXIT_ON_MSG(!ifs.is_open(), "Cannot open the CIFAR-10 file %s", filename.c_str());
+        _labels.clear();
+        _images.clear();
+        std::vector<char> record(1 + image_size);
+        while((max_images == 0 || _labels.size() < max_images) && ifs.read(record.data(), record.size()))
+        {
+            ARM_COMPUTE_EXIT_ON_MSG(static_cast<uint8_t>(record[0]) >= num_classes, "Invalid label in the CIFAR-10 file %s", filename.c_str());
+            _labels.push_back(static_cast<uint8_t>(record[0]));
+            _images.insert(_images.end(), record.begin() + 1, record.end());
+        }
+        ARM_COMPUTE_EXIT_ON_MSG(_labels.empty(), "No image in the CIFAR-10 file %s", filename.c_str());
+    }
+    /** Number of images loaded */
+    size_t size() const
+    {
+        return _labels.size();
+    }
+    /** Label of an image */
+    unsigned int label(size_t index) const
+    {
+        return _labels[index];
+    }
+    /** Planar RGB bytes of an image */
+    const uint8_t *image(size_t index) const
+    {
+        return _images.data() + index * image_size;
+    }
+    /** Per-pixel mean of the images loaded, planar RGB like the images */
+    std::vector<float> mean() const
+    {
+        std::vector<float> sum(image_size, 0.f);
+        for(size_t i = 0; i < size(); ++i)
+        {
+            const uint8_t *pixels = image(i);
+            for(size_t j = 0; j < image_size; ++j)
+            {
+                sum[j] += pixels[j];
+            }
+        }
+        for(auto &value : sum)
+        {
+            value /= size();
+        }
+        return sum;
+    }
+
+private:
+    std::vector<uint8_t> _labels{};
+    std::vector<uint8_t> _images{};
+};
+
+/** Reads the mean image the simple_models were trained with
+ *
+ * @param[in] filename .npy file of 3x32x32 floats, planar RGB, as converted from the Caffe mean file
+ *
+ * @return The mean image
+ */
+inline std::vector<float> load_cifar10_mean(const std::string &filename)
+{
+    const NpyArray &array    = WeightStore::get().find(filename);
+    size_t          elements = 1;
+    for(size_t dim : array.shape)
+    {
+        elements *= dim;
+    }
+    ARM_COMPUTE_EXIT_ON_MSG(array.descr != "<f4" || elements != Cifar10Dataset::image_size, "The mean file %s must hold 3x32x32 floats", filename.c_str());
+    std::vector<float> mean(elements);
+    std::memcpy(mean.data(), array.data, elements * sizeof(float));
+    return mean;
+}
+
+/** Images fed to a graph and its top-1 accuracy, shared by the input and output accessors */
+struct Cifar10Feed
+{
+    /** Constructor
+     *
+     * @param[in] dataset Images to feed, must outlive the feed
+     * @param[in] mean    Mean image subtracted from the images
+     */
+    Cifar10Feed(const Cifar10Dataset &dataset, std::vector<float> mean)
+        : dataset(dataset), mean(std::move(mean))
+    {
+    }
+    /** Feeds the images [first, first + count) from the first one, and clears the accuracy
+     *
+     * @param[in] first_image First image to feed
+     * @param[in] num_images  Number of images to feed
+     */
+    void reset(size_t first_image, size_t num_images)
+    {
+        first    = first_image;
+        count    = num_images;
+        position = 0;
+        correct  = 0;
+        total    = 0;
+    }
+    /** Top-1 accuracy of the images classified since the last reset, in [0, 1] */
+    double accuracy() const
+    {
+        return (total > 0) ? static_cast<double>(correct) / total : 0.0;
+    }
+
+    const Cifar10Dataset &dataset;       /**< Images to feed */
+    std::vector<float>    mean;          /**< Mean image subtracted from the images */
+    size_t                first{ 0 };    /**< First image to feed */
+    size_t                count{ 0 };    /**< Number of images to feed */
+    size_t                position{ 0 }; /**< Image of the next run relative to first, wraps around count */
+    size_t                correct{ 0 };  /**< Images classified correctly since the last reset */
+    size_t                total{ 0 };    /**< Images classified since the last reset */
+};
+
+/** Input accessor filling the batch of a graph with the next images of a feed
+ *
+ * The mean is subtracted and, for a QASYMM8 input, the result is quantized with the quantization
+ * of the input. The last batch wraps around to the first images of the feed.
+ */
+class Cifar10InputAccessor final : public arm_compute::graph::ITensorAccessor
+{
+public:
+    /** Constructor
+     *
+     * @param[in] feed Feed of the images, must outlive the accessor
+     */
+    explicit Cifar10InputAccessor(Cifar10Feed &feed)
+        : _feed(feed)
+    {
+    }
+    /** Allow instances of this class to be move constructed */
+    Cifar10InputAccessor(Cifar10InputAccessor &&) = default;
+
+    // Inherited methods overriden:
+    bool access_tensor(arm_compute::ITensor &tensor) override
+    {
+        using namespace arm_compute;
+
+        const ITensorInfo &info    = *tensor.info();
+        const bool         is_nhwc = info.data_layout() == DataLayout::NHWC;
+        const size_t       batch   = info.tensor_shape()[3];
+        ARM_COMPUTE_EXIT_ON_MSG(_feed.count == 0, "No CIFAR-10 image to feed");
+        for(size_t b = 0; b < batch; ++b)
+        {
+            const uint8_t *pixels = _feed.dataset.image(_feed.first + (_feed.position + b) % _feed.count);
+            for(size_t c = 0; c < Cifar10Dataset::channels; ++c)
+            {
+                for(size_t y = 0; y < Cifar10Dataset::width; ++y)
+                {
+                    for(size_t x = 0; x < Cifar10Dataset::width; ++x)
+                    {
+                        const size_t      index  = (c * Cifar10Dataset::width + y) * Cifar10Dataset::width + x;
+                        const float       value  = pixels[index] - _feed.mean[index];
+                        const Coordinates coords = is_nhwc ? Coordinates(c, x, y, b) : Coordinates(x, y, c, b);
+                        if(info.data_type() == DataType::QASYMM8)
+                        {
+                            *tensor.ptr_to_element(coords) = info.quantization_info().quantize(value, RoundingPolicy::TO_NEAREST_UP);
+                        }
+                        else
+                        {
+                            *reinterpret_cast<float *>(tensor.ptr_to_element(coords)) = value;
+                        }
+                    }
+                }
+            }
+        }
+        return true;
+    }
+
+private:
+    Cifar10Feed &_feed;
+};
+
+/** Output accessor counting the images of a feed whose top-1 class is their label
+ *
+ * Reads an output of shape (classes, batch), F32 or QASYMM8, and moves the feed to the next batch.
+ * The images fed again by the wrapped around last batch are not counted.
+ */
+class Cifar10AccuracyAccessor final : public arm_compute::graph::ITensorAccessor
+{
+public:
+    /** Constructor
+     *
+     * @param[in] feed Feed of the images, must outlive the accessor
+     */
+    explicit Cifar10AccuracyAccessor(Cifar10Feed &feed)
+        : _feed(feed)
+    {
+    }
+    /** Allow instances of this class to be move constructed */
+    Cifar10AccuracyAccessor(Cifar10AccuracyAccessor &&) = default;
+
+    // Inherited methods overriden:
+    bool access_tensor(arm_compute::ITensor &tensor) override
+    {
+        using namespace arm_compute;
+
+        const ITensorInfo &info    = *tensor.info();
+        const size_t       classes = info.tensor_shape()[0];
+        const size_t       batch   = info.tensor_shape()[1];
+        for(size_t b = 0; b < batch; ++b)
+        {
+            size_t best       = 0;
+            float  best_value = 0.f;
+            for(size_t c = 0; c < classes; ++c)
+            {
+                const uint8_t *ptr   = tensor.ptr_to_element(Coordinates(c, b));
+                const float    value = (info.data_type() == DataType::QASYMM8) ? info.quantization_info().dequantize(*ptr) : *reinterpret_cast<const float *>(ptr);
+                if(c == 0 || value > best_value)
+                {
+                    best       = c;
+                    best_value = value;
+                }
+            }
+            if(_feed.position + b < _feed.count)
+            {
+                _feed.correct += (best == _feed.dataset.label(_feed.first + _feed.position + b)) ? 1 : 0;
+                _feed.total++;
+            }
+        }
+        _feed.position = (_feed.position + batch) % _feed.count;
+        return true;
+    }
+
+private:
+    Cifar10Feed &_feed;
+};
+
+/** Feeds the images of a feed to a graph and counts its correct classifications, in place of the accessors of its input and output layers
+ *
+ * @param[in,out] g    Graph built by the frontend, not finalized yet
+ * @param[in]     feed Feed of the images, must outlive the graph
+ */
+inline void attach_cifar10_feed(arm_compute::graph::Graph &g, Cifar10Feed &feed)
+{
+    using namespace arm_compute::graph;
+    for(auto &node : g.nodes())
+    {
+        if(node != nullptr && node->type() == NodeType::Input)
+        {
+            node->output(0)->set_accessor(arm_compute::support::cpp14::make_unique<Cifar10InputAccessor>(feed));
+        }
+        else if(node != nullptr && node->type() == NodeType::Output)
+        {
+            node->input(0)->set_accessor(arm_compute::support::cpp14::make_unique<Cifar10AccuracyAccessor>(feed));
+        }
+    }
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_CIFAR10_H__ */
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_CIFAR_GRAPH_H__
+#define __WIDTH_MULTIPLIED_CIFAR_GRAPH_H__
+
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+#include "utils/CommonGraphOptions.h"
+#include "utils/GraphUtils.h"
+
+#include "common/SweepUtils.h"
+
+#include <algorithm>
+#include <array>
+#include <string>
+
+namespace width_multiplied
+{
+/** Builds the CIFAR-10 models of simple_models/ into a graph stream for a given width and resolution multiplier
+ *
+ * The models are sp_resnet (SimpleResNet), sp_shufflenet (SimpleShflNet) and sp_sqznext (SimpleSqzNext),
+ * with the layer names of their prototxt. The trained weights are the blobs of the caffemodel saved as
+ * .npy files in /cnn_data/<model>_model/: <layer>_w.npy and <layer>_b.npy for the convolutions and the
+ * fully connected layer, <layer>_mean.npy and <layer>_var.npy for the BatchNorm layers, already divided by
+ * their moving average factor, <layer>_w.npy and <layer>_b.npy for the Scale layers, and the depthwise
+ * weights of sp_shufflenet reshaped to (channels, 3, 3). Each BatchNorm and Scale pair is one batch
+ * normalization layer named after the BatchNorm layer.
+ *
+ * @note The grouped channel counts of sp_shufflenet are rounded down to multiples of its 3 groups.
+ */
+class CifarGraphBuilder
+{
+public:
+    /** Constructor
+     *
+     * @param[in] graph         Stream to add the layers to
+     * @param[in] common_params Common graph parameters
+     */
+    CifarGraphBuilder(arm_compute::graph::frontend::Stream &graph, const arm_compute::utils::CommonGraphParams &common_params)
+        : graph(graph), common_params(common_params), data_path(), depth_scale(1.f, ChannelRounding())
+    {
+    }
+    /** Adds the whole network, from input to output layer, to the stream
+     *
+     * @param[in] variant Model, width, resolution and batch size to build
+     */
+    void create_graph(const GraphVariant &variant)
+    {
+        using namespace arm_compute::graph::frontend;
+        using namespace arm_compute::graph_utils;
+
+        // Get trainable parameters data path
+        data_path = common_params.data_path.empty() ? "" : common_params.data_path + "/cnn_data/" + variant.model + "_model/";
+
+        // Create a preprocessor object, the models were trained on RGB images minus the CIFAR-10 mean
+        const std::array<float, 3> mean_rgb{ { 125.31f, 122.95f, 113.87f } };
+        std::unique_ptr<IPreprocessor> preprocessor = arm_compute::support::cpp14::make_unique<CaffePreproccessor>(mean_rgb,
+                                                                                                                   false /* Do not convert to BGR */);
+
+        // Create input descriptor
+        const TensorShape tensor_shape     = permute_shape(TensorShape(variant.resolution, variant.resolution, 3U, variant.batch), DataLayout::NCHW, common_params.data_layout);
+        TensorDescriptor  input_descriptor = TensorDescriptor(tensor_shape, common_params.data_type).set_layout(common_params.data_layout);
+
+        // Scale the channel counts by the width multiplier
+        depth_scale = ChannelScaler(variant.width, variant.rounding);
+
+        graph << common_params.target
+              << common_params.fast_math_hint
+              << InputLayer(input_descriptor, get_input_accessor(common_params, std::move(preprocessor), false /* Do not convert to BGR */));
+
+        if(variant.model == "sp_resnet")
+        {
+            create_resnet();
+        }
+        else if(variant.model == "sp_shufflenet")
+        {
+            create_shufflenet();
+        }
+        else
+        {
+            create_sqznext();
+        }
+
+        graph << FullyConnectedLayer(10U, get_mapped_weights_accessor(data_path, "fc_w.npy"), std::unique_ptr<arm_compute::graph::ITensorAccessor>(nullptr)).set_name("fc")
+              << SoftmaxLayer().set_name("prob")
+              << OutputLayer(get_recorded_output_accessor(common_params, 5));
+    }
+
+private:
+    arm_compute::graph::frontend::Stream        &graph;
+    const arm_compute::utils::CommonGraphParams &common_params;
+    std::string                                 data_path;
+    ChannelScaler                               depth_scale;
+
+    void create_resnet()
+    {
+        using namespace arm_compute::graph::frontend;
+
+        const unsigned int depth = depth_scale(40U);
+        graph << convolution("Convolution1", 5U, 5U, depth, PadStrideInfo(1, 1, 0, 0), true);
+
+        SubStream right(graph);
+        right << convolution("res2b_branch2a", 1U, 1U, depth_scale(10U), PadStrideInfo(1, 1, 0, 0))
+              << batch_normalization("bn2b_branch2a", "scale2b_branch2a")
+              << relu("res2b_branch2a_relu")
+              << convolution("res2b_branch2b", 3U, 3U, depth_scale(10U), PadStrideInfo(1, 1, 1, 1))
+              << batch_normalization("bn2b_branch2b", "scale2b_branch2b")
+              << relu("res2b_branch2b_relu")
+              << convolution("res2b_branch2c", 1U, 1U, depth, PadStrideInfo(1, 1, 0, 0))
+              << batch_normalization("bn2b_branch2c", "scale2b_branch2c");
+
+        SubStream left(graph);
+        graph << BranchLayer(BranchMergeMethod::ADD, std::move(left), std::move(right)).set_name("Eltwise1")
+              << relu("res2b_relu");
+    }
+
+    void create_shufflenet()
+    {
+        using namespace arm_compute::graph::frontend;
+
+        const unsigned int groups = 3U;
+        const unsigned int depth  = grouped_depth(48U, groups);
+        const unsigned int bottle = grouped_depth(12U, groups);
+        graph << convolution("Convolution1", 5U, 5U, depth, PadStrideInfo(1, 1, 0, 0), true);
+
+        SubStream right(graph);
+        right << convolution("resx2_conv1", 1U, 1U, bottle, PadStrideInfo(1, 1, 0, 0), false, groups)
+              << batch_normalization("resx2_conv1_bn", "resx2_conv1_scale")
+              << relu("resx2_conv1_relu")
+              << ChannelShuffleLayer(groups).set_name("shuffle2")
+              << DepthwiseConvolutionLayer(3U, 3U, get_mapped_weights_accessor(data_path, "resx2_conv2_w.npy"),
+                                           std::unique_ptr<arm_compute::graph::ITensorAccessor>(nullptr), PadStrideInfo(1, 1, 1, 1))
+              .set_name("resx2_conv2")
+              << batch_normalization("resx2_conv2_bn", "resx2_conv2_scale")
+              << convolution("resx2_conv3", 1U, 1U, depth, PadStrideInfo(1, 1, 0, 0), false, groups)
+              << batch_normalization("resx2_conv3_bn", "resx2_conv3_scale");
+
+        SubStream left(graph);
+        graph << BranchLayer(BranchMergeMethod::ADD, std::move(left), std::move(right)).set_name("Eltwise1")
+              << relu("resx2_elewise_relu");
+    }
+
+    void create_sqznext()
+    {
+        using namespace arm_compute::graph::frontend;
+
+        const unsigned int depth = depth_scale(32U);
+        graph << convolution("Convolution1", 5U, 5U, depth, PadStrideInfo(1, 1, 0, 0), true);
+
+        SubStream right(graph);
+        right << convolution("Convolution2", 1U, 1U, depth_scale(16U), PadStrideInfo(1, 1, 0, 0))
+              << batch_normalization("BatchNorm2", "Scale2") << relu("ReLU2")
+              << convolution("Convolution3", 1U, 1U, depth_scale(8U), PadStrideInfo(1, 1, 0, 0))
+              << batch_normalization("BatchNorm3", "Scale3") << relu("ReLU3")
+              << convolution("Convolution4", 1U, 3U, depth_scale(16U), PadStrideInfo(1, 1, 0, 1))
+              << batch_normalization("BatchNorm4", "Scale4") << relu("ReLU4")
+              << convolution("Convolution5", 3U, 1U, depth_scale(16U), PadStrideInfo(1, 1, 1, 0))
+              << batch_normalization("BatchNorm5", "Scale5") << relu("ReLU5")
+              << convolution("Convolution6", 1U, 1U, depth, PadStrideInfo(1, 1, 0, 0))
+              << batch_normalization("BatchNorm6", "Scale6") << relu("ReLU6");
+
+        SubStream left(graph);
+        graph << BranchLayer(BranchMergeMethod::ADD, std::move(left), std::move(right)).set_name("Eltwise1");
+    }
+
+    unsigned int grouped_depth(unsigned int channels, unsigned int groups) const
+    {
+        return std::max(groups, depth_scale(channels) / groups * groups);
+    }
+
+    arm_compute::graph::frontend::ConvolutionLayer convolution(const std::string &name, unsigned int conv_width, unsigned int conv_height, unsigned int ofm, arm_compute::PadStrideInfo conv_info,
+                                                               bool has_bias = false, unsigned int num_groups = 1)
+    {
+        arm_compute::graph::frontend::ConvolutionLayer layer(conv_width, conv_height, ofm,
+                                                             get_mapped_weights_accessor(data_path, name + "_w.npy"),
+                                                             has_bias ? get_mapped_weights_accessor(data_path, name + "_b.npy") : std::unique_ptr<arm_compute::graph::ITensorAccessor>(nullptr),
+                                                             conv_info, num_groups);
+        layer.set_name(name);
+        return layer;
+    }
+
+    arm_compute::graph::frontend::BatchNormalizationLayer batch_normalization(const std::string &batch_norm, const std::string &scale)
+    {
+        arm_compute::graph::frontend::BatchNormalizationLayer layer(get_mapped_weights_accessor(data_path, batch_norm + "_mean.npy"),
+                                                                    get_mapped_weights_accessor(data_path, batch_norm + "_var.npy"),
+                                                                    get_mapped_weights_accessor(data_path, scale + "_w.npy"),
+                                                                    get_mapped_weights_accessor(data_path, scale + "_b.npy"),
+                                                                    0.00001f);
+        layer.set_name(batch_norm);
+        return layer;
+    }
+
+    static arm_compute::graph::frontend::ActivationLayer relu(const std::string &name)
+    {
+        using namespace arm_compute::graph::frontend;
+
+        ActivationLayer layer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU));
+        layer.set_name(name);
+        return layer;
+    }
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_CIFAR_GRAPH_H__ */
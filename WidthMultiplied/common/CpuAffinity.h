@@ -0,0 +1,368 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_CPU_AFFINITY_H__
+#define __WIDTH_MULTIPLIED_CPU_AFFINITY_H__
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <cstdio>
+#include <sched.h>
+
+namespace width_multiplied
+{
+/** How the threads of the device are shared between concurrent streams */
+enum class ThreadBudget
+{
+    Shared,      /**< Every stream uses all the threads, on any CPU */
+    Partitioned, /**< Every stream gets its share of the threads, pinned to its own CPUs */
+};
+
+/** Stream operator to print a thread budget
+ *
+ * @param[out] os     Output stream
+ * @param[in]  budget Thread budget to print
+ *
+ * @return Modified output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, ThreadBudget budget)
+{
+    os << (budget == ThreadBudget::Shared ? "shared" : "partitioned");
+    return os;
+}
+
+/** Stream operator to read a thread budget
+ *
+ * @param[in]  is     Input stream
+ * @param[out] budget Thread budget read
+ *
+ * @return Modified input stream
+ */
+inline std::istream &operator>>(std::istream &is, ThreadBudget &budget)
+{
+    std::string value;
+    is >> value;
+    if(value == "shared")
+    {
+        budget = ThreadBudget::Shared;
+    }
+    else if(value == "partitioned")
+    {
+        budget = ThreadBudget::Partitioned;
+    }
+    else
+    {
+        is.setstate(std::ios::failbit);
+    }
+    return is;
+}
+
+/** Returns the CPUs the calling process may run on, in increasing order */
+inline std::vector<unsigned int> allowed_cpus()
+{
+    std::vector<unsigned int> cpus;
+    cpu_set_t                 set;
+    CPU_ZERO(&set);
+    if(sched_getaffinity(0, sizeof(set), &set) == 0)
+    {
+        for(unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu)
+        {
+            if(CPU_ISSET(cpu, &set))
+            {
+                cpus.push_back(cpu);
+            }
+        }
+    }
+    if(cpus.empty())
+    {
+        for(unsigned int cpu = 0; cpu < std::max(1U, std::thread::hardware_concurrency()); ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    return cpus;
+}
+
+/** Restricts the calling thread to some CPUs
+ *
+ * @note Threads created afterwards inherit the mask, so call it before the backend creates its thread pool.
+ *
+ * @param[in] cpus CPUs to run on
+ *
+ * @return True on success
+ */
+inline bool set_cpu_affinity(const std::vector<unsigned int> &cpus)
+{
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    for(unsigned int cpu : cpus)
+    {
+        CPU_SET(cpu, &set);
+    }
+    return !cpus.empty() && sched_setaffinity(0, sizeof(set), &set) == 0;
+}
+
+/** Formats a list of CPUs, e.g. "0-3+6" (no commas, so that it can be used in comma separated lists and CSV files)
+ *
+ * @param[in] cpus CPUs in increasing order
+ *
+ * @return The formatted list, "any" if empty
+ */
+inline std::string cpu_list_to_string(const std::vector<unsigned int> &cpus)
+{
+    if(cpus.empty())
+    {
+        return "any";
+    }
+    std::string list;
+    for(size_t i = 0; i < cpus.size();)
+    {
+        size_t last = i;
+        while(last + 1 < cpus.size() && cpus[last + 1] == cpus[last] + 1)
+        {
+            ++last;
+        }
+        list += (list.empty() ? "" : "+") + std::to_string(cpus[i]) + (last > i ? "-" + std::to_string(cpus[last]) : "");
+        i = last + 1;
+    }
+    return list;
+}
+/** CPUs of the same core type */
+struct CpuCluster
+{
+    std::string               name{};        /**< Core type: big, little, mid<n>, or cpu when every core is the same */
+    std::vector<unsigned int> cpus{};        /**< CPUs of the cluster, in increasing order */
+    unsigned long             capacity{ 0 }; /**< Capacity (or maximum frequency in kHz) of its cores, 0 if unknown */
+};
+
+/** Reads the capacity of a CPU from sysfs
+ *
+ * Uses the scheduler's cpu_capacity when the kernel exposes it (arm64 big.LITTLE), else the maximum
+ * frequency of the core, which separates the clusters of older big.LITTLE kernels (e.g. the Exynos 5422
+ * of the ODROID-XU4) as well.
+ *
+ * @param[in] cpu CPU to read
+ *
+ * @return The capacity, 0 if neither file is readable
+ */
+inline unsigned long read_cpu_capacity(unsigned int cpu)
+{
+    const std::string root = "/sys/devices/system/cpu/cpu" + std::to_string(cpu);
+    for(const char *file : { "/cpu_capacity", "/cpufreq/cpuinfo_max_freq" })
+    {
+        std::ifstream ifs(root + file);
+        unsigned long value = 0;
+        if(ifs >> value)
+        {
+            return value;
+        }
+    }
+    return 0;
+}
+
+/** Groups the CPUs the process may run on by core type
+ *
+ * @return The clusters, the fastest first
+ */
+inline std::vector<CpuCluster> detect_cpu_clusters()
+{
+    std::map<unsigned long, std::vector<unsigned int>> by_capacity;
+    for(unsigned int cpu : allowed_cpus())
+    {
+        by_capacity[read_cpu_capacity(cpu)].push_back(cpu);
+    }
+    std::vector<CpuCluster> clusters;
+    for(auto it = by_capacity.rbegin(); it != by_capacity.rend(); ++it)
+    {
+        CpuCluster cluster;
+        cluster.cpus     = it->second;
+        cluster.capacity = it->first;
+        clusters.push_back(cluster);
+    }
+    for(size_t i = 0; i < clusters.size(); ++i)
+    {
+        if(clusters.size() == 1)
+        {
+            clusters[i].name = "cpu";
+        }
+        else if(i == 0)
+        {
+            clusters[i].name = "big";
+        }
+        else if(i + 1 == clusters.size())
+        {
+            clusters[i].name = "little";
+        }
+        else
+        {
+            clusters[i].name = "mid" + std::to_string(i);
+        }
+    }
+    return clusters;
+}
+
+/** Parses a set of CPUs
+ *
+ * @param[in] cpu_set  "all", the name of a cluster, or CPUs and ranges of CPUs joined by '+', e.g. "0-3+6"
+ * @param[in] clusters Clusters of the device
+ *
+ * @return The CPUs in increasing order, empty if the set is invalid
+ */
+inline std::vector<unsigned int> parse_cpu_set(const std::string &cpu_set, const std::vector<CpuCluster> &clusters)
+{
+    std::vector<unsigned int> cpus;
+    if(cpu_set == "all")
+    {
+        return allowed_cpus();
+    }
+    for(const auto &cluster : clusters)
+    {
+        if(cluster.name == cpu_set)
+        {
+            return cluster.cpus;
+        }
+    }
+    std::stringstream ss(cpu_set);
+    std::string       range;
+    while(std::getline(ss, range, '+'))
+    {
+        unsigned int first = 0;
+        unsigned int last  = 0;
+        char         extra = 0;
+        if(std::sscanf(range.c_str(), "%u-%u%c", &first, &last, &extra) != 2)
+        {
+            if(std::sscanf(range.c_str(), "%u%c", &first, &extra) != 1)
+            {
+                return std::vector<unsigned int>();
+            }
+            last = first;
+        }
+        if(last < first || last >= CPU_SETSIZE)
+        {
+            return std::vector<unsigned int>();
+        }
+        for(unsigned int cpu = first; cpu <= last; ++cpu)
+        {
+            cpus.push_back(cpu);
+        }
+    }
+    std::sort(cpus.begin(), cpus.end());
+    cpus.erase(std::unique(cpus.begin(), cpus.end()), cpus.end());
+    return cpus;
+}
+
+/** Thread count and CPUs a graph runs with */
+struct CpuPlacement
+{
+    std::string               name{};       /**< CPU set as given (cluster name, "all" or explicit CPUs), empty for the process default */
+    std::vector<unsigned int> cpus{};       /**< CPUs the graph runs on, empty for the process default */
+    std::string               core_type{};  /**< Cluster holding all the CPUs, "mixed" if they span several */
+    unsigned int              threads{ 0 }; /**< Threads of the backend, 0 for its default */
+};
+
+/** Compares two placements
+ *
+ * @param[in] a First placement
+ * @param[in] b Second placement
+ *
+ * @return True if both run on the same CPUs with the same thread count
+ */
+inline bool operator==(const CpuPlacement &a, const CpuPlacement &b)
+{
+    return a.cpus == b.cpus && a.threads == b.threads;
+}
+
+/** Returns the core type of a set of CPUs
+ *
+ * @param[in] cpus     CPUs
+ * @param[in] clusters Clusters of the device
+ *
+ * @return The name of the cluster holding all the CPUs, "mixed" if they span several clusters
+ */
+inline std::string core_type(const std::vector<unsigned int> &cpus, const std::vector<CpuCluster> &clusters)
+{
+    for(const auto &cluster : clusters)
+    {
+        if(std::includes(cluster.cpus.begin(), cluster.cpus.end(), cpus.begin(), cpus.end()))
+        {
+            return cluster.name;
+        }
+    }
+    return "mixed";
+}
+
+/** Builds every combination of CPU sets and thread counts
+ *
+ * Thread counts above the number of CPUs of a set are skipped, as the threads would only share cores.
+ *
+ * @param[in] cpu_sets      CPU sets (see parse_cpu_set)
+ * @param[in] thread_counts Thread counts; when empty, 1, the powers of 2 below the number of CPUs of each set and that number
+ * @param[in] clusters      Clusters of the device
+ *
+ * @return The placements, grouped by CPU set
+ */
+inline std::vector<CpuPlacement> make_cpu_placements(const std::vector<std::string> &cpu_sets, const std::vector<unsigned int> &thread_counts, const std::vector<CpuCluster> &clusters)
+{
+    std::vector<CpuPlacement> placements;
+    for(const auto &cpu_set : cpu_sets)
+    {
+        CpuPlacement placement;
+        placement.name      = cpu_set;
+        placement.cpus      = parse_cpu_set(cpu_set, clusters);
+        placement.core_type = core_type(placement.cpus, clusters);
+        if(placement.cpus.empty())
+        {
+            std::cerr << "Invalid CPU set " << cpu_set << ", skipped" << std::endl;
+            continue;
+        }
+        std::vector<unsigned int> counts = thread_counts;
+        if(counts.empty())
+        {
+            for(unsigned int threads = 1; threads < placement.cpus.size(); threads *= 2)
+            {
+                counts.push_back(threads);
+            }
+            counts.push_back(placement.cpus.size());
+        }
+        for(unsigned int threads : counts)
+        {
+            if(threads > 0 && threads <= placement.cpus.size())
+            {
+                placement.threads = threads;
+                placements.push_back(placement);
+            }
+        }
+    }
+    return placements;
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_CPU_AFFINITY_H__ */
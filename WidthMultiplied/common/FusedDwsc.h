@@ -0,0 +1,1053 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_FUSED_DWSC_H__
+#define __WIDTH_MULTIPLIED_FUSED_DWSC_H__
+
+#include "arm_compute/core/Error.h"
+#include "arm_compute/core/Helpers.h"
+#include "arm_compute/core/ITensor.h"
+#include "arm_compute/core/NEON/INEKernel.h"
+#include "arm_compute/core/Types.h"
+#include "arm_compute/core/Utils.h"
+#include "arm_compute/core/Window.h"
+#include "arm_compute/core/utils/misc/Cast.h"
+#include "arm_compute/graph.h"
+#include "arm_compute/runtime/IFunction.h"
+#include "arm_compute/runtime/NEON/NEScheduler.h"
+#include "support/ToolchainSupport.h"
+
+#include "common/BatchNormFolding.h"
+#include "common/GraphExecutor.h"
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif /* __ARM_NEON */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Number of depthwise separable blocks of MobileNetV1, Conv2d_1 to Conv2d_13 */
+constexpr unsigned int num_dwsc_blocks = 13;
+
+/** Bytes of the depthwise output kept per tile by @ref NEFusedDwscKernel, to stay in the L1 data cache */
+constexpr size_t fused_dwsc_tile_bytes = 32 * 1024;
+
+/** Depthwise separable blocks of MobileNet executed as one fused function */
+struct DwscFusion
+{
+    uint32_t blocks{ 0 }; /**< Bit n set when block Conv2d_<n> is fused, n from 1 to num_dwsc_blocks */
+
+    /** Checks whether a block is fused
+     *
+     * @param[in] block Block, from 1 to num_dwsc_blocks
+     *
+     * @return True if the block is fused
+     */
+    bool is_fused(unsigned int block) const
+    {
+        return ((blocks >> block) & 1U) != 0;
+    }
+};
+
+/** Equality operator
+ *
+ * @param[in] a First selection
+ * @param[in] b Second selection
+ *
+ * @return True if both fuse the same blocks
+ */
+inline bool operator==(const DwscFusion &a, const DwscFusion &b)
+{
+    return a.blocks == b.blocks;
+}
+
+/** Converts a selection of fused blocks to its command line name
+ *
+ * @param[in] fusion Selection to convert
+ *
+ * @return "none", "all", or the blocks and ranges of blocks joined by '+', e.g. "1-5+7"
+ */
+inline std::string to_string(const DwscFusion &fusion)
+{
+    const uint32_t all = ((1U << num_dwsc_blocks) - 1U) << 1;
+    if(fusion.blocks == 0)
+    {
+        return "none";
+    }
+    if((fusion.blocks & all) == all)
+    {
+        return "all";
+    }
+    std::string name;
+    for(unsigned int first = 1; first <= num_dwsc_blocks; ++first)
+    {
+        if(!fusion.is_fused(first))
+        {
+            continue;
+        }
+        unsigned int last = first;
+        while(last < num_dwsc_blocks && fusion.is_fused(last + 1))
+        {
+            ++last;
+        }
+        name += (name.empty() ? "" : "+") + std::to_string(first) + (last > first ? "-" + std::to_string(last) : "");
+        first = last;
+    }
+    return name;
+}
+
+/** Stream operator to print a selection of fused blocks
+ *
+ * @param[out] os     Output stream
+ * @param[in]  fusion Selection to print
+ *
+ * @return Modified output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, const DwscFusion &fusion)
+{
+    os << to_string(fusion);
+    return os;
+}
+
+/** Parses a selection of fused blocks
+ *
+ * @param[in] name "none", "all", or blocks and ranges of blocks joined by '+', e.g. "1-5+7"
+ *
+ * @return Parsed selection
+ */
+inline DwscFusion parse_dwsc_fusion(const std::string &name)
+{
+    DwscFusion fusion;
+    if(name == "none")
+    {
+        return fusion;
+    }
+    if(name == "all")
+    {
+        fusion.blocks = ((1U << num_dwsc_blocks) - 1U) << 1;
+        return fusion;
+    }
+    std::stringstream ss(name);
+    std::string       range;
+    while(std::getline(ss, range, '+'))
+    {
+        unsigned int first = 0;
+        unsigned int last  = 0;
+        char         extra = 0;
+        if(std::sscanf(range.c_str(), "%u-%u%c", &first, &last, &extra) != 2)
+        {
+            ARM_COMPUTE_EXIT_ON_MSG(std::sscanf(range.c_str(), "%u%c", &first, &extra) != 1, "Unknown depthwise separable blocks, expected none, all or blocks such as 1-5+7");
+            last = first;
+        }
+        ARM_COMPUTE_EXIT_ON_MSG(first == 0 || last < first || last > num_dwsc_blocks, "Depthwise separable blocks go from 1 to %u", num_dwsc_blocks);
+        for(unsigned int block = first; block <= last; ++block)
+        {
+            fusion.blocks |= 1U << block;
+        }
+    }
+    return fusion;
+}
+
+/** Checks whether an activation can be applied by @ref NEFusedDwscKernel
+ *
+ * @param[in] info Activation
+ *
+ * @return True for no activation, RELU, BOUNDED_RELU and LU_BOUNDED_RELU
+ */
+inline bool is_fusable_activation(const arm_compute::ActivationLayerInfo &info)
+{
+    using ActivationFunction = arm_compute::ActivationLayerInfo::ActivationFunction;
+    return !info.enabled() || info.activation() == ActivationFunction::RELU || info.activation() == ActivationFunction::BOUNDED_RELU
+           || info.activation() == ActivationFunction::LU_BOUNDED_RELU;
+}
+
+/** Applies an activation accepted by @ref is_fusable_activation to a value
+ *
+ * @param[in] value Value
+ * @param[in] info  Activation
+ *
+ * @return Activated value
+ */
+inline float apply_fused_activation(float value, const arm_compute::ActivationLayerInfo &info)
+{
+    using ActivationFunction = arm_compute::ActivationLayerInfo::ActivationFunction;
+    if(!info.enabled())
+    {
+        return value;
+    }
+    switch(info.activation())
+    {
+        case ActivationFunction::RELU:
+            return std::max(0.f, value);
+        case ActivationFunction::BOUNDED_RELU:
+            return std::min(info.a(), std::max(0.f, value));
+        case ActivationFunction::LU_BOUNDED_RELU:
+            return std::min(info.a(), std::max(info.b(), value));
+        default:
+            return value;
+    }
+}
+
+#ifdef __ARM_NEON
+/** Applies an activation accepted by @ref is_fusable_activation to 4 values
+ *
+ * @param[in] value Values
+ * @param[in] info  Activation
+ *
+ * @return Activated values
+ */
+inline float32x4_t apply_fused_activation(float32x4_t value, const arm_compute::ActivationLayerInfo &info)
+{
+    using ActivationFunction = arm_compute::ActivationLayerInfo::ActivationFunction;
+    if(!info.enabled())
+    {
+        return value;
+    }
+    switch(info.activation())
+    {
+        case ActivationFunction::RELU:
+            return vmaxq_f32(vdupq_n_f32(0.f), value);
+        case ActivationFunction::BOUNDED_RELU:
+            return vminq_f32(vdupq_n_f32(info.a()), vmaxq_f32(vdupq_n_f32(0.f), value));
+        case ActivationFunction::LU_BOUNDED_RELU:
+            return vminq_f32(vdupq_n_f32(info.a()), vmaxq_f32(vdupq_n_f32(info.b()), value));
+        default:
+            return value;
+    }
+}
+#endif /* __ARM_NEON */
+
+/** NEON kernel running a depthwise convolution and a 1x1 convolution, each followed by its bias and activation
+ *
+ * The output is computed a few rows at a time: the depthwise output of the rows, for all the
+ * channels, is written to a per-thread buffer of about @ref fused_dwsc_tile_bytes and read back from
+ * the cache by the 1x1 convolution, instead of going through memory between the six layers of the
+ * block. The rows are split between the threads. F32, NCHW or NHWC.
+ *
+ * The depthwise convolution runs the pixels whose window lies inside the input without bounds
+ * checks: 4 pixels at a time in NCHW for strides 1 and 2, 4 channels at a time in NHWC. The pixels
+ * of the borders are computed separately. The 1x1 convolution is a register-blocked GEMM over the
+ * tile, 4 output channels by 4 pixels at a time.
+ */
+class NEFusedDwscKernel final : public arm_compute::INEKernel
+{
+public:
+    const char *name() const override
+    {
+        return "NEFusedDwscKernel";
+    }
+    /** Default constructor */
+    NEFusedDwscKernel()
+        : _input(nullptr), _output(nullptr), _dw_weights(nullptr), _dw_bias(nullptr), _pw_weights(nullptr), _pw_bias(nullptr), _scratch(nullptr), _dw_act(), _pw_act(),
+          _in_strides(), _out_strides(), _in_width(0), _in_height(0), _channels(0), _out_width(0), _out_height(0), _out_channels(0), _kernel_width(0), _kernel_height(0),
+          _stride_x(1), _stride_y(1), _pad_left(0), _pad_top(0), _tile_rows(1), _interior_begin(0), _interior_end(0), _vector_end(0), _nhwc(false)
+    {
+    }
+    /** Initialise the kernel
+     *
+     * @param[in]  input       Input of the depthwise convolution, F32
+     * @param[in]  dw_weights  Depthwise weights packed as [channel][row][column] in NCHW, [row][column][channel] in NHWC
+     * @param[in]  dw_bias     Depthwise bias, one value per channel
+     * @param[in]  pw_weights  1x1 weights packed as [output channel][input channel]
+     * @param[in]  pw_bias     1x1 bias, one value per output channel
+     * @param[out] output      Output of the 1x1 convolution, F32, same layout as the input
+     * @param[in]  kernel_size Width and height of the depthwise kernel
+     * @param[in]  conv_info   Padding and strides of the depthwise convolution
+     * @param[in]  dw_act      Activation of the depthwise output
+     * @param[in]  pw_act      Activation of the 1x1 output
+     * @param[in]  scratch     Per-thread buffers, of at least @ref scratch_size() values each once configured
+     */
+    void configure(const arm_compute::ITensor *input, const float *dw_weights, const float *dw_bias, const float *pw_weights, const float *pw_bias, arm_compute::ITensor *output,
+                   const arm_compute::Size2D &kernel_size, const arm_compute::PadStrideInfo &conv_info, const arm_compute::ActivationLayerInfo &dw_act,
+                   const arm_compute::ActivationLayerInfo &pw_act, std::vector<std::vector<float>> *scratch)
+    {
+        using namespace arm_compute;
+
+        const DataLayout layout = input->info()->data_layout();
+        const size_t     idx_w  = get_data_layout_dimension_index(layout, DataLayoutDimension::WIDTH);
+        const size_t     idx_h  = get_data_layout_dimension_index(layout, DataLayoutDimension::HEIGHT);
+        const size_t     idx_c  = get_data_layout_dimension_index(layout, DataLayoutDimension::CHANNEL);
+        const size_t     idx_n  = get_data_layout_dimension_index(layout, DataLayoutDimension::BATCHES);
+
+        _input         = input;
+        _output        = output;
+        _dw_weights    = dw_weights;
+        _dw_bias       = dw_bias;
+        _pw_weights    = pw_weights;
+        _pw_bias       = pw_bias;
+        _scratch       = scratch;
+        _dw_act        = dw_act;
+        _pw_act        = pw_act;
+        _in_strides    = { input->info()->strides_in_bytes()[idx_w], input->info()->strides_in_bytes()[idx_h], input->info()->strides_in_bytes()[idx_c], input->info()->strides_in_bytes()[idx_n] };
+        _out_strides   = { output->info()->strides_in_bytes()[idx_w], output->info()->strides_in_bytes()[idx_h], output->info()->strides_in_bytes()[idx_c], output->info()->strides_in_bytes()[idx_n] };
+        _in_width      = input->info()->dimension(idx_w);
+        _in_height     = input->info()->dimension(idx_h);
+        _channels      = input->info()->dimension(idx_c);
+        _out_width     = output->info()->dimension(idx_w);
+        _out_height    = output->info()->dimension(idx_h);
+        _out_channels  = output->info()->dimension(idx_c);
+        _kernel_width  = kernel_size.width;
+        _kernel_height = kernel_size.height;
+        _stride_x      = conv_info.stride().first;
+        _stride_y      = conv_info.stride().second;
+        _pad_left      = conv_info.pad_left();
+        _pad_top       = conv_info.pad_top();
+        _nhwc          = layout == DataLayout::NHWC;
+
+        // Output columns whose window lies inside the input, and those the NCHW vector path can read
+        // 4 at a time, vld2q reading one value past the window with a stride of 2
+        const int  last_start = static_cast<int>(_in_width) + _pad_left - static_cast<int>(_kernel_width);
+        const auto columns    = [&](int last) -> size_t
+        {
+            return std::max(_interior_begin, std::min<size_t>(_out_width, (last >= 0) ? last / _stride_x + 1 : 0));
+        };
+        _interior_begin = std::min<size_t>(_out_width, (_pad_left + _stride_x - 1) / _stride_x);
+        _interior_end   = columns(last_start);
+        _vector_end     = columns(last_start - (_stride_x - 1));
+
+        // As many output rows per tile as fit in the budget, at least one
+        const size_t row_bytes = _channels * _out_width * sizeof(float);
+        _tile_rows             = std::max<size_t>(1, std::min<size_t>(_out_height, fused_dwsc_tile_bytes / std::max<size_t>(1, row_bytes)));
+
+        // Tiles of rows along Y, the images of the batch along Z
+        Window win;
+        win.set(Window::DimX, Window::Dimension(0, 1, 1));
+        win.set(Window::DimY, Window::Dimension(0, ceil_to_multiple(_out_height, _tile_rows), _tile_rows));
+        win.set(Window::DimZ, Window::Dimension(0, output->info()->dimension(idx_n), 1));
+        INEKernel::configure(win);
+    }
+    /** Values of the buffer a thread needs: the depthwise output of a tile */
+    size_t scratch_size() const
+    {
+        return _channels * _tile_rows * _out_width;
+    }
+
+    // Inherited methods overridden:
+    void run(const arm_compute::Window &window, const arm_compute::ThreadInfo &info) override
+    {
+        using namespace arm_compute;
+
+        float *tile = (*_scratch)[info.thread_id].data();
+
+        const Window::Dimension &rows    = window[Window::DimY];
+        const Window::Dimension &batches = window[Window::DimZ];
+        for(int batch = batches.start(); batch < batches.end(); ++batch)
+        {
+            const uint8_t *in  = _input->buffer() + _input->info()->offset_first_element_in_bytes() + batch * _in_strides.batch;
+            uint8_t       *out = _output->buffer() + _output->info()->offset_first_element_in_bytes() + batch * _out_strides.batch;
+            for(int y = rows.start(); y < std::min(rows.end(), static_cast<int>(_out_height)); y += rows.step())
+            {
+                const int tile_rows = std::min(rows.step(), static_cast<int>(_out_height) - y);
+                if(_nhwc)
+                {
+                    run_depthwise_nhwc(in, y, tile_rows, tile);
+                }
+                else
+                {
+                    run_depthwise_nchw(in, y, tile_rows, tile);
+                }
+                run_pointwise(tile, y, tile_rows, out);
+            }
+        }
+    }
+
+private:
+    struct Strides
+    {
+        size_t x;
+        size_t y;
+        size_t channel;
+        size_t batch;
+    };
+
+    /** Checks whether the windows of a row of the depthwise output lie inside the input vertically */
+    bool is_interior_row(int iy) const
+    {
+        return iy >= 0 && iy + static_cast<int>(_kernel_height) <= static_cast<int>(_in_height);
+    }
+
+    /** Depthwise output of a channel at one pixel before the activation, skipping the taps outside the input
+     *
+     * @param[in] in_c    First value of the channel in the input
+     * @param[in] weights First weight of the channel
+     * @param[in] step    Distance between two taps of the channel in the packed weights
+     * @param[in] bias    Bias of the channel
+     * @param[in] iy      Input row of the first tap, may be negative
+     * @param[in] ix      Input column of the first tap, may be negative
+     */
+    float depthwise_pixel(const uint8_t *in_c, const float *weights, size_t step, float bias, int iy, int ix) const
+    {
+        const int kw  = _kernel_width;
+        const int kh  = _kernel_height;
+        float     sum = bias;
+        for(int ky = std::max(0, -iy); ky < std::min(kh, static_cast<int>(_in_height) - iy); ++ky)
+        {
+            const uint8_t *in_row = in_c + (iy + ky) * _in_strides.y;
+            for(int kx = std::max(0, -ix); kx < std::min(kw, static_cast<int>(_in_width) - ix); ++kx)
+            {
+                sum += *reinterpret_cast<const float *>(in_row + (ix + kx) * _in_strides.x) * weights[(ky * kw + kx) * step];
+            }
+        }
+        return sum;
+    }
+
+    /** Depthwise output of a tile in NCHW, the interior of the rows 4 pixels at a time */
+    void run_depthwise_nchw(const uint8_t *in, int y, int tile_rows, float *tile) const
+    {
+        const size_t taps = _kernel_width * _kernel_height;
+        for(size_t c = 0; c < _channels; ++c)
+        {
+            const uint8_t *in_c    = in + c * _in_strides.channel;
+            const float   *weights = _dw_weights + c * taps;
+            float         *dst     = tile + c * tile_rows * _out_width;
+            for(int r = 0; r < tile_rows; ++r, dst += _out_width)
+            {
+                const int iy = (y + r) * _stride_y - _pad_top;
+                size_t    ox = 0;
+                if(is_interior_row(iy))
+                {
+                    for(; ox < _interior_begin; ++ox)
+                    {
+                        dst[ox] = apply_fused_activation(depthwise_pixel(in_c, weights, 1, _dw_bias[c], iy, ox * _stride_x - _pad_left), _dw_act);
+                    }
+#ifdef __ARM_NEON
+                    ox = run_depthwise_nchw_interior(in_c, weights, _dw_bias[c], iy, ox, dst);
+#endif /* __ARM_NEON */
+                }
+                for(; ox < _out_width; ++ox)
+                {
+                    dst[ox] = apply_fused_activation(depthwise_pixel(in_c, weights, 1, _dw_bias[c], iy, ox * _stride_x - _pad_left), _dw_act);
+                }
+            }
+        }
+    }
+
+#ifdef __ARM_NEON
+    /** Computes the interior pixels of a row of the depthwise output 4 at a time from a column, returns the first column left */
+    size_t run_depthwise_nchw_interior(const uint8_t *in_c, const float *weights, float bias, int iy, size_t ox, float *dst) const
+    {
+        if(_stride_x > 2)
+        {
+            return ox;
+        }
+        const int kw = _kernel_width;
+        const int kh = _kernel_height;
+        for(; ox + 4 <= _vector_end; ox += 4)
+        {
+            const int   ix  = ox * _stride_x - _pad_left;
+            float32x4_t acc = vdupq_n_f32(bias);
+            for(int ky = 0; ky < kh; ++ky)
+            {
+                const float *in_row = reinterpret_cast<const float *>(in_c + (iy + ky) * _in_strides.y) + ix;
+                for(int kx = 0; kx < kw; ++kx)
+                {
+                    const float32x4_t values = (_stride_x == 1) ? vld1q_f32(in_row + kx) : vld2q_f32(in_row + kx).val[0];
+                    acc                      = vmlaq_n_f32(acc, values, weights[ky * kw + kx]);
+                }
+            }
+            vst1q_f32(dst + ox, apply_fused_activation(acc, _dw_act));
+        }
+        return ox;
+    }
+#endif /* __ARM_NEON */
+
+    /** Depthwise output of a tile in NHWC, the interior pixels 4 channels at a time */
+    void run_depthwise_nhwc(const uint8_t *in, int y, int tile_rows, float *tile) const
+    {
+        const size_t pixels = tile_rows * _out_width;
+        for(int r = 0; r < tile_rows; ++r)
+        {
+            const int iy = (y + r) * _stride_y - _pad_top;
+            for(size_t ox = 0; ox < _out_width; ++ox)
+            {
+                const int ix  = ox * _stride_x - _pad_left;
+                float    *dst = tile + r * _out_width + ox;
+                size_t    c   = 0;
+#ifdef __ARM_NEON
+                if(is_interior_row(iy) && ox >= _interior_begin && ox < _interior_end)
+                {
+                    c = run_depthwise_nhwc_interior(in + iy * _in_strides.y + ix * _in_strides.x, dst, pixels);
+                }
+#endif /* __ARM_NEON */
+                for(; c < _channels; ++c)
+                {
+                    dst[c * pixels] = apply_fused_activation(depthwise_pixel(in + c * _in_strides.channel, _dw_weights + c, _channels, _dw_bias[c], iy, ix), _dw_act);
+                }
+            }
+        }
+    }
+
+#ifdef __ARM_NEON
+    /** Computes the channels of an interior pixel of the depthwise output 4 at a time, returns the first channel left */
+    size_t run_depthwise_nhwc_interior(const uint8_t *in, float *dst, size_t pixels) const
+    {
+        const size_t kw = _kernel_width;
+        const size_t kh = _kernel_height;
+        size_t       c  = 0;
+        for(; c + 4 <= _channels; c += 4)
+        {
+            float32x4_t acc = vld1q_f32(_dw_bias + c);
+            for(size_t ky = 0; ky < kh; ++ky)
+            {
+                const uint8_t *in_row = in + ky * _in_strides.y;
+                for(size_t kx = 0; kx < kw; ++kx)
+                {
+                    acc = vmlaq_f32(acc, vld1q_f32(reinterpret_cast<const float *>(in_row + kx * _in_strides.x) + c), vld1q_f32(_dw_weights + (ky * kw + kx) * _channels + c));
+                }
+            }
+            float values[4];
+            vst1q_f32(values, apply_fused_activation(acc, _dw_act));
+            for(size_t i = 0; i < 4; ++i)
+            {
+                dst[(c + i) * pixels] = values[i];
+            }
+        }
+        return c;
+    }
+#endif /* __ARM_NEON */
+
+    /** 1x1 convolution of a tile, 4 output channels at a time */
+    void run_pointwise(const float *tile, int y, int tile_rows, uint8_t *out) const
+    {
+        size_t co = 0;
+        for(; co + 4 <= _out_channels; co += 4)
+        {
+            run_pointwise_block<4>(tile, y, tile_rows, out, co);
+        }
+        for(; co < _out_channels; ++co)
+        {
+            run_pointwise_block<1>(tile, y, tile_rows, out, co);
+        }
+    }
+
+    /** Computes N output channels of a tile, keeping the accumulators of N channels by 4 pixels in registers */
+    template <size_t N>
+    void run_pointwise_block(const float *tile, int y, int tile_rows, uint8_t *out, size_t co) const
+    {
+        const size_t pixels  = tile_rows * _out_width;
+        const float *weights = _pw_weights + co * _channels;
+        for(int r = 0; r < tile_rows; ++r)
+        {
+            const float *src     = tile + r * _out_width;
+            uint8_t     *out_row = out + (y + r) * _out_strides.y;
+            size_t       x       = 0;
+#ifdef __ARM_NEON
+            for(; x + 4 <= _out_width; x += 4)
+            {
+                float32x4_t acc[N];
+                for(size_t n = 0; n < N; ++n)
+                {
+                    acc[n] = vdupq_n_f32(_pw_bias[co + n]);
+                }
+                for(size_t ci = 0; ci < _channels; ++ci)
+                {
+                    const float32x4_t in = vld1q_f32(src + ci * pixels + x);
+                    for(size_t n = 0; n < N; ++n)
+                    {
+                        acc[n] = vmlaq_n_f32(acc[n], in, weights[n * _channels + ci]);
+                    }
+                }
+                for(size_t n = 0; n < N; ++n)
+                {
+                    store_pixels(out_row, co + n, x, apply_fused_activation(acc[n], _pw_act));
+                }
+            }
+#endif /* __ARM_NEON */
+            for(; x < _out_width; ++x)
+            {
+                for(size_t n = 0; n < N; ++n)
+                {
+                    float sum = _pw_bias[co + n];
+                    for(size_t ci = 0; ci < _channels; ++ci)
+                    {
+                        sum += src[ci * pixels + x] * weights[n * _channels + ci];
+                    }
+                    *output_at(out_row, co + n, x) = apply_fused_activation(sum, _pw_act);
+                }
+            }
+        }
+    }
+
+    float *output_at(uint8_t *out_row, size_t channel, size_t x) const
+    {
+        return reinterpret_cast<float *>(out_row + channel * _out_strides.channel + x * _out_strides.x);
+    }
+
+#ifdef __ARM_NEON
+    /** Stores 4 consecutive pixels of an output channel, as one vector in NCHW */
+    void store_pixels(uint8_t *out_row, size_t channel, size_t x, float32x4_t values) const
+    {
+        if(!_nhwc)
+        {
+            vst1q_f32(output_at(out_row, channel, x), values);
+            return;
+        }
+        float lanes[4];
+        vst1q_f32(lanes, values);
+        for(size_t i = 0; i < 4; ++i)
+        {
+            *output_at(out_row, channel, x + i) = lanes[i];
+        }
+    }
+#endif /* __ARM_NEON */
+
+    const arm_compute::ITensor      *_input;
+    arm_compute::ITensor            *_output;
+    const float                     *_dw_weights;
+    const float                     *_dw_bias;
+    const float                     *_pw_weights;
+    const float                     *_pw_bias;
+    std::vector<std::vector<float>> *_scratch;
+    arm_compute::ActivationLayerInfo _dw_act;
+    arm_compute::ActivationLayerInfo _pw_act;
+    Strides                          _in_strides;
+    Strides                          _out_strides;
+    size_t                           _in_width;
+    size_t                           _in_height;
+    size_t                           _channels;
+    size_t                           _out_width;
+    size_t                           _out_height;
+    size_t                           _out_channels;
+    size_t                           _kernel_width;
+    size_t                           _kernel_height;
+    int                              _stride_x;
+    int                              _stride_y;
+    int                              _pad_left;
+    int                              _pad_top;
+    size_t                           _tile_rows;
+    size_t                           _interior_begin;
+    size_t                           _interior_end;
+    size_t                           _vector_end;
+    bool                             _nhwc;
+};
+
+/** Function running a depthwise separable block with @ref NEFusedDwscKernel
+ *
+ * The weights and biases are packed when the function is prepared, after which their tensors are
+ * marked as unused so that the graph releases them.
+ */
+class NEFusedDwscLayer final : public arm_compute::IFunction
+{
+public:
+    /** Default constructor */
+    NEFusedDwscLayer()
+        : _kernel(), _replaced(), _tensors(), _dw_weights(), _dw_bias(), _pw_weights(), _pw_bias(), _scratch(), _is_prepared(false)
+    {
+    }
+    /** Set the input and output tensors
+     *
+     * @param[in]  input      Input of the depthwise convolution, F32
+     * @param[in]  dw_weights Depthwise weights, same layout as the input
+     * @param[in]  dw_bias    Depthwise bias, nullptr for none
+     * @param[in]  pw_weights 1x1 weights, same layout as the input
+     * @param[in]  pw_bias    1x1 bias, nullptr for none
+     * @param[out] output     Output of the 1x1 convolution
+     * @param[in]  conv_info  Padding and strides of the depthwise convolution
+     * @param[in]  dw_act     Activation of the depthwise output
+     * @param[in]  pw_act     Activation of the 1x1 output
+     * @param[in]  replaced   Functions of the layers the block replaces, never run but kept alive as their memory is registered with the memory managers of the graph
+     */
+    void configure(const arm_compute::ITensor *input, const arm_compute::ITensor *dw_weights, const arm_compute::ITensor *dw_bias, const arm_compute::ITensor *pw_weights,
+                   const arm_compute::ITensor *pw_bias, arm_compute::ITensor *output, const arm_compute::PadStrideInfo &conv_info, const arm_compute::ActivationLayerInfo &dw_act,
+                   const arm_compute::ActivationLayerInfo &pw_act, std::vector<std::unique_ptr<arm_compute::IFunction>> replaced)
+    {
+        using namespace arm_compute;
+
+        const DataLayout layout   = dw_weights->info()->data_layout();
+        const Size2D     kernel   = Size2D(dw_weights->info()->dimension(get_data_layout_dimension_index(layout, DataLayoutDimension::WIDTH)),
+                                           dw_weights->info()->dimension(get_data_layout_dimension_index(layout, DataLayoutDimension::HEIGHT)));
+        const size_t     channels = dw_weights->info()->dimension(get_data_layout_dimension_index(layout, DataLayoutDimension::CHANNEL));
+        const size_t     outputs  = pw_weights->info()->dimension(get_data_layout_dimension_index(layout, DataLayoutDimension::BATCHES));
+
+        _replaced = std::move(replaced);
+        _tensors  = { dw_weights, dw_bias, pw_weights, pw_bias };
+        _dw_weights.resize(channels * kernel.width * kernel.height);
+        _dw_bias.resize(channels);
+        _pw_weights.resize(outputs * channels);
+        _pw_bias.resize(outputs);
+        _kernel.configure(input, _dw_weights.data(), _dw_bias.data(), _pw_weights.data(), _pw_bias.data(), output, kernel, conv_info, dw_act, pw_act, &_scratch);
+        _scratch.assign(NEScheduler::get().num_threads(), std::vector<float>(_kernel.scratch_size()));
+    }
+
+    // Inherited methods overridden:
+    void run() override
+    {
+        using namespace arm_compute;
+
+        prepare();
+        if(_scratch.size() < NEScheduler::get().num_threads())
+        {
+            _scratch.resize(NEScheduler::get().num_threads(), std::vector<float>(_kernel.scratch_size()));
+        }
+        NEScheduler::get().schedule(&_kernel, Window::DimY);
+    }
+    void prepare() override
+    {
+        if(_is_prepared)
+        {
+            return;
+        }
+        pack_depthwise_weights(_tensors[0], _dw_weights);
+        pack_bias(_tensors[1], _dw_bias);
+        pack_pointwise_weights(_tensors[2], _pw_weights);
+        pack_bias(_tensors[3], _pw_bias);
+        for(const arm_compute::ITensor *tensor : _tensors)
+        {
+            if(tensor != nullptr)
+            {
+                tensor->mark_as_unused();
+            }
+        }
+        _is_prepared = true;
+    }
+
+private:
+    static void pack_depthwise_weights(const arm_compute::ITensor *weights, std::vector<float> &values)
+    {
+        using namespace arm_compute;
+
+        const DataLayout layout = weights->info()->data_layout();
+        const size_t     idx_w  = get_data_layout_dimension_index(layout, DataLayoutDimension::WIDTH);
+        const size_t     idx_h  = get_data_layout_dimension_index(layout, DataLayoutDimension::HEIGHT);
+        const size_t     idx_c  = get_data_layout_dimension_index(layout, DataLayoutDimension::CHANNEL);
+        const size_t     width  = weights->info()->dimension(idx_w);
+        const size_t     height = weights->info()->dimension(idx_h);
+        const size_t     taps   = width * height;
+        const size_t     count  = weights->info()->dimension(idx_c);
+        for(size_t c = 0; c < count; ++c)
+        {
+            for(size_t y = 0; y < height; ++y)
+            {
+                for(size_t x = 0; x < width; ++x)
+                {
+                    Coordinates id;
+                    id.set(idx_w, x);
+                    id.set(idx_h, y);
+                    id.set(idx_c, c);
+                    const size_t tap = y * width + x;
+                    values[(layout == DataLayout::NHWC) ? tap * count + c : c * taps + tap] = *reinterpret_cast<const float *>(weights->ptr_to_element(id));
+                }
+            }
+        }
+    }
+
+    static void pack_pointwise_weights(const arm_compute::ITensor *weights, std::vector<float> &values)
+    {
+        using namespace arm_compute;
+
+        const DataLayout layout = weights->info()->data_layout();
+        const size_t     idx_c  = get_data_layout_dimension_index(layout, DataLayoutDimension::CHANNEL);
+        const size_t     idx_n  = get_data_layout_dimension_index(layout, DataLayoutDimension::BATCHES);
+        auto             value  = values.begin();
+        for(size_t co = 0; co < weights->info()->dimension(idx_n); ++co)
+        {
+            for(size_t ci = 0; ci < weights->info()->dimension(idx_c); ++ci)
+            {
+                Coordinates id;
+                id.set(idx_c, ci);
+                id.set(idx_n, co);
+                *value++ = *reinterpret_cast<const float *>(weights->ptr_to_element(id));
+            }
+        }
+    }
+
+    static void pack_bias(const arm_compute::ITensor *bias, std::vector<float> &values)
+    {
+        for(size_t i = 0; i < values.size(); ++i)
+        {
+            values[i] = (bias != nullptr) ? *reinterpret_cast<const float *>(bias->ptr_to_element(arm_compute::Coordinates(i))) : 0.f;
+        }
+    }
+
+    NEFusedDwscKernel                                    _kernel;
+    std::vector<std::unique_ptr<arm_compute::IFunction>> _replaced;
+    std::vector<const arm_compute::ITensor *>            _tensors;
+    std::vector<float>                                   _dw_weights;
+    std::vector<float>                                   _dw_bias;
+    std::vector<float>                                   _pw_weights;
+    std::vector<float>                                   _pw_bias;
+    std::vector<std::vector<float>>                      _scratch;
+    bool                                                 _is_prepared;
+};
+
+/** Executes the selected depthwise separable blocks of MobileNet with @ref NEFusedDwscLayer
+ *
+ * Before the graph is finalized, prepare() folds the batch normalizations of every selected block
+ * into its convolutions and removes its two activations, which the fused function applies. Once
+ * the functions are configured and the constant tensors filled, mutate() runs the fused function in
+ * place of the 1x1 convolution of every block and drops the depthwise task. The 1x1 convolution node
+ * is then fed from the block input rather than the depthwise output, so that the transition memory
+ * manager keeps the input alive until the fused task and never gives its memory to the output.
+ * The blocks are found by the names of their depthwise layers, Conv2d_<n>_depthwise/depthwise.
+ * The graph of ACL 18.08 cannot host custom nodes, hence the tasks replaced in the workload.
+ */
+class DwscFusionMutator final : public IWorkloadMutator
+{
+public:
+    /** Constructor
+     *
+     * @param[in] fusion Blocks to fuse
+     */
+    explicit DwscFusionMutator(DwscFusion fusion)
+        : _fusion(fusion), _blocks(), _fused(0)
+    {
+    }
+    /** Prepares the selected blocks of a graph for fusion
+     *
+     * Blocks that are not a F32 depthwise convolution followed by a 1x1 convolution, each with a
+     * supported activation, are left as they are.
+     *
+     * @param[in,out] g Graph built by the frontend, not finalized yet
+     *
+     * @return Number of blocks to fuse
+     */
+    unsigned int prepare(arm_compute::graph::Graph &g)
+    {
+        using namespace arm_compute::graph;
+
+        // The fused function only adds biases, so the batch normalizations of the blocks are folded first
+        std::vector<NodeID> convolutions;
+        for(unsigned int block = 1; block <= num_dwsc_blocks; ++block)
+        {
+            INode *depthwise = _fusion.is_fused(block) ? find_depthwise(g, block) : nullptr;
+            INode *pointwise = (depthwise != nullptr) ? next_convolution(g, *depthwise) : nullptr;
+            if(pointwise != nullptr)
+            {
+                convolutions.push_back(depthwise->id());
+                convolutions.push_back(pointwise->id());
+            }
+        }
+        if(!convolutions.empty())
+        {
+            BatchNormFoldingMutator(convolutions).mutate(g);
+        }
+
+        for(unsigned int block = 1; block <= num_dwsc_blocks; ++block)
+        {
+            INode *depthwise = _fusion.is_fused(block) ? find_depthwise(g, block) : nullptr;
+            INode *dw_act    = (depthwise != nullptr) ? consumer(g, *depthwise) : nullptr;
+            INode *pointwise = is_activation(dw_act) ? consumer(g, *dw_act) : nullptr;
+            if(!is_pointwise(pointwise))
+            {
+                continue;
+            }
+            INode *pw_act = consumer(g, *pointwise);
+            Block fused;
+            fused.depthwise = depthwise->id();
+            fused.pointwise = pointwise->id();
+            fused.dw_act    = arm_compute::utils::cast::polymorphic_downcast<ActivationLayerNode *>(dw_act)->activation_info();
+            bypass(g, dw_act->id());
+            if(is_activation(pw_act))
+            {
+                fused.pw_act = arm_compute::utils::cast::polymorphic_downcast<ActivationLayerNode *>(pw_act)->activation_info();
+                bypass(g, pw_act->id());
+            }
+            _blocks.push_back(fused);
+        }
+        return _blocks.size();
+    }
+    /** Number of blocks fused by the last call to mutate() */
+    unsigned int fused() const
+    {
+        return _fused;
+    }
+
+    // Inherited methods overridden:
+    void mutate(arm_compute::graph::Graph &g, arm_compute::graph::ExecutionWorkload &workload) override
+    {
+        using namespace arm_compute::graph;
+
+        _fused = 0;
+        for(const auto &block : _blocks)
+        {
+            INode *depthwise = g.node(block.depthwise);
+            INode *pointwise = g.node(block.pointwise);
+            auto   find_task = [&](const INode * node)
+            {
+                return std::find_if(workload.tasks.begin(), workload.tasks.end(), [&](const ExecutionTask & task)
+                {
+                    return task.node == node;
+                });
+            };
+            auto dw_task = find_task(depthwise);
+            auto pw_task = find_task(pointwise);
+            if(depthwise == nullptr || pointwise == nullptr || dw_task == workload.tasks.end() || pw_task == workload.tasks.end() || pointwise->assigned_target() != Target::NEON)
+            {
+                continue;
+            }
+
+            std::vector<std::unique_ptr<arm_compute::IFunction>> replaced;
+            replaced.push_back(std::move(dw_task->task));
+            replaced.push_back(std::move(pw_task->task));
+            auto layer = arm_compute::support::cpp14::make_unique<NEFusedDwscLayer>();
+            layer->configure(tensor_of(depthwise->input(0)), tensor_of(depthwise->input(1)), tensor_of(depthwise->input(2)), tensor_of(pointwise->input(1)),
+                             tensor_of(pointwise->input(2)), tensor_of(pointwise->output(0)),
+                             arm_compute::utils::cast::polymorphic_downcast<DepthwiseConvolutionLayerNode *>(depthwise)->convolution_info(), block.dw_act, block.pw_act,
+                             std::move(replaced));
+            pw_task->task = std::move(layer);
+            workload.tasks.erase(dw_task);
+
+            // Feed the 1x1 convolution from the block input, keeping the descriptor of its output
+            const Edge            *input_edge  = g.edge(depthwise->input_edge_id(0));
+            const TensorDescriptor output_desc = pointwise->output(0)->desc();
+            g.remove_connection(pointwise->input_edge_id(0));
+            g.add_connection(input_edge->producer_id(), input_edge->producer_idx(), pointwise->id(), 0);
+            pointwise->output(0)->desc() = output_desc;
+            ++_fused;
+        }
+    }
+
+private:
+    struct Block
+    {
+        arm_compute::graph::NodeID       depthwise{ arm_compute::graph::EmptyNodeID };
+        arm_compute::graph::NodeID       pointwise{ arm_compute::graph::EmptyNodeID };
+        arm_compute::ActivationLayerInfo dw_act{};
+        arm_compute::ActivationLayerInfo pw_act{};
+    };
+
+    static arm_compute::ITensor *tensor_of(arm_compute::graph::Tensor *tensor)
+    {
+        return (tensor != nullptr && tensor->handle() != nullptr) ? &tensor->handle()->tensor() : nullptr;
+    }
+
+    static arm_compute::graph::INode *find_depthwise(arm_compute::graph::Graph &g, unsigned int block)
+    {
+        using namespace arm_compute::graph;
+        const std::string name = "Conv2d_" + std::to_string(block) + "_depthwise/depthwise";
+        for(auto &node : g.nodes())
+        {
+            if(node != nullptr && node->type() == NodeType::DepthwiseConvolutionLayer && node->name() == name && node->output(0)->desc().data_type == arm_compute::DataType::F32)
+            {
+                return node.get();
+            }
+        }
+        return nullptr;
+    }
+
+    /** Only consumer of the output of a node, nullptr if it has several */
+    static arm_compute::graph::INode *consumer(arm_compute::graph::Graph &g, const arm_compute::graph::INode &node)
+    {
+        if(node.output_edges().size() != 1)
+        {
+            return nullptr;
+        }
+        const arm_compute::graph::Edge *edge = g.edge(*node.output_edges().begin());
+        return (edge != nullptr) ? edge->consumer() : nullptr;
+    }
+
+    /** Convolution following a node through batch normalizations and activations */
+    static arm_compute::graph::INode *next_convolution(arm_compute::graph::Graph &g, const arm_compute::graph::INode &node)
+    {
+        using namespace arm_compute::graph;
+        INode *next = consumer(g, node);
+        while(next != nullptr && (next->type() == NodeType::BatchNormalizationLayer || next->type() == NodeType::ActivationLayer))
+        {
+            next = consumer(g, *next);
+        }
+        return (next != nullptr && next->type() == NodeType::ConvolutionLayer) ? next : nullptr;
+    }
+
+    static bool is_activation(const arm_compute::graph::INode *node)
+    {
+        using namespace arm_compute::graph;
+        return node != nullptr && node->type() == NodeType::ActivationLayer
+               && is_fusable_activation(arm_compute::utils::cast::polymorphic_downcast<const ActivationLayerNode *>(node)->activation_info());
+    }
+
+    static bool is_pointwise(const arm_compute::graph::INode *node)
+    {
+        using namespace arm_compute::graph;
+        if(node == nullptr || node->type() != NodeType::ConvolutionLayer)
+        {
+            return false;
+        }
+        const auto                      *conv_node = arm_compute::utils::cast::polymorphic_downcast<const ConvolutionLayerNode *>(node);
+        const TensorDescriptor           &weights  = conv_node->input(1)->desc();
+        const arm_compute::PadStrideInfo  info     = conv_node->convolution_info();
+        return get_dimension_size(weights, arm_compute::DataLayoutDimension::WIDTH) == 1 && get_dimension_size(weights, arm_compute::DataLayoutDimension::HEIGHT) == 1
+               && info.stride() == std::make_pair(1U, 1U) && !info.has_padding() && conv_node->num_groups() == 1;
+    }
+
+    /** Removes a node with one input and one output, feeding its consumers from its producer */
+    static void bypass(arm_compute::graph::Graph &g, arm_compute::graph::NodeID nid)
+    {
+        using namespace arm_compute::graph;
+        INode                   *node         = g.node(nid);
+        const Edge              *input_edge   = g.edge(node->input_edge_id(0));
+        const NodeID             producer     = input_edge->producer_id();
+        const size_t             producer_idx = input_edge->producer_idx();
+        std::vector<NodeIdxPair> consumers;
+        for(const auto &output_edge_id : node->output_edges())
+        {
+            const Edge *output_edge = g.edge(output_edge_id);
+            if(output_edge != nullptr)
+            {
+                consumers.push_back({ output_edge->consumer_id(), output_edge->consumer_idx() });
+            }
+        }
+        std::unique_ptr<ITensorAccessor> accessor = node->output(0)->extract_accessor();
+        g.remove_node(nid);
+        for(const auto &consumer : consumers)
+        {
+            g.add_connection(producer, producer_idx, consumer.node_id, consumer.index);
+        }
+        g.node(producer)->output(producer_idx)->set_accessor(std::move(accessor));
+    }
+
+    DwscFusion         _fusion;
+    std::vector<Block> _blocks;
+    unsigned int       _fused;
+};
+
+/** Prepares the fusion of the selected depthwise separable blocks of a graph
+ *
+ * @param[in,out] g      Graph built by the frontend, not finalized yet
+ * @param[in]     fusion Blocks to fuse
+ *
+ * @return The mutator to pass to @ref GraphExecutor::finalize(), nullptr if no block is fused
+ */
+inline std::unique_ptr<IWorkloadMutator> apply_dwsc_fusion(arm_compute::graph::Graph &g, const DwscFusion &fusion)
+{
+    if(fusion.blocks == 0)
+    {
+        return nullptr;
+    }
+    std::unique_ptr<DwscFusionMutator> mutator = arm_compute::support::cpp14::make_unique<DwscFusionMutator>(fusion);
+    if(mutator->prepare(g) == 0)
+    {
+        return nullptr;
+    }
+    return std::unique_ptr<IWorkloadMutator>(std::move(mutator));
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_FUSED_DWSC_H__ */
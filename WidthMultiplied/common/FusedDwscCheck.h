@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_FUSED_DWSC_CHECK_H__
+#define __WIDTH_MULTIPLIED_FUSED_DWSC_CHECK_H__
+
+#include "arm_compute/core/Helpers.h"
+#include "arm_compute/core/Types.h"
+#include "arm_compute/graph/TypePrinter.h"
+#include "arm_compute/runtime/Tensor.h"
+
+#include "common/FusedDwsc.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <random>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Depthwise separable block checked by @ref check_fused_dwsc */
+struct FusedDwscCase
+{
+    arm_compute::DataLayout          layout{ arm_compute::DataLayout::NCHW }; /**< Layout of the input, the weights and the output */
+    unsigned int                     width{ 1 };                              /**< Width of the input */
+    unsigned int                     height{ 1 };                             /**< Height of the input */
+    unsigned int                     channels{ 1 };                           /**< Channels of the input and of the depthwise output */
+    unsigned int                     outputs{ 1 };                            /**< Channels of the output */
+    unsigned int                     batches{ 1 };                            /**< Images of the batch */
+    unsigned int                     kernel{ 3 };                             /**< Width and height of the depthwise kernel */
+    unsigned int                     stride{ 1 };                             /**< Stride of the depthwise convolution */
+    unsigned int                     pad{ 1 };                                /**< Padding of the depthwise convolution on every side */
+    arm_compute::ActivationLayerInfo dw_act{};                                /**< Activation of the depthwise output */
+    arm_compute::ActivationLayerInfo pw_act{};                                /**< Activation of the output */
+};
+
+/** Stream operator to print a checked block
+ *
+ * @param[out] os         Output stream
+ * @param[in]  check_case Block to print
+ *
+ * @return Modified output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, const FusedDwscCase &check_case)
+{
+    os << ((check_case.layout == arm_compute::DataLayout::NHWC) ? "NHWC" : "NCHW") << " " << check_case.width << "x" << check_case.height << "x" << check_case.channels
+       << " batch " << check_case.batches << ", " << check_case.kernel << "x" << check_case.kernel << " stride " << check_case.stride << " pad " << check_case.pad
+       << ", " << check_case.outputs << " outputs, activations ";
+    const auto print_activation = [&](const arm_compute::ActivationLayerInfo & act)
+    {
+        if(act.enabled())
+        {
+            os << act.activation();
+        }
+        else
+        {
+            os << "none";
+        }
+    };
+    print_activation(check_case.dw_act);
+    os << "/";
+    print_activation(check_case.pw_act);
+    return os;
+}
+
+/** Allocates a F32 tensor of a 4D shape given in NCHW order
+ *
+ * @param[out] tensor   Tensor to initialise and allocate
+ * @param[in]  layout   Layout of the tensor
+ * @param[in]  width    Width
+ * @param[in]  height   Height
+ * @param[in]  channels Channels
+ * @param[in]  batches  Batches
+ */
+inline void allocate_check_tensor(arm_compute::Tensor &tensor, arm_compute::DataLayout layout, size_t width, size_t height, size_t channels, size_t batches)
+{
+    using namespace arm_compute;
+
+    const TensorShape shape = (layout == DataLayout::NHWC) ? TensorShape(channels, width, height, batches) : TensorShape(width, height, channels, batches);
+    TensorInfo        info(shape, 1, DataType::F32);
+    info.set_data_layout(layout);
+    tensor.allocator()->init(info);
+    tensor.allocator()->allocate();
+}
+
+/** Returns an element of a 4D F32 tensor from its coordinates in NCHW order
+ *
+ * @param[in] tensor  Tensor
+ * @param[in] x       Column
+ * @param[in] y       Row
+ * @param[in] channel Channel
+ * @param[in] batch   Batch
+ *
+ * @return The element
+ */
+inline float &check_element(const arm_compute::ITensor &tensor, size_t x, size_t y, size_t channel, size_t batch)
+{
+    using namespace arm_compute;
+
+    const DataLayout layout = tensor.info()->data_layout();
+    Coordinates      id;
+    id.set(get_data_layout_dimension_index(layout, DataLayoutDimension::WIDTH), x);
+    id.set(get_data_layout_dimension_index(layout, DataLayoutDimension::HEIGHT), y);
+    id.set(get_data_layout_dimension_index(layout, DataLayoutDimension::CHANNEL), channel);
+    id.set(get_data_layout_dimension_index(layout, DataLayoutDimension::BATCHES), batch);
+    return *reinterpret_cast<float *>(tensor.ptr_to_element(id));
+}
+
+/** Runs a block with @ref NEFusedDwscLayer and with a scalar reference accumulating in double
+ *
+ * @param[in]     check_case Block to run
+ * @param[in,out] generator  Generator of the random input, weights and biases
+ *
+ * @return The largest difference between the two outputs, relative to 1 plus the magnitude of the reference
+ */
+inline double run_fused_dwsc_case(const FusedDwscCase &check_case, std::mt19937 &generator)
+{
+    using namespace arm_compute;
+
+    const FusedDwscCase &c          = check_case;
+    const unsigned int   out_width  = (c.width + 2 * c.pad - c.kernel) / c.stride + 1;
+    const unsigned int   out_height = (c.height + 2 * c.pad - c.kernel) / c.stride + 1;
+
+    Tensor input;
+    Tensor dw_weights;
+    Tensor dw_bias;
+    Tensor pw_weights;
+    Tensor pw_bias;
+    Tensor output;
+    allocate_check_tensor(input, c.layout, c.width, c.height, c.channels, c.batches);
+    allocate_check_tensor(dw_weights, c.layout, c.kernel, c.kernel, c.channels, 1);
+    allocate_check_tensor(pw_weights, c.layout, 1, 1, c.channels, c.outputs);
+    allocate_check_tensor(output, c.layout, out_width, out_height, c.outputs, c.batches);
+    dw_bias.allocator()->init(TensorInfo(TensorShape(c.channels), 1, DataType::F32));
+    dw_bias.allocator()->allocate();
+    pw_bias.allocator()->init(TensorInfo(TensorShape(c.outputs), 1, DataType::F32));
+    pw_bias.allocator()->allocate();
+
+    std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+    const auto                            fill = [&](const ITensor & tensor, size_t width, size_t height, size_t channels, size_t batches)
+    {
+        for(size_t n = 0; n < batches; ++n)
+        {
+            for(size_t ch = 0; ch < channels; ++ch)
+            {
+                for(size_t y = 0; y < height; ++y)
+                {
+                    for(size_t x = 0; x < width; ++x)
+                    {
+                        check_element(tensor, x, y, ch, n) = distribution(generator);
+                    }
+                }
+            }
+        }
+    };
+    const auto bias = [](const ITensor & tensor, size_t i) -> float &
+    {
+        return *reinterpret_cast<float *>(tensor.ptr_to_element(Coordinates(i)));
+    };
+    fill(input, c.width, c.height, c.channels, c.batches);
+    fill(dw_weights, c.kernel, c.kernel, c.channels, 1);
+    fill(pw_weights, 1, 1, c.channels, c.outputs);
+    for(size_t ch = 0; ch < c.channels; ++ch)
+    {
+        bias(dw_bias, ch) = distribution(generator);
+    }
+    for(size_t co = 0; co < c.outputs; ++co)
+    {
+        bias(pw_bias, co) = distribution(generator);
+    }
+
+    NEFusedDwscLayer fused;
+    fused.configure(&input, &dw_weights, &dw_bias, &pw_weights, &pw_bias, &output, PadStrideInfo(c.stride, c.stride, c.pad, c.pad), c.dw_act, c.pw_act,
+                    std::vector<std::unique_ptr<IFunction>>());
+    fused.run();
+
+    double              max_error = 0;
+    std::vector<double> depthwise(c.channels);
+    for(size_t n = 0; n < c.batches; ++n)
+    {
+        for(size_t y = 0; y < out_height; ++y)
+        {
+            for(size_t x = 0; x < out_width; ++x)
+            {
+                for(size_t ch = 0; ch < c.channels; ++ch)
+                {
+                    double sum = bias(dw_bias, ch);
+                    for(size_t ky = 0; ky < c.kernel; ++ky)
+                    {
+                        for(size_t kx = 0; kx < c.kernel; ++kx)
+                        {
+                            const int in_y = static_cast<int>(y * c.stride + ky) - static_cast<int>(c.pad);
+                            const int in_x = static_cast<int>(x * c.stride + kx) - static_cast<int>(c.pad);
+                            if(in_y >= 0 && in_y < static_cast<int>(c.height) && in_x >= 0 && in_x < static_cast<int>(c.width))
+                            {
+                                sum += static_cast<double>(check_element(dw_weights, kx, ky, ch, 0)) * check_element(input, in_x, in_y, ch, n);
+                            }
+                        }
+                    }
+                    depthwise[ch] = apply_fused_activation(static_cast<float>(sum), c.dw_act);
+                }
+                for(size_t co = 0; co < c.outputs; ++co)
+                {
+                    double sum = bias(pw_bias, co);
+                    for(size_t ch = 0; ch < c.channels; ++ch)
+                    {
+                        sum += check_element(pw_weights, 0, 0, ch, co) * depthwise[ch];
+                    }
+                    const double reference = apply_fused_activation(static_cast<float>(sum), c.pw_act);
+                    max_error              = std::max(max_error, std::fabs(check_element(output, x, y, co, n) - reference) / (1 + std::fabs(reference)));
+                }
+            }
+        }
+    }
+    return max_error;
+}
+
+/** Checks @ref NEFusedDwscLayer against a scalar reference over the shapes its code paths depend on
+ *
+ * Both layouts, 1x1, 3x3 and 5x5 kernels, strides 1 to 3 (the NCHW vector path handles 1 and 2, other
+ * strides take the scalar path), padding 0 to 2, widths below, around and above 4 vectors of output
+ * columns, channel counts around the 4 channel vectors of NHWC and output channel counts around the 4x4
+ * blocks of the 1x1 convolution, and every fusable activation. Most of these blocks fit in one tile of
+ * output rows, so tall blocks of several tiles, the last one partial, check the halo rows at the tile
+ * boundaries and the reuse of the per-thread scratch. The failing blocks are printed, followed by a summary.
+ *
+ * @param[out] os Output stream
+ *
+ * @return Number of failing blocks
+ */
+inline unsigned int check_fused_dwsc(std::ostream &os)
+{
+    using namespace arm_compute;
+    using ActivationFunction = ActivationLayerInfo::ActivationFunction;
+
+    // Far above the rounding of a float accumulation of a few hundred products of values in [-1, 1]
+    const double tolerance = 1e-4;
+
+    const std::vector<std::pair<ActivationLayerInfo, ActivationLayerInfo>> activations =
+    {
+        { ActivationLayerInfo(), ActivationLayerInfo() },
+        { ActivationLayerInfo(ActivationFunction::RELU), ActivationLayerInfo(ActivationFunction::RELU) },
+        { ActivationLayerInfo(ActivationFunction::BOUNDED_RELU, 0.5f), ActivationLayerInfo(ActivationFunction::LU_BOUNDED_RELU, 0.3f, -0.2f) }
+    };
+
+    std::mt19937 generator(0);
+    unsigned int cases    = 0;
+    unsigned int failures = 0;
+    double       largest  = 0;
+    const auto   check    = [&](const FusedDwscCase & check_case)
+    {
+        const double error = run_fused_dwsc_case(check_case, generator);
+        largest            = std::max(largest, error);
+        ++cases;
+        if(!(error <= tolerance))
+        {
+            ++failures;
+            os << "Mismatch: " << check_case << ", difference " << error << std::endl;
+        }
+    };
+
+    for(DataLayout layout : { DataLayout::NCHW, DataLayout::NHWC })
+    {
+        for(unsigned int kernel : { 1U, 3U, 5U })
+        {
+            for(unsigned int stride : { 1U, 2U, 3U })
+            {
+                for(unsigned int pad : { 0U, 1U, 2U })
+                {
+                    for(unsigned int width : { 5U, 9U, 17U, 70U })
+                    {
+                        for(unsigned int channels : { 1U, 4U, 7U, 32U })
+                        {
+                            for(unsigned int outputs : { 1U, 5U, 16U })
+                            {
+                                for(const auto &activation : activations)
+                                {
+                                    FusedDwscCase check_case;
+                                    check_case.layout   = layout;
+                                    check_case.width    = width;
+                                    check_case.height   = 7;
+                                    check_case.channels = channels;
+                                    check_case.outputs  = outputs;
+                                    check_case.batches  = 2;
+                                    check_case.kernel   = kernel;
+                                    check_case.stride   = stride;
+                                    check_case.pad      = pad;
+                                    check_case.dw_act   = activation.first;
+                                    check_case.pw_act   = activation.second;
+                                    check(check_case);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    // Tiles of 3 rows of 32 channels by 68 to 70 columns with stride 1, 7 rows of 34 to 35 columns with
+    // stride 2: none of the 64, 62, 32 and 31 output rows is a multiple, the last tile is partial
+    for(DataLayout layout : { DataLayout::NCHW, DataLayout::NHWC })
+    {
+        for(unsigned int kernel : { 3U, 5U })
+        {
+            for(unsigned int stride : { 1U, 2U })
+            {
+                FusedDwscCase check_case;
+                check_case.layout   = layout;
+                check_case.width    = 70;
+                check_case.height   = 64;
+                check_case.channels = 32;
+                check_case.outputs  = 16;
+                check_case.batches  = 2;
+                check_case.kernel   = kernel;
+                check_case.stride   = stride;
+                check_case.pad      = 1;
+                check_case.dw_act   = activations[1].first;
+                check_case.pw_act   = activations[1].second;
+                check(check_case);
+            }
+        }
+    }
+    os << "Fused depthwise-separable kernel: " << cases << " blocks checked, " << failures << " failed, largest relative difference " << largest << std::endl;
+    return failures;
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_FUSED_DWSC_CHECK_H__ */
@@ -0,0 +1,200 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_GOOGLENET_GRAPH_H__
+#define __WIDTH_MULTIPLIED_GOOGLENET_GRAPH_H__
+
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+#include "utils/CommonGraphOptions.h"
+#include "utils/GraphUtils.h"
+
+#include "common/SweepUtils.h"
+
+namespace width_multiplied
+{
+/** Builds GoogLeNet into a graph stream for a given width and resolution multiplier */
+class GooglenetGraphBuilder
+{
+public:
+    /** Constructor
+     *
+     * @param[in] graph         Stream to add the layers to
+     * @param[in] common_params Common graph parameters
+     */
+    GooglenetGraphBuilder(arm_compute::graph::frontend::Stream &graph, const arm_compute::utils::CommonGraphParams &common_params)
+        : graph(graph), common_params(common_params)
+    {
+    }
+    /** Adds the whole network, from input to output layer, to the stream
+     *
+     * @param[in] variant Width, resolution and batch size to build
+     */
+    void create_graph(const GraphVariant &variant)
+    {
+        using namespace arm_compute::graph::frontend;
+        using namespace arm_compute::graph_utils;
+
+        // Get trainable parameters data path
+        std::string data_path = common_params.data_path;
+
+        // Create a preprocessor object
+        const std::array<float, 3> mean_rgb{ { 122.68f, 116.67f, 104.01f } };
+        std::unique_ptr<IPreprocessor> preprocessor = arm_compute::support::cpp14::make_unique<CaffePreproccessor>(mean_rgb);
+
+        // Create input descriptor
+        const TensorShape tensor_shape     = permute_shape(TensorShape(variant.resolution, variant.resolution, 3U, variant.batch), DataLayout::NCHW, common_params.data_layout);
+        TensorDescriptor  input_descriptor = TensorDescriptor(tensor_shape, common_params.data_type).set_layout(common_params.data_layout);
+
+        // Set weights trained layout
+        const DataLayout weights_layout = DataLayout::NCHW;
+
+        // Scale the channel counts by the width multiplier
+        const ChannelScaler depth_scale(variant.width, variant.rounding);
+
+        // Channels kept by the consumers of an inception block when slicing the trained weights: the leading ones of each concatenated branch
+        const auto concat_slice = [&](unsigned int a, unsigned int b, unsigned int c, unsigned int d)
+        {
+            return ChannelSlice("", "", { { a, depth_scale(a) }, { b, depth_scale(b) }, { c, depth_scale(c) }, { d, depth_scale(d) } });
+        };
+
+        graph << common_params.target
+              << common_params.fast_math_hint
+              << InputLayer(input_descriptor, get_input_accessor(common_params, std::move(preprocessor)))
+              << ConvolutionLayer(
+                  7U, 7U, depth_scale(64U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/googlenet_model/conv1/conv1_7x7_s2_w.npy", weights_layout),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/googlenet_model/conv1/conv1_7x7_s2_b.npy"),
+                  PadStrideInfo(2, 2, 3, 3))
+              .set_name("conv1/7x7_s2")
+              << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv1/relu_7x7")
+              << PoolingLayer(PoolingLayerInfo(PoolingType::MAX, 3, PadStrideInfo(2, 2, 0, 0, DimensionRoundingType::CEIL))).set_name("pool1/3x3_s2")
+              << NormalizationLayer(NormalizationLayerInfo(NormType::CROSS_MAP, 5, 0.0001f, 0.75f)).set_name("pool1/norm1")
+              << ConvolutionLayer(
+                  1U, 1U, depth_scale(64U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/googlenet_model/conv2/conv2_3x3_reduce_w.npy", weights_layout),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/googlenet_model/conv2/conv2_3x3_reduce_b.npy"),
+                  PadStrideInfo(1, 1, 0, 0))
+              .set_name("conv2/3x3_reduce")
+              << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv2/relu_3x3_reduce")
+              << ConvolutionLayer(
+                  3U, 3U, depth_scale(192U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/googlenet_model/conv2/conv2_3x3_w.npy", weights_layout),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/googlenet_model/conv2/conv2_3x3_b.npy"),
+                  PadStrideInfo(1, 1, 1, 1))
+              .set_name("conv2/3x3")
+              << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv2/relu_3x3")
+              << NormalizationLayer(NormalizationLayerInfo(NormType::CROSS_MAP, 5, 0.0001f, 0.75f)).set_name("conv2/norm2")
+              << PoolingLayer(PoolingLayerInfo(PoolingType::MAX, 3, PadStrideInfo(2, 2, 0, 0, DimensionRoundingType::CEIL))).set_name("pool2/3x3_s2");
+        graph << get_inception_node(data_path, "inception_3a", weights_layout, ChannelSlice(), depth_scale(64U), std::make_tuple(depth_scale(96U), depth_scale(128U)), std::make_tuple(depth_scale(16U), depth_scale(32U)), depth_scale(32U));
+        graph << get_inception_node(data_path, "inception_3b", weights_layout, concat_slice(64U, 128U, 32U, 32U), depth_scale(128U), std::make_tuple(depth_scale(128U), depth_scale(192U)), std::make_tuple(depth_scale(32U), depth_scale(96U)), depth_scale(64U));
+        graph << PoolingLayer(PoolingLayerInfo(PoolingType::MAX, 3, PadStrideInfo(2, 2, 0, 0, DimensionRoundingType::CEIL))).set_name("pool3/3x3_s2");
+        graph << get_inception_node(data_path, "inception_4a", weights_layout, concat_slice(128U, 192U, 96U, 64U), depth_scale(192U), std::make_tuple(depth_scale(96U), depth_scale(208U)), std::make_tuple(depth_scale(16U), depth_scale(48U)), depth_scale(64U));
+        graph << get_inception_node(data_path, "inception_4b", weights_layout, concat_slice(192U, 208U, 48U, 64U), depth_scale(160U), std::make_tuple(depth_scale(112U), depth_scale(224U)), std::make_tuple(depth_scale(24U), depth_scale(64U)), depth_scale(64U));
+        graph << get_inception_node(data_path, "inception_4c", weights_layout, concat_slice(160U, 224U, 64U, 64U), depth_scale(128U), std::make_tuple(depth_scale(128U), depth_scale(256U)), std::make_tuple(depth_scale(24U), depth_scale(64U)), depth_scale(64U));
+        graph << get_inception_node(data_path, "inception_4d", weights_layout, concat_slice(128U, 256U, 64U, 64U), depth_scale(112U), std::make_tuple(depth_scale(144U), depth_scale(288U)), std::make_tuple(depth_scale(32U), depth_scale(64U)), depth_scale(64U));
+        graph << get_inception_node(data_path, "inception_4e", weights_layout, concat_slice(112U, 288U, 64U, 64U), depth_scale(256U), std::make_tuple(depth_scale(160U), depth_scale(320U)), std::make_tuple(depth_scale(32U), depth_scale(128U)), depth_scale(128U));
+        graph << PoolingLayer(PoolingLayerInfo(PoolingType::MAX, 3, PadStrideInfo(2, 2, 0, 0, DimensionRoundingType::CEIL))).set_name("pool4/3x3_s2");
+        graph << get_inception_node(data_path, "inception_5a", weights_layout, concat_slice(256U, 320U, 128U, 128U), depth_scale(256U), std::make_tuple(depth_scale(160U), depth_scale(320U)), std::make_tuple(depth_scale(32U), depth_scale(128U)), depth_scale(128U));
+        graph << get_inception_node(data_path, "inception_5b", weights_layout, concat_slice(256U, 320U, 128U, 128U), depth_scale(384U), std::make_tuple(depth_scale(192U), depth_scale(384U)), std::make_tuple(depth_scale(48U), depth_scale(128U)), depth_scale(128U));
+        graph << PoolingLayer(PoolingLayerInfo(PoolingType::AVG)).set_name("pool5/7x7_s1")
+              << FullyConnectedLayer(
+                  1000U,
+                  get_mapped_weights_accessor(data_path, "/cnn_data/googlenet_model/loss3/loss3_classifier_w.npy", weights_layout, concat_slice(384U, 384U, 128U, 128U)),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/googlenet_model/loss3/loss3_classifier_b.npy"))
+              .set_name("loss3/classifier")
+              << SoftmaxLayer().set_name("prob")
+              << OutputLayer(get_recorded_output_accessor(common_params, 5));
+    }
+
+private:
+    arm_compute::graph::frontend::Stream        &graph;
+    const arm_compute::utils::CommonGraphParams &common_params;
+
+    arm_compute::graph::frontend::BranchLayer get_inception_node(const std::string &data_path, std::string &&param_path, arm_compute::DataLayout weights_layout, const ChannelSlice &input_slice,
+                                                                 unsigned int a_filt,
+                                                                 std::tuple<unsigned int, unsigned int> b_filters,
+                                                                 std::tuple<unsigned int, unsigned int> c_filters,
+                                                                 unsigned int d_filt)
+    {
+        using namespace arm_compute::graph::frontend;
+
+        std::string total_path = "/cnn_data/googlenet_model/" + param_path + "/" + param_path + "_";
+        SubStream   i_a(graph);
+        i_a << ConvolutionLayer(
+                1U, 1U, a_filt,
+                get_mapped_weights_accessor(data_path, total_path + "1x1_w.npy", weights_layout, input_slice),
+                get_mapped_weights_accessor(data_path, total_path + "1x1_b.npy"),
+                PadStrideInfo(1, 1, 0, 0))
+            .set_name(param_path + "/1x1")
+            << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name(param_path + "/relu_1x1");
+
+        SubStream i_b(graph);
+        i_b << ConvolutionLayer(
+                1U, 1U, std::get<0>(b_filters),
+                get_mapped_weights_accessor(data_path, total_path + "3x3_reduce_w.npy", weights_layout, input_slice),
+                get_mapped_weights_accessor(data_path, total_path + "3x3_reduce_b.npy"),
+                PadStrideInfo(1, 1, 0, 0))
+            .set_name(param_path + "/3x3_reduce")
+            << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name(param_path + "/relu_3x3_reduce")
+            << ConvolutionLayer(
+                3U, 3U, std::get<1>(b_filters),
+                get_mapped_weights_accessor(data_path, total_path + "3x3_w.npy", weights_layout),
+                get_mapped_weights_accessor(data_path, total_path + "3x3_b.npy"),
+                PadStrideInfo(1, 1, 1, 1))
+            .set_name(param_path + "/3x3")
+            << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name(param_path + "/relu_3x3");
+
+        SubStream i_c(graph);
+        i_c << ConvolutionLayer(
+                1U, 1U, std::get<0>(c_filters),
+                get_mapped_weights_accessor(data_path, total_path + "5x5_reduce_w.npy", weights_layout, input_slice),
+                get_mapped_weights_accessor(data_path, total_path + "5x5_reduce_b.npy"),
+                PadStrideInfo(1, 1, 0, 0))
+            .set_name(param_path + "/5x5_reduce")
+            << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name(param_path + "/relu_5x5_reduce")
+            << ConvolutionLayer(
+                5U, 5U, std::get<1>(c_filters),
+                get_mapped_weights_accessor(data_path, total_path + "5x5_w.npy", weights_layout),
+                get_mapped_weights_accessor(data_path, total_path + "5x5_b.npy"),
+                PadStrideInfo(1, 1, 2, 2))
+            .set_name(param_path + "/5x5")
+            << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name(param_path + "/relu_5x5");
+
+        SubStream i_d(graph);
+        i_d << PoolingLayer(PoolingLayerInfo(PoolingType::MAX, 3, PadStrideInfo(1, 1, 1, 1, DimensionRoundingType::CEIL))).set_name(param_path + "/pool")
+            << ConvolutionLayer(
+                1U, 1U, d_filt,
+                get_mapped_weights_accessor(data_path, total_path + "pool_proj_w.npy", weights_layout, input_slice),
+                get_mapped_weights_accessor(data_path, total_path + "pool_proj_b.npy"),
+                PadStrideInfo(1, 1, 0, 0))
+            .set_name(param_path + "/pool_proj")
+            << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name(param_path + "/relu_pool_proj");
+
+        BranchLayer concat(BranchMergeMethod::DEPTH_CONCATENATE, std::move(i_a), std::move(i_b), std::move(i_c), std::move(i_d));
+        concat.set_name(param_path + "/concat");
+        return concat;
+    }
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_GOOGLENET_GRAPH_H__ */
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_GRAPH_BUILDERS_H__
+#define __WIDTH_MULTIPLIED_GRAPH_BUILDERS_H__
+
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+#include "utils/CommonGraphOptions.h"
+
+#include "common/AsymmetricConv.h"
+#include "common/CaffeGraph.h"
+#include "common/ChannelShuffle.h"
+#include "common/CifarGraph.h"
+#include "common/FusedDwsc.h"
+#include "common/GooglenetGraph.h"
+#include "common/GraphExecutor.h"
+#include "common/GroupedConvGraph.h"
+#include "common/MobilenetGraph.h"
+#include "common/Quantization.h"
+#include "common/ResNet50Graph.h"
+#include "common/SqueezeNextGraph.h"
+#include "common/SweepUtils.h"
+#include "common/VGG16Graph.h"
+
+#include <memory>
+#include <string>
+
+namespace width_multiplied
+{
+/** Checks whether a graph family is one of the CIFAR-10 models of simple_models/
+ *
+ * @param[in] model Graph family name
+ *
+ * @return True for sp_resnet, sp_shufflenet and sp_sqznext
+ */
+inline bool is_cifar_model(const std::string &model)
+{
+    return model == "sp_resnet" || model == "sp_shufflenet" || model == "sp_sqznext";
+}
+
+/** Checks whether a graph family is known
+ *
+ * @param[in] model Graph family name or path to a Caffe prototxt
+ *
+ * @return True if a builder exists for the given family
+ */
+inline bool is_supported_model(const std::string &model)
+{
+    return model == "mobilenet" || model == "googlenet" || model == "resnet50" || model == "vgg16" || model == "squeezenext" || is_cifar_model(model) || is_grouped_conv_model(model) || is_caffe_prototxt(model);
+}
+
+/** Returns the name the original examples gave to the stream of a graph family, or the name of a Caffe prototxt
+ *
+ * @param[in] model Graph family name or path to a Caffe prototxt
+ *
+ * @return Stream name
+ */
+inline std::string get_graph_name(const std::string &model)
+{
+    if(is_caffe_prototxt(model))
+    {
+        return parse_prototxt(model).get("name", get_caffe_model_name(model));
+    }
+    else if(model == "mobilenet")
+    {
+        return "MobileNetV1";
+    }
+    else if(model == "googlenet")
+    {
+        return "GoogleNet";
+    }
+    else if(model == "resnet50")
+    {
+        return "ResNet50";
+    }
+    else if(model == "squeezenext")
+    {
+        return "SqueezeNext_23";
+    }
+    else if(model == "sp_resnet")
+    {
+        return "SimpleResNet";
+    }
+    else if(model == "sp_shufflenet")
+    {
+        return "SimpleShflNet";
+    }
+    else if(model == "sp_sqznext")
+    {
+        return "SimpleSqzNext";
+    }
+    else if(is_grouped_conv_model(model))
+    {
+        return "GroupedConv_g" + arm_compute::support::cpp11::to_string(get_grouped_conv_groups(model));
+    }
+    return "VGG16";
+}
+
+/** Validates a variant against the common parameters, exiting on unsupported combinations
+ *
+ * @param[in] common_params Common graph parameters
+ * @param[in] variant       Variant to validate
+ * @param[in] selection     (Optional) Channels kept when slicing the trained weights
+ */
+inline void validate_variant(const arm_compute::utils::CommonGraphParams &common_params, const GraphVariant &variant, ChannelSelection selection = ChannelSelection::Leading)
+{
+    using namespace arm_compute;
+    using namespace arm_compute::graph;
+
+    ARM_COMPUTE_EXIT_ON_MSG(!is_supported_model(variant.model), "Unknown model, expected one of mobilenet, googlenet, resnet50, vgg16, squeezenext, sp_resnet, sp_shufflenet, sp_sqznext, gconv_g<n> or a .prototxt file");
+    ARM_COMPUTE_EXIT_ON_MSG(variant.width <= 0.f, "Width multiplier must be positive");
+    ARM_COMPUTE_EXIT_ON_MSG(variant.resolution < 32U, "Resolution must be at least 32");
+    ARM_COMPUTE_EXIT_ON_MSG(variant.batch == 0U, "Batch size must be positive");
+    ARM_COMPUTE_EXIT_ON_MSG(!common_params.data_path.empty() && variant.width > 1.f, "Trained weights (--data) can only be sliced to widths up to 1.0");
+    ARM_COMPUTE_EXIT_ON_MSG(!common_params.data_path.empty() && selection == ChannelSelection::L1 && variant.model != "mobilenet" && variant.model != "vgg16",
+                            "L1 channel selection needs a chain of layers, use leading channels for this graph");
+    ARM_COMPUTE_EXIT_ON_MSG(!common_params.data_path.empty() && variant.model == "mobilenet" && selection == ChannelSelection::L1
+                            && arm_compute::is_data_type_quantized_asymmetric(common_params.data_type),
+                            "L1 channel selection needs F32 weights, use leading channels for the QASYMM8 MobileNet");
+    ARM_COMPUTE_EXIT_ON_MSG(!common_params.data_path.empty() && is_cifar_model(variant.model) && (variant.width != 1.f || variant.resolution != 32U),
+                            "The trained CIFAR-10 models only run at width 1.0 and resolution 32");
+    ARM_COMPUTE_EXIT_ON_MSG(!common_params.data_path.empty() && is_caffe_prototxt(variant.model) && variant.width != 1.f, "The trained Caffe models only run at width 1.0");
+    ARM_COMPUTE_EXIT_ON_MSG(!common_params.data_path.empty() && is_grouped_conv_model(variant.model), "The grouped convolution benchmarks have no trained weights");
+    ARM_COMPUTE_EXIT_ON_MSG(!common_params.data_path.empty() && variant.model == "squeezenext", "SqueezeNext has no trained weights");
+    ARM_COMPUTE_EXIT_ON_MSG(variant.model != "vgg16" && common_params.data_type == DataType::F16 && common_params.target == Target::NEON, "F16 NEON not supported for this graph");
+    ARM_COMPUTE_EXIT_ON_MSG(variant.dwsc_fusion.blocks != 0 && (common_params.target != Target::NEON || common_params.data_type != DataType::F32),
+                            "Fused depthwise separable blocks need --target=NEON and F32");
+    ARM_COMPUTE_EXIT_ON_MSG(variant.channel_shuffle != ChannelShuffleMode::Acl && common_params.target != Target::NEON, "NEON channel shuffles need --target=NEON");
+    ARM_COMPUTE_EXIT_ON_MSG(variant.channel_shuffle == ChannelShuffleMode::Fused && common_params.data_type != DataType::F32, "Fused channel shuffles need F32");
+    ARM_COMPUTE_EXIT_ON_MSG(variant.grouped_conv == GroupedConvMode::Batched && (common_params.target != Target::NEON || common_params.data_type != DataType::F32),
+                            "Batched grouped convolutions need --target=NEON and F32");
+    ARM_COMPUTE_EXIT_ON_MSG(variant.asymmetric_conv == AsymmetricConvMode::Direct && (common_params.target != Target::NEON || common_params.data_type != DataType::F32),
+                            "Direct asymmetric convolutions need --target=NEON and F32");
+}
+
+/** Adds the whole network of a variant to a stream, with its batch normalizations folded, its depthwise separable blocks and its channel shuffles fused, its grouped convolutions batched and its asymmetric convolutions run directly if requested
+ *
+ * A QASYMM8 graph is quantized by @ref QuantizationMutator: the trained MobileNet keeps the quantization of its
+ * layers, the synthetic graphs get the synthetic one, and a calibration file overrides both. The F32 weights of
+ * the other trained graphs are quantized when loaded, with the calibrated or synthetic quantization.
+ *
+ * @param[in,out] graph         Stream to add the layers to
+ * @param[in]     common_params Common graph parameters
+ * @param[in]     variant       Variant to build
+ *
+ * @return The workload mutator to finalize the graph with, nullptr if none is needed
+ */
+inline std::unique_ptr<IWorkloadMutator> create_graph(arm_compute::graph::frontend::Stream &graph, const arm_compute::utils::CommonGraphParams &common_params, const GraphVariant &variant)
+{
+    if(variant.model == "mobilenet")
+    {
+        MobilenetGraphBuilder(graph, common_params).create_graph(variant);
+    }
+    else if(variant.model == "googlenet")
+    {
+        GooglenetGraphBuilder(graph, common_params).create_graph(variant);
+    }
+    else if(variant.model == "resnet50")
+    {
+        ResNet50GraphBuilder(graph, common_params).create_graph(variant);
+    }
+    else if(variant.model == "squeezenext")
+    {
+        SqueezeNextGraphBuilder(graph, common_params).create_graph(variant);
+    }
+    else if(is_cifar_model(variant.model))
+    {
+        CifarGraphBuilder(graph, common_params).create_graph(variant);
+    }
+    else if(is_grouped_conv_model(variant.model))
+    {
+        GroupedConvGraphBuilder(graph, common_params).create_graph(variant);
+    }
+    else if(is_caffe_prototxt(variant.model))
+    {
+        CaffeGraphBuilder(graph, common_params).create_graph(variant);
+    }
+    else
+    {
+        VGG16GraphBuilder(graph, common_params).create_graph(variant);
+    }
+    set_synthetic_weight_kinds(graph.graph());
+
+    // Only the QASYMM8 MobileNet has trained quantized weights
+    const bool trained_qasymm8 = variant.model == "mobilenet" && !common_params.data_path.empty();
+    apply_quantization(graph.graph(), common_params.data_type, !trained_qasymm8, !trained_qasymm8);
+    apply_batch_norm_mode(graph.graph(), variant.batch_norm);
+
+    auto mutators = arm_compute::support::cpp14::make_unique<WorkloadMutatorList>();
+    mutators->add(apply_channel_shuffle_mode(graph.graph(), variant.channel_shuffle));
+    mutators->add(apply_grouped_conv_mode(variant.grouped_conv));
+    mutators->add(apply_asymmetric_conv_mode(variant.asymmetric_conv));
+    mutators->add(apply_dwsc_fusion(graph.graph(), variant.dwsc_fusion));
+    return mutators->empty() ? nullptr : std::unique_ptr<IWorkloadMutator>(std::move(mutators));
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_GRAPH_BUILDERS_H__ */
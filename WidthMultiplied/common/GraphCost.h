@@ -0,0 +1,209 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_GRAPH_COST_H__
+#define __WIDTH_MULTIPLIED_GRAPH_COST_H__
+
+#include "arm_compute/core/Utils.h"
+#include "arm_compute/graph.h"
+#include "arm_compute/graph/Utils.h"
+
+#include <cstdint>
+
+namespace width_multiplied
+{
+/** Analytical cost of a layer or of a whole graph */
+struct LayerCost
+{
+    uint64_t macs{ 0 };             /**< Multiply-accumulates of one inference */
+    uint64_t params{ 0 };           /**< Number of trainable parameters (weights, biases, batch normalization statistics) */
+    uint64_t activation_bytes{ 0 }; /**< Bytes of the output activations */
+    uint64_t weight_bytes{ 0 };     /**< Bytes of the parameters */
+    uint64_t input_bytes{ 0 };      /**< Bytes of the input activations */
+
+    /** Accumulates the cost of another layer
+     *
+     * @param[in] other Cost to add
+     *
+     * @return This cost
+     */
+    LayerCost &operator+=(const LayerCost &other)
+    {
+        macs += other.macs;
+        params += other.params;
+        activation_bytes += other.activation_bytes;
+        weight_bytes += other.weight_bytes;
+        input_bytes += other.input_bytes;
+        return *this;
+    }
+    /** Minimum memory traffic of one inference: every input, parameter and output moved once
+     *
+     * @return Traffic in bytes
+     */
+    uint64_t traffic_bytes() const
+    {
+        return input_bytes + weight_bytes + activation_bytes;
+    }
+};
+
+/** Returns the size in bytes of a tensor descriptor
+ *
+ * @param[in] desc Tensor descriptor
+ *
+ * @return Size in bytes
+ */
+inline uint64_t tensor_bytes(const arm_compute::graph::TensorDescriptor &desc)
+{
+    return static_cast<uint64_t>(desc.shape.total_size()) * arm_compute::data_size_from_type(desc.data_type);
+}
+
+/** Computes the cost of a node of a configured graph
+ *
+ * Only convolutions, depthwise convolutions, fully connected layers and batch normalizations
+ * contribute MACs (a batch normalization counting one per output element); pooling, activations,
+ * element-wise and normalization layers are memory bound and only contribute their activations.
+ * Layers fused into another one by the graph passes are accounted in the node that absorbed them.
+ *
+ * @param[in] node Node of a graph whose tensors have been configured
+ *
+ * @return The cost of the node
+ */
+inline LayerCost compute_node_cost(const arm_compute::graph::INode &node)
+{
+    using namespace arm_compute::graph;
+
+    LayerCost cost;
+    if(node.type() == NodeType::Input || node.type() == NodeType::Output || node.type() == NodeType::Const)
+    {
+        return cost;
+    }
+
+    const arm_compute::graph::Tensor *output = (node.num_outputs() > 0) ? node.output(0) : nullptr;
+    if(output == nullptr)
+    {
+        return cost;
+    }
+    const TensorDescriptor &out_desc = output->desc();
+    cost.activation_bytes            = tensor_bytes(out_desc);
+
+    // Trainable parameters are the inputs following the data input, all the other inputs are activations
+    const bool has_params = node.type() == NodeType::ConvolutionLayer || node.type() == NodeType::DepthwiseConvolutionLayer
+                            || node.type() == NodeType::FullyConnectedLayer || node.type() == NodeType::BatchNormalizationLayer;
+    for(size_t i = 0; i < node.num_inputs(); ++i)
+    {
+        const arm_compute::graph::Tensor *input = node.input(i);
+        if(input == nullptr)
+        {
+            continue;
+        }
+        if(has_params && i > 0)
+        {
+            cost.params += input->desc().shape.total_size();
+            cost.weight_bytes += tensor_bytes(input->desc());
+        }
+        else
+        {
+            cost.input_bytes += tensor_bytes(input->desc());
+        }
+    }
+
+    const arm_compute::graph::Tensor *weights = (node.num_inputs() > 1) ? node.input(1) : nullptr;
+    switch(node.type())
+    {
+        case NodeType::ConvolutionLayer:
+        case NodeType::DepthwiseConvolutionLayer:
+        {
+            // Every output position of every image applies the whole weights tensor once
+            // (Kw x Kh x Cin/groups x Cout for a convolution, Kw x Kh x C for a depthwise convolution)
+            if(weights != nullptr)
+            {
+                const uint64_t positions = static_cast<uint64_t>(get_dimension_size(out_desc, DataLayoutDimension::WIDTH)) * get_dimension_size(out_desc, DataLayoutDimension::HEIGHT)
+                                           * get_dimension_size(out_desc, DataLayoutDimension::BATCHES);
+                cost.macs = positions * weights->desc().shape.total_size();
+            }
+            break;
+        }
+        case NodeType::FullyConnectedLayer:
+        {
+            // The output is (num_outputs, batches): every image applies the whole weights matrix once
+            if(weights != nullptr)
+            {
+                const uint64_t batches = out_desc.shape.total_size() / out_desc.shape.x();
+                cost.macs              = batches * weights->desc().shape.total_size();
+            }
+            break;
+        }
+        case NodeType::BatchNormalizationLayer:
+            cost.macs = out_desc.shape.total_size();
+            break;
+        default:
+            break;
+    }
+    return cost;
+}
+
+/** Computes the total cost of a configured graph
+ *
+ * @param[in] graph Graph whose tensors have been configured, e.g. a finalized graph
+ *
+ * @return The summed cost of all the nodes
+ */
+inline LayerCost compute_graph_cost(const arm_compute::graph::Graph &graph)
+{
+    LayerCost total;
+    for(const auto &node : graph.nodes())
+    {
+        // Nodes removed by the mutating passes leave an empty slot
+        if(node != nullptr)
+        {
+            total += compute_node_cost(*node);
+        }
+    }
+    return total;
+}
+
+/** Achieved throughput of a graph, counting a multiply-accumulate as two floating point operations
+ *
+ * @param[in] macs       Multiply-accumulates of one inference
+ * @param[in] latency_ms Latency of one inference in milliseconds
+ *
+ * @return GFLOP/s, 0 if the latency is not positive
+ */
+inline double gflops_per_second(uint64_t macs, double latency_ms)
+{
+    return (latency_ms > 0) ? 2.0 * static_cast<double>(macs) / (latency_ms * 1e6) : 0;
+}
+
+/** Images processed per second by a graph
+ *
+ * @param[in] batch      Images per run
+ * @param[in] latency_ms Latency of one run in milliseconds
+ *
+ * @return Images per second, 0 if the latency is not positive
+ */
+inline double images_per_second(unsigned int batch, double latency_ms)
+{
+    return (latency_ms > 0) ? batch * 1e3 / latency_ms : 0;
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_GRAPH_COST_H__ */
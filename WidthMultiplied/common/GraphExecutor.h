@@ -0,0 +1,333 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_GRAPH_EXECUTOR_H__
+#define __WIDTH_MULTIPLIED_GRAPH_EXECUTOR_H__
+
+#include "arm_compute/graph.h"
+#include "arm_compute/graph/GraphContext.h"
+#include "arm_compute/graph/PassManager.h"
+#include "arm_compute/graph/Utils.h"
+#include "arm_compute/graph/Workload.h"
+#include "arm_compute/graph/detail/CrossLayerMemoryManagerHelpers.h"
+#include "arm_compute/graph/detail/ExecutionHelpers.h"
+
+#include <memory>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Interface for callbacks invoked around every task of a graph run */
+class ITaskListener
+{
+public:
+    /** Default destructor */
+    virtual ~ITaskListener() = default;
+    /** Called right before a task is run
+     *
+     * @param[in] task Task about to run
+     */
+    virtual void on_task_start(const arm_compute::graph::ExecutionTask &task) = 0;
+    /** Called right after a task has run
+     *
+     * @param[in] task Task that has run
+     */
+    virtual void on_task_end(const arm_compute::graph::ExecutionTask &task) = 0;
+};
+
+/** Forwards the task callbacks to several listeners
+ *
+ * The start callbacks are called in insertion order and the end callbacks in reverse order, so the
+ * first listener added wraps the measurements of the following ones.
+ */
+class TaskListenerGroup final : public ITaskListener
+{
+public:
+    /** Default constructor */
+    TaskListenerGroup()
+        : _listeners()
+    {
+    }
+    /** Adds a listener
+     *
+     * @param[in] listener Listener to add, must outlive the group. Ignored if nullptr
+     */
+    void add(ITaskListener *listener)
+    {
+        if(listener != nullptr)
+        {
+            _listeners.push_back(listener);
+        }
+    }
+    /** Checks if the group has no listener
+     *
+     * @return True if no listener was added
+     */
+    bool empty() const
+    {
+        return _listeners.empty();
+    }
+    // Inherited methods overridden:
+    void on_task_start(const arm_compute::graph::ExecutionTask &task) override
+    {
+        for(auto it = _listeners.begin(); it != _listeners.end(); ++it)
+        {
+            (*it)->on_task_start(task);
+        }
+    }
+    void on_task_end(const arm_compute::graph::ExecutionTask &task) override
+    {
+        for(auto it = _listeners.rbegin(); it != _listeners.rend(); ++it)
+        {
+            (*it)->on_task_end(task);
+        }
+    }
+
+private:
+    std::vector<ITaskListener *> _listeners;
+};
+
+/** Interface for changes to the workload of a graph once its functions are configured and its constant tensors filled */
+class IWorkloadMutator
+{
+public:
+    /** Default destructor */
+    virtual ~IWorkloadMutator() = default;
+    /** Mutates a workload
+     *
+     * @param[in,out] g        Graph of the workload
+     * @param[in,out] workload Workload to mutate, before its tasks are prepared and its memory is set up
+     */
+    virtual void mutate(arm_compute::graph::Graph &g, arm_compute::graph::ExecutionWorkload &workload) = 0;
+};
+
+/** Workload mutator running several mutators in the order they were added */
+class WorkloadMutatorList final : public IWorkloadMutator
+{
+public:
+    /** Default constructor */
+    WorkloadMutatorList()
+        : _mutators()
+    {
+    }
+    /** Adds a mutator to the list
+     *
+     * @param[in] mutator Mutator to add, ignored if nullptr
+     */
+    void add(std::unique_ptr<IWorkloadMutator> mutator)
+    {
+        if(mutator != nullptr)
+        {
+            _mutators.push_back(std::move(mutator));
+        }
+    }
+    /** Checks if the list has no mutator
+     *
+     * @return True if no mutator was added
+     */
+    bool empty() const
+    {
+        return _mutators.empty();
+    }
+    // Inherited methods overridden:
+    void mutate(arm_compute::graph::Graph &g, arm_compute::graph::ExecutionWorkload &workload) override
+    {
+        for(auto &mutator : _mutators)
+        {
+            mutator->mutate(g, workload);
+        }
+    }
+
+private:
+    std::vector<std::unique_ptr<IWorkloadMutator>> _mutators;
+};
+
+/** Runs the first steps of the finalization of a graph
+ *
+ * Assigns the target, configures the tensors and applies the mutating passes, leaving the graph
+ * with the nodes it would be executed with, without configuring the functions or allocating memory.
+ *
+ * @param[in,out] graph  Graph to prepare
+ * @param[in]     target Execution target
+ * @param[in,out] pm     Passes to run on the graph
+ */
+inline void prepare_graph(arm_compute::graph::Graph &graph, arm_compute::graph::Target target, arm_compute::graph::PassManager &pm)
+{
+    using namespace arm_compute::graph;
+
+    // Force target to all graph construct
+    Target forced_target = is_target_supported(target) ? target : get_default_target();
+    force_target_to_graph(graph, forced_target);
+
+    // Configure all tensors
+    arm_compute::graph::detail::configure_all_tensors(graph);
+
+    // Apply all mutating passes
+    pm.run_all(graph);
+}
+
+/** Finalizes and runs a graph while keeping its workload accessible
+ *
+ * Follows the steps of GraphManager::finalize_graph() and execute_graph(), but keeps the
+ * execution workload so that the tasks, and the nodes they were created from, can be
+ * inspected and instrumented one by one.
+ */
+class GraphExecutor
+{
+public:
+    /** Default constructor */
+    GraphExecutor()
+        : _ctx(), _workload(), _finalized(false)
+    {
+    }
+    /** Prevent instances of this class from being copied (As the workload points to the context) */
+    GraphExecutor(const GraphExecutor &) = delete;
+    /** Prevent instances of this class from being copied (As the workload points to the context) */
+    GraphExecutor &operator=(const GraphExecutor &) = delete;
+    /** Finalizes a graph
+     *
+     * @param[in,out] graph   Graph to finalize, must outlive the executor
+     * @param[in]     target  Execution target
+     * @param[in]     config  Graph configuration
+     * @param[in,out] pm      Passes to run on the graph before configuring it
+     * @param[in,out] mutator (Optional) Changes to the workload once the constant tensors are filled
+     */
+    void finalize(arm_compute::graph::Graph &graph, arm_compute::graph::Target target, const arm_compute::graph::GraphConfig &config, arm_compute::graph::PassManager &pm,
+                  IWorkloadMutator *mutator = nullptr)
+    {
+        using namespace arm_compute::graph;
+        ARM_COMPUTE_ERROR_ON_MSG(_finalized, "Graph already finalized");
+
+        // Setup graph context
+        _ctx.set_config(config);
+        setup_default_graph_context(_ctx);
+
+        // Assign the target, configure the tensors and apply all mutating passes
+        prepare_graph(graph, target, pm);
+
+        // Validate and configure all nodes
+        arm_compute::graph::detail::validate_all_nodes(graph);
+        _workload = arm_compute::graph::detail::configure_all_nodes(graph, _ctx);
+        ARM_COMPUTE_ERROR_ON_MSG(_workload.tasks.empty(), "Could not configure all nodes!");
+
+        // Allocate const tensors and call accessors
+        arm_compute::graph::detail::allocate_const_tensors(graph);
+        arm_compute::graph::detail::call_all_const_node_accessors(graph);
+
+        // Apply the changes to the workload, before the tensor lifetimes are taken from its tasks
+        if(mutator != nullptr)
+        {
+            mutator->mutate(graph, _workload);
+        }
+
+        // Prepare graph
+        arm_compute::graph::detail::prepare_all_tasks(_workload);
+
+        // Setup tensor memory (Allocate all tensors or setup transition manager)
+        if(_ctx.config().use_transition_memory_manager)
+        {
+            arm_compute::graph::detail::configure_transition_manager(graph, _ctx, _workload);
+        }
+        else
+        {
+            arm_compute::graph::detail::allocate_all_tensors(graph);
+        }
+
+        // Finalize Graph context
+        _ctx.finalize();
+        _finalized = true;
+
+        // Make first run
+        run();
+
+        // Release all unused const tensors
+        arm_compute::graph::detail::release_unused_tensors(graph);
+    }
+    /** Runs the graph once
+     *
+     * @param[in] listener (Optional) Callbacks invoked around every task
+     */
+    void run(ITaskListener *listener = nullptr)
+    {
+        using namespace arm_compute::graph;
+        ARM_COMPUTE_ERROR_ON_MSG(!_finalized, "Graph not finalized");
+
+        // Call input accessors
+        if(!arm_compute::graph::detail::call_all_input_node_accessors(_workload))
+        {
+            return;
+        }
+
+        // Acquire memory for the transition buffers
+        for(auto &mm_ctx : _ctx.memory_managers())
+        {
+            if(mm_ctx.second.cross_group != nullptr)
+            {
+                mm_ctx.second.cross_group->acquire();
+            }
+        }
+
+        // Execute tasks
+        for(auto &task : _workload.tasks)
+        {
+            if(listener != nullptr)
+            {
+                listener->on_task_start(task);
+            }
+            task();
+            if(listener != nullptr)
+            {
+                listener->on_task_end(task);
+            }
+        }
+
+        // Release memory for the transition buffers
+        for(auto &mm_ctx : _ctx.memory_managers())
+        {
+            if(mm_ctx.second.cross_group != nullptr)
+            {
+                mm_ctx.second.cross_group->release();
+            }
+        }
+
+        // Call output accessors
+        arm_compute::graph::detail::call_all_output_node_accessors(_workload);
+    }
+    /** Execution workload of the finalized graph */
+    const arm_compute::graph::ExecutionWorkload &workload() const
+    {
+        return _workload;
+    }
+    /** Context of the finalized graph */
+    arm_compute::graph::GraphContext &context()
+    {
+        return _ctx;
+    }
+
+private:
+    arm_compute::graph::GraphContext      _ctx;
+    arm_compute::graph::ExecutionWorkload _workload;
+    bool                                  _finalized;
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_GRAPH_EXECUTOR_H__ */
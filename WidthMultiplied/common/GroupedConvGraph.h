@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_GROUPED_CONV_GRAPH_H__
+#define __WIDTH_MULTIPLIED_GROUPED_CONV_GRAPH_H__
+
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+#include "utils/CommonGraphOptions.h"
+#include "utils/GraphUtils.h"
+
+#include "common/SweepUtils.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <string>
+
+namespace width_multiplied
+{
+/** Checks whether a graph family is the grouped convolution benchmark
+ *
+ * @param[in] model Graph family name
+ *
+ * @return True for gconv_g<n>, n being the number of groups of its 1x1 convolutions
+ */
+inline bool is_grouped_conv_model(const std::string &model)
+{
+    const std::string prefix = "gconv_g";
+    return model.size() > prefix.size() && model.compare(0, prefix.size(), prefix) == 0
+           && model.find_first_not_of("0123456789", prefix.size()) == std::string::npos && std::atoi(model.c_str() + prefix.size()) > 0;
+}
+
+/** Returns the number of groups of a grouped convolution benchmark
+ *
+ * @param[in] model Graph family name, gconv_g<n>
+ *
+ * @return n
+ */
+inline unsigned int get_grouped_conv_groups(const std::string &model)
+{
+    return std::atoi(model.c_str() + std::string("gconv_g").size());
+}
+
+/** Builds the grouped convolution benchmark into a graph stream for a given width and resolution multiplier
+ *
+ * A stem (3x3 convolution with stride 2 and max pooling) followed by four residual units of the
+ * ShuffleNet and ResNeXt kind, each a grouped 1x1 convolution to a quarter of the channels, a ReLU and
+ * a grouped 1x1 convolution back, with biases, as after batch normalization folding; then the average
+ * pooling and a 1000 class classifier. The units have 240 channels at width 1.0, and every grouped
+ * count is rounded down to a multiple of the groups, so that the grouped convolutions take most of the
+ * time and the groups and the width can be swept independently. Synthetic weights only.
+ */
+class GroupedConvGraphBuilder
+{
+public:
+    /** Constructor
+     *
+     * @param[in] graph         Stream to add the layers to
+     * @param[in] common_params Common graph parameters
+     */
+    GroupedConvGraphBuilder(arm_compute::graph::frontend::Stream &graph, const arm_compute::utils::CommonGraphParams &common_params)
+        : graph(graph), common_params(common_params), depth_scale(1.f, ChannelRounding())
+    {
+    }
+    /** Adds the whole network, from input to output layer, to the stream
+     *
+     * @param[in] variant Model, width, resolution and batch size to build
+     */
+    void create_graph(const GraphVariant &variant)
+    {
+        using namespace arm_compute::graph::frontend;
+        using namespace arm_compute::graph_utils;
+
+        const unsigned int groups = get_grouped_conv_groups(variant.model);
+
+        // Create input descriptor
+        const TensorShape tensor_shape     = permute_shape(TensorShape(variant.resolution, variant.resolution, 3U, variant.batch), DataLayout::NCHW, common_params.data_layout);
+        TensorDescriptor  input_descriptor = TensorDescriptor(tensor_shape, common_params.data_type).set_layout(common_params.data_layout);
+
+        // Scale the channel counts by the width multiplier
+        depth_scale = ChannelScaler(variant.width, variant.rounding);
+
+        graph << common_params.target
+              << common_params.fast_math_hint
+              << InputLayer(input_descriptor, get_input_accessor(common_params))
+              << convolution("conv1", 3U, depth_scale(24U), PadStrideInfo(2, 2, 1, 1))
+              << relu("conv1/Relu")
+              << PoolingLayer(PoolingLayerInfo(PoolingType::MAX, 3, PadStrideInfo(2, 2, 1, 1))).set_name("pool1/MaxPool")
+              << convolution("expand", 1U, grouped_depth(240U, groups), PadStrideInfo(1, 1, 0, 0))
+              << relu("expand/Relu");
+
+        for(unsigned int unit = 1; unit <= 4; ++unit)
+        {
+            const std::string unit_name = "unit" + arm_compute::support::cpp11::to_string(unit) + "/";
+
+            SubStream right(graph);
+            right << convolution(unit_name + "gconv1", 1U, grouped_depth(60U, groups), PadStrideInfo(1, 1, 0, 0), groups)
+                  << relu(unit_name + "gconv1/Relu")
+                  << convolution(unit_name + "gconv2", 1U, grouped_depth(240U, groups), PadStrideInfo(1, 1, 0, 0), groups);
+
+            SubStream left(graph);
+            graph << BranchLayer(BranchMergeMethod::ADD, std::move(left), std::move(right)).set_name(unit_name + "add")
+                  << relu(unit_name + "Relu");
+        }
+
+        graph << PoolingLayer(PoolingLayerInfo(PoolingType::AVG)).set_name("pool2")
+              << FullyConnectedLayer(1000U, Dummy(), Dummy()).set_name("fc")
+              << SoftmaxLayer().set_name("prob")
+              << OutputLayer(get_recorded_output_accessor(common_params, 5));
+    }
+
+private:
+    arm_compute::graph::frontend::Stream        &graph;
+    const arm_compute::utils::CommonGraphParams &common_params;
+    ChannelScaler                               depth_scale;
+
+    unsigned int grouped_depth(unsigned int channels, unsigned int groups) const
+    {
+        return std::max(groups, depth_scale(channels) / groups * groups);
+    }
+
+    static arm_compute::graph::frontend::ConvolutionLayer convolution(const std::string &name, unsigned int size, unsigned int ofm, arm_compute::PadStrideInfo conv_info, unsigned int num_groups = 1)
+    {
+        arm_compute::graph::frontend::ConvolutionLayer layer(size, size, ofm, Dummy(), Dummy(), conv_info, num_groups);
+        layer.set_name(name);
+        return layer;
+    }
+
+    static arm_compute::graph::frontend::ActivationLayer relu(const std::string &name)
+    {
+        using namespace arm_compute::graph::frontend;
+
+        ActivationLayer layer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU));
+        layer.set_name(name);
+        return layer;
+    }
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_GROUPED_CONV_GRAPH_H__ */
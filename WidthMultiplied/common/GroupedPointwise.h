@@ -0,0 +1,703 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_GROUPED_POINTWISE_H__
+#define __WIDTH_MULTIPLIED_GROUPED_POINTWISE_H__
+
+#include "arm_compute/core/Error.h"
+#include "arm_compute/core/Helpers.h"
+#include "arm_compute/core/ITensor.h"
+#include "arm_compute/core/NEON/INEKernel.h"
+#include "arm_compute/core/Types.h"
+#include "arm_compute/core/Utils.h"
+#include "arm_compute/core/Window.h"
+#include "arm_compute/core/utils/misc/Cast.h"
+#include "arm_compute/graph.h"
+#include "arm_compute/runtime/IFunction.h"
+#include "arm_compute/runtime/NEON/NEScheduler.h"
+#include "support/ToolchainSupport.h"
+
+#include "common/BatchNormFolding.h"
+#include "common/GraphExecutor.h"
+
+#ifdef __ARM_NEON
+#include <arm_neon.h>
+#endif /* __ARM_NEON */
+
+#include <algorithm>
+#include <cstdint>
+#include <istream>
+#include <memory>
+#include <numeric>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace width_multiplied
+{
+/** How the grouped 1x1 convolutions of a graph are executed */
+enum class GroupedConvMode
+{
+    Split,   /**< As built by the frontend: a split, one convolution per group and a concatenation */
+    Batched, /**< By @ref NEGroupedPointwiseLayer, every group in one dispatch */
+};
+
+/** Stream operator to print a grouped convolution mode
+ *
+ * @param[out] os   Output stream
+ * @param[in]  mode Mode to print
+ *
+ * @return Modified output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, GroupedConvMode mode)
+{
+    switch(mode)
+    {
+        case GroupedConvMode::Batched:
+            os << "batched";
+            break;
+        case GroupedConvMode::Split:
+        default:
+            os << "split";
+            break;
+    }
+    return os;
+}
+
+/** Stream operator to read a grouped convolution mode
+ *
+ * @param[in]  is   Input stream
+ * @param[out] mode Mode read
+ *
+ * @return Modified input stream
+ */
+inline std::istream &operator>>(std::istream &is, GroupedConvMode &mode)
+{
+    std::string value;
+    is >> value;
+    if(value == "split")
+    {
+        mode = GroupedConvMode::Split;
+    }
+    else if(value == "batched")
+    {
+        mode = GroupedConvMode::Batched;
+    }
+    else
+    {
+        is.setstate(std::ios::failbit);
+    }
+    return is;
+}
+
+/** Parses a grouped convolution mode, as written in the sweep CSV files
+ *
+ * @param[in] name Name of the mode, empty in the files written before the grouped convolution column
+ *
+ * @return The mode, split if the name is empty or unknown
+ */
+inline GroupedConvMode parse_grouped_conv_mode(const std::string &name)
+{
+    std::stringstream ss(name);
+    GroupedConvMode   mode = GroupedConvMode::Split;
+    ss >> mode;
+    return ss.fail() ? GroupedConvMode::Split : mode;
+}
+
+/** NEON kernel running every group of a grouped 1x1 convolution in one pass
+ *
+ * Each group is a small GEMM of its output channels by its input channels over the pixels of a row.
+ * The rows of the output are split between the threads, every thread computing all the groups of its
+ * rows, so the G GEMMs take one dispatch and read the input and write the output in place, without
+ * the split and concatenation of the frontend's one convolution per group.
+ *
+ * The input channels of the groups are read through a channel map, which lets a preceding channel
+ * shuffle be fused as a permuted read. F32, NCHW or NHWC, stride 1 and no padding.
+ */
+class NEGroupedPointwiseKernel final : public arm_compute::INEKernel
+{
+public:
+    const char *name() const override
+    {
+        return "NEGroupedPointwiseKernel";
+    }
+    /** Default constructor */
+    NEGroupedPointwiseKernel()
+        : _input(nullptr), _output(nullptr), _weights(nullptr), _bias(nullptr), _input_channels(nullptr), _in_strides(), _out_strides(), _width(0), _height(0), _num_groups(1),
+          _group_inputs(0), _group_outputs(0), _nhwc(false)
+    {
+    }
+    /** Initialise the kernel
+     *
+     * @param[in]  input          Input of the convolution, F32
+     * @param[in]  weights        Weights packed as returned by @ref pack_weights for the layout of the input
+     * @param[in]  bias           Bias, one value per output channel
+     * @param[out] output         Output of the convolution, F32, same layout and size as the input
+     * @param[in]  num_groups     Number of groups
+     * @param[in]  input_channels Input channel read as each input channel of the groups, one per input channel
+     */
+    void configure(const arm_compute::ITensor *input, const float *weights, const float *bias, arm_compute::ITensor *output, unsigned int num_groups,
+                   const unsigned int *input_channels)
+    {
+        using namespace arm_compute;
+
+        const DataLayout layout = input->info()->data_layout();
+        const size_t     idx_w  = get_data_layout_dimension_index(layout, DataLayoutDimension::WIDTH);
+        const size_t     idx_h  = get_data_layout_dimension_index(layout, DataLayoutDimension::HEIGHT);
+        const size_t     idx_c  = get_data_layout_dimension_index(layout, DataLayoutDimension::CHANNEL);
+        const size_t     idx_n  = get_data_layout_dimension_index(layout, DataLayoutDimension::BATCHES);
+
+        _input          = input;
+        _output         = output;
+        _weights        = weights;
+        _bias           = bias;
+        _input_channels = input_channels;
+        _in_strides     = { input->info()->strides_in_bytes()[idx_w], input->info()->strides_in_bytes()[idx_h], input->info()->strides_in_bytes()[idx_c], input->info()->strides_in_bytes()[idx_n] };
+        _out_strides    = { output->info()->strides_in_bytes()[idx_w], output->info()->strides_in_bytes()[idx_h], output->info()->strides_in_bytes()[idx_c], output->info()->strides_in_bytes()[idx_n] };
+        _width          = output->info()->dimension(idx_w);
+        _height         = output->info()->dimension(idx_h);
+        _num_groups     = num_groups;
+        _group_inputs   = input->info()->dimension(idx_c) / num_groups;
+        _group_outputs  = output->info()->dimension(idx_c) / num_groups;
+        _nhwc           = layout == DataLayout::NHWC;
+
+        // Rows along Y, the images of the batch along Z
+        Window win;
+        win.set(Window::DimX, Window::Dimension(0, 1, 1));
+        win.set(Window::DimY, Window::Dimension(0, _height, 1));
+        win.set(Window::DimZ, Window::Dimension(0, output->info()->dimension(idx_n), 1));
+        INEKernel::configure(win);
+    }
+    /** Packs the weights of a grouped 1x1 convolution for the kernel
+     *
+     * @param[in]  weights    Weights of all the groups, F32, shape (1, 1, input channels per group, output channels) in the layout of the tensor
+     * @param[in]  num_groups Number of groups
+     * @param[in]  nhwc       True to pack for a NHWC input: [group][input channel][output channel of the group], else [output channel][input channel of its group]
+     * @param[out] values     Packed weights
+     */
+    static void pack_weights(const arm_compute::ITensor *weights, unsigned int num_groups, bool nhwc, std::vector<float> &values)
+    {
+        using namespace arm_compute;
+
+        const DataLayout layout        = weights->info()->data_layout();
+        const size_t     idx_c         = get_data_layout_dimension_index(layout, DataLayoutDimension::CHANNEL);
+        const size_t     idx_n         = get_data_layout_dimension_index(layout, DataLayoutDimension::BATCHES);
+        const size_t     group_inputs  = weights->info()->dimension(idx_c);
+        const size_t     outputs       = weights->info()->dimension(idx_n);
+        const size_t     group_outputs = outputs / num_groups;
+        values.resize(group_inputs * outputs);
+        for(size_t co = 0; co < outputs; ++co)
+        {
+            const size_t group = co / group_outputs;
+            for(size_t ci = 0; ci < group_inputs; ++ci)
+            {
+                Coordinates id;
+                id.set(idx_c, ci);
+                id.set(idx_n, co);
+                const size_t index = nhwc ? (group * group_inputs + ci) * group_outputs + co % group_outputs : co * group_inputs + ci;
+                values[index]      = *reinterpret_cast<const float *>(weights->ptr_to_element(id));
+            }
+        }
+    }
+
+    // Inherited methods overridden:
+    void run(const arm_compute::Window &window, const arm_compute::ThreadInfo &info) override
+    {
+        using namespace arm_compute;
+        ARM_COMPUTE_UNUSED(info);
+
+        const Window::Dimension &rows    = window[Window::DimY];
+        const Window::Dimension &batches = window[Window::DimZ];
+        for(int batch = batches.start(); batch < batches.end(); ++batch)
+        {
+            const uint8_t *in  = _input->buffer() + _input->info()->offset_first_element_in_bytes() + batch * _in_strides.batch;
+            uint8_t       *out = _output->buffer() + _output->info()->offset_first_element_in_bytes() + batch * _out_strides.batch;
+            for(int y = rows.start(); y < rows.end(); y += rows.step())
+            {
+                for(size_t group = 0; group < _num_groups; ++group)
+                {
+                    if(_nhwc)
+                    {
+                        run_nhwc_row(in + y * _in_strides.y, out + y * _out_strides.y, group);
+                    }
+                    else
+                    {
+                        run_nchw_row(in + y * _in_strides.y, out + y * _out_strides.y, group);
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    struct Strides
+    {
+        size_t x;
+        size_t y;
+        size_t channel;
+        size_t batch;
+    };
+
+    const float *input_row(const uint8_t *in_row, const unsigned int *channels, size_t ci) const
+    {
+        return reinterpret_cast<const float *>(in_row + channels[ci] * _in_strides.channel);
+    }
+
+    void run_nchw_row(const uint8_t *in_row, uint8_t *out_row, size_t group) const
+    {
+        const unsigned int *channels = _input_channels + group * _group_inputs;
+        const size_t        co_end   = (group + 1) * _group_outputs;
+        size_t              co       = group * _group_outputs;
+        for(; co + 4 <= co_end; co += 4)
+        {
+            run_nchw_block<4>(in_row, out_row, channels, co);
+        }
+        for(; co < co_end; ++co)
+        {
+            run_nchw_block<1>(in_row, out_row, channels, co);
+        }
+    }
+
+    /** Computes N output channels of a row, 4 pixels at a time: every input row loaded is used by the N channels */
+    template <size_t N>
+    void run_nchw_block(const uint8_t *in_row, uint8_t *out_row, const unsigned int *channels, size_t co) const
+    {
+        const float *weights = _weights + co * _group_inputs;
+        float       *dst[N];
+        for(size_t n = 0; n < N; ++n)
+        {
+            dst[n] = reinterpret_cast<float *>(out_row + (co + n) * _out_strides.channel);
+        }
+        size_t x = 0;
+#ifdef __ARM_NEON
+        for(; x + 4 <= _width; x += 4)
+        {
+            float32x4_t acc[N];
+            for(size_t n = 0; n < N; ++n)
+            {
+                acc[n] = vdupq_n_f32(_bias[co + n]);
+            }
+            for(size_t ci = 0; ci < _group_inputs; ++ci)
+            {
+                const float32x4_t in = vld1q_f32(input_row(in_row, channels, ci) + x);
+                for(size_t n = 0; n < N; ++n)
+                {
+                    acc[n] = vmlaq_n_f32(acc[n], in, weights[n * _group_inputs + ci]);
+                }
+            }
+            for(size_t n = 0; n < N; ++n)
+            {
+                vst1q_f32(dst[n] + x, acc[n]);
+            }
+        }
+#endif /* __ARM_NEON */
+        for(; x < _width; ++x)
+        {
+            for(size_t n = 0; n < N; ++n)
+            {
+                float sum = _bias[co + n];
+                for(size_t ci = 0; ci < _group_inputs; ++ci)
+                {
+                    sum += input_row(in_row, channels, ci)[x] * weights[n * _group_inputs + ci];
+                }
+                dst[n][x] = sum;
+            }
+        }
+    }
+
+    /** Computes the output channels of a group for every pixel of a row, 4 channels at a time */
+    void run_nhwc_row(const uint8_t *in_row, uint8_t *out_row, size_t group) const
+    {
+        const unsigned int *channels = _input_channels + group * _group_inputs;
+        const float        *weights  = _weights + group * _group_inputs * _group_outputs;
+        const float        *bias     = _bias + group * _group_outputs;
+        for(size_t x = 0; x < _width; ++x)
+        {
+            const float *in  = reinterpret_cast<const float *>(in_row + x * _in_strides.x);
+            float       *out = reinterpret_cast<float *>(out_row + x * _out_strides.x) + group * _group_outputs;
+            size_t       co  = 0;
+#ifdef __ARM_NEON
+            for(; co + 4 <= _group_outputs; co += 4)
+            {
+                float32x4_t acc = vld1q_f32(bias + co);
+                for(size_t ci = 0; ci < _group_inputs; ++ci)
+                {
+                    acc = vmlaq_n_f32(acc, vld1q_f32(weights + ci * _group_outputs + co), in[channels[ci]]);
+                }
+                vst1q_f32(out + co, acc);
+            }
+#endif /* __ARM_NEON */
+            for(; co < _group_outputs; ++co)
+            {
+                float sum = bias[co];
+                for(size_t ci = 0; ci < _group_inputs; ++ci)
+                {
+                    sum += weights[ci * _group_outputs + co] * in[channels[ci]];
+                }
+                out[co] = sum;
+            }
+        }
+    }
+
+    const arm_compute::ITensor *_input;
+    arm_compute::ITensor       *_output;
+    const float                *_weights;
+    const float                *_bias;
+    const unsigned int         *_input_channels;
+    Strides                     _in_strides;
+    Strides                     _out_strides;
+    size_t                      _width;
+    size_t                      _height;
+    size_t                      _num_groups;
+    size_t                      _group_inputs;
+    size_t                      _group_outputs;
+    bool                        _nhwc;
+};
+
+/** Function running a grouped 1x1 convolution with @ref NEGroupedPointwiseKernel
+ *
+ * The weights and biases are packed when the function is prepared, after which their tensors are
+ * marked as unused so that the graph releases them.
+ */
+class NEGroupedPointwiseLayer final : public arm_compute::IFunction
+{
+public:
+    /** Default constructor */
+    NEGroupedPointwiseLayer()
+        : _kernel(), _replaced(), _weights_tensor(nullptr), _bias_tensors(), _weights(), _bias(), _input_channels(), _num_groups(1), _nhwc(false), _is_prepared(false)
+    {
+    }
+    /** Set the input and output tensors
+     *
+     * @param[in]  input          Input of the convolution, F32
+     * @param[in]  weights        Weights of all the groups, shape (1, 1, input channels per group, output channels) in the layout of the input
+     * @param[in]  biases         Bias of every group, as its tensor (nullptr for none) and the index of the first value of the group in it
+     * @param[out] output         Output of the convolution
+     * @param[in]  num_groups     Number of groups
+     * @param[in]  input_channels (Optional) Input channel read as each input channel of the groups, the identity if empty
+     * @param[in]  replaced       (Optional) Functions of the layers the convolution replaces, never run but kept alive as their memory is registered with the memory managers of the graph
+     */
+    void configure(const arm_compute::ITensor *input, const arm_compute::ITensor *weights, std::vector<std::pair<const arm_compute::ITensor *, size_t>> biases,
+                   arm_compute::ITensor *output, unsigned int num_groups, std::vector<unsigned int> input_channels = std::vector<unsigned int>(),
+                   std::vector<std::unique_ptr<arm_compute::IFunction>> replaced = std::vector<std::unique_ptr<arm_compute::IFunction>>())
+    {
+        using namespace arm_compute;
+
+        const size_t channels = input->info()->dimension(get_data_layout_dimension_index(input->info()->data_layout(), DataLayoutDimension::CHANNEL));
+        const size_t outputs  = output->info()->dimension(get_data_layout_dimension_index(output->info()->data_layout(), DataLayoutDimension::CHANNEL));
+        ARM_COMPUTE_ERROR_ON(biases.size() != num_groups);
+        ARM_COMPUTE_ERROR_ON(!input_channels.empty() && input_channels.size() != channels);
+
+        _replaced       = std::move(replaced);
+        _weights_tensor = weights;
+        _bias_tensors   = std::move(biases);
+        _num_groups     = num_groups;
+        _nhwc           = input->info()->data_layout() == DataLayout::NHWC;
+        _input_channels = std::move(input_channels);
+        if(_input_channels.empty())
+        {
+            _input_channels.resize(channels);
+            std::iota(_input_channels.begin(), _input_channels.end(), 0U);
+        }
+        _weights.resize(channels / num_groups * outputs);
+        _bias.resize(outputs);
+        _kernel.configure(input, _weights.data(), _bias.data(), output, num_groups, _input_channels.data());
+    }
+
+    // Inherited methods overridden:
+    void run() override
+    {
+        prepare();
+        arm_compute::NEScheduler::get().schedule(&_kernel, arm_compute::Window::DimY);
+    }
+    void prepare() override
+    {
+        if(_is_prepared)
+        {
+            return;
+        }
+        NEGroupedPointwiseKernel::pack_weights(_weights_tensor, _num_groups, _nhwc, _weights);
+        const size_t group_outputs = _bias.size() / _num_groups;
+        for(size_t group = 0; group < _num_groups; ++group)
+        {
+            const arm_compute::ITensor *bias = _bias_tensors[group].first;
+            for(size_t i = 0; i < group_outputs; ++i)
+            {
+                _bias[group * group_outputs + i] = (bias != nullptr) ? *reinterpret_cast<const float *>(bias->ptr_to_element(arm_compute::Coordinates(_bias_tensors[group].second + i))) : 0.f;
+            }
+        }
+        _weights_tensor->mark_as_unused();
+        for(const auto &bias : _bias_tensors)
+        {
+            if(bias.first != nullptr)
+            {
+                bias.first->mark_as_unused();
+            }
+        }
+        _is_prepared = true;
+    }
+
+private:
+    NEGroupedPointwiseKernel                                     _kernel;
+    std::vector<std::unique_ptr<arm_compute::IFunction>>         _replaced;
+    const arm_compute::ITensor                                  *_weights_tensor;
+    std::vector<std::pair<const arm_compute::ITensor *, size_t>> _bias_tensors;
+    std::vector<float>                                           _weights;
+    std::vector<float>                                           _bias;
+    std::vector<unsigned int>                                    _input_channels;
+    unsigned int                                                 _num_groups;
+    bool                                                         _nhwc;
+    bool                                                         _is_prepared;
+};
+
+namespace detail
+{
+inline arm_compute::ITensor *tensor_of(arm_compute::graph::Tensor *tensor)
+{
+    return (tensor != nullptr && tensor->handle() != nullptr) ? &tensor->handle()->tensor() : nullptr;
+}
+
+/** Only consumer of the output of a node, nullptr if it has several */
+inline arm_compute::graph::INode *single_consumer(arm_compute::graph::Graph &g, const arm_compute::graph::INode &node)
+{
+    if(node.output_edges().size() != 1)
+    {
+        return nullptr;
+    }
+    const arm_compute::graph::Edge *edge = g.edge(*node.output_edges().begin());
+    return (edge != nullptr) ? edge->consumer() : nullptr;
+}
+
+inline bool is_pointwise(const arm_compute::graph::INode &node)
+{
+    using namespace arm_compute::graph;
+    const auto                      *conv_node = arm_compute::utils::cast::polymorphic_downcast<const ConvolutionLayerNode *>(&node);
+    const TensorDescriptor           &weights  = conv_node->input(1)->desc();
+    const arm_compute::PadStrideInfo  info     = conv_node->convolution_info();
+    return get_dimension_size(weights, arm_compute::DataLayoutDimension::WIDTH) == 1 && get_dimension_size(weights, arm_compute::DataLayoutDimension::HEIGHT) == 1
+           && info.stride() == std::make_pair(1U, 1U) && !info.has_padding();
+}
+} // namespace detail
+
+/** Returns the convolutions of the groups of a grouped 1x1 convolution
+ *
+ * The frontend builds a grouped convolution as a split of its input along the channels, one
+ * convolution per group, whose weights and biases are split from one constant tensor, and a
+ * concatenation of their outputs. Only the split feeding the input of the groups starts one.
+ *
+ * @param[in] g     Graph
+ * @param[in] split Split node of the grouped convolution
+ *
+ * @return The convolution of every group in order, empty if the split does not start a grouped 1x1 convolution
+ */
+inline std::vector<arm_compute::graph::INode *> get_grouped_pointwise_convolutions(arm_compute::graph::Graph &g, const arm_compute::graph::INode &split)
+{
+    using namespace arm_compute::graph;
+    std::vector<INode *>              groups;
+    const INode                      *concat  = nullptr;
+    const arm_compute::graph::Tensor *weights = nullptr;
+    for(size_t idx = 0; idx < split.num_outputs(); ++idx)
+    {
+        const auto &edges = split.output(idx)->bound_edges();
+        if(edges.size() != 1)
+        {
+            return std::vector<INode *>();
+        }
+        // The weights and bias splits feed the same convolutions, at inputs 1 and 2
+        const Edge *edge  = g.edge(*edges.begin());
+        INode      *group = (edge != nullptr && edge->consumer_idx() == 0) ? edge->consumer() : nullptr;
+        if(group == nullptr || group->type() != NodeType::ConvolutionLayer || !detail::is_pointwise(*group) || get_const_source(g, *group, 1) == nullptr
+           || (weights != nullptr && get_const_source(g, *group, 1) != weights) || (group->input(2) != nullptr && get_const_source(g, *group, 2) == nullptr))
+        {
+            return std::vector<INode *>();
+        }
+        INode *next = detail::single_consumer(g, *group);
+        if(next == nullptr || next->type() != NodeType::ConcatenateLayer || next->num_inputs() != split.num_outputs() || (concat != nullptr && next != concat))
+        {
+            return std::vector<INode *>();
+        }
+        concat  = next;
+        weights = get_const_source(g, *group, 1);
+        groups.push_back(group);
+    }
+    return groups;
+}
+
+/** Checks whether a node is the split of a F32 grouped 1x1 convolution
+ *
+ * @param[in] g    Graph
+ * @param[in] node Node to check, may be nullptr
+ *
+ * @return True if @ref replace_grouped_pointwise() can run the grouped convolution the node starts
+ */
+inline bool is_grouped_pointwise(arm_compute::graph::Graph &g, const arm_compute::graph::INode *node)
+{
+    using namespace arm_compute::graph;
+    return node != nullptr && node->type() == NodeType::SplitLayer && node->num_outputs() > 1 && node->output(0)->desc().data_type == arm_compute::DataType::F32
+           && arm_compute::utils::cast::polymorphic_downcast<const SplitLayerNode *>(node)->axis() == get_dimension_idx(node->input(0)->desc(), arm_compute::DataLayoutDimension::CHANNEL)
+           && !get_grouped_pointwise_convolutions(g, *node).empty();
+}
+
+/** Replaces the tasks of a grouped 1x1 convolution with one @ref NEGroupedPointwiseLayer
+ *
+ * The tasks of the split, the groups and the concatenation (the split and the concatenation have
+ * none when they are run as sub-tensors) are dropped and the last one runs the new function. Its task
+ * is attached to the concatenation, which is then fed from the input of the split, so that the
+ * transition memory manager keeps that input alive until the task runs.
+ *
+ * @param[in,out] g              Graph of the workload
+ * @param[in,out] workload       Workload whose functions are configured and constant tensors filled
+ * @param[in]     split_id       Split node of the grouped convolution
+ * @param[in]     input_channels (Optional) Input channel read as each input channel of the groups, the identity if empty
+ *
+ * @return True if the grouped convolution was replaced, false if it is not a NEON grouped 1x1 convolution with tasks
+ */
+inline bool replace_grouped_pointwise(arm_compute::graph::Graph &g, arm_compute::graph::ExecutionWorkload &workload, arm_compute::graph::NodeID split_id,
+                                      std::vector<unsigned int> input_channels = std::vector<unsigned int>())
+{
+    using namespace arm_compute::graph;
+
+    INode *split = g.node(split_id);
+    if(!is_grouped_pointwise(g, split) || split->assigned_target() != Target::NEON)
+    {
+        return false;
+    }
+    const std::vector<INode *> groups = get_grouped_pointwise_convolutions(g, *split);
+    INode                     *concat = detail::single_consumer(g, *groups.front());
+
+    // Take the tasks of the split, the groups and the concatenation
+    std::vector<const INode *> nodes(groups.begin(), groups.end());
+    nodes.push_back(split);
+    nodes.push_back(concat);
+    std::vector<size_t> positions;
+    for(size_t i = 0; i < workload.tasks.size(); ++i)
+    {
+        if(std::find(nodes.begin(), nodes.end(), workload.tasks[i].node) != nodes.end())
+        {
+            positions.push_back(i);
+        }
+    }
+    if(positions.empty())
+    {
+        return false;
+    }
+
+    // Bias of every group, from the split bias of the grouped convolution or its own
+    const size_t                                                 group_outputs = get_dimension_size(groups.front()->output(0)->desc(), arm_compute::DataLayoutDimension::CHANNEL);
+    std::vector<std::pair<const arm_compute::ITensor *, size_t>> biases;
+    for(size_t group = 0; group < groups.size(); ++group)
+    {
+        arm_compute::graph::Tensor *bias = (groups[group]->input(2) != nullptr) ? get_const_source(g, *groups[group], 2) : nullptr;
+        biases.emplace_back(detail::tensor_of(bias), (bias != nullptr && bias->desc().shape.total_size() > group_outputs) ? group * group_outputs : 0);
+    }
+
+    std::vector<std::unique_ptr<arm_compute::IFunction>> replaced;
+    for(size_t position : positions)
+    {
+        replaced.push_back(std::move(workload.tasks[position].task));
+    }
+    auto layer = arm_compute::support::cpp14::make_unique<NEGroupedPointwiseLayer>();
+    layer->configure(detail::tensor_of(split->input(0)), detail::tensor_of(get_const_source(g, *groups.front(), 1)), std::move(biases), detail::tensor_of(concat->output(0)),
+                     groups.size(), std::move(input_channels), std::move(replaced));
+    workload.tasks[positions.back()].task = std::move(layer);
+    workload.tasks[positions.back()].node = concat;
+    for(auto position = positions.rbegin() + 1; position != positions.rend(); ++position)
+    {
+        workload.tasks.erase(workload.tasks.begin() + *position);
+    }
+
+    // Feed the concatenation from the input of the split, keeping the descriptor of its output
+    const Edge            *input_edge  = g.edge(split->input_edge_id(0));
+    const TensorDescriptor output_desc = concat->output(0)->desc();
+    g.remove_connection(concat->input_edge_id(0));
+    g.add_connection(input_edge->producer_id(), input_edge->producer_idx(), concat->id(), 0);
+    concat->output(0)->desc() = output_desc;
+    return true;
+}
+
+/** Runs every F32 grouped 1x1 convolution of a graph with @ref NEGroupedPointwiseLayer
+ *
+ * Once the functions are configured and the constant tensors filled, mutate() replaces the split,
+ * the convolution of every group and the concatenation of each grouped 1x1 convolution left in the
+ * graph with one function. The grouped convolutions already fused with a channel shuffle are skipped,
+ * so this mutator runs after @ref ChannelShuffleMutator.
+ */
+class GroupedConvMutator final : public IWorkloadMutator
+{
+public:
+    /** Default constructor */
+    GroupedConvMutator()
+        : _batched(0)
+    {
+    }
+    /** Number of grouped convolutions batched by the last call to mutate() */
+    unsigned int batched() const
+    {
+        return _batched;
+    }
+
+    // Inherited methods overridden:
+    void mutate(arm_compute::graph::Graph &g, arm_compute::graph::ExecutionWorkload &workload) override
+    {
+        using namespace arm_compute::graph;
+
+        _batched = 0;
+        std::vector<NodeID> splits;
+        for(auto &node : g.nodes())
+        {
+            if(is_grouped_pointwise(g, node.get()))
+            {
+                splits.push_back(node->id());
+            }
+        }
+        for(NodeID split : splits)
+        {
+            if(replace_grouped_pointwise(g, workload, split))
+            {
+                ++_batched;
+            }
+        }
+    }
+
+private:
+    unsigned int _batched;
+};
+
+/** Prepares the execution of the grouped 1x1 convolutions of a graph
+ *
+ * @param[in] mode How to execute the grouped convolutions
+ *
+ * @return The mutator to pass to @ref GraphExecutor::finalize(), nullptr in the split mode
+ */
+inline std::unique_ptr<IWorkloadMutator> apply_grouped_conv_mode(GroupedConvMode mode)
+{
+    if(mode == GroupedConvMode::Split)
+    {
+        return nullptr;
+    }
+    return std::unique_ptr<IWorkloadMutator>(arm_compute::support::cpp14::make_unique<GroupedConvMutator>());
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_GROUPED_POINTWISE_H__ */
@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_LATENCY_PREDICTOR_H__
+#define __WIDTH_MULTIPLIED_LATENCY_PREDICTOR_H__
+
+#include "arm_compute/graph.h"
+#include "arm_compute/graph/TypePrinter.h"
+#include "utils/CommonGraphOptions.h"
+
+#include "common/GraphBuilders.h"
+#include "common/GraphCost.h"
+#include "common/GraphExecutor.h"
+#include "common/SweepUtils.h"
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace width_multiplied
+{
+/** A layer of a graph with its operator type and analytical cost */
+struct LayerFeatures
+{
+    std::string type{}; /**< Operator type */
+    LayerCost   cost{}; /**< Analytical cost */
+};
+
+/** A measured layer, as read back from a per-layer CSV */
+struct LayerSample
+{
+    GraphVariant  variant{};    /**< Variant the layer belongs to */
+    LayerFeatures features{};   /**< Type and cost of the layer */
+    double        time_ms{ 0 }; /**< Measured mean time of the layer */
+};
+
+/** Returns the key identifying a variant in the maps below
+ *
+ * @param[in] variant Graph variant
+ *
+ * @return The variant as printed by operator<<
+ */
+inline std::string variant_key(const GraphVariant &variant)
+{
+    std::stringstream ss;
+    ss << variant;
+    return ss.str();
+}
+
+/** Splits a CSV line on commas (fields are not quoted in the files written by the sweeps)
+ *
+ * @param[in] line Line to split
+ *
+ * @return The fields of the line
+ */
+inline std::vector<std::string> split_csv_line(const std::string &line)
+{
+    std::vector<std::string> fields;
+    std::stringstream        ss(line);
+    std::string              field;
+    while(std::getline(ss, field, ','))
+    {
+        fields.push_back(field);
+    }
+    return fields;
+}
+
+/** Reads a CSV file into rows of named fields
+ *
+ * Lines starting with '#' are skipped, the first remaining line is the header.
+ *
+ * @param[in]  filename Input file
+ * @param[out] rows     Rows read, appended
+ *
+ * @return True on success
+ */
+inline bool read_csv_rows(const std::string &filename, std::vector<std::map<std::string, std::string>> &rows)
+{
+    std::ifstream ifs(filename);
+    if(!ifs.is_open())
+    {
+        std::cerr << "Cannot open " << filename << " for reading" << std::endl;
+        return false;
+    }
+    std::vector<std::string> header;
+    std::string              line;
+    while(std::getline(ifs, line))
+    {
+        if(line.empty() || line[0] == '#')
+        {
+            continue;
+        }
+        const std::vector<std::string> fields = split_csv_line(line);
+        if(header.empty())
+        {
+            header = fields;
+            continue;
+        }
+        std::map<std::string, std::string> row;
+        for(size_t i = 0; i < std::min(header.size(), fields.size()); ++i)
+        {
+            row[header[i]] = fields[i];
+        }
+        rows.push_back(row);
+    }
+    return true;
+}
+
+/** Reads the layers measured by a sweep run with --layer-csv
+ *
+ * @param[in]  filename Per-layer CSV file
+ * @param[out] samples  Layers read, appended
+ *
+ * @return True on success
+ */
+inline bool read_layer_samples(const std::string &filename, std::vector<LayerSample> &samples)
+{
+    std::vector<std::map<std::string, std::string>> rows;
+    if(!read_csv_rows(filename, rows))
+    {
+        return false;
+    }
+    for(auto &row : rows)
+    {
+        LayerSample sample;
+        sample.variant.model                  = row["model"];
+        sample.variant.width                  = std::stof(row["width"]);
+        sample.variant.resolution             = std::stoul(row["resolution"]);
+        sample.variant.rounding               = row["rounding"].empty() ? ChannelRounding() : parse_channel_rounding(row["rounding"]);
+        sample.variant.batch                  = row["batch"].empty() ? 1U : std::stoul(row["batch"]);
+        sample.variant.batch_norm             = row["batch_norm"] == "folded" ? BatchNormMode::Folded : BatchNormMode::Unfused;
+        sample.variant.dwsc_fusion            = row["fused_dwsc"].empty() ? DwscFusion() : parse_dwsc_fusion(row["fused_dwsc"]);
+        sample.variant.channel_shuffle        = parse_channel_shuffle_mode(row["channel_shuffle"]);
+        sample.variant.grouped_conv           = parse_grouped_conv_mode(row["grouped_conv"]);
+        sample.variant.asymmetric_conv        = parse_asymmetric_conv_mode(row["asymmetric_conv"]);
+        sample.features.type                  = row["type"];
+        sample.features.cost.macs             = std::stoull(row["macs"]);
+        sample.features.cost.params           = std::stoull(row["params"]);
+        sample.features.cost.input_bytes      = std::stoull(row["input_bytes"]);
+        sample.features.cost.activation_bytes = std::stoull(row["activation_bytes"]);
+        sample.features.cost.weight_bytes     = std::stoull(row["weight_bytes"]);
+        sample.time_ms                        = std::stod(row["mean_ms"]);
+        samples.push_back(sample);
+    }
+    return true;
+}
+
+/** Reads the end-to-end median latencies of a sweep run with --csv
+ *
+ * @param[in]  filename  Summary CSV file
+ * @param[out] latencies Median latency of every variant, keyed by variant_key()
+ *
+ * @return True on success
+ */
+inline bool read_sweep_latencies(const std::string &filename, std::map<std::string, double> &latencies)
+{
+    std::vector<std::map<std::string, std::string>> rows;
+    if(!read_csv_rows(filename, rows))
+    {
+        return false;
+    }
+    for(auto &row : rows)
+    {
+        GraphVariant variant;
+        variant.model                   = row["model"];
+        variant.width                   = std::stof(row["width"]);
+        variant.resolution              = std::stoul(row["resolution"]);
+        variant.rounding                = row["rounding"].empty() ? ChannelRounding() : parse_channel_rounding(row["rounding"]);
+        variant.batch                   = row["batch"].empty() ? 1U : std::stoul(row["batch"]);
+        variant.batch_norm              = row["batch_norm"] == "folded" ? BatchNormMode::Folded : BatchNormMode::Unfused;
+        variant.dwsc_fusion             = row["fused_dwsc"].empty() ? DwscFusion() : parse_dwsc_fusion(row["fused_dwsc"]);
+        variant.channel_shuffle         = parse_channel_shuffle_mode(row["channel_shuffle"]);
+        variant.grouped_conv            = parse_grouped_conv_mode(row["grouped_conv"]);
+        variant.asymmetric_conv         = parse_asymmetric_conv_mode(row["asymmetric_conv"]);
+        latencies[variant_key(variant)] = std::stod(row["median_ms"]);
+    }
+    return true;
+}
+
+/** Builds a variant and returns the layers it would be executed with, without running it
+ *
+ * @param[in] common_params Common graph parameters
+ * @param[in] variant       Variant to analyze
+ *
+ * @return One entry per node of the mutated graph, input, output and constant nodes excluded
+ */
+inline std::vector<LayerFeatures> analyze_variant(const arm_compute::utils::CommonGraphParams &common_params, const GraphVariant &variant)
+{
+    arm_compute::graph::frontend::Stream graph(0, get_graph_name(variant.model));
+    create_graph(graph, common_params, variant);
+    arm_compute::graph::PassManager pm = arm_compute::graph::create_default_pass_manager(common_params.target);
+    prepare_graph(graph.graph(), common_params.target, pm);
+
+    std::vector<LayerFeatures> layers;
+    for(const auto &node : graph.graph().nodes())
+    {
+        if(node == nullptr || node->type() == arm_compute::graph::NodeType::Input || node->type() == arm_compute::graph::NodeType::Output
+           || node->type() == arm_compute::graph::NodeType::Const)
+        {
+            continue;
+        }
+        std::stringstream type;
+        type << node->type();
+
+        LayerFeatures layer;
+        layer.type = type.str();
+        layer.cost = compute_node_cost(*node);
+        layers.push_back(layer);
+    }
+    return layers;
+}
+
+/** Per-layer latency model fitted on measured sweeps
+ *
+ * The time of a layer is modelled, per operator type, as a linear function of its MACs, input
+ * bytes, output bytes and weight bytes plus a constant, which captures the compute work, the
+ * channel count and the spatial size of the layer. Types with too few samples for a least squares
+ * fit fall back to a time proportional to their memory traffic. The end-to-end latency is the sum
+ * of the layer times scaled by the ratio, fitted on the measured graphs, between the end-to-end
+ * latency and the sum of the profiled layer times (which covers the gaps between layers and the
+ * profiling overhead).
+ */
+class LatencyPredictor
+{
+public:
+    /** Number of coefficients of the model of each operator type */
+    static constexpr size_t num_features = 5;
+    /** Coefficients of the model of an operator type */
+    using Coefficients = std::array<double, num_features>;
+
+    /** Default constructor */
+    LatencyPredictor()
+        : _coefficients(), _samples(), _scale(1.0)
+    {
+    }
+    /** Fits the model
+     *
+     * @param[in] samples   Measured layers
+     * @param[in] latencies (Optional) Measured end-to-end latencies, keyed by variant_key(). The scale stays 1 without them
+     */
+    void fit(const std::vector<LayerSample> &samples, const std::map<std::string, double> &latencies = std::map<std::string, double>())
+    {
+        std::map<std::string, std::vector<const LayerSample *>> by_type;
+        std::map<std::string, double>                           layer_sums;
+        for(const auto &sample : samples)
+        {
+            by_type[sample.features.type].push_back(&sample);
+            layer_sums[variant_key(sample.variant)] += sample.time_ms;
+        }
+
+        _coefficients.clear();
+        _samples.clear();
+        for(const auto &type : by_type)
+        {
+            _coefficients[type.first] = (type.second.size() >= 2 * num_features) ? fit_least_squares(type.second) : fit_traffic(type.second);
+            _samples[type.first]      = type.second.size();
+        }
+
+        // Least squares scale through the origin between the summed layer times and the end-to-end latencies
+        double num = 0;
+        double den = 0;
+        for(const auto &sum : layer_sums)
+        {
+            const auto latency = latencies.find(sum.first);
+            if(latency != latencies.end())
+            {
+                num += latency->second * sum.second;
+                den += sum.second * sum.second;
+            }
+        }
+        _scale = (den > 0) ? num / den : 1.0;
+    }
+    /** Predicts the time of a layer
+     *
+     * @param[in] layer Layer to predict
+     *
+     * @return Predicted time in milliseconds, 0 for operator types never measured (e.g. concatenations done with sub-tensors)
+     */
+    double predict_layer(const LayerFeatures &layer) const
+    {
+        const auto it = _coefficients.find(layer.type);
+        if(it == _coefficients.end())
+        {
+            return 0;
+        }
+        const Coefficients x = features(layer.cost);
+        double             t = 0;
+        for(size_t i = 0; i < num_features; ++i)
+        {
+            t += it->second[i] * x[i];
+        }
+        return std::max(t, 0.0);
+    }
+    /** Predicts the end-to-end latency of a graph
+     *
+     * @param[in] layers Layers of the graph
+     *
+     * @return Predicted latency in milliseconds
+     */
+    double predict(const std::vector<LayerFeatures> &layers) const
+    {
+        double t = 0;
+        for(const auto &layer : layers)
+        {
+            t += predict_layer(layer);
+        }
+        return t * _scale;
+    }
+    /** Ratio between the end-to-end latency and the sum of the layer times */
+    double scale() const
+    {
+        return _scale;
+    }
+    /** Prints the coefficients of every operator type
+     *
+     * @param[out] os Output stream
+     */
+    void print(std::ostream &os) const
+    {
+        const std::ios_base::fmtflags flags = os.flags();
+        os << std::left << std::setw(28) << "type" << std::right << std::setw(8) << "samples" << std::setw(12) << "ms/MMAC" << std::setw(12) << "ms/MB in"
+           << std::setw(12) << "ms/MB out" << std::setw(12) << "ms/MB wei" << std::setw(12) << "ms" << std::endl;
+        for(const auto &type : _coefficients)
+        {
+            os << std::left << std::setw(28) << type.first << std::right << std::setw(8) << _samples.at(type.first) << std::scientific << std::setprecision(3);
+            for(double c : type.second)
+            {
+                os << std::setw(12) << c;
+            }
+            os << std::endl;
+            os.flags(flags);
+        }
+        os << "End-to-end scale : " << _scale << std::endl;
+        os.flags(flags);
+    }
+
+private:
+    static Coefficients features(const LayerCost &cost)
+    {
+        return Coefficients{ { cost.macs / 1e6, cost.input_bytes / 1e6, cost.activation_bytes / 1e6, cost.weight_bytes / 1e6, 1.0 } };
+    }
+
+    static Coefficients fit_least_squares(const std::vector<const LayerSample *> &samples)
+    {
+        // Normal equations (X^T X + lambda I) c = X^T t, with a small ridge term to keep them solvable
+        // when a feature is constant within a type (e.g. no weights for pooling layers)
+        double a[num_features][num_features + 1] = {};
+        for(const auto *sample : samples)
+        {
+            const Coefficients x = features(sample->features.cost);
+            for(size_t i = 0; i < num_features; ++i)
+            {
+                for(size_t j = 0; j < num_features; ++j)
+                {
+                    a[i][j] += x[i] * x[j];
+                }
+                a[i][num_features] += x[i] * sample->time_ms;
+            }
+        }
+        double max_diag = 0;
+        for(size_t i = 0; i < num_features; ++i)
+        {
+            max_diag = std::max(max_diag, a[i][i]);
+        }
+        for(size_t i = 0; i < num_features; ++i)
+        {
+            a[i][i] += 1e-9 * max_diag + 1e-12;
+        }
+
+        // Gaussian elimination with partial pivoting
+        for(size_t col = 0; col < num_features; ++col)
+        {
+            size_t pivot = col;
+            for(size_t row = col + 1; row < num_features; ++row)
+            {
+                if(std::fabs(a[row][col]) > std::fabs(a[pivot][col]))
+                {
+                    pivot = row;
+                }
+            }
+            for(size_t k = 0; k <= num_features; ++k)
+            {
+                std::swap(a[col][k], a[pivot][k]);
+            }
+            for(size_t row = col + 1; row < num_features; ++row)
+            {
+                const double f = a[row][col] / a[col][col];
+                for(size_t k = col; k <= num_features; ++k)
+                {
+                    a[row][k] -= f * a[col][k];
+                }
+            }
+        }
+        Coefficients c{};
+        for(size_t i = num_features; i-- > 0;)
+        {
+            double v = a[i][num_features];
+            for(size_t k = i + 1; k < num_features; ++k)
+            {
+                v -= a[i][k] * c[k];
+            }
+            c[i] = v / a[i][i];
+        }
+        return c;
+    }
+
+    static Coefficients fit_traffic(const std::vector<const LayerSample *> &samples)
+    {
+        double time    = 0;
+        double traffic = 0;
+        for(const auto *sample : samples)
+        {
+            time += sample->time_ms;
+            traffic += sample->features.cost.traffic_bytes() / 1e6;
+        }
+        Coefficients c{};
+        if(traffic > 0)
+        {
+            c[1] = c[2] = c[3] = time / traffic;
+        }
+        else
+        {
+            c[4] = time / samples.size();
+        }
+        return c;
+    }
+
+    std::map<std::string, Coefficients> _coefficients;
+    std::map<std::string, size_t>       _samples;
+    double                              _scale;
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_LATENCY_PREDICTOR_H__ */
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_LATENCY_STATS_H__
+#define __WIDTH_MULTIPLIED_LATENCY_STATS_H__
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Summary statistics of a set of latency samples (all values in milliseconds) */
+struct LatencyStats
+{
+    size_t count{ 0 };     /**< Number of samples */
+    double min{ 0 };       /**< Fastest sample */
+    double max{ 0 };       /**< Slowest sample */
+    double mean{ 0 };      /**< Arithmetic mean */
+    double median{ 0 };    /**< 50th percentile */
+    double p90{ 0 };       /**< 90th percentile */
+    double p99{ 0 };       /**< 99th percentile */
+    double stddev{ 0 };    /**< Sample standard deviation */
+    double ci95_low{ 0 };  /**< Lower bound of the 95% confidence interval of the mean */
+    double ci95_high{ 0 }; /**< Upper bound of the 95% confidence interval of the mean */
+};
+
+/** Returns a percentile of sorted samples using linear interpolation between closest ranks
+ *
+ * @param[in] sorted_samples Samples sorted in ascending order
+ * @param[in] percentile     Percentile in the range [0, 100]
+ *
+ * @return Interpolated percentile, 0 if there are no samples
+ */
+inline double percentile(const std::vector<double> &sorted_samples, double percentile)
+{
+    if(sorted_samples.empty())
+    {
+        return 0.0;
+    }
+    const double rank  = (percentile / 100.0) * (sorted_samples.size() - 1);
+    const size_t lower = static_cast<size_t>(std::floor(rank));
+    const size_t upper = std::min(lower + 1, sorted_samples.size() - 1);
+    const double frac  = rank - lower;
+    return sorted_samples[lower] + frac * (sorted_samples[upper] - sorted_samples[lower]);
+}
+
+/** Two-sided 95% Student's t critical value
+ *
+ * @param[in] degrees_of_freedom Degrees of freedom (number of samples - 1)
+ *
+ * @return Critical value, converging to the normal 1.96 for large samples
+ */
+inline double t_critical_95(size_t degrees_of_freedom)
+{
+    static const double table[] =
+    {
+        12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262, 2.228,
+        2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093, 2.086,
+        2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045, 2.042
+    };
+    if(degrees_of_freedom == 0)
+    {
+        return 0.0;
+    }
+    if(degrees_of_freedom <= 30)
+    {
+        return table[degrees_of_freedom - 1];
+    }
+    return degrees_of_freedom <= 60 ? 2.000 : (degrees_of_freedom <= 120 ? 1.980 : 1.960);
+}
+
+/** Computes the summary statistics of a set of latency samples
+ *
+ * @param[in] samples Latency samples in milliseconds
+ *
+ * @return Summary statistics
+ */
+inline LatencyStats compute_latency_stats(const std::vector<double> &samples)
+{
+    LatencyStats stats;
+    stats.count = samples.size();
+    if(samples.empty())
+    {
+        return stats;
+    }
+
+    std::vector<double> sorted(samples);
+    std::sort(sorted.begin(), sorted.end());
+
+    stats.min    = sorted.front();
+    stats.max    = sorted.back();
+    stats.mean   = std::accumulate(sorted.begin(), sorted.end(), 0.0) / sorted.size();
+    stats.median = percentile(sorted, 50.0);
+    stats.p90    = percentile(sorted, 90.0);
+    stats.p99    = percentile(sorted, 99.0);
+
+    if(sorted.size() > 1)
+    {
+        double sum_sq = 0.0;
+        for(double sample : sorted)
+        {
+            sum_sq += (sample - stats.mean) * (sample - stats.mean);
+        }
+        stats.stddev = std::sqrt(sum_sq / (sorted.size() - 1));
+    }
+
+    const double half_width = t_critical_95(sorted.size() - 1) * stats.stddev / std::sqrt(static_cast<double>(sorted.size()));
+    stats.ci95_low          = stats.mean - half_width;
+    stats.ci95_high         = stats.mean + half_width;
+
+    return stats;
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_LATENCY_STATS_H__ */
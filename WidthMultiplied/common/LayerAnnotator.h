@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_LAYER_ANNOTATOR_H__
+#define __WIDTH_MULTIPLIED_LAYER_ANNOTATOR_H__
+
+#include "arm_compute/graph.h"
+#include "arm_compute/graph/TypePrinter.h"
+
+#include "common/GraphExecutor.h"
+
+#include <streamline_annotate.h>
+
+#include <chrono>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Emits a Streamline annotation for every task of a graph run
+ *
+ * Every operator type gets its own channel in the "Layers" group and its own colour, and each task
+ * is annotated on its channel with the name of its node, so the Streamline timeline shows one
+ * labelled block per layer. The wall time of every layer is also reported through the
+ * "Layer time (us)" absolute counter.
+ * OpenCL tasks only enqueue their kernels: unless the queue is flushed after every task (as done by
+ * the LayerProfiler) the blocks show the enqueue time, not the execution time.
+ */
+class LayerAnnotator final : public ITaskListener
+{
+public:
+    /** Constructor
+     *
+     * @param[in] workload Workload of the finalized graph to annotate
+     */
+    explicit LayerAnnotator(const arm_compute::graph::ExecutionWorkload &workload)
+        : _layers(), _start()
+    {
+        static const uint32_t colors[] =
+        {
+            ANNOTATE_RED, ANNOTATE_BLUE, ANNOTATE_GREEN, ANNOTATE_PURPLE, ANNOTATE_YELLOW, ANNOTATE_CYAN, ANNOTATE_LTGRAY, ANNOTATE_DKGRAY
+        };
+        const size_t num_colors = sizeof(colors) / sizeof(colors[0]);
+
+        ANNOTATE_NAME_GROUP(layers_group, "Layers");
+        ANNOTATE_ABSOLUTE_COUNTER(layer_time_counter, "Layers", "Layer time (us)");
+
+        std::map<std::string, uint32_t> channels;
+        for(const auto &task : workload.tasks)
+        {
+            const arm_compute::graph::INode *node = task.node;
+            if(node == nullptr)
+            {
+                continue;
+            }
+
+            std::stringstream type;
+            type << node->type();
+
+            // Channel 0 is used by the whole-graph annotations
+            auto it = channels.find(type.str());
+            if(it == channels.end())
+            {
+                it = channels.emplace(type.str(), static_cast<uint32_t>(channels.size() + 1)).first;
+                ANNOTATE_NAME_CHANNEL(it->second, layers_group, it->first.c_str());
+            }
+
+            LayerChannel layer;
+            layer.name    = node->name().empty() ? type.str() + "_" + std::to_string(node->id()) : node->name();
+            layer.channel = it->second;
+            layer.color   = colors[(it->second - 1) % num_colors];
+            _layers[node] = layer;
+        }
+    }
+    // Inherited methods overridden:
+    void on_task_start(const arm_compute::graph::ExecutionTask &task) override
+    {
+        const auto it = _layers.find(task.node);
+        if(it != _layers.end())
+        {
+            ANNOTATE_CHANNEL_COLOR(it->second.channel, it->second.color, it->second.name.c_str());
+        }
+        _start = std::chrono::steady_clock::now();
+    }
+    void on_task_end(const arm_compute::graph::ExecutionTask &task) override
+    {
+        const auto it = _layers.find(task.node);
+        if(it != _layers.end())
+        {
+            ANNOTATE_CHANNEL_END(it->second.channel);
+            ANNOTATE_COUNTER_VALUE(layer_time_counter, std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - _start).count());
+        }
+    }
+
+private:
+    struct LayerChannel
+    {
+        std::string name{};
+        uint32_t    channel{ 0 };
+        uint32_t    color{ 0 };
+    };
+
+    static constexpr uint32_t layers_group       = 1;
+    static constexpr uint32_t layer_time_counter = 1;
+
+    std::map<const arm_compute::graph::INode *, LayerChannel> _layers;
+    std::chrono::steady_clock::time_point                     _start;
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_LAYER_ANNOTATOR_H__ */
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_LAYER_PROFILER_H__
+#define __WIDTH_MULTIPLIED_LAYER_PROFILER_H__
+
+#include "arm_compute/graph.h"
+#include "arm_compute/graph/TypePrinter.h"
+#include "arm_compute/runtime/CL/CLScheduler.h"
+
+#include "common/GraphCost.h"
+#include "common/GraphExecutor.h"
+#include "common/LatencyStats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iomanip>
+#include <map>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Timings of one layer of a graph */
+struct LayerProfile
+{
+    std::string         name{};         /**< Layer name, as given by set_name() */
+    std::string         type{};         /**< Operator type */
+    std::string         output_shape{}; /**< Shape of the first output */
+    std::string         kernel{};       /**< Kernel size "WxH" of the convolutions, empty for the other layers */
+    std::vector<double> samples_ms{};   /**< Time spent in the layer in every profiled run */
+    LatencyStats        stats{};        /**< Summary of the profiled runs */
+    double              share{ 0 };     /**< Share of the summed mean time of all layers */
+    LayerCost           cost{};         /**< Analytical cost of the layer */
+};
+
+/** Formats a tensor shape as "WxHxCxN"
+ *
+ * @param[in] shape Shape to format
+ *
+ * @return The formatted shape
+ */
+inline std::string shape_to_string(const arm_compute::TensorShape &shape)
+{
+    std::stringstream ss;
+    for(size_t i = 0; i < shape.num_dimensions(); ++i)
+    {
+        ss << (i == 0 ? "" : "x") << shape[i];
+    }
+    return ss.str();
+}
+
+/** Times every task of a graph run
+ *
+ * Each task maps to one node of the graph, so the timings are keyed by the node names given with
+ * set_name(). Layers fused away by the graph passes (e.g. an activation merged into a convolution)
+ * do not get a task of their own and are accounted in the layer they were fused into.
+ * On OpenCL the queue is flushed after every task, which serializes the kernels: the per-layer
+ * times add up to more than an unprofiled run.
+ */
+class LayerProfiler final : public ITaskListener
+{
+public:
+    /** Constructor
+     *
+     * @param[in] workload Workload of the finalized graph to profile
+     * @param[in] target   Execution target of the graph
+     */
+    LayerProfiler(const arm_compute::graph::ExecutionWorkload &workload, arm_compute::graph::Target target)
+        : _target(target), _layers(), _indices(), _current(0), _start()
+    {
+        for(const auto &task : workload.tasks)
+        {
+            const arm_compute::graph::INode *node = task.node;
+            if(node == nullptr)
+            {
+                continue;
+            }
+
+            std::stringstream type;
+            type << node->type();
+
+            LayerProfile layer;
+            layer.type = type.str();
+            layer.name = node->name().empty() ? layer.type + "_" + std::to_string(node->id()) : node->name();
+            if(node->num_outputs() > 0 && node->output(0) != nullptr)
+            {
+                layer.output_shape = shape_to_string(node->output(0)->desc().shape);
+            }
+            if((node->type() == arm_compute::graph::NodeType::ConvolutionLayer || node->type() == arm_compute::graph::NodeType::DepthwiseConvolutionLayer) && node->input(1) != nullptr)
+            {
+                const arm_compute::graph::TensorDescriptor &weights = node->input(1)->desc();
+                layer.kernel = std::to_string(arm_compute::graph::get_dimension_size(weights, arm_compute::DataLayoutDimension::WIDTH)) + "x"
+                               + std::to_string(arm_compute::graph::get_dimension_size(weights, arm_compute::DataLayoutDimension::HEIGHT));
+            }
+            layer.cost = compute_node_cost(*node);
+            _indices[node] = _layers.size();
+            _layers.push_back(layer);
+        }
+    }
+    // Inherited methods overridden:
+    void on_task_start(const arm_compute::graph::ExecutionTask &task) override
+    {
+        const auto it = _indices.find(task.node);
+        _current      = (it != _indices.end()) ? it->second : _layers.size();
+        _start        = std::chrono::steady_clock::now();
+    }
+    void on_task_end(const arm_compute::graph::ExecutionTask &task) override
+    {
+        ARM_COMPUTE_UNUSED(task);
+        if(_target == arm_compute::graph::Target::CL)
+        {
+            arm_compute::CLScheduler::get().sync();
+        }
+        if(_current < _layers.size())
+        {
+            _layers[_current].samples_ms.push_back(std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - _start).count());
+        }
+    }
+    /** Summarizes the runs profiled so far
+     *
+     * @return One entry per layer, in execution order
+     */
+    std::vector<LayerProfile> layers() const
+    {
+        std::vector<LayerProfile> layers = _layers;
+        double                    total  = 0;
+        for(auto &layer : layers)
+        {
+            layer.stats = compute_latency_stats(layer.samples_ms);
+            total += layer.stats.mean;
+        }
+        for(auto &layer : layers)
+        {
+            layer.share = (total > 0) ? layer.stats.mean / total : 0;
+        }
+        return layers;
+    }
+
+private:
+    arm_compute::graph::Target                          _target;
+    std::vector<LayerProfile>                           _layers;
+    std::map<const arm_compute::graph::INode *, size_t> _indices;
+    size_t                                              _current;
+    std::chrono::steady_clock::time_point               _start;
+};
+
+/** Prints one line per layer
+ *
+ * @param[out] os     Output stream
+ * @param[in]  layers Layer profiles
+ */
+inline void print_layer_profile(std::ostream &os, const std::vector<LayerProfile> &layers)
+{
+    size_t name_width = 4;
+    for(const auto &layer : layers)
+    {
+        name_width = std::max(name_width, layer.name.size());
+    }
+
+    const std::ios_base::fmtflags flags = os.flags();
+    os << std::left << std::setw(name_width + 2) << "name" << std::setw(28) << "type" << std::setw(20) << "output"
+       << std::right << std::setw(10) << "mean" << std::setw(10) << "median" << std::setw(9) << "share" << std::setw(10) << "MMACs" << std::setw(10) << "GFLOP/s" << std::endl;
+    for(const auto &layer : layers)
+    {
+        os << std::left << std::setw(name_width + 2) << layer.name << std::setw(28) << layer.type << std::setw(20) << layer.output_shape
+           << std::right << std::fixed << std::setprecision(3) << std::setw(10) << layer.stats.mean << std::setw(10) << layer.stats.median
+           << std::setprecision(1) << std::setw(8) << layer.share * 100.f << "%"
+           << std::setprecision(2) << std::setw(10) << layer.cost.macs / 1e6 << std::setw(10) << gflops_per_second(layer.cost.macs, layer.stats.median) << std::endl;
+        os.flags(flags);
+    }
+    os.flags(flags);
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_LAYER_PROFILER_H__ */
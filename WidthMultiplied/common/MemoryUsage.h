@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_MEMORY_USAGE_H__
+#define __WIDTH_MULTIPLIED_MEMORY_USAGE_H__
+
+#include <cstdint>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include <malloc.h>
+
+namespace width_multiplied
+{
+/** Memory used by one configuration of a sweep */
+struct MemoryUsage
+{
+    uint64_t estimated_bytes{ 0 };    /**< Weights and intermediate tensors without reuse, estimated before allocating the graph */
+    uint64_t weight_bytes{ 0 };       /**< Bytes of the constant tensors */
+    uint64_t intermediate_bytes{ 0 }; /**< Bytes of every intermediate tensor, as if none shared its memory */
+    uint64_t graph_heap_bytes{ 0 };   /**< Heap held by the finalized graph: tensors, memory manager pools and function workspaces */
+    uint64_t peak_rss_bytes{ 0 };     /**< Peak resident set size of the process while building and running the graph */
+    uint64_t rss_bytes{ 0 };          /**< Resident set size of the process after the timed runs */
+    bool     peak_reset{ false };     /**< False if the peak could not be reset and covers the whole process lifetime */
+
+    /** Bytes of the intermediate tensors over the heap they actually take
+     *
+     * The heap of the graph minus its weights holds the intermediate tensors, in the pools of the
+     * memory managers, and the workspaces of the functions, so the ratio is a lower bound of the
+     * reuse of the intermediate buffers.
+     *
+     * @return The reuse ratio, 0 if the heap of the graph is not larger than its weights
+     */
+    double reuse_ratio() const
+    {
+        return (graph_heap_bytes > weight_bytes) ? static_cast<double>(intermediate_bytes) / (graph_heap_bytes - weight_bytes) : 0.0;
+    }
+};
+
+/** Returns the bytes of heap in use by the process, including the large blocks malloc maps on their own */
+inline uint64_t heap_in_use_bytes()
+{
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+    const struct mallinfo2 info = mallinfo2();
+#else  /* defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33)) */
+    const struct mallinfo info = mallinfo();
+#endif /* defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33)) */
+    return static_cast<uint64_t>(info.uordblks) + static_cast<uint64_t>(info.hblkhd);
+}
+
+/** Reads a size from a /proc file of the form "<field>: <value> kB"
+ *
+ * @param[in] filename File to read, e.g. /proc/self/status
+ * @param[in] field    Field to read, e.g. VmHWM
+ *
+ * @return The size in bytes, 0 if the field is missing
+ */
+inline uint64_t read_proc_bytes(const std::string &filename, const std::string &field)
+{
+    std::ifstream ifs(filename);
+    std::string   line;
+    while(std::getline(ifs, line))
+    {
+        if(line.compare(0, field.size() + 1, field + ":") == 0)
+        {
+            std::stringstream ss(line.substr(field.size() + 1));
+            uint64_t          kb = 0;
+            ss >> kb;
+            return kb * 1024;
+        }
+    }
+    return 0;
+}
+
+/** Returns the peak resident set size of the process since it started or since the last reset_peak_rss() */
+inline uint64_t peak_rss_bytes()
+{
+    return read_proc_bytes("/proc/self/status", "VmHWM");
+}
+
+/** Returns the resident set size of the process */
+inline uint64_t rss_bytes()
+{
+    return read_proc_bytes("/proc/self/status", "VmRSS");
+}
+
+/** Resets the peak resident set size of the process to its current resident set size
+ *
+ * @note Needs Linux 4.0 or later
+ *
+ * @return True on success
+ */
+inline bool reset_peak_rss()
+{
+    std::ofstream ofs("/proc/self/clear_refs");
+    ofs << "5";
+    ofs.close();
+    return ofs.good();
+}
+
+/** Returns the memory the system can give to new allocations without swapping */
+inline uint64_t available_memory_bytes()
+{
+    return read_proc_bytes("/proc/meminfo", "MemAvailable");
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_MEMORY_USAGE_H__ */
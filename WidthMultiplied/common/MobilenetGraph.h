@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_MOBILENET_GRAPH_H__
+#define __WIDTH_MULTIPLIED_MOBILENET_GRAPH_H__
+
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+#include "utils/CommonGraphOptions.h"
+#include "utils/GraphUtils.h"
+
+#include "common/SweepUtils.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Builds MobileNetV1 into a graph stream for a given width and resolution multiplier */
+class MobilenetGraphBuilder
+{
+public:
+    /** Constructor
+     *
+     * @param[in] graph         Stream to add the layers to
+     * @param[in] common_params Common graph parameters
+     */
+    MobilenetGraphBuilder(arm_compute::graph::frontend::Stream &graph, const arm_compute::utils::CommonGraphParams &common_params)
+        : graph(graph), common_params(common_params)
+    {
+    }
+    /** Adds the whole network, from input to output layer, to the stream
+     *
+     * @param[in] variant Width, resolution and batch size to build
+     */
+    void create_graph(const GraphVariant &variant)
+    {
+        using namespace arm_compute::graph::frontend;
+        using namespace arm_compute::graph_utils;
+
+        // Create input descriptor
+        const TensorShape tensor_shape     = permute_shape(TensorShape(variant.resolution, variant.resolution, 3U, variant.batch), DataLayout::NCHW, common_params.data_layout);
+        TensorDescriptor  input_descriptor = TensorDescriptor(tensor_shape, common_params.data_type).set_layout(common_params.data_layout);
+
+        // Set graph hints
+        graph << common_params.target
+              << DepthwiseConvolutionMethod::Optimized3x3
+              << common_params.fast_math_hint;
+
+        // Create core graph
+        if(arm_compute::is_data_type_float(common_params.data_type))
+        {
+            create_graph_float(input_descriptor, ChannelScaler(variant.width, variant.rounding));
+        }
+        else
+        {
+            create_graph_qasymm(input_descriptor, ChannelScaler(variant.width, variant.rounding));
+        }
+
+        // Create common tail
+        graph << ReshapeLayer(TensorShape(1001U, variant.batch)).set_name("Reshape")
+              << SoftmaxLayer().set_name("Softmax")
+              << OutputLayer(get_recorded_output_accessor(common_params, 5));
+    }
+
+private:
+    arm_compute::graph::frontend::Stream        &graph;
+    const arm_compute::utils::CommonGraphParams &common_params;
+
+    void create_graph_float(arm_compute::graph::TensorDescriptor &input_descriptor, const ChannelScaler &depth_scale)
+    {
+        using namespace arm_compute::graph::frontend;
+        using namespace arm_compute::graph_utils;
+
+        std::string model_path = "/cnn_data/mobilenet_v1_1_224_model/";
+
+        // Create a preprocessor object
+        std::unique_ptr<IPreprocessor> preprocessor = arm_compute::support::cpp14::make_unique<TFPreproccessor>();
+
+        // Get trainable parameters data path
+        std::string data_path = common_params.data_path;
+
+        // Add model path to data path
+        if(!data_path.empty())
+        {
+            data_path += model_path;
+        }
+
+        // Channels kept when slicing the trained weights, ranked by the layer producing them
+        const ChannelSlice conv0_slice("Conv2d_0_weights.npy");
+
+        graph << InputLayer(input_descriptor,
+                            get_input_accessor(common_params, std::move(preprocessor), false))
+              << ConvolutionLayer(
+                  3U, 3U, depth_scale(32U),
+                  get_mapped_weights_accessor(data_path, "Conv2d_0_weights.npy", DataLayout::NCHW, conv0_slice),
+                  std::unique_ptr<arm_compute::graph::ITensorAccessor>(nullptr),
+                  PadStrideInfo(2, 2, 0, 1, 0, 1, DimensionRoundingType::FLOOR))
+              .set_name("Conv2d_0")
+              << BatchNormalizationLayer(
+                  get_mapped_weights_accessor(data_path, "Conv2d_0_BatchNorm_moving_mean.npy", DataLayout::NCHW, conv0_slice),
+                  get_mapped_weights_accessor(data_path, "Conv2d_0_BatchNorm_moving_variance.npy", DataLayout::NCHW, conv0_slice),
+                  get_mapped_weights_accessor(data_path, "Conv2d_0_BatchNorm_gamma.npy", DataLayout::NCHW, conv0_slice),
+                  get_mapped_weights_accessor(data_path, "Conv2d_0_BatchNorm_beta.npy", DataLayout::NCHW, conv0_slice),
+                  0.001f)
+              .set_name("Conv2d_0/BatchNorm")
+              << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::BOUNDED_RELU, 6.f)).set_name("Conv2d_0/Relu6");
+        graph << get_dwsc_node_float(data_path, "Conv2d_1", "Conv2d_0_weights.npy", depth_scale(64U), PadStrideInfo(1, 1, 1, 1), PadStrideInfo(1, 1, 0, 0));
+        graph << get_dwsc_node_float(data_path, "Conv2d_2", "Conv2d_1_pointwise_weights.npy", depth_scale(128U), PadStrideInfo(2, 2, 0, 1, 0, 1, DimensionRoundingType::CEIL), PadStrideInfo(1, 1, 0, 0));
+        graph << get_dwsc_node_float(data_path, "Conv2d_3", "Conv2d_2_pointwise_weights.npy", depth_scale(128U), PadStrideInfo(1, 1, 1, 1, 1, 1, DimensionRoundingType::CEIL), PadStrideInfo(1, 1, 0, 0));
+        graph << get_dwsc_node_float(data_path, "Conv2d_4", "Conv2d_3_pointwise_weights.npy", depth_scale(256U), PadStrideInfo(2, 2, 0, 1, 0, 1, DimensionRoundingType::CEIL), PadStrideInfo(1, 1, 0, 0));
+        graph << get_dwsc_node_float(data_path, "Conv2d_5", "Conv2d_4_pointwise_weights.npy", depth_scale(256U), PadStrideInfo(1, 1, 1, 1, 1, 1, DimensionRoundingType::CEIL), PadStrideInfo(1, 1, 0, 0));
+        graph << get_dwsc_node_float(data_path, "Conv2d_6", "Conv2d_5_pointwise_weights.npy", depth_scale(512U), PadStrideInfo(2, 2, 0, 1, 0, 1, DimensionRoundingType::CEIL), PadStrideInfo(1, 1, 0, 0));
+        graph << get_dwsc_node_float(data_path, "Conv2d_7", "Conv2d_6_pointwise_weights.npy", depth_scale(512U), PadStrideInfo(1, 1, 1, 1, 1, 1, DimensionRoundingType::CEIL), PadStrideInfo(1, 1, 0, 0));
+        graph << get_dwsc_node_float(data_path, "Conv2d_8", "Conv2d_7_pointwise_weights.npy", depth_scale(512U), PadStrideInfo(1, 1, 1, 1, 1, 1, DimensionRoundingType::CEIL), PadStrideInfo(1, 1, 0, 0));
+        graph << get_dwsc_node_float(data_path, "Conv2d_9", "Conv2d_8_pointwise_weights.npy", depth_scale(512U), PadStrideInfo(1, 1, 1, 1, 1, 1, DimensionRoundingType::CEIL), PadStrideInfo(1, 1, 0, 0));
+        graph << get_dwsc_node_float(data_path, "Conv2d_10", "Conv2d_9_pointwise_weights.npy", depth_scale(512U), PadStrideInfo(1, 1, 1, 1, 1, 1, DimensionRoundingType::CEIL), PadStrideInfo(1, 1, 0, 0));
+        graph << get_dwsc_node_float(data_path, "Conv2d_11", "Conv2d_10_pointwise_weights.npy", depth_scale(512U), PadStrideInfo(1, 1, 1, 1, 1, 1, DimensionRoundingType::CEIL), PadStrideInfo(1, 1, 0, 0));
+        graph << get_dwsc_node_float(data_path, "Conv2d_12", "Conv2d_11_pointwise_weights.npy", depth_scale(1024U), PadStrideInfo(2, 2, 0, 1, 0, 1, DimensionRoundingType::CEIL), PadStrideInfo(1, 1, 0, 0));
+        graph << get_dwsc_node_float(data_path, "Conv2d_13", "Conv2d_12_pointwise_weights.npy", depth_scale(1024U), PadStrideInfo(1, 1, 1, 1, 1, 1, DimensionRoundingType::CEIL), PadStrideInfo(1, 1, 0, 0));
+        graph << PoolingLayer(PoolingLayerInfo(PoolingType::AVG)).set_name("Logits/AvgPool_1a")
+              << ConvolutionLayer(
+                  1U, 1U, 1001U,
+                  get_mapped_weights_accessor(data_path, "Logits_Conv2d_1c_1x1_weights.npy", DataLayout::NCHW, ChannelSlice("", "Conv2d_13_pointwise_weights.npy")),
+                  get_mapped_weights_accessor(data_path, "Logits_Conv2d_1c_1x1_biases.npy"),
+                  PadStrideInfo(1, 1, 0, 0))
+              .set_name("Logits/Conv2d_1c_1x1");
+    }
+
+    void create_graph_qasymm(arm_compute::graph::TensorDescriptor &input_descriptor, const ChannelScaler &depth_scale)
+    {
+        using namespace arm_compute;
+        using namespace arm_compute::graph::frontend;
+
+        // Get trainable parameters data path
+        std::string data_path = common_params.data_path;
+
+        // Quantization info taken from the AndroidNN QASYMM8 MobileNet example. A narrower graph keeps the leading
+        // channels of the trained weights, whose quantization does not change
+        QuantizationInfo in_quant_info  = QuantizationInfo(0.0078125f, 128);
+        QuantizationInfo mid_quant_info = QuantizationInfo(0.0784313753247f, 128);
+
+        std::vector<QuantizationInfo> conv_weights_quant_info =
+        {
+            QuantizationInfo(0.031778190285f, 156), // conv0
+            QuantizationInfo(0.00604454148561f, 66) // conv14
+        };
+
+        std::vector<QuantizationInfo> depth_weights_quant_info =
+        {
+            QuantizationInfo(0.254282623529f, 129),  // dwsc1
+            QuantizationInfo(0.12828284502f, 172),   // dwsc2
+            QuantizationInfo(0.265911251307f, 83),   // dwsc3
+            QuantizationInfo(0.0985597148538f, 30),  // dwsc4
+            QuantizationInfo(0.0631204470992f, 54),  // dwsc5
+            QuantizationInfo(0.0137207424268f, 141), // dwsc6
+            QuantizationInfo(0.0817828401923f, 125), // dwsc7
+            QuantizationInfo(0.0393880493939f, 164), // dwsc8
+            QuantizationInfo(0.211694166064f, 129),  // dwsc9
+            QuantizationInfo(0.158015936613f, 103),  // dwsc10
+            QuantizationInfo(0.0182712618262f, 137), // dwsc11
+            QuantizationInfo(0.0127998134121f, 134), // dwsc12
+            QuantizationInfo(0.299285322428f, 161)   // dwsc13
+        };
+
+        std::vector<QuantizationInfo> point_weights_quant_info =
+        {
+            QuantizationInfo(0.0425766184926f, 129),  // dwsc1
+            QuantizationInfo(0.0250773020089f, 94),   // dwsc2
+            QuantizationInfo(0.015851572156f, 93),    // dwsc3
+            QuantizationInfo(0.0167811904103f, 98),   // dwsc4
+            QuantizationInfo(0.00951790809631f, 135), // dwsc5
+            QuantizationInfo(0.00999817531556f, 128), // dwsc6
+            QuantizationInfo(0.00590536883101f, 126), // dwsc7
+            QuantizationInfo(0.00576109671965f, 133), // dwsc8
+            QuantizationInfo(0.00830461271107f, 142), // dwsc9
+            QuantizationInfo(0.0152327232063f, 72),   // dwsc10
+            QuantizationInfo(0.00741417845711f, 125), // dwsc11
+            QuantizationInfo(0.0135628981516f, 142),  // dwsc12
+            QuantizationInfo(0.0338749065995f, 140)   // dwsc13
+        };
+
+        // Those only hold for the trained weights: without them, every tensor is left unquantized so that the
+        // QuantizationMutator gives it the synthetic quantization, as for the other families
+        if(data_path.empty())
+        {
+            in_quant_info  = QuantizationInfo();
+            mid_quant_info = QuantizationInfo();
+            for(auto *quant_infos : { &conv_weights_quant_info, &depth_weights_quant_info, &point_weights_quant_info })
+            {
+                std::fill(quant_infos->begin(), quant_infos->end(), QuantizationInfo());
+            }
+        }
+
+        graph << InputLayer(input_descriptor.set_quantization_info(in_quant_info),
+                            Dummy())
+              << ConvolutionLayer(
+                  3U, 3U, depth_scale(32U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/mobilenet_qasymm8_model/Conv2d_0_weights.npy"),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/mobilenet_qasymm8_model/Conv2d_0_bias.npy"),
+                  PadStrideInfo(2U, 2U, 0U, 1U, 0U, 1U, DimensionRoundingType::FLOOR),
+                  1, conv_weights_quant_info.at(0), mid_quant_info)
+              .set_name("Conv2d_0")
+              << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::LU_BOUNDED_RELU, 6.f)).set_name("Conv2d_0/Relu6");
+        graph << get_dwsc_node_qasymm(data_path, "Conv2d_1", depth_scale(64U), PadStrideInfo(1U, 1U, 1U, 1U), PadStrideInfo(1U, 1U, 0U, 0U), depth_weights_quant_info.at(0), point_weights_quant_info.at(0));
+        graph << get_dwsc_node_qasymm(data_path, "Conv2d_2", depth_scale(128U), PadStrideInfo(2U, 2U, 0U, 1U, 0U, 1U, DimensionRoundingType::FLOOR), PadStrideInfo(1U, 1U, 0U, 0U), depth_weights_quant_info.at(1),
+                                      point_weights_quant_info.at(1));
+        graph << get_dwsc_node_qasymm(data_path, "Conv2d_3", depth_scale(128U), PadStrideInfo(1U, 1U, 1U, 1U, 1U, 1U, DimensionRoundingType::FLOOR), PadStrideInfo(1U, 1U, 0U, 0U), depth_weights_quant_info.at(2),
+                                      point_weights_quant_info.at(2));
+        graph << get_dwsc_node_qasymm(data_path, "Conv2d_4", depth_scale(256U), PadStrideInfo(2U, 2U, 0U, 1U, 0U, 1U, DimensionRoundingType::FLOOR), PadStrideInfo(1U, 1U, 0U, 0U), depth_weights_quant_info.at(3),
+                                      point_weights_quant_info.at(3));
+        graph << get_dwsc_node_qasymm(data_path, "Conv2d_5", depth_scale(256U), PadStrideInfo(1U, 1U, 1U, 1U, 1U, 1U, DimensionRoundingType::FLOOR), PadStrideInfo(1U, 1U, 0U, 0U), depth_weights_quant_info.at(4),
+                                      point_weights_quant_info.at(4));
+        graph << get_dwsc_node_qasymm(data_path, "Conv2d_6", depth_scale(512U), PadStrideInfo(2U, 2U, 0U, 1U, 0U, 1U, DimensionRoundingType::FLOOR), PadStrideInfo(1U, 1U, 0U, 0U), depth_weights_quant_info.at(5),
+                                      point_weights_quant_info.at(5));
+        graph << get_dwsc_node_qasymm(data_path, "Conv2d_7", depth_scale(512U), PadStrideInfo(1U, 1U, 1U, 1U, 1U, 1U, DimensionRoundingType::FLOOR), PadStrideInfo(1U, 1U, 0U, 0U), depth_weights_quant_info.at(6),
+                                      point_weights_quant_info.at(6));
+        graph << get_dwsc_node_qasymm(data_path, "Conv2d_8", depth_scale(512U), PadStrideInfo(1U, 1U, 1U, 1U, 1U, 1U, DimensionRoundingType::FLOOR), PadStrideInfo(1U, 1U, 0U, 0U), depth_weights_quant_info.at(7),
+                                      point_weights_quant_info.at(7));
+        graph << get_dwsc_node_qasymm(data_path, "Conv2d_9", depth_scale(512U), PadStrideInfo(1U, 1U, 1U, 1U, 1U, 1U, DimensionRoundingType::FLOOR), PadStrideInfo(1U, 1U, 0U, 0U), depth_weights_quant_info.at(8),
+                                      point_weights_quant_info.at(8));
+        graph << get_dwsc_node_qasymm(data_path, "Conv2d_10", depth_scale(512U), PadStrideInfo(1U, 1U, 1U, 1U, 1U, 1U, DimensionRoundingType::FLOOR), PadStrideInfo(1U, 1U, 0U, 0U), depth_weights_quant_info.at(9),
+                                      point_weights_quant_info.at(9));
+        graph << get_dwsc_node_qasymm(data_path, "Conv2d_11", depth_scale(512U), PadStrideInfo(1U, 1U, 1U, 1U, 1U, 1U, DimensionRoundingType::FLOOR), PadStrideInfo(1U, 1U, 0U, 0U), depth_weights_quant_info.at(10),
+                                      point_weights_quant_info.at(10));
+        graph << get_dwsc_node_qasymm(data_path, "Conv2d_12", depth_scale(1024U), PadStrideInfo(2U, 2U, 0U, 1U, 0U, 1U, DimensionRoundingType::FLOOR), PadStrideInfo(1U, 1U, 0U, 0U), depth_weights_quant_info.at(11),
+                                      point_weights_quant_info.at(11));
+        graph << get_dwsc_node_qasymm(data_path, "Conv2d_13", depth_scale(1024U), PadStrideInfo(1U, 1U, 1U, 1U, 1U, 1U, DimensionRoundingType::FLOOR), PadStrideInfo(1U, 1U, 0U, 0U), depth_weights_quant_info.at(12),
+                                      point_weights_quant_info.at(12))
+              << PoolingLayer(PoolingLayerInfo(PoolingType::AVG)).set_name("Logits/AvgPool_1a")
+              << ConvolutionLayer(
+                  1U, 1U, 1001U,
+                  get_mapped_weights_accessor(data_path, "/cnn_data/mobilenet_qasymm8_model/Logits_Conv2d_1c_1x1_weights.npy"),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/mobilenet_qasymm8_model/Logits_Conv2d_1c_1x1_bias.npy"),
+                  PadStrideInfo(1U, 1U, 0U, 0U), 1, conv_weights_quant_info.at(1))
+              .set_name("Logits/Conv2d_1c_1x1");
+    }
+
+    arm_compute::graph::frontend::BranchLayer get_dwsc_node_float(const std::string &data_path, std::string &&param_path, const std::string &input_weights,
+                                                                  unsigned int               conv_filt,
+                                                                  arm_compute::PadStrideInfo dwc_pad_stride_info, arm_compute::PadStrideInfo conv_pad_stride_info)
+    {
+        using namespace arm_compute::graph::frontend;
+
+        // The depthwise layer keeps the channels of its input, the pointwise one ranks its own
+        std::string        total_path = param_path + "_";
+        const ChannelSlice depthwise_slice(input_weights);
+        const ChannelSlice pointwise_slice(total_path + "pointwise_weights.npy", input_weights);
+        SubStream          sg(graph);
+        sg << DepthwiseConvolutionLayer(
+               3U, 3U,
+               get_mapped_weights_accessor(data_path, total_path + "depthwise_depthwise_weights.npy", DataLayout::NCHW, depthwise_slice),
+               std::unique_ptr<arm_compute::graph::ITensorAccessor>(nullptr),
+               dwc_pad_stride_info)
+           .set_name(total_path + "depthwise/depthwise")
+           << BatchNormalizationLayer(
+               get_mapped_weights_accessor(data_path, total_path + "depthwise_BatchNorm_moving_mean.npy", DataLayout::NCHW, depthwise_slice),
+               get_mapped_weights_accessor(data_path, total_path + "depthwise_BatchNorm_moving_variance.npy", DataLayout::NCHW, depthwise_slice),
+               get_mapped_weights_accessor(data_path, total_path + "depthwise_BatchNorm_gamma.npy", DataLayout::NCHW, depthwise_slice),
+               get_mapped_weights_accessor(data_path, total_path + "depthwise_BatchNorm_beta.npy", DataLayout::NCHW, depthwise_slice),
+               0.001f)
+           .set_name(total_path + "depthwise/BatchNorm")
+           << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::BOUNDED_RELU, 6.f)).set_name(total_path + "depthwise/Relu6")
+           << ConvolutionLayer(
+               1U, 1U, conv_filt,
+               get_mapped_weights_accessor(data_path, total_path + "pointwise_weights.npy", DataLayout::NCHW, pointwise_slice),
+               std::unique_ptr<arm_compute::graph::ITensorAccessor>(nullptr),
+               conv_pad_stride_info)
+           .set_name(total_path + "pointwise/Conv2D")
+           << BatchNormalizationLayer(
+               get_mapped_weights_accessor(data_path, total_path + "pointwise_BatchNorm_moving_mean.npy", DataLayout::NCHW, pointwise_slice),
+               get_mapped_weights_accessor(data_path, total_path + "pointwise_BatchNorm_moving_variance.npy", DataLayout::NCHW, pointwise_slice),
+               get_mapped_weights_accessor(data_path, total_path + "pointwise_BatchNorm_gamma.npy", DataLayout::NCHW, pointwise_slice),
+               get_mapped_weights_accessor(data_path, total_path + "pointwise_BatchNorm_beta.npy", DataLayout::NCHW, pointwise_slice),
+               0.001f)
+           .set_name(total_path + "pointwise/BatchNorm")
+           << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::BOUNDED_RELU, 6.f)).set_name(total_path + "pointwise/Relu6");
+
+        return BranchLayer(std::move(sg));
+    }
+
+    arm_compute::graph::frontend::BranchLayer get_dwsc_node_qasymm(const std::string &data_path, std::string &&param_path,
+                                                                   const unsigned int conv_filt,
+                                                                   arm_compute::PadStrideInfo dwc_pad_stride_info, arm_compute::PadStrideInfo conv_pad_stride_info,
+                                                                   arm_compute::QuantizationInfo depth_weights_quant_info, arm_compute::QuantizationInfo point_weights_quant_info)
+    {
+        using namespace arm_compute::graph::frontend;
+
+        std::string total_path = "/cnn_data/mobilenet_qasymm8_model/" + param_path + "_";
+        SubStream   sg(graph);
+
+        sg << DepthwiseConvolutionLayer(
+               3U, 3U,
+               get_mapped_weights_accessor(data_path, total_path + "depthwise_weights.npy"),
+               get_mapped_weights_accessor(data_path, total_path + "depthwise_bias.npy"),
+               dwc_pad_stride_info, depth_weights_quant_info)
+           .set_name(param_path + "_depthwise/depthwise")
+           << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::LU_BOUNDED_RELU, 6.f)).set_name(param_path + "_depthwise/Relu6")
+           << ConvolutionLayer(
+               1U, 1U, conv_filt,
+               get_mapped_weights_accessor(data_path, total_path + "pointwise_weights.npy"),
+               get_mapped_weights_accessor(data_path, total_path + "pointwise_bias.npy"),
+               conv_pad_stride_info, 1, point_weights_quant_info)
+           .set_name(param_path + "_pointwise/Conv2D")
+           << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::LU_BOUNDED_RELU, 6.f)).set_name(param_path + "_pointwise/Relu6");
+
+        return BranchLayer(std::move(sg));
+    }
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_MOBILENET_GRAPH_H__ */
@@ -0,0 +1,456 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_MULTI_STREAM_RUNNER_H__
+#define __WIDTH_MULTIPLIED_MULTI_STREAM_RUNNER_H__
+
+#include "arm_compute/graph.h"
+#include "arm_compute/runtime/CL/CLScheduler.h"
+#include "utils/CommonGraphOptions.h"
+
+#include "common/CpuAffinity.h"
+#include "common/GraphBuilders.h"
+#include "common/GraphCost.h"
+#include "common/GraphExecutor.h"
+#include "common/LatencyStats.h"
+#include "common/SweepOptions.h"
+#include "common/SweepUtils.h"
+#include "common/WarmupDetector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <ostream>
+#include <vector>
+
+#include <poll.h>
+#include <signal.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace width_multiplied
+{
+/** Latencies of one stream of a multi-stream run */
+struct StreamResult
+{
+    unsigned int              stream{ 0 };             /**< Index of the stream */
+    GraphVariant              variant{};               /**< Variant run by the stream */
+    unsigned int              threads{ 0 };            /**< Threads of the stream's backend */
+    std::vector<unsigned int> cpus{};                  /**< CPUs the stream is pinned to, empty if not pinned */
+    LatencyStats              solo{};                  /**< Latency when running alone */
+    LatencyStats              concurrent{};            /**< Latency while every stream runs */
+    double                    concurrent_time_ms{ 0 }; /**< Duration of the concurrent runs of the stream */
+};
+
+/** Images per second of a stream while every stream runs
+ *
+ * @param[in] result Stream result
+ *
+ * @return Images per second, 0 if the stream did not run
+ */
+inline double concurrent_images_per_second(const StreamResult &result)
+{
+    return (result.concurrent_time_ms > 0) ? result.variant.batch * result.concurrent.count * 1e3 / result.concurrent_time_ms : 0;
+}
+
+/** Runs several independent graphs concurrently, one per stream
+ *
+ * The backends of ACL 18.08 are process-wide singletons (the NEON thread pool and the OpenCL
+ * scheduler) whose scheduling is not reentrant, so every stream runs in its own process with its own
+ * backend, as independent camera pipelines would. With a shared thread budget every stream uses all the
+ * threads on any CPU; with a partitioned one every stream gets its share of the threads, pinned to its
+ * own CPUs.
+ *
+ * Every stream is built and warmed up, then timed alone, one stream after the other, then timed while
+ * every stream runs. The concurrent runs of each stream continue until every stream has done its
+ * timed runs, so all the samples are taken under the full load.
+ */
+class MultiStreamRunner
+{
+public:
+    /** Constructor
+     *
+     * @param[in] common_params Common graph parameters
+     * @param[in] sweep_params  Sweep parameters
+     */
+    MultiStreamRunner(const arm_compute::utils::CommonGraphParams &common_params, const SweepParams &sweep_params)
+        : _common_params(common_params), _sweep_params(sweep_params), _results(), _children()
+    {
+    }
+    /** Runs the streams, the variants being assigned to the streams in turn
+     *
+     * @param[in] variants Variants to run, at least one and no more than the streams
+     */
+    void run(const std::vector<GraphVariant> &variants)
+    {
+        ARM_COMPUTE_EXIT_ON_MSG(variants.empty(), "No variant to run");
+        const std::vector<unsigned int> cpus    = allowed_cpus();
+        const unsigned int              streams = std::max(_sweep_params.streams, 1U);
+        ARM_COMPUTE_EXIT_ON_MSG(variants.size() > streams, "%zu variants for %u streams, every variant needs a stream: raise --streams or narrow the sweep", variants.size(), streams);
+        const unsigned int              budget  = (_common_params.threads > 0) ? _common_params.threads : cpus.size();
+        if(_sweep_params.thread_budget == ThreadBudget::Partitioned)
+        {
+            ARM_COMPUTE_EXIT_ON_MSG(budget < streams, "%u threads for %u streams, every partitioned stream needs a thread: raise --threads or lower --streams", budget, streams);
+            ARM_COMPUTE_EXIT_ON_MSG(budget > cpus.size(), "%u threads on %zu CPUs, every partitioned thread needs its own CPU: lower --threads", budget, cpus.size());
+        }
+
+        // A stream that exits early closes its command pipe: report it in fail() rather than die of SIGPIPE
+        const sighandler_t sigpipe_handler = signal(SIGPIPE, SIG_IGN);
+
+        // Start one process per stream, before the backend is initialized in this process
+        std::cout.flush();
+        for(unsigned int i = 0; i < streams; ++i)
+        {
+            StreamResult result;
+            result.stream  = i;
+            result.variant = variants[i % variants.size()];
+            if(_sweep_params.thread_budget == ThreadBudget::Partitioned)
+            {
+                // Checked above: the shares of the streams fit the allowed CPUs, one CPU per thread
+                result.threads = budget / streams;
+                result.cpus.assign(cpus.begin() + i * result.threads, cpus.begin() + (i + 1) * result.threads);
+            }
+            else
+            {
+                result.threads = budget;
+            }
+            validate_variant(_common_params, result.variant, _sweep_params.channel_selection);
+            _results.push_back(result);
+            start_stream(result);
+        }
+        for(unsigned int i = 0; i < streams; ++i)
+        {
+            expect(i, 'R');
+        }
+
+        // Each stream alone
+        for(unsigned int i = 0; i < streams; ++i)
+        {
+            send(i, 'S');
+            _results[i].solo = compute_latency_stats(receive_samples(i));
+        }
+
+        // Every stream at once, until they have all done their timed runs
+        for(unsigned int i = 0; i < streams; ++i)
+        {
+            send(i, 'G');
+        }
+        for(unsigned int i = 0; i < streams; ++i)
+        {
+            expect(i, 'M');
+        }
+        for(unsigned int i = 0; i < streams; ++i)
+        {
+            send(i, 'X');
+        }
+        for(unsigned int i = 0; i < streams; ++i)
+        {
+            _results[i].concurrent         = compute_latency_stats(receive_samples(i));
+            _results[i].concurrent_time_ms = receive_value(i);
+            close(_children[i].command_fd);
+            close(_children[i].result_fd);
+            waitpid(_children[i].pid, nullptr, 0);
+        }
+        _children.clear();
+        signal(SIGPIPE, sigpipe_handler);
+    }
+    /** Prints the latency of every stream, alone and concurrent, and the aggregate throughput
+     *
+     * The slowdown is the concurrent median latency over the median latency alone. The efficiency is
+     * the aggregate throughput over the sum of the throughputs of the streams alone, 1 meaning that the
+     * streams do not interfere.
+     *
+     * @param[out] os Output stream
+     */
+    void print_results(std::ostream &os) const
+    {
+        const std::ios_base::fmtflags flags = os.flags();
+        os << "Streams : " << _results.size() << ", thread budget : " << _sweep_params.thread_budget << std::endl;
+        os << std::left << std::setw(8) << "stream" << std::setw(12) << "model" << std::setw(8) << "width" << std::setw(12) << "resolution" << std::setw(19) << "rounding"
+           << std::setw(7) << "batch" << std::setw(9) << "threads" << std::setw(10) << "cpus" << std::right << std::setw(12) << "alone(ms)" << std::setw(10) << "median"
+           << std::setw(10) << "p90" << std::setw(10) << "p99" << std::setw(10) << "slowdown" << std::setw(10) << "img/s" << std::endl;
+        double aggregate = 0;
+        double alone     = 0;
+        for(const auto &result : _results)
+        {
+            const double images_per_s = concurrent_images_per_second(result);
+            aggregate += images_per_s;
+            alone += images_per_second(result.variant.batch, result.solo.median);
+            os << std::left << std::setw(8) << result.stream << std::setw(12) << result.variant.model << std::setw(8) << result.variant.width
+               << std::setw(12) << result.variant.resolution << std::setw(19) << to_string(result.variant.rounding) << std::setw(7) << result.variant.batch
+               << std::setw(9) << result.threads << std::setw(10) << cpu_list_to_string(result.cpus) << std::right << std::fixed << std::setprecision(3)
+               << std::setw(12) << result.solo.median << std::setw(10) << result.concurrent.median << std::setw(10) << result.concurrent.p90
+               << std::setw(10) << result.concurrent.p99 << std::setw(10) << (result.solo.median > 0 ? result.concurrent.median / result.solo.median : 0.0)
+               << std::setw(10) << images_per_s << std::endl;
+            os.flags(flags);
+        }
+        os << std::fixed << std::setprecision(3) << "Aggregate throughput (img/s) : " << aggregate << " (streams alone : " << alone << ", efficiency : "
+           << (alone > 0 ? aggregate / alone : 0.0) << ")" << std::endl;
+        os.flags(flags);
+    }
+    /** Writes one row per stream to the CSV file requested in the sweep parameters, if any */
+    void write_results() const
+    {
+        if(_sweep_params.csv_file.empty())
+        {
+            return;
+        }
+        std::ofstream ofs(_sweep_params.csv_file);
+        if(!ofs.is_open())
+        {
+            std::cerr << "Cannot open " << _sweep_params.csv_file << " for writing" << std::endl;
+            return;
+        }
+        ofs << "stream,model,width,resolution,rounding,batch,batch_norm,fused_dwsc,channel_shuffle,grouped_conv,asymmetric_conv,thread_budget,threads,cpus,alone_median_ms,median_ms,p90_ms,p99_ms,iterations,images_per_second,slowdown\n";
+        ofs << std::setprecision(6);
+        for(const auto &result : _results)
+        {
+            ofs << result.stream << "," << result.variant.model << "," << result.variant.width << "," << result.variant.resolution << "," << result.variant.rounding << ","
+                << result.variant.batch << "," << result.variant.batch_norm << "," << result.variant.dwsc_fusion << "," << result.variant.channel_shuffle << "," << result.variant.grouped_conv << "," << result.variant.asymmetric_conv << "," << _sweep_params.thread_budget << "," << result.threads << "," << cpu_list_to_string(result.cpus) << ","
+                << result.solo.median << "," << result.concurrent.median << "," << result.concurrent.p90 << "," << result.concurrent.p99 << "," << result.concurrent.count << ","
+                << concurrent_images_per_second(result) << "," << (result.solo.median > 0 ? result.concurrent.median / result.solo.median : 0.0) << "\n";
+        }
+    }
+
+private:
+    struct Child
+    {
+        pid_t pid;
+        int   command_fd;
+        int   result_fd;
+    };
+
+    static double elapsed_ms(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    static bool write_all(int fd, const void *data, size_t size)
+    {
+        const char *p = static_cast<const char *>(data);
+        while(size > 0)
+        {
+            const ssize_t written = ::write(fd, p, size);
+            if(written <= 0)
+            {
+                return false;
+            }
+            p += written;
+            size -= written;
+        }
+        return true;
+    }
+
+    static bool read_all(int fd, void *data, size_t size)
+    {
+        char *p = static_cast<char *>(data);
+        while(size > 0)
+        {
+            const ssize_t bytes = ::read(fd, p, size);
+            if(bytes <= 0)
+            {
+                return false;
+            }
+            p += bytes;
+            size -= bytes;
+        }
+        return true;
+    }
+
+    static bool write_samples(int fd, const std::vector<double> &samples)
+    {
+        const uint64_t count = samples.size();
+        return write_all(fd, &count, sizeof(count)) && write_all(fd, samples.data(), count * sizeof(double));
+    }
+
+    void fail(unsigned int stream)
+    {
+        for(const auto &child : _children)
+        {
+            kill(child.pid, SIGKILL);
+            waitpid(child.pid, nullptr, 0);
+        }
+        ARM_COMPUTE_EXIT_ON_MSG(true, "Stream %u failed", stream);
+    }
+
+    void send(unsigned int stream, char command)
+    {
+        if(!write_all(_children[stream].command_fd, &command, 1))
+        {
+            fail(stream);
+        }
+    }
+
+    void expect(unsigned int stream, char message)
+    {
+        char received = 0;
+        if(!read_all(_children[stream].result_fd, &received, 1) || received != message)
+        {
+            fail(stream);
+        }
+    }
+
+    double receive_value(unsigned int stream)
+    {
+        double value = 0;
+        if(!read_all(_children[stream].result_fd, &value, sizeof(value)))
+        {
+            fail(stream);
+        }
+        return value;
+    }
+
+    std::vector<double> receive_samples(unsigned int stream)
+    {
+        uint64_t count = 0;
+        if(!read_all(_children[stream].result_fd, &count, sizeof(count)))
+        {
+            fail(stream);
+        }
+        std::vector<double> samples(count);
+        if(!read_all(_children[stream].result_fd, samples.data(), count * sizeof(double)))
+        {
+            fail(stream);
+        }
+        return samples;
+    }
+
+    void start_stream(const StreamResult &stream)
+    {
+        int command_pipe[2];
+        int result_pipe[2];
+        ARM_COMPUTE_EXIT_ON_MSG(pipe(command_pipe) != 0 || pipe(result_pipe) != 0, "Cannot create the pipes of stream %u", stream.stream);
+        const pid_t pid = fork();
+        ARM_COMPUTE_EXIT_ON_MSG(pid < 0, "Cannot start stream %u", stream.stream);
+        if(pid == 0)
+        {
+            for(const auto &child : _children)
+            {
+                close(child.command_fd);
+                close(child.result_fd);
+            }
+            close(command_pipe[1]);
+            close(result_pipe[0]);
+            run_stream(stream, command_pipe[0], result_pipe[1]);
+            _exit(0);
+        }
+        close(command_pipe[0]);
+        close(result_pipe[1]);
+        _children.push_back(Child{ pid, command_pipe[1], result_pipe[0] });
+    }
+
+    /** Body of the process of a stream, exits on any error so that the parent sees the pipe closed */
+    void run_stream(const StreamResult &stream, int command_fd, int result_fd) const
+    {
+        using namespace arm_compute;
+        using namespace arm_compute::utils;
+        using namespace arm_compute::graph::frontend;
+
+        if(!stream.cpus.empty() && !set_cpu_affinity(stream.cpus))
+        {
+            std::cerr << "Cannot pin stream " << stream.stream << " to CPUs " << cpu_list_to_string(stream.cpus) << std::endl;
+        }
+        CommonGraphParams common_params = _common_params;
+        common_params.threads           = stream.threads;
+        const auto sync                 = [&]()
+        {
+            if(common_params.target == Target::CL)
+            {
+                CLScheduler::get().sync();
+            }
+        };
+
+        SyntheticWeights::get().configure(_sweep_params.weight_fill, _sweep_params.weight_seed);
+        WeightStore::get().set_channel_selection(_sweep_params.channel_selection);
+        QuantizationParams::get().configure(_sweep_params.quantization_file);
+        Stream graph(stream.stream, get_graph_name(stream.variant.model));
+        std::unique_ptr<IWorkloadMutator> workload_mutator = create_graph(graph, common_params, stream.variant);
+        GraphExecutor                     executor;
+        arm_compute::graph::PassManager   pm = arm_compute::graph::create_default_pass_manager(common_params.target);
+        executor.finalize(graph.graph(), common_params.target, make_graph_config(common_params), pm, workload_mutator.get());
+
+        // Warm up as the sweep does
+        if(_sweep_params.adaptive_warmup)
+        {
+            WarmupDetector detector(_sweep_params.warmup_window, _sweep_params.warmup_tolerance, _sweep_params.max_warmup_iterations);
+            while(!detector.done())
+            {
+                const auto run_start = std::chrono::steady_clock::now();
+                executor.run();
+                sync();
+                detector.add_sample(elapsed_ms(run_start));
+            }
+        }
+        else
+        {
+            for(unsigned int i = 0; i < _sweep_params.warmup_iterations; ++i)
+            {
+                executor.run();
+            }
+            sync();
+        }
+
+        char command = 0;
+        ARM_COMPUTE_EXIT_ON_MSG(!write_all(result_fd, "R", 1) || !read_all(command_fd, &command, 1) || command != 'S', "Stream %u lost its runner", stream.stream);
+
+        // Alone
+        std::vector<double> samples;
+        for(unsigned int i = 0; i < _sweep_params.iterations; ++i)
+        {
+            const auto run_start = std::chrono::steady_clock::now();
+            executor.run();
+            sync();
+            samples.push_back(elapsed_ms(run_start));
+        }
+        ARM_COMPUTE_EXIT_ON_MSG(!write_samples(result_fd, samples) || !read_all(command_fd, &command, 1) || command != 'G', "Stream %u lost its runner", stream.stream);
+
+        // Concurrent, until the runner stops every stream
+        samples.clear();
+        const auto start = std::chrono::steady_clock::now();
+        for(bool stop = false; !stop;)
+        {
+            const auto run_start = std::chrono::steady_clock::now();
+            executor.run();
+            sync();
+            samples.push_back(elapsed_ms(run_start));
+            if(samples.size() == _sweep_params.iterations)
+            {
+                ARM_COMPUTE_EXIT_ON_MSG(!write_all(result_fd, "M", 1), "Stream %u lost its runner", stream.stream);
+            }
+            pollfd command_poll{ command_fd, POLLIN, 0 };
+            stop = samples.size() >= _sweep_params.iterations && poll(&command_poll, 1, 0) > 0;
+        }
+        const double time_ms = elapsed_ms(start);
+        ARM_COMPUTE_EXIT_ON_MSG(!write_samples(result_fd, samples) || !write_all(result_fd, &time_ms, sizeof(time_ms)), "Stream %u lost its runner", stream.stream);
+    }
+
+    const arm_compute::utils::CommonGraphParams &_common_params;
+    const SweepParams                           _sweep_params;
+    std::vector<StreamResult>                   _results;
+    std::vector<Child>                          _children;
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_MULTI_STREAM_RUNNER_H__ */
@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_OUTPUT_RECORDER_H__
+#define __WIDTH_MULTIPLIED_OUTPUT_RECORDER_H__
+
+#include "arm_compute/core/Helpers.h"
+#include "arm_compute/core/ITensor.h"
+#include "arm_compute/core/Types.h"
+#include "arm_compute/core/Window.h"
+#include "arm_compute/graph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <numeric>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Agreement of the output of a graph with the output of a reference graph on the same input */
+struct OutputAgreement
+{
+    size_t       top1{ 0 };            /**< Top-1 class of the output */
+    bool         top1_agrees{ false }; /**< True if the reference has the same top-1 class */
+    unsigned int top5_overlap{ 0 };    /**< Classes shared by the top-5 of the output and of the reference */
+    double       distance{ 0 };        /**< Total variation distance between the two distributions, in [0, 1] */
+    double       max_difference{ 0 };  /**< Largest absolute difference between two values of the outputs */
+};
+
+/** Returns the indices of the largest values, largest first
+ *
+ * @param[in] values Values to rank
+ * @param[in] n      Number of indices to return
+ *
+ * @return The indices of the n largest values
+ */
+inline std::vector<size_t> top_n(const std::vector<float> &values, size_t n)
+{
+    std::vector<size_t> indices(values.size());
+    std::iota(indices.begin(), indices.end(), 0);
+    n = std::min(n, indices.size());
+    std::partial_sort(indices.begin(), indices.begin() + n, indices.end(), [&](size_t a, size_t b)
+    {
+        return values[a] > values[b];
+    });
+    indices.resize(n);
+    return indices;
+}
+
+/** Compares the output of a graph with the output of a reference graph
+ *
+ * @param[in] output    Output of the graph, a probability distribution
+ * @param[in] reference Output of the reference graph, of the same size
+ *
+ * @return The agreement of the two outputs
+ */
+inline OutputAgreement compare_outputs(const std::vector<float> &output, const std::vector<float> &reference)
+{
+    OutputAgreement agreement;
+    if(output.empty() || output.size() != reference.size())
+    {
+        return agreement;
+    }
+    const std::vector<size_t> top5           = top_n(output, 5);
+    const std::vector<size_t> reference_top5 = top_n(reference, 5);
+    agreement.top1                           = top5[0];
+    agreement.top1_agrees                    = top5[0] == reference_top5[0];
+    for(size_t index : top5)
+    {
+        agreement.top5_overlap += std::count(reference_top5.begin(), reference_top5.end(), index);
+    }
+    for(size_t i = 0; i < output.size(); ++i)
+    {
+        agreement.distance += std::fabs(output[i] - reference[i]) / 2;
+        agreement.max_difference = std::max<double>(agreement.max_difference, std::fabs(output[i] - reference[i]));
+    }
+    return agreement;
+}
+
+/** Process-wide copy of the output of one run of a graph
+ *
+ * The output is only copied by the run following arm(), so the timed runs are not slowed down.
+ */
+class OutputRecorder
+{
+public:
+    /** Gets the process-wide recorder
+     *
+     * @return The recorder
+     */
+    static OutputRecorder &get()
+    {
+        static OutputRecorder instance;
+        return instance;
+    }
+    /** Clears the output and records the one of the next run */
+    void arm()
+    {
+        _armed = true;
+        _output.clear();
+    }
+    /** Copies the output of the first image of the batch as floats if armed
+     *
+     * @param[in] tensor Output tensor of shape (classes, batch), F32, F16 or QASYMM8
+     */
+    void record(arm_compute::ITensor &tensor)
+    {
+        using namespace arm_compute;
+
+        if(!_armed)
+        {
+            return;
+        }
+        _armed = false;
+
+        const ITensorInfo &info = *tensor.info();
+        Window             window;
+        window.use_tensor_dimensions(info.tensor_shape());
+        window.set(Window::DimY, Window::Dimension(0, 1, 1));
+        Iterator it(&tensor, window);
+        execute_window_loop(window, [&](const Coordinates &)
+        {
+            switch(info.data_type())
+            {
+                case DataType::F32:
+                    _output.push_back(*reinterpret_cast<const float *>(it.ptr()));
+                    break;
+                case DataType::F16:
+                    _output.push_back(static_cast<float>(*reinterpret_cast<const half *>(it.ptr())));
+                    break;
+                case DataType::QASYMM8:
+                    _output.push_back(info.quantization_info().dequantize(*it.ptr()));
+                    break;
+                default:
+                    break;
+            }
+        },
+        it);
+    }
+    /** Returns the output of the last armed run, empty if none */
+    const std::vector<float> &output() const
+    {
+        return _output;
+    }
+
+private:
+    OutputRecorder()
+        : _armed(false), _output()
+    {
+    }
+
+    bool               _armed;
+    std::vector<float> _output;
+};
+
+/** Output accessor recording the output before handing it to another accessor */
+class RecordedOutputAccessor final : public arm_compute::graph::ITensorAccessor
+{
+public:
+    /** Constructor
+     *
+     * @param[in] accessor Accessor to call after recording, can be nullptr
+     */
+    RecordedOutputAccessor(std::unique_ptr<arm_compute::graph::ITensorAccessor> accessor)
+        : _accessor(std::move(accessor))
+    {
+    }
+    /** Allow instances of this class to be move constructed */
+    RecordedOutputAccessor(RecordedOutputAccessor &&) = default;
+
+    // Inherited methods overriden:
+    bool access_tensor(arm_compute::ITensor &tensor) override
+    {
+        OutputRecorder::get().record(tensor);
+        return _accessor == nullptr || _accessor->access_tensor(tensor);
+    }
+
+private:
+    std::unique_ptr<arm_compute::graph::ITensorAccessor> _accessor;
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_OUTPUT_RECORDER_H__ */
@@ -0,0 +1,308 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_PROTOTXT_H__
+#define __WIDTH_MULTIPLIED_PROTOTXT_H__
+
+#include "arm_compute/core/Error.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Message of a protobuf text format file, such as a Caffe prototxt
+ *
+ * Fields keep their order and can be repeated. Scalar values are kept as written, strings without
+ * their quotes, and enum values as their name (e.g. "SUM").
+ */
+struct PrototxtMessage
+{
+    std::vector<std::pair<std::string, std::string>>     values{};   /**< Scalar fields, in file order */
+    std::vector<std::pair<std::string, PrototxtMessage>> messages{}; /**< Message fields, in file order */
+
+    /** Counts the values of a scalar field
+     *
+     * @param[in] key Name of the field
+     *
+     * @return Number of times the field is set
+     */
+    size_t count(const std::string &key) const
+    {
+        size_t count = 0;
+        for(const auto &value : values)
+        {
+            count += (value.first == key) ? 1 : 0;
+        }
+        return count;
+    }
+    /** Checks whether a scalar field is set */
+    bool has(const std::string &key) const
+    {
+        return count(key) != 0;
+    }
+    /** Returns a value of a scalar field
+     *
+     * @param[in] key           Name of the field
+     * @param[in] default_value (Optional) Value returned if the field is not set that many times
+     * @param[in] index         (Optional) Index of the value for a repeated field
+     *
+     * @return The value as written in the file
+     */
+    std::string get(const std::string &key, const std::string &default_value = "", size_t index = 0) const
+    {
+        for(const auto &value : values)
+        {
+            if(value.first == key && index-- == 0)
+            {
+                return value.second;
+            }
+        }
+        return default_value;
+    }
+    /** Returns a value of an unsigned integer field, exits with an error if it is not one */
+    unsigned int get_uint(const std::string &key, unsigned int default_value, size_t index = 0) const
+    {
+        if(count(key) <= index)
+        {
+            return default_value;
+        }
+        const std::string value  = get(key, "", index);
+        char             *end    = nullptr;
+        const long        parsed = std::strtol(value.c_str(), &end, 10);
+        ARM_COMPUTE_EXIT_ON_MSG(value.empty() || *end != '\0' || parsed < 0, "Invalid value of %s: %s", key.c_str(), value.c_str());
+        return static_cast<unsigned int>(parsed);
+    }
+    /** Returns a value of a floating point field, exits with an error if it is not one */
+    float get_float(const std::string &key, float default_value, size_t index = 0) const
+    {
+        if(count(key) <= index)
+        {
+            return default_value;
+        }
+        const std::string value  = get(key, "", index);
+        char             *end    = nullptr;
+        const float       parsed = std::strtof(value.c_str(), &end);
+        ARM_COMPUTE_EXIT_ON_MSG(value.empty() || *end != '\0', "Invalid value of %s: %s", key.c_str(), value.c_str());
+        return parsed;
+    }
+    /** Returns the first value of a boolean field, exits with an error if it is not one */
+    bool get_bool(const std::string &key, bool default_value) const
+    {
+        if(!has(key))
+        {
+            return default_value;
+        }
+        const std::string value = get(key);
+        ARM_COMPUTE_EXIT_ON_MSG(value != "true" && value != "false", "Invalid value of %s: %s", key.c_str(), value.c_str());
+        return value == "true";
+    }
+    /** Returns the first message of a field, nullptr if the field is not set */
+    const PrototxtMessage *message(const std::string &key) const
+    {
+        for(const auto &message : messages)
+        {
+            if(message.first == key)
+            {
+                return &message.second;
+            }
+        }
+        return nullptr;
+    }
+    /** Returns every message of a repeated field, in file order */
+    std::vector<const PrototxtMessage *> get_messages(const std::string &key) const
+    {
+        std::vector<const PrototxtMessage *> all;
+        for(const auto &message : messages)
+        {
+            if(message.first == key)
+            {
+                all.push_back(&message.second);
+            }
+        }
+        return all;
+    }
+};
+
+namespace detail
+{
+/** Splits a protobuf text format file into tokens: names and values, quoted strings (without quotes), and the ':', '{' and '}' symbols */
+class PrototxtTokenizer
+{
+public:
+    /** Constructor
+     *
+     * @param[in] text     Content of the file
+     * @param[in] filename Name of the file, for the error messages
+     */
+    PrototxtTokenizer(std::string text, std::string filename)
+        : _text(std::move(text)), _filename(std::move(filename)), _pos(0), _line(1)
+    {
+    }
+    /** Reads the next token
+     *
+     * @param[out] token  Token read
+     * @param[out] quoted True if the token was a quoted string
+     *
+     * @return False at the end of the file
+     */
+    bool next(std::string &token, bool &quoted)
+    {
+        skip_blanks();
+        quoted = false;
+        token.clear();
+        if(_pos >= _text.size())
+        {
+            return false;
+        }
+        const char c = _text[_pos];
+        if(c == '{' || c == '}' || c == ':')
+        {
+            token = std::string(1, c);
+            ++_pos;
+        }
+        else if(c == '"' || c == '\'')
+        {
+            quoted = true;
+            for(++_pos; _pos < _text.size() && _text[_pos] != c; ++_pos)
+            {
+                if(_text[_pos] == '\\' && _pos + 1 < _text.size())
+                {
+                    ++_pos;
+                }
+                token += _text[_pos];
+            }
+            ARM_COMPUTE_EXIT_ON_MSG(_pos >= _text.size(), "Unterminated string in %s at line %u", _filename.c_str(), _line);
+            ++_pos;
+        }
+        else
+        {
+            while(_pos < _text.size() && !std::isspace(static_cast<unsigned char>(_text[_pos])) && std::string("{}:#\"'").find(_text[_pos]) == std::string::npos)
+            {
+                token += _text[_pos++];
+            }
+        }
+        return true;
+    }
+    /** Line of the last token, for the error messages */
+    unsigned int line() const
+    {
+        return _line;
+    }
+    /** Name of the file, for the error messages */
+    const std::string &filename() const
+    {
+        return _filename;
+    }
+
+private:
+    void skip_blanks()
+    {
+        while(_pos < _text.size())
+        {
+            if(_text[_pos] == '#')
+            {
+                while(_pos < _text.size() && _text[_pos] != '\n')
+                {
+                    ++_pos;
+                }
+            }
+            else if(std::isspace(static_cast<unsigned char>(_text[_pos])))
+            {
+                _line += (_text[_pos] == '\n') ? 1 : 0;
+                ++_pos;
+            }
+            else
+            {
+                break;
+            }
+        }
+    }
+
+    std::string  _text;
+    std::string  _filename;
+    size_t       _pos;
+    unsigned int _line;
+};
+
+/** Parses the fields of a message up to its closing brace, or up to the end of the file for the top level message */
+inline void parse_prototxt_fields(PrototxtTokenizer &tokenizer, PrototxtMessage &message, bool top_level)
+{
+    std::string name;
+    bool        quoted = false;
+    while(tokenizer.next(name, quoted))
+    {
+        if(name == "}" && !quoted)
+        {
+            ARM_COMPUTE_EXIT_ON_MSG(top_level, "Unexpected '}' in %s at line %u", tokenizer.filename().c_str(), tokenizer.line());
+            return;
+        }
+        ARM_COMPUTE_EXIT_ON_MSG(quoted || name == "{" || name == ":", "Expected a field name in %s at line %u", tokenizer.filename().c_str(), tokenizer.line());
+
+        // "name: value", "name: { ... }" or "name { ... }"
+        std::string value;
+        ARM_COMPUTE_EXIT_ON_MSG(!tokenizer.next(value, quoted), "Missing value of %s in %s", name.c_str(), tokenizer.filename().c_str());
+        if(value == ":" && !quoted)
+        {
+            ARM_COMPUTE_EXIT_ON_MSG(!tokenizer.next(value, quoted), "Missing value of %s in %s", name.c_str(), tokenizer.filename().c_str());
+        }
+        if(value == "{" && !quoted)
+        {
+            message.messages.emplace_back(name, PrototxtMessage());
+            parse_prototxt_fields(tokenizer, message.messages.back().second, false);
+        }
+        else
+        {
+            ARM_COMPUTE_EXIT_ON_MSG(!quoted && (value == "}" || value == ":"), "Missing value of %s in %s at line %u", name.c_str(), tokenizer.filename().c_str(), tokenizer.line());
+            message.values.emplace_back(name, value);
+        }
+    }
+    ARM_COMPUTE_EXIT_ON_MSG(!top_level, "Missing '}' at the end of %s", tokenizer.filename().c_str());
+}
+} // namespace detail
+
+/** Reads a protobuf text format file, exits with an error if it cannot be read or parsed
+ *
+ * @param[in] filename File to read, e.g. a Caffe prototxt
+ *
+ * @return The top level message
+ */
+inline PrototxtMessage parse_prototxt(const std::string &filename)
+{
+    std::ifstream ifs(filename);
+    ARM_COMPUTE_EXIT_ON_MSG(!ifs.is_open(), "Cannot open %s", filename.c_str());
+    std::stringstream text;
+    text << ifs.rdbuf();
+
+    PrototxtMessage           message;
+    detail::PrototxtTokenizer tokenizer(text.str(), filename);
+    detail::parse_prototxt_fields(tokenizer, message, true);
+    return message;
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_PROTOTXT_H__ */
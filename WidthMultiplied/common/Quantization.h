@@ -0,0 +1,462 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_QUANTIZATION_H__
+#define __WIDTH_MULTIPLIED_QUANTIZATION_H__
+
+#include "arm_compute/core/Error.h"
+#include "arm_compute/core/Helpers.h"
+#include "arm_compute/core/ITensor.h"
+#include "arm_compute/core/Types.h"
+#include "arm_compute/core/Utils.h"
+#include "arm_compute/core/Window.h"
+#include "arm_compute/graph.h"
+#include "arm_compute/runtime/Tensor.h"
+#include "support/ToolchainSupport.h"
+
+#include "common/BatchNormFolding.h"
+#include "common/SyntheticWeights.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <memory>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Quantization of a layer of a QASYMM8 graph */
+struct LayerQuantization
+{
+    arm_compute::QuantizationInfo weights{}; /**< Quantization of the weights, empty to keep the synthetic or trained one */
+    arm_compute::QuantizationInfo output{};  /**< Quantization of the output, empty to keep the synthetic or trained one */
+};
+
+/** Process-wide per-layer quantization parameters of the QASYMM8 graphs
+ *
+ * Without a calibration file, the parameters are synthetic: the weights of a layer are quantized
+ * over +/-4 standard deviations of the synthetic weights (sqrt(2 / fan_in)), the activations over
+ * [-10, 10] and the input over [-1, 1], the ranges of the AndroidNN QASYMM8 MobileNet. A calibration
+ * file overrides them layer by layer. It is a CSV with a header line and one row per layer:
+ *
+ *     layer,weights_scale,weights_offset,output_scale,output_offset
+ *     input,,,0.0078125,128
+ *     Conv2d_0,0.031778,156,0.078431,128
+ *
+ * where the layer is the name of a convolution, depthwise convolution or fully connected layer,
+ * of any other layer for its output, or "input" for the input of the graph, and empty fields keep
+ * the synthetic or trained values. graph_calibration writes such files from a calibration set.
+ */
+class QuantizationParams
+{
+public:
+    /** Gets the process-wide parameters
+     *
+     * @return The parameters
+     */
+    static QuantizationParams &get()
+    {
+        static QuantizationParams instance;
+        return instance;
+    }
+    /** Loads a calibration file, exits with an error if it cannot be read
+     *
+     * @param[in] filename Calibration file, empty for the synthetic parameters only
+     */
+    void configure(const std::string &filename)
+    {
+        if(filename == _filename)
+        {
+            return;
+        }
+        _filename = filename;
+        _layers.clear();
+        if(filename.empty())
+        {
+            return;
+        }
+
+        std::ifstream ifs(filename);
+        ARM_COMPUTE_EXIT_ON_MSG(!ifs.is_open(), "Cannot open the calibration file %s", filename.c_str());
+        std::string line;
+        bool        header = true;
+        while(std::getline(ifs, line))
+        {
+            if(line.empty() || line[0] == '#')
+            {
+                continue;
+            }
+            if(header)
+            {
+                header = false;
+                continue;
+            }
+            std::vector<std::string> fields;
+            std::stringstream        ss(line);
+            std::string              field;
+            while(std::getline(ss, field, ','))
+            {
+                fields.push_back(field);
+            }
+            fields.resize(5);
+            ARM_COMPUTE_EXIT_ON_MSG(fields[0].empty(), "Missing layer name in %s: %s", filename.c_str(), line.c_str());
+            LayerQuantization &layer = _layers[fields[0]];
+            layer.weights            = parse_quantization(fields[1], fields[2], line);
+            layer.output             = parse_quantization(fields[3], fields[4], line);
+        }
+    }
+    /** Returns true if a calibration file is loaded */
+    bool is_calibrated() const
+    {
+        return !_filename.empty();
+    }
+    /** Calibration file, empty if none */
+    const std::string &filename() const
+    {
+        return _filename;
+    }
+    /** Returns the calibrated parameters of a layer
+     *
+     * @param[in] name Name of the layer, "input" for the input of the graph
+     *
+     * @return The parameters, empty if the layer is not calibrated
+     */
+    LayerQuantization layer(const std::string &name) const
+    {
+        const auto it = _layers.find(name);
+        return (it != _layers.end()) ? it->second : LayerQuantization();
+    }
+    /** Synthetic quantization of the input of a graph */
+    static arm_compute::QuantizationInfo synthetic_input()
+    {
+        return arm_compute::QuantizationInfo(0.0078125f, 128);
+    }
+    /** Synthetic quantization of the output of a layer */
+    static arm_compute::QuantizationInfo synthetic_activations()
+    {
+        return arm_compute::QuantizationInfo(0.0784313753247f, 128);
+    }
+    /** Synthetic quantization of the weights of a layer
+     *
+     * @param[in] fan_in Number of weights per output channel
+     *
+     * @return The quantization covering +/-4 standard deviations of the synthetic weights
+     */
+    static arm_compute::QuantizationInfo synthetic_weights(size_t fan_in)
+    {
+        const float deviation = std::sqrt(2.f / std::max<size_t>(fan_in, 1));
+        return arm_compute::QuantizationInfo(8.f * deviation / 255.f, 128);
+    }
+
+private:
+    QuantizationParams()
+        : _filename(), _layers()
+    {
+    }
+
+    arm_compute::QuantizationInfo parse_quantization(const std::string &scale, const std::string &offset, const std::string &line) const
+    {
+        if(scale.empty() && offset.empty())
+        {
+            return arm_compute::QuantizationInfo();
+        }
+        char       *end   = nullptr;
+        const float value = std::strtof(scale.c_str(), &end);
+        ARM_COMPUTE_EXIT_ON_MSG(scale.empty() || *end != '\0' || value <= 0.f, "Invalid scale in %s: %s", _filename.c_str(), line.c_str());
+        const long zero = std::strtol(offset.c_str(), &end, 10);
+        ARM_COMPUTE_EXIT_ON_MSG(offset.empty() || *end != '\0' || zero < 0 || zero > 255, "Invalid offset in %s: %s", _filename.c_str(), line.c_str());
+        return arm_compute::QuantizationInfo(value, static_cast<int>(zero));
+    }
+
+    std::string                              _filename;
+    std::map<std::string, LayerQuantization> _layers;
+};
+
+/** Accessor filling a QASYMM8 or S32 tensor with the quantized values of a F32 accessor
+ *
+ * The F32 accessor fills a temporary tensor of the same shape and layout, whose values are then
+ * quantized with the quantization info of the tensor: QASYMM8 weights with their own, S32 biases
+ * with the product of the scales of the input and of the weights, set by @ref QuantizationMutator.
+ */
+class QuantizingAccessor final : public arm_compute::graph::ITensorAccessor
+{
+public:
+    /** Constructor
+     *
+     * @param[in] accessor Accessor of the F32 values, nullptr for zeros
+     */
+    explicit QuantizingAccessor(std::unique_ptr<arm_compute::graph::ITensorAccessor> accessor)
+        : _accessor(std::move(accessor))
+    {
+    }
+    /** Allow instances of this class to be move constructed */
+    QuantizingAccessor(QuantizingAccessor &&) = default;
+
+    // Inherited methods overriden:
+    bool access_tensor(arm_compute::ITensor &tensor) override
+    {
+        using namespace arm_compute;
+
+        const ITensorInfo &info = *tensor.info();
+        TensorInfo         values_info(info.tensor_shape(), 1, DataType::F32);
+        values_info.set_data_layout(info.data_layout());
+        Tensor values;
+        values.allocator()->init(values_info);
+        values.allocator()->allocate();
+        std::memset(values.buffer(), 0, values.info()->total_size());
+        if(_accessor != nullptr)
+        {
+            _accessor->access_tensor(values);
+        }
+
+        const QuantizationInfo qinfo = info.quantization_info();
+        Window                 window;
+        window.use_tensor_dimensions(info.tensor_shape());
+        Iterator in(&values, window);
+        Iterator out(&tensor, window);
+        if(info.data_type() == DataType::S32)
+        {
+            execute_window_loop(window, [&](const Coordinates &)
+            {
+                const float value                         = *reinterpret_cast<const float *>(in.ptr());
+                *reinterpret_cast<int32_t *>(out.ptr()) = (qinfo.scale > 0.f) ? static_cast<int32_t>(std::lround(value / qinfo.scale)) : 0;
+            },
+            in, out);
+        }
+        else
+        {
+            execute_window_loop(window, [&](const Coordinates &)
+            {
+                *out.ptr() = qinfo.quantize(*reinterpret_cast<const float *>(in.ptr()), RoundingPolicy::TO_NEAREST_UP);
+            },
+            in, out);
+        }
+        return true;
+    }
+
+private:
+    std::unique_ptr<arm_compute::graph::ITensorAccessor> _accessor;
+};
+
+/** Graph mutator turning a graph built with the QASYMM8 data type into one ACL 18.08 can run
+ *
+ * ACL 18.08 has no QASYMM8 batch normalization nor normalization layer. Like the deployed int8
+ * models, the batch normalizations are folded into the convolution feeding them when the weights
+ * are quantized when loaded (see @ref BatchNormFoldingMutator), or dropped otherwise, and so are
+ * the cross-map normalizations of GoogLeNet. Then every tensor gets its quantization, in the order
+ * the layers were added: the input and the weights keep the one they were built with or get a
+ * synthetic one, the outputs of the convolutions, depthwise convolutions and fully connected
+ * layers get the synthetic one unless @p synthetic_outputs is false, the other layers propagate
+ * the quantization of their inputs, and the calibrated parameters of @ref QuantizationParams
+ * override all of them. Unless the weights are already quantized, their accessors are wrapped in a
+ * @ref QuantizingAccessor, so the F32 weights, trained or synthetic, are quantized when loaded.
+ */
+class QuantizationMutator final : public arm_compute::graph::IGraphMutator
+{
+public:
+    /** Constructor
+     *
+     * @param[in] synthetic_outputs Give the synthetic quantization to the outputs of the layers with weights, false to keep the ones they were built with
+     * @param[in] quantize_weights  Quantize the weights and biases from F32 accessors, false if the accessors fill QASYMM8 and S32 tensors
+     */
+    QuantizationMutator(bool synthetic_outputs, bool quantize_weights)
+        : _synthetic_outputs(synthetic_outputs), _quantize_weights(quantize_weights), _folded(0), _removed(0)
+    {
+    }
+    /** Number of batch normalizations folded so far */
+    unsigned int folded() const
+    {
+        return _folded;
+    }
+    /** Number of batch normalization and normalization layers removed so far */
+    unsigned int removed() const
+    {
+        return _removed;
+    }
+
+    // Inherited methods overriden:
+    virtual void mutate(arm_compute::graph::Graph &g) override
+    {
+        using namespace arm_compute::graph;
+
+        // Folded weights are F32 values, they can only be folded into weights quantized when loaded
+        if(_quantize_weights)
+        {
+            BatchNormFoldingMutator folding(std::vector<NodeID>(), true);
+            folding.mutate(g);
+            _folded += folding.folded();
+        }
+        for(NodeID id = 0; id < g.nodes().size(); ++id)
+        {
+            INode *node = g.node(id);
+            if(node != nullptr && (node->type() == NodeType::BatchNormalizationLayer || node->type() == NodeType::NormalizationLayer))
+            {
+                remove_layer(g, *node);
+            }
+        }
+
+        const QuantizationParams &params = QuantizationParams::get();
+        std::set<TensorID>        quantized;
+        for(NodeID id = 0; id < g.nodes().size(); ++id)
+        {
+            INode *node = g.node(id);
+            if(node == nullptr || node->type() == NodeType::Const)
+            {
+                continue;
+            }
+            if(node->type() == NodeType::Input)
+            {
+                TensorDescriptor &desc       = node->output(0)->desc();
+                const auto        calibrated = params.layer("input").output;
+                desc.quant_info              = !calibrated.empty() ? calibrated : desc.quant_info.empty() ? QuantizationParams::synthetic_input() : desc.quant_info;
+                continue;
+            }
+
+            const bool has_weights = node->type() == NodeType::ConvolutionLayer || node->type() == NodeType::DepthwiseConvolutionLayer
+                                     || node->type() == NodeType::FullyConnectedLayer;
+            const LayerQuantization calibrated = params.layer(node->name());
+
+            // The groups of a grouped convolution share the weights and bias they are split from, quantized once
+            arm_compute::graph::Tensor *weights = has_weights ? get_const_source(g, *node, 1) : nullptr;
+            if(weights != nullptr)
+            {
+                TensorDescriptor &desc = weights->desc();
+                if(quantized.insert(weights->id()).second)
+                {
+                    const size_t fan_in = synthetic_fan_in(desc.shape, desc.layout, weight_kind(node->type()));
+                    desc.quant_info     = !calibrated.weights.empty() ? calibrated.weights : desc.quant_info.empty() ? QuantizationParams::synthetic_weights(fan_in) : desc.quant_info;
+                    if(_quantize_weights)
+                    {
+                        weights->set_accessor(arm_compute::support::cpp14::make_unique<QuantizingAccessor>(weights->extract_accessor()));
+                    }
+                }
+                node->input(1)->desc().quant_info = desc.quant_info;
+            }
+            arm_compute::graph::Tensor *bias = (weights != nullptr) ? get_const_source(g, *node, 2) : nullptr;
+            if(bias != nullptr)
+            {
+                bias->desc().data_type            = arm_compute::DataType::S32;
+                bias->desc().quant_info           = arm_compute::QuantizationInfo(node->input(0)->desc().quant_info.scale * weights->desc().quant_info.scale, 0);
+                node->input(2)->desc().data_type  = arm_compute::DataType::S32;
+                node->input(2)->desc().quant_info = bias->desc().quant_info;
+                if(quantized.insert(bias->id()).second && _quantize_weights)
+                {
+                    bias->set_accessor(arm_compute::support::cpp14::make_unique<QuantizingAccessor>(bias->extract_accessor()));
+                }
+            }
+
+            // Propagate the quantization of the inputs, then override the calibrated ones and the ones of the layers with weights
+            node->forward_descriptors();
+            if(node->num_outputs() > 0 && node->output(0) != nullptr)
+            {
+                TensorDescriptor &desc = node->output(0)->desc();
+                if(!calibrated.output.empty())
+                {
+                    desc.quant_info = calibrated.output;
+                }
+                else if(has_weights && _synthetic_outputs)
+                {
+                    desc.quant_info = QuantizationParams::synthetic_activations();
+                }
+            }
+        }
+    }
+    const char *name() override
+    {
+        return "QuantizationMutator";
+    }
+
+private:
+    void remove_layer(arm_compute::graph::Graph &g, arm_compute::graph::INode &node)
+    {
+        using namespace arm_compute::graph;
+
+        const Edge *input_edge = g.edge(node.input_edge_id(0));
+        if(input_edge == nullptr)
+        {
+            return;
+        }
+        const NodeID producer_id  = input_edge->producer_id();
+        const size_t producer_idx = input_edge->producer_idx();
+
+        std::vector<NodeIdxPair> consumers;
+        for(const auto &output_edge_id : node.output_edges())
+        {
+            const Edge *output_edge = g.edge(output_edge_id);
+            if(output_edge != nullptr)
+            {
+                consumers.push_back({ output_edge->consumer_id(), output_edge->consumer_idx() });
+            }
+        }
+        std::vector<NodeID> param_nodes;
+        for(size_t idx = 1; idx < node.num_inputs(); ++idx)
+        {
+            const Edge *param_edge = g.edge(node.input_edge_id(idx));
+            if(param_edge != nullptr)
+            {
+                param_nodes.push_back(param_edge->producer_id());
+            }
+        }
+        g.remove_node(node.id());
+        for(NodeID param_node : param_nodes)
+        {
+            g.remove_node(param_node);
+        }
+        for(const auto &consumer : consumers)
+        {
+            g.add_connection(producer_id, producer_idx, consumer.node_id, consumer.index);
+        }
+        ++_removed;
+    }
+
+    bool         _synthetic_outputs;
+    bool         _quantize_weights;
+    unsigned int _folded;
+    unsigned int _removed;
+};
+
+/** Quantizes a graph built with a QASYMM8 data type, does nothing for the other data types
+ *
+ * @param[in,out] g                 Graph built by the frontend, not finalized yet
+ * @param[in]     data_type         Data type the graph was built with
+ * @param[in]     synthetic_outputs Give the synthetic quantization to the outputs of the layers with weights, false to keep the ones they were built with
+ * @param[in]     quantize_weights  Quantize the weights and biases from F32 accessors, false if the accessors fill QASYMM8 and S32 tensors
+ */
+inline void apply_quantization(arm_compute::graph::Graph &g, arm_compute::DataType data_type, bool synthetic_outputs, bool quantize_weights)
+{
+    if(!arm_compute::is_data_type_quantized_asymmetric(data_type))
+    {
+        return;
+    }
+    QuantizationMutator mutator(synthetic_outputs, quantize_weights);
+    mutator.mutate(g);
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_QUANTIZATION_H__ */
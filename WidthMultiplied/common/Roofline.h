@@ -0,0 +1,325 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_ROOFLINE_H__
+#define __WIDTH_MULTIPLIED_ROOFLINE_H__
+
+#include "arm_compute/graph.h"
+#include "arm_compute/runtime/CL/CLFunctions.h"
+#include "arm_compute/runtime/CL/CLScheduler.h"
+#include "arm_compute/runtime/CL/CLTensor.h"
+#include "arm_compute/runtime/NEON/NEFunctions.h"
+#include "arm_compute/runtime/Tensor.h"
+#include "utils/Utils.h"
+
+#include "common/GraphCost.h"
+#include "common/SweepReport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Compute and bandwidth ceilings of a roofline */
+struct RooflineCeilings
+{
+    double peak_gflops{ 0 };         /**< Compute ceiling, in GFLOP/s */
+    double peak_bandwidth_gbps{ 0 }; /**< Memory bandwidth ceiling, in GB/s */
+
+    /** Arithmetic intensity at which a kernel stops being memory bound
+     *
+     * @return The ridge point in FLOP/byte
+     */
+    double ridge_point() const
+    {
+        return (peak_bandwidth_gbps > 0) ? peak_gflops / peak_bandwidth_gbps : 0;
+    }
+};
+
+/** A layer placed on the roofline */
+struct RooflinePoint
+{
+    std::string name{};                 /**< Layer name */
+    std::string type{};                 /**< Operator type */
+    double      intensity{ 0 };         /**< Arithmetic intensity, in FLOP/byte */
+    double      gflops{ 0 };            /**< Achieved GFLOP/s */
+    double      bandwidth_gbps{ 0 };    /**< Achieved memory traffic, in GB/s */
+    double      attainable_gflops{ 0 }; /**< Roofline bound at this intensity, in GFLOP/s */
+    double      roof_fraction{ 0 };     /**< Fraction of the roof reached */
+    bool        memory_bound{ true };   /**< True if the intensity is below the ridge point */
+};
+
+namespace detail
+{
+/** Times a function, keeping the fastest of several runs
+ *
+ * @param[in] func        Function to time
+ * @param[in] sync        Waits for the completion of the function
+ * @param[in] repetitions Number of timed runs
+ *
+ * @return Fastest run in milliseconds
+ */
+template <typename F>
+double best_time_ms(F &func, const std::function<void()> &sync, unsigned int repetitions)
+{
+    // Untimed run to page in the buffers and compile the kernels
+    func.run();
+    sync();
+
+    double best = std::numeric_limits<double>::max();
+    for(unsigned int i = 0; i < repetitions; ++i)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        func.run();
+        sync();
+        best = std::min(best, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+    }
+    return best;
+}
+
+/** Measures the ceilings with a square GEMM (compute) and an element-wise addition of large vectors (bandwidth)
+ *
+ * @param[in] data_type       Data type of the operands
+ * @param[in] sync            Waits for the completion of the functions
+ * @param[in] gemm_size       M, N and K of the GEMM
+ * @param[in] stream_elements Elements of each operand of the addition, large enough to spill all the caches
+ * @param[in] repetitions     Number of timed runs of each function
+ *
+ * @return The measured ceilings
+ */
+template <typename TensorType, typename GEMMType, typename AdditionType>
+RooflineCeilings measure_ceilings(arm_compute::DataType data_type, const std::function<void()> &sync, unsigned int gemm_size, unsigned int stream_elements, unsigned int repetitions)
+{
+    using namespace arm_compute;
+
+    RooflineCeilings ceilings;
+
+    TensorType a, b, d;
+    a.allocator()->init(TensorInfo(TensorShape(gemm_size, gemm_size), 1, data_type));
+    b.allocator()->init(TensorInfo(TensorShape(gemm_size, gemm_size), 1, data_type));
+    d.allocator()->init(TensorInfo(TensorShape(gemm_size, gemm_size), 1, data_type));
+    GEMMType gemm;
+    gemm.configure(&a, &b, nullptr, &d, 1.f, 0.f);
+    a.allocator()->allocate();
+    b.allocator()->allocate();
+    d.allocator()->allocate();
+    arm_compute::utils::fill_random_tensor(a, -1.f, 1.f);
+    arm_compute::utils::fill_random_tensor(b, -1.f, 1.f);
+
+    const double gemm_ms = best_time_ms(gemm, sync, repetitions);
+    ceilings.peak_gflops = 2.0 * gemm_size * gemm_size * gemm_size / (gemm_ms * 1e6);
+
+    TensorType x, y, z;
+    x.allocator()->init(TensorInfo(TensorShape(stream_elements), 1, data_type));
+    y.allocator()->init(TensorInfo(TensorShape(stream_elements), 1, data_type));
+    z.allocator()->init(TensorInfo(TensorShape(stream_elements), 1, data_type));
+    AdditionType add;
+    add.configure(&x, &y, &z, ConvertPolicy::SATURATE);
+    x.allocator()->allocate();
+    y.allocator()->allocate();
+    z.allocator()->allocate();
+    arm_compute::utils::fill_random_tensor(x, -1.f, 1.f);
+    arm_compute::utils::fill_random_tensor(y, -1.f, 1.f);
+
+    // Two reads and one write per element
+    const double add_ms          = best_time_ms(add, sync, repetitions);
+    ceilings.peak_bandwidth_gbps = 3.0 * stream_elements * data_size_from_type(data_type) / (add_ms * 1e6);
+
+    return ceilings;
+}
+} // namespace detail
+
+/** Measures the roofline ceilings of a target with the library's own functions
+ *
+ * The compute ceiling is the throughput of a 1024x1024x1024 GEMM and the bandwidth ceiling the
+ * traffic of an element-wise addition of 4M-element vectors, both on the same backend, thread
+ * count and data type as the graphs. They are the achievable rather than the theoretical peaks.
+ * Must be called after a graph has been finalized on the target, so that its backend (and the
+ * OpenCL scheduler) is already initialized.
+ *
+ * @param[in] target    Execution target
+ * @param[in] data_type Data type of the graphs. QASYMM8 graphs are measured against F32 ceilings
+ *
+ * @return The measured ceilings
+ */
+inline RooflineCeilings measure_roofline_ceilings(arm_compute::graph::Target target, arm_compute::DataType data_type)
+{
+    using namespace arm_compute;
+    using namespace arm_compute::graph;
+
+    constexpr unsigned int gemm_size       = 1024;
+    constexpr unsigned int stream_elements = 4 * 1024 * 1024;
+    constexpr unsigned int repetitions     = 5;
+
+    const DataType ceiling_data_type = (data_type == DataType::F16) ? DataType::F16 : DataType::F32;
+    if(target == Target::CL)
+    {
+        return detail::measure_ceilings<CLTensor, CLGEMM, CLArithmeticAddition>(ceiling_data_type, []()
+        {
+            CLScheduler::get().sync();
+        },
+        gemm_size, stream_elements, repetitions);
+    }
+    return detail::measure_ceilings<arm_compute::Tensor, NEGEMM, NEArithmeticAddition>(ceiling_data_type, []()
+    {
+    },
+    gemm_size, stream_elements, repetitions);
+}
+
+/** Places a layer (or a whole graph) on the roofline
+ *
+ * @param[in] name     Layer name
+ * @param[in] type     Operator type
+ * @param[in] cost     Analytical cost of the layer
+ * @param[in] time_ms  Measured time of the layer
+ * @param[in] ceilings Roofline ceilings
+ *
+ * @return The roofline point
+ */
+inline RooflinePoint make_roofline_point(const std::string &name, const std::string &type, const LayerCost &cost, double time_ms, const RooflineCeilings &ceilings)
+{
+    RooflinePoint point;
+    point.name = name;
+    point.type = type;
+
+    const double flops   = 2.0 * static_cast<double>(cost.macs);
+    const double traffic = static_cast<double>(cost.traffic_bytes());
+    point.intensity      = (traffic > 0) ? flops / traffic : 0;
+    if(time_ms > 0)
+    {
+        point.gflops         = flops / (time_ms * 1e6);
+        point.bandwidth_gbps = traffic / (time_ms * 1e6);
+    }
+    point.attainable_gflops = std::min(ceilings.peak_gflops, point.intensity * ceilings.peak_bandwidth_gbps);
+    point.memory_bound      = point.intensity < ceilings.ridge_point();
+
+    // Layers without arithmetic (pooling, activations, ...) are measured against the bandwidth roof
+    if(cost.macs == 0)
+    {
+        point.roof_fraction = (ceilings.peak_bandwidth_gbps > 0) ? point.bandwidth_gbps / ceilings.peak_bandwidth_gbps : 0;
+    }
+    else
+    {
+        point.roof_fraction = (point.attainable_gflops > 0) ? point.gflops / point.attainable_gflops : 0;
+    }
+    return point;
+}
+
+/** Places every profiled layer of a variant, followed by the whole graph, on the roofline
+ *
+ * @param[in] result   Sweep result, with layer profiles
+ * @param[in] ceilings Roofline ceilings
+ *
+ * @return One point per layer, in execution order, and a last "total" point for the whole graph
+ */
+inline std::vector<RooflinePoint> make_roofline(const SweepResult &result, const RooflineCeilings &ceilings)
+{
+    std::vector<RooflinePoint> points;
+    for(const auto &layer : result.layers)
+    {
+        points.push_back(make_roofline_point(layer.name, layer.type, layer.cost, layer.stats.median, ceilings));
+    }
+    points.push_back(make_roofline_point("total", "Graph", result.cost, result.stats.median, ceilings));
+    return points;
+}
+
+/** Prints the roofline of every variant
+ *
+ * @param[out] os       Output stream
+ * @param[in]  results  Sweep results, with layer profiles
+ * @param[in]  ceilings Roofline ceilings
+ */
+inline void print_roofline(std::ostream &os, const std::vector<SweepResult> &results, const RooflineCeilings &ceilings)
+{
+    const std::ios_base::fmtflags flags = os.flags();
+    os << std::fixed << std::setprecision(2) << "Roofline ceilings : " << ceilings.peak_gflops << " GFLOP/s, " << ceilings.peak_bandwidth_gbps << " GB/s, ridge point "
+       << ceilings.ridge_point() << " FLOP/B" << std::endl;
+    os.flags(flags);
+
+    for(const auto &result : results)
+    {
+        const std::vector<RooflinePoint> points = make_roofline(result, ceilings);
+
+        size_t name_width = 5;
+        for(const auto &point : points)
+        {
+            name_width = std::max(name_width, point.name.size());
+        }
+
+        os << "Roofline of " << result.variant << std::endl;
+        os << std::left << std::setw(name_width + 2) << "name" << std::setw(28) << "type"
+           << std::right << std::setw(10) << "FLOP/B" << std::setw(10) << "GFLOP/s" << std::setw(10) << "GB/s" << std::setw(12) << "roof GF/s" << std::setw(8) << "roof"
+           << "  bound" << std::endl;
+        for(const auto &point : points)
+        {
+            os << std::left << std::setw(name_width + 2) << point.name << std::setw(28) << point.type
+               << std::right << std::fixed << std::setprecision(2) << std::setw(10) << point.intensity << std::setw(10) << point.gflops << std::setw(10) << point.bandwidth_gbps
+               << std::setw(12) << point.attainable_gflops << std::setprecision(1) << std::setw(7) << point.roof_fraction * 100.f << "%"
+               << "  " << (point.memory_bound ? "memory" : "compute") << std::endl;
+            os.flags(flags);
+        }
+        os << std::endl;
+    }
+    os.flags(flags);
+}
+
+/** Writes the roofline of every variant as CSV
+ *
+ * @param[in] filename Output file
+ * @param[in] results  Sweep results, with layer profiles
+ * @param[in] ceilings Roofline ceilings
+ *
+ * @return True on success
+ */
+inline bool write_roofline_csv(const std::string &filename, const std::vector<SweepResult> &results, const RooflineCeilings &ceilings)
+{
+    std::ofstream ofs(filename);
+    if(!ofs.is_open())
+    {
+        std::cerr << "Cannot open " << filename << " for writing" << std::endl;
+        return false;
+    }
+    ofs << "# peak_gflops=" << ceilings.peak_gflops << ",peak_bandwidth_gbps=" << ceilings.peak_bandwidth_gbps << "\n";
+    ofs << "model,width,resolution,rounding,batch,batch_norm,fused_dwsc,channel_shuffle,grouped_conv,asymmetric_conv,layer,type,intensity,gflops,bandwidth_gbps,attainable_gflops,roof_fraction,bound\n";
+    ofs << std::setprecision(6);
+    for(const auto &result : results)
+    {
+        for(const auto &point : make_roofline(result, ceilings))
+        {
+            ofs << result.variant.model << "," << result.variant.width << "," << result.variant.resolution << "," << result.variant.rounding << "," << result.variant.batch << ","
+                << result.variant.batch_norm << "," << result.variant.dwsc_fusion << "," << result.variant.channel_shuffle << "," << result.variant.grouped_conv << "," << result.variant.asymmetric_conv << "," << point.name << "," << point.type << ","
+                << point.intensity << "," << point.gflops << "," << point.bandwidth_gbps << "," << point.attainable_gflops << "," << point.roof_fraction << ","
+                << (point.memory_bound ? "memory" : "compute") << "\n";
+        }
+    }
+    return ofs.good();
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_ROOFLINE_H__ */
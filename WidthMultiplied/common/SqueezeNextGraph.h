@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_SQUEEZENEXT_GRAPH_H__
+#define __WIDTH_MULTIPLIED_SQUEEZENEXT_GRAPH_H__
+
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+#include "utils/CommonGraphOptions.h"
+#include "utils/GraphUtils.h"
+
+#include "common/SweepUtils.h"
+
+#include <string>
+
+namespace width_multiplied
+{
+/** Builds SqueezeNext (1.0-SqNxt-23) into a graph stream for a given width and resolution multiplier
+ *
+ * A 7x7 convolution with stride 2 and max pooling, then four stages of 6, 6, 8 and 1 SqueezeNext blocks
+ * with 32, 64, 128 and 256 channels at width 1.0, the first block of the last three stages having a
+ * stride of 2; then a 1x1 convolution to 128 channels, the average pooling and a 1000 class classifier.
+ * A block is two 1x1 convolutions reducing the channels to a half and a quarter, a 1x3 and a 3x1
+ * convolution back to a half, and a 1x1 convolution to the channels of the block, each followed by a
+ * batch normalization and a ReLU, added to the input, or to its 1x1 projection when the block changes
+ * the shape. This is the ImageNet network sp_sqznext has one block of. Synthetic weights only.
+ */
+class SqueezeNextGraphBuilder
+{
+public:
+    /** Constructor
+     *
+     * @param[in] graph         Stream to add the layers to
+     * @param[in] common_params Common graph parameters
+     */
+    SqueezeNextGraphBuilder(arm_compute::graph::frontend::Stream &graph, const arm_compute::utils::CommonGraphParams &common_params)
+        : graph(graph), common_params(common_params), depth_scale(1.f, ChannelRounding())
+    {
+    }
+    /** Adds the whole network, from input to output layer, to the stream
+     *
+     * @param[in] variant Width, resolution and batch size to build
+     */
+    void create_graph(const GraphVariant &variant)
+    {
+        using namespace arm_compute::graph::frontend;
+        using namespace arm_compute::graph_utils;
+
+        // Create input descriptor
+        const TensorShape tensor_shape     = permute_shape(TensorShape(variant.resolution, variant.resolution, 3U, variant.batch), DataLayout::NCHW, common_params.data_layout);
+        TensorDescriptor  input_descriptor = TensorDescriptor(tensor_shape, common_params.data_type).set_layout(common_params.data_layout);
+
+        // Scale the channel counts by the width multiplier
+        depth_scale = ChannelScaler(variant.width, variant.rounding);
+
+        graph << common_params.target
+              << common_params.fast_math_hint
+              << InputLayer(input_descriptor, get_input_accessor(common_params))
+              << convolution("conv1", 7U, 7U, depth_scale(64U), PadStrideInfo(2, 2, 3, 3))
+              << batch_normalization("conv1/BatchNorm")
+              << relu("conv1/Relu")
+              << PoolingLayer(PoolingLayerInfo(PoolingType::MAX, 3, PadStrideInfo(2, 2, 1, 1))).set_name("pool1/MaxPool");
+
+        const unsigned int blocks[]   = { 6U, 6U, 8U, 1U };
+        const unsigned int channels[] = { 32U, 64U, 128U, 256U };
+        unsigned int       input      = 64U;
+        for(unsigned int stage = 0; stage < 4; ++stage)
+        {
+            for(unsigned int block = 0; block < blocks[stage]; ++block)
+            {
+                const unsigned int stride = (stage > 0 && block == 0) ? 2U : 1U;
+                add_block("stage" + arm_compute::support::cpp11::to_string(stage + 1) + "/block" + arm_compute::support::cpp11::to_string(block + 1) + "/",
+                          input, channels[stage], stride);
+                input = channels[stage];
+            }
+        }
+
+        graph << convolution("conv2", 1U, 1U, depth_scale(128U), PadStrideInfo(1, 1, 0, 0))
+              << batch_normalization("conv2/BatchNorm")
+              << relu("conv2/Relu")
+              << PoolingLayer(PoolingLayerInfo(PoolingType::AVG)).set_name("pool2")
+              << FullyConnectedLayer(1000U, Dummy(), Dummy()).set_name("fc")
+              << SoftmaxLayer().set_name("prob")
+              << OutputLayer(get_recorded_output_accessor(common_params, 5));
+    }
+
+private:
+    arm_compute::graph::frontend::Stream        &graph;
+    const arm_compute::utils::CommonGraphParams &common_params;
+    ChannelScaler                               depth_scale;
+
+    void add_block(const std::string &name, unsigned int input, unsigned int output, unsigned int stride)
+    {
+        using namespace arm_compute::graph::frontend;
+
+        SubStream right(graph);
+        right << convolution(name + "reduce1", 1U, 1U, depth_scale(output / 2), PadStrideInfo(stride, stride, 0, 0))
+              << batch_normalization(name + "reduce1/BatchNorm")
+              << relu(name + "reduce1/Relu")
+              << convolution(name + "reduce2", 1U, 1U, depth_scale(output / 4), PadStrideInfo(1, 1, 0, 0))
+              << batch_normalization(name + "reduce2/BatchNorm")
+              << relu(name + "reduce2/Relu")
+              << convolution(name + "conv1x3", 3U, 1U, depth_scale(output / 2), PadStrideInfo(1, 1, 1, 0))
+              << batch_normalization(name + "conv1x3/BatchNorm")
+              << relu(name + "conv1x3/Relu")
+              << convolution(name + "conv3x1", 1U, 3U, depth_scale(output / 2), PadStrideInfo(1, 1, 0, 1))
+              << batch_normalization(name + "conv3x1/BatchNorm")
+              << relu(name + "conv3x1/Relu")
+              << convolution(name + "expand", 1U, 1U, depth_scale(output), PadStrideInfo(1, 1, 0, 0))
+              << batch_normalization(name + "expand/BatchNorm")
+              << relu(name + "expand/Relu");
+
+        SubStream left(graph);
+        if(input != output || stride != 1)
+        {
+            left << convolution(name + "shortcut", 1U, 1U, depth_scale(output), PadStrideInfo(stride, stride, 0, 0))
+                 << batch_normalization(name + "shortcut/BatchNorm")
+                 << relu(name + "shortcut/Relu");
+        }
+
+        graph << BranchLayer(BranchMergeMethod::ADD, std::move(left), std::move(right)).set_name(name + "add")
+              << relu(name + "Relu");
+    }
+
+    static arm_compute::graph::frontend::ConvolutionLayer convolution(const std::string &name, unsigned int conv_width, unsigned int conv_height, unsigned int ofm, arm_compute::PadStrideInfo conv_info)
+    {
+        arm_compute::graph::frontend::ConvolutionLayer layer(conv_width, conv_height, ofm, Dummy(), std::unique_ptr<arm_compute::graph::ITensorAccessor>(nullptr), conv_info);
+        layer.set_name(name);
+        return layer;
+    }
+
+    static arm_compute::graph::frontend::BatchNormalizationLayer batch_normalization(const std::string &name)
+    {
+        arm_compute::graph::frontend::BatchNormalizationLayer layer(Dummy(), Dummy(), Dummy(), Dummy(), 0.001f);
+        layer.set_name(name);
+        return layer;
+    }
+
+    static arm_compute::graph::frontend::ActivationLayer relu(const std::string &name)
+    {
+        using namespace arm_compute::graph::frontend;
+
+        ActivationLayer layer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU));
+        layer.set_name(name);
+        return layer;
+    }
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_SQUEEZENEXT_GRAPH_H__ */
@@ -0,0 +1,458 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_SWEEP_OPTIONS_H__
+#define __WIDTH_MULTIPLIED_SWEEP_OPTIONS_H__
+
+#include "utils/CommonGraphOptions.h"
+
+#include "common/AsymmetricConv.h"
+#include "common/BatchNormFolding.h"
+#include "common/ChannelRounding.h"
+#include "common/ChannelShuffle.h"
+#include "common/CpuAffinity.h"
+#include "common/FusedDwsc.h"
+#include "common/GroupedPointwise.h"
+#include "common/Quantization.h"
+#include "common/SyntheticWeights.h"
+#include "common/WeightStore.h"
+
+#include <ostream>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Structure holding the sweep parameters */
+struct SweepParams
+{
+    std::vector<float>              widths{ 1.f };                                  /**< Width multipliers */
+    std::vector<unsigned int>       resolutions{ 224U };                            /**< Input resolutions */
+    std::vector<ChannelRounding>    roundings{ ChannelRounding() };                 /**< Channel roundings */
+    std::vector<unsigned int>       batches{ 1U };                                  /**< Batch sizes */
+    std::vector<BatchNormMode>      batch_norms{ BatchNormMode::Unfused };          /**< Batch normalization modes */
+    std::vector<DwscFusion>         dwsc_fusions{ DwscFusion() };                   /**< Depthwise separable blocks to fuse */
+    std::vector<ChannelShuffleMode> channel_shuffles{ ChannelShuffleMode::Acl };    /**< Channel shuffle modes */
+    std::vector<GroupedConvMode>    grouped_convs{ GroupedConvMode::Split };        /**< Grouped convolution modes */
+    std::vector<AsymmetricConvMode> asymmetric_convs{ AsymmetricConvMode::Gemm };   /**< Asymmetric convolution modes */
+    WeightFill                      weight_fill{ WeightFill::Random };              /**< Values of the synthetic weights */
+    unsigned int                    weight_seed{ 0 };                               /**< Seed of the synthetic weights */
+    ChannelSelection                channel_selection{ ChannelSelection::Leading }; /**< Channels kept when slicing the trained weights */
+    std::string                     quantization_file{};                            /**< Per-layer quantization of the QASYMM8 graphs, empty for the synthetic one */
+    bool                            adaptive_warmup{ true };                        /**< Warm up until the latency is steady instead of a fixed count */
+    unsigned int                    warmup_iterations{ 10 };                        /**< Untimed runs before measuring when the warm-up is fixed */
+    unsigned int                    warmup_window{ 5 };                             /**< Sliding window size of the adaptive warm-up */
+    double                          warmup_tolerance{ 0.05 };                       /**< Relative tolerance of the adaptive warm-up */
+    unsigned int                    max_warmup_iterations{ 200 };                   /**< Cap of the adaptive warm-up */
+    unsigned int                    iterations{ 20 };                               /**< Timed runs */
+    std::string                     csv_file{};                                     /**< Summary CSV output, empty to disable */
+    std::string                     json_file{};                                    /**< Per-iteration JSON output, empty to disable */
+    bool                            profile_layers{ false };                        /**< Time every layer in extra profiled runs */
+    std::string                     layer_csv_file{};                               /**< Per-layer CSV output, empty to disable */
+    bool                            annotate_layers{ false };                       /**< Emit a Streamline annotation for every layer */
+    bool                            roofline{ false };                              /**< Place every profiled layer on a measured roofline */
+    std::string                     roofline_csv_file{};                            /**< Roofline CSV output, empty to disable */
+    unsigned int                    streams{ 1 };                                   /**< Graphs run concurrently, 1 for the sequential sweep */
+    ThreadBudget                    thread_budget{ ThreadBudget::Shared };          /**< Split of the threads between the concurrent graphs */
+    std::vector<std::string>        cpu_sets{};                                     /**< CPU sets every variant is run on, empty for the process default */
+    std::vector<unsigned int>       thread_counts{};                                /**< Thread counts every variant is run with on each CPU set, empty for the default counts */
+    unsigned int                    memory_budget_mb{ 0 };                          /**< Variants estimated above it are skipped, 0 for the available memory */
+};
+
+/** Stream operator to print the sweep parameters
+ *
+ * @param[out] os     Output stream
+ * @param[in]  params Sweep parameters
+ *
+ * @return Modified output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, const SweepParams &params)
+{
+    os << "Widths : ";
+    for(float width : params.widths)
+    {
+        os << width << " ";
+    }
+    os << std::endl;
+    os << "Resolutions : ";
+    for(unsigned int resolution : params.resolutions)
+    {
+        os << resolution << " ";
+    }
+    os << std::endl;
+    os << "Channel roundings : ";
+    for(const auto &rounding : params.roundings)
+    {
+        os << rounding << " ";
+    }
+    os << std::endl;
+    os << "Batch sizes : ";
+    for(unsigned int batch : params.batches)
+    {
+        os << batch << " ";
+    }
+    os << std::endl;
+    os << "Batch normalization : ";
+    for(BatchNormMode batch_norm : params.batch_norms)
+    {
+        os << batch_norm << " ";
+    }
+    os << std::endl;
+    os << "Fused dwsc blocks : ";
+    for(const auto &fusion : params.dwsc_fusions)
+    {
+        os << fusion << " ";
+    }
+    os << std::endl;
+    os << "Channel shuffles : ";
+    for(ChannelShuffleMode shuffle : params.channel_shuffles)
+    {
+        os << shuffle << " ";
+    }
+    os << std::endl;
+    os << "Grouped convolutions : ";
+    for(GroupedConvMode grouped_conv : params.grouped_convs)
+    {
+        os << grouped_conv << " ";
+    }
+    os << std::endl;
+    os << "Asymmetric convolutions : ";
+    for(AsymmetricConvMode asymmetric_conv : params.asymmetric_convs)
+    {
+        os << asymmetric_conv << " ";
+    }
+    os << std::endl;
+    os << "Weights : " << params.weight_fill << " (seed " << params.weight_seed << ")" << std::endl;
+    os << "Channel selection : " << params.channel_selection << std::endl;
+    if(!params.quantization_file.empty())
+    {
+        os << "Quantization file : " << params.quantization_file << std::endl;
+    }
+    if(params.adaptive_warmup)
+    {
+        os << "Warm-up : adaptive (window " << params.warmup_window << ", tolerance " << params.warmup_tolerance
+           << ", max " << params.max_warmup_iterations << ")" << std::endl;
+    }
+    else
+    {
+        os << "Warm-up iterations : " << params.warmup_iterations << std::endl;
+    }
+    os << "Iterations : " << params.iterations << std::endl;
+    if(!params.csv_file.empty())
+    {
+        os << "CSV file : " << params.csv_file << std::endl;
+    }
+    if(!params.json_file.empty())
+    {
+        os << "JSON file : " << params.json_file << std::endl;
+    }
+    os << "Layer profiling : " << (params.profile_layers ? "enabled" : "disabled") << std::endl;
+    if(!params.layer_csv_file.empty())
+    {
+        os << "Layer CSV file : " << params.layer_csv_file << std::endl;
+    }
+    os << "Layer annotations : " << (params.annotate_layers ? "enabled" : "disabled") << std::endl;
+    os << "Roofline : " << (params.roofline ? "enabled" : "disabled") << std::endl;
+    if(!params.roofline_csv_file.empty())
+    {
+        os << "Roofline CSV file : " << params.roofline_csv_file << std::endl;
+    }
+    if(params.memory_budget_mb > 0)
+    {
+        os << "Memory budget (MB) : " << params.memory_budget_mb << std::endl;
+    }
+    if(!params.cpu_sets.empty())
+    {
+        os << "CPU sets : ";
+        for(const auto &cpu_set : params.cpu_sets)
+        {
+            os << cpu_set << " ";
+        }
+        os << std::endl;
+        os << "Thread counts : ";
+        for(unsigned int threads : params.thread_counts)
+        {
+            os << threads << " ";
+        }
+        os << (params.thread_counts.empty() ? "1, powers of 2 and all the CPUs of each set" : "") << std::endl;
+    }
+    if(params.streams > 1)
+    {
+        os << "Streams : " << params.streams << " (" << params.thread_budget << " threads)" << std::endl;
+    }
+    return os;
+}
+
+/** Sweep command line options used by the width multiplied examples
+ *
+ * --width=<list>             Width multipliers (default: 1.0)
+ * --resolution=<list>        Input resolutions (default: 224)
+ * --channel-rounding=<list>  Roundings of the scaled channel counts: truncate, multiple-<n>, make-divisible[-<n>] (default: truncate)
+ * --batch=<list>             Batch sizes (default: 1)
+ * --batch-norm=<list>        Batch normalizations after the convolutions: unfused (default) or folded into them
+ * --fused-dwsc=<list>        MobileNet depthwise separable blocks run as one fused function: none (default), all, or blocks such as 1-5+7
+ * --channel-shuffle=<list>   Execution of the channel shuffles of sp_shufflenet and the prototxts: acl (default), neon or fused
+ * --grouped-conv=<list>      Execution of the grouped 1x1 convolutions: split (default) or batched
+ * --asymmetric-conv=<list>   Execution of the 1xK and Kx1 convolutions: gemm (default) or direct
+ * --weights=<fill>           Synthetic weights: random (default) or none (left as allocated)
+ * --weights-seed=<n>         Seed of the random weights
+ * --channel-selection=<sel>  Channels kept when slicing the trained weights of --data: leading (default) or l1
+ * --quantization=<file>      Per-layer quantization of the QASYMM8 graphs, as written by a calibration (default: synthetic)
+ * --warmup=<n>               Fixed number of untimed runs of each graph (disables the adaptive warm-up)
+ * --warmup-window=<n>        Sliding window size of the adaptive warm-up
+ * --warmup-tolerance=<f>     Relative latency tolerance of the adaptive warm-up
+ * --warmup-max=<n>           Maximum number of adaptive warm-up runs
+ * --iterations=<n>           Timed runs of each graph, at least 1
+ * --csv=<file>               Write one summary row per configuration
+ * --json=<file>              Write every iteration latency of every configuration
+ * --profile-layers           Time every layer in extra runs after the timed ones
+ * --layer-csv=<file>         Write the per-layer timings of every configuration (implies --profile-layers)
+ * --annotate-layers          Emit a Streamline annotation for every layer of the timed and profiled runs
+ * --roofline                 Place every layer on a roofline measured on the same target (implies --profile-layers)
+ * --roofline-csv=<file>      Write the roofline of every configuration (implies --roofline)
+ * --memory-budget=<MB>       Skip the variants whose weights and intermediate tensors exceed it (default: the available memory)
+ * --affinity=<list>          CPU sets to run every variant on: all, big, little, or CPUs such as 0-3+6 (NEON only)
+ * --thread-counts=<list>     Thread counts to run every variant with on each CPU set (default: 1, powers of 2 and all the CPUs of the set)
+ * --streams=<k>              Run k graphs concurrently instead of sweeping them one after the other (default: 1)
+ * --stream-threads=<budget>  Threads of the concurrent graphs: shared (default) or partitioned
+ */
+class SweepOptions
+{
+public:
+    /** Constructor
+     *
+     * @param[in,out] parser A parser on which "parse()" hasn't been called yet.
+     */
+    SweepOptions(arm_compute::utils::CommandLineParser &parser)
+        : width(parser.add_option<arm_compute::utils::ListOption<float>>("width")),
+          resolution(parser.add_option<arm_compute::utils::ListOption<unsigned int>>("resolution")),
+          channel_rounding(parser.add_option<arm_compute::utils::ListOption<std::string>>("channel-rounding")),
+          batch(parser.add_option<arm_compute::utils::ListOption<unsigned int>>("batch")),
+          batch_norm(parser.add_option<arm_compute::utils::ListOption<BatchNormMode>>("batch-norm")),
+          fused_dwsc(parser.add_option<arm_compute::utils::ListOption<std::string>>("fused-dwsc")),
+          channel_shuffle(parser.add_option<arm_compute::utils::ListOption<ChannelShuffleMode>>("channel-shuffle")),
+          grouped_conv(parser.add_option<arm_compute::utils::ListOption<GroupedConvMode>>("grouped-conv")),
+          asymmetric_conv(parser.add_option<arm_compute::utils::ListOption<AsymmetricConvMode>>("asymmetric-conv")),
+          weights(parser.add_option<arm_compute::utils::EnumOption<WeightFill>>("weights", std::set<WeightFill> { WeightFill::None, WeightFill::Random }, WeightFill::Random)),
+          weights_seed(parser.add_option<arm_compute::utils::SimpleOption<unsigned int>>("weights-seed", 0)),
+          channel_selection(parser.add_option<arm_compute::utils::EnumOption<ChannelSelection>>("channel-selection", std::set<ChannelSelection> { ChannelSelection::Leading, ChannelSelection::L1 }, ChannelSelection::Leading)),
+          quantization(parser.add_option<arm_compute::utils::SimpleOption<std::string>>("quantization")),
+          warmup(parser.add_option<arm_compute::utils::SimpleOption<unsigned int>>("warmup", 10)),
+          warmup_window(parser.add_option<arm_compute::utils::SimpleOption<unsigned int>>("warmup-window", 5)),
+          warmup_tolerance(parser.add_option<arm_compute::utils::SimpleOption<float>>("warmup-tolerance", 0.05f)),
+          warmup_max(parser.add_option<arm_compute::utils::SimpleOption<unsigned int>>("warmup-max", 200)),
+          iterations(parser.add_option<arm_compute::utils::SimpleOption<unsigned int>>("iterations", 20)),
+          csv_file(parser.add_option<arm_compute::utils::SimpleOption<std::string>>("csv")),
+          json_file(parser.add_option<arm_compute::utils::SimpleOption<std::string>>("json")),
+          profile_layers(parser.add_option<arm_compute::utils::ToggleOption>("profile-layers")),
+          layer_csv_file(parser.add_option<arm_compute::utils::SimpleOption<std::string>>("layer-csv")),
+          annotate_layers(parser.add_option<arm_compute::utils::ToggleOption>("annotate-layers")),
+          roofline(parser.add_option<arm_compute::utils::ToggleOption>("roofline")),
+          roofline_csv_file(parser.add_option<arm_compute::utils::SimpleOption<std::string>>("roofline-csv")),
+          memory_budget(parser.add_option<arm_compute::utils::SimpleOption<unsigned int>>("memory-budget", 0)),
+          affinity(parser.add_option<arm_compute::utils::ListOption<std::string>>("affinity")),
+          thread_counts(parser.add_option<arm_compute::utils::ListOption<unsigned int>>("thread-counts")),
+          streams(parser.add_option<arm_compute::utils::SimpleOption<unsigned int>>("streams", 1)),
+          stream_threads(parser.add_option<arm_compute::utils::EnumOption<ThreadBudget>>("stream-threads", std::set<ThreadBudget> { ThreadBudget::Shared, ThreadBudget::Partitioned }, ThreadBudget::Shared))
+    {
+        width->set_help("Comma separated list of width multipliers to sweep (default: 1.0)");
+        resolution->set_help("Comma separated list of input resolutions to sweep (default: 224)");
+        channel_rounding->set_help("Comma separated list of roundings of the scaled channel counts to sweep: truncate, multiple-<n> (nearest multiple of n), "
+                                   "make-divisible[-<n>] (MobileNet's rule, n defaults to 8) (default: truncate)");
+        batch->set_help("Comma separated list of batch sizes to sweep, the images of a batch going through the graph in one run (default: 1)");
+        batch_norm->set_help("Comma separated list of batch normalization modes to sweep: unfused (separate layers) or folded (into the weights and bias "
+                             "of the convolution feeding them, mobilenet and resnet50) (default: unfused)");
+        fused_dwsc->set_help("Comma separated list of the MobileNet depthwise separable blocks to run as one fused function, with --target=NEON and F32: "
+                             "none, all, or blocks Conv2d_1 to Conv2d_13 and ranges joined by +, e.g. 1-5+7 (default: none)");
+        channel_shuffle->set_help("Comma separated list of the ways to execute the channel shuffles of sp_shufflenet and the prototxts, with --target=NEON: "
+                                  "acl (the function of the backend), neon (a NEON copy kernel) or fused (F32 only, read through by the grouped 1x1 "
+                                  "convolution that follows, the others with the NEON kernel) (default: acl)");
+        grouped_conv->set_help("Comma separated list of the ways to execute the grouped 1x1 convolutions of gconv_g<n>, sp_shufflenet and the prototxts: "
+                               "split (a split, one convolution per group and a concatenation) or batched (every group in one NEON dispatch, "
+                               "with --target=NEON and F32) (default: split)");
+        asymmetric_conv->set_help("Comma separated list of the ways to execute the 1xK and Kx1 convolutions of squeezenext, sp_sqznext and the prototxts: "
+                                  "gemm (the convolution function of the backend) or direct (a NEON direct convolution, with --target=NEON and F32) "
+                                  "(default: gemm)");
+        weights->set_help("Values of the synthetic weights: random (seeded, normal with a fan-in based deviation) or none (left as allocated, as DummyAccessor)");
+        weights_seed->set_help("Seed of the random synthetic weights");
+        channel_selection->set_help("Channels kept when the trained weights of --data are sliced for a width below 1.0: leading (the first channels of every layer) "
+                                    "or l1 (the channels whose filters have the largest L1 norm, mobilenet and vgg16 only)");
+        quantization->set_help("CSV file of the per-layer quantization of the QASYMM8 graphs (layer,weights_scale,weights_offset,output_scale,output_offset), "
+                               "overriding the synthetic one and the one of the trained MobileNet");
+        warmup->set_help("Fixed number of untimed runs of each graph. When not set, runs until the latency is steady");
+        warmup_window->set_help("Number of runs per sliding window of the adaptive warm-up");
+        warmup_tolerance->set_help("Maximum relative change between the median latency of two consecutive windows");
+        warmup_max->set_help("Maximum number of runs of the adaptive warm-up");
+        iterations->set_help("Number of timed runs of each graph, at least 1");
+        csv_file->set_help("File to write the per-configuration latency summary to, as CSV");
+        json_file->set_help("File to write the latency of every iteration to, as JSON");
+        profile_layers->set_help("Time every layer of each graph in extra runs after the timed ones");
+        layer_csv_file->set_help("File to write the per-layer timings to, as CSV. Enables the layer profiling");
+        annotate_layers->set_help("Emit a Streamline annotation for every layer of the timed and profiled runs");
+        roofline->set_help("Place every layer on a roofline whose ceilings are measured on the same target. Enables the layer profiling");
+        roofline_csv_file->set_help("File to write the roofline to, as CSV. Enables the roofline");
+        memory_budget->set_help("Memory in MB that the weights and intermediate tensors of a variant, without any reuse, may take; "
+                                "variants above it are skipped (default: the memory available when the variant is built)");
+        affinity->set_help("Comma separated list of CPU sets to run every variant on, with --target=NEON: all, the core types detected from sysfs "
+                           "(big, little, or cpu when every core is the same) or CPUs and ranges joined by +, e.g. 0-3+6");
+        thread_counts->set_help("Comma separated list of thread counts to run every variant with on each CPU set of --affinity (default: 1, "
+                                "the powers of 2 below the number of CPUs of the set and that number). Without --affinity, runs on all the CPUs");
+        streams->set_help("Number of graphs run concurrently, each in its own process, the swept variants being assigned to them in turn. "
+                          "Above 1, reports the per-stream latency and the aggregate throughput instead of sweeping");
+        stream_threads->set_help("Threads of the concurrent graphs: shared (every graph uses all the threads on any CPU) "
+                                 "or partitioned (every graph gets its share of the threads, pinned to its own CPUs)");
+    }
+    /** Prevent instances of this class from being copied (As this class contains pointers) */
+    SweepOptions(const SweepOptions &) = delete;
+    /** Prevent instances of this class from being copied (As this class contains pointers) */
+    SweepOptions &operator=(const SweepOptions &) = delete;
+    /** Allow instances of this class to be moved */
+    SweepOptions(SweepOptions &&) = default;
+    /** Allow instances of this class to be moved */
+    SweepOptions &operator=(SweepOptions &&) = default;
+    /** Default destructor */
+    ~SweepOptions() = default;
+
+    arm_compute::utils::ListOption<float>              *width;             /**< Width multipliers */
+    arm_compute::utils::ListOption<unsigned int>       *resolution;        /**< Input resolutions */
+    arm_compute::utils::ListOption<std::string>        *channel_rounding;  /**< Channel roundings */
+    arm_compute::utils::ListOption<unsigned int>       *batch;             /**< Batch sizes */
+    arm_compute::utils::ListOption<BatchNormMode>      *batch_norm;        /**< Batch normalization modes */
+    arm_compute::utils::ListOption<std::string>        *fused_dwsc;        /**< Depthwise separable blocks to fuse */
+    arm_compute::utils::ListOption<ChannelShuffleMode> *channel_shuffle;   /**< Channel shuffle modes */
+    arm_compute::utils::ListOption<GroupedConvMode>    *grouped_conv;      /**< Grouped convolution modes */
+    arm_compute::utils::ListOption<AsymmetricConvMode> *asymmetric_conv;   /**< Asymmetric convolution modes */
+    arm_compute::utils::EnumOption<WeightFill>         *weights;           /**< Synthetic weights */
+    arm_compute::utils::SimpleOption<unsigned int>     *weights_seed;      /**< Seed of the synthetic weights */
+    arm_compute::utils::EnumOption<ChannelSelection>   *channel_selection; /**< Channels kept when slicing the trained weights */
+    arm_compute::utils::SimpleOption<std::string>      *quantization;      /**< Per-layer quantization of the QASYMM8 graphs */
+    arm_compute::utils::SimpleOption<unsigned int>     *warmup;            /**< Fixed number of untimed runs */
+    arm_compute::utils::SimpleOption<unsigned int>     *warmup_window;     /**< Adaptive warm-up window */
+    arm_compute::utils::SimpleOption<float>            *warmup_tolerance;  /**< Adaptive warm-up tolerance */
+    arm_compute::utils::SimpleOption<unsigned int>     *warmup_max;        /**< Adaptive warm-up cap */
+    arm_compute::utils::SimpleOption<unsigned int>     *iterations;        /**< Timed runs */
+    arm_compute::utils::SimpleOption<std::string>      *csv_file;          /**< Summary CSV output */
+    arm_compute::utils::SimpleOption<std::string>      *json_file;         /**< Per-iteration JSON output */
+    arm_compute::utils::ToggleOption                   *profile_layers;    /**< Per-layer profiling */
+    arm_compute::utils::SimpleOption<std::string>      *layer_csv_file;    /**< Per-layer CSV output */
+    arm_compute::utils::ToggleOption                   *annotate_layers;   /**< Per-layer Streamline annotations */
+    arm_compute::utils::ToggleOption                   *roofline;          /**< Roofline report */
+    arm_compute::utils::SimpleOption<std::string>      *roofline_csv_file; /**< Roofline CSV output */
+    arm_compute::utils::SimpleOption<unsigned int>     *memory_budget;     /**< Memory budget of a variant */
+    arm_compute::utils::ListOption<std::string>        *affinity;          /**< CPU sets */
+    arm_compute::utils::ListOption<unsigned int>       *thread_counts;     /**< Thread counts per CPU set */
+    arm_compute::utils::SimpleOption<unsigned int>     *streams;           /**< Concurrent graphs */
+    arm_compute::utils::EnumOption<ThreadBudget>       *stream_threads;    /**< Split of the threads between the concurrent graphs */
+};
+
+/** Consumes the sweep options and creates a structure containing their values
+ *
+ * @param[in] options Options to consume
+ *
+ * @return Structure containing the sweep parameters
+ */
+inline SweepParams consume_sweep_parameters(SweepOptions &options)
+{
+    SweepParams params;
+    if(options.width->is_set())
+    {
+        params.widths = options.width->value();
+    }
+    if(options.resolution->is_set())
+    {
+        params.resolutions = options.resolution->value();
+    }
+    if(options.channel_rounding->is_set())
+    {
+        params.roundings.clear();
+        for(const auto &name : options.channel_rounding->value())
+        {
+            params.roundings.push_back(parse_channel_rounding(name));
+        }
+    }
+    if(options.batch->is_set())
+    {
+        params.batches = options.batch->value();
+    }
+    if(options.batch_norm->is_set())
+    {
+        params.batch_norms = options.batch_norm->value();
+    }
+    if(options.fused_dwsc->is_set())
+    {
+        params.dwsc_fusions.clear();
+        for(const auto &name : options.fused_dwsc->value())
+        {
+            params.dwsc_fusions.push_back(parse_dwsc_fusion(name));
+        }
+    }
+    if(options.channel_shuffle->is_set())
+    {
+        params.channel_shuffles = options.channel_shuffle->value();
+    }
+    if(options.grouped_conv->is_set())
+    {
+        params.grouped_convs = options.grouped_conv->value();
+    }
+    if(options.asymmetric_conv->is_set())
+    {
+        params.asymmetric_convs = options.asymmetric_conv->value();
+    }
+    params.weight_fill           = options.weights->value();
+    params.weight_seed           = options.weights_seed->value();
+    params.channel_selection     = options.channel_selection->value();
+    params.quantization_file     = options.quantization->value();
+    params.adaptive_warmup       = !options.warmup->is_set();
+    params.warmup_iterations     = options.warmup->value();
+    params.warmup_window         = options.warmup_window->value();
+    params.warmup_tolerance      = options.warmup_tolerance->value();
+    params.max_warmup_iterations = options.warmup_max->value();
+    params.iterations            = options.iterations->value();
+    params.csv_file              = options.csv_file->value();
+    params.json_file             = options.json_file->value();
+    params.layer_csv_file        = options.layer_csv_file->value();
+    params.roofline_csv_file     = options.roofline_csv_file->value();
+    params.roofline              = options.roofline->value() || !params.roofline_csv_file.empty();
+    params.profile_layers        = options.profile_layers->value() || !params.layer_csv_file.empty() || params.roofline;
+    params.annotate_layers       = options.annotate_layers->value();
+    params.memory_budget_mb      = options.memory_budget->value();
+    if(options.affinity->is_set())
+    {
+        params.cpu_sets = options.affinity->value();
+    }
+    if(options.thread_counts->is_set())
+    {
+        params.thread_counts = options.thread_counts->value();
+        if(params.cpu_sets.empty())
+        {
+            params.cpu_sets.push_back("all");
+        }
+    }
+    params.streams               = options.streams->value();
+    params.thread_budget         = options.stream_threads->value();
+    ARM_COMPUTE_EXIT_ON_MSG(params.iterations == 0, "At least one timed iteration is needed, got --iterations=0");
+    return params;
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_SWEEP_OPTIONS_H__ */
@@ -0,0 +1,793 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_SWEEP_REPORT_H__
+#define __WIDTH_MULTIPLIED_SWEEP_REPORT_H__
+
+#include "common/CpuAffinity.h"
+#include "common/GraphCost.h"
+#include "common/LatencyStats.h"
+#include "common/LayerProfiler.h"
+#include "common/MemoryUsage.h"
+#include "common/OutputRecorder.h"
+#include "common/SweepUtils.h"
+#include "common/WeightStore.h"
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Measurements of one variant of a sweep */
+struct SweepResult
+{
+    GraphVariant              variant{};                /**< Measured variant */
+    CpuPlacement              placement{};              /**< CPUs and thread count the variant ran with, empty for the process default */
+    double                    setup_time_ms{ 0 };       /**< Time spent building and finalizing the graph */
+    unsigned int              warmup_iterations{ 0 };   /**< Warm-up runs before the steady state */
+    bool                      warmup_converged{ true }; /**< False if the adaptive warm-up hit its cap */
+    double                    warmup_time_ms{ 0 };      /**< Time spent in the warm-up */
+    std::vector<double>       samples_ms{};             /**< Latency of every timed run */
+    LatencyStats              stats{};                  /**< Summary of the timed runs */
+    LayerCost                 cost{};                   /**< Analytical cost of the finalized graph */
+    WeightLoadStats           weights{};                /**< Trained weights loading, empty with synthetic weights */
+    MemoryUsage               memory{};                 /**< Memory used by the graph and the process */
+    std::vector<float>        output{};                 /**< Output of one run after the timed ones */
+    std::vector<LayerProfile> layers{};                 /**< Per-layer timings, empty unless profiling was requested */
+};
+
+/** Returns the name of a placement in the tables
+ *
+ * @param[in] placement Placement
+ *
+ * @return The CPU set and the thread count, e.g. "big x4", or "default" for the process default
+ */
+inline std::string placement_name(const CpuPlacement &placement)
+{
+    return placement.cpus.empty() && placement.threads == 0 ? "default" : placement.name + " x" + std::to_string(placement.threads);
+}
+
+/** Returns the width of the variant column of the tables, fitting every variant of a sweep
+ *
+ * @param[in] results Sweep results
+ *
+ * @return Width of the column, separator included
+ */
+inline int variant_column_width(const std::vector<SweepResult> &results)
+{
+    size_t width = std::string("variant").size();
+    for(const auto &result : results)
+    {
+        width = std::max(width, to_string(result.variant).size());
+    }
+    return static_cast<int>(width) + 2;
+}
+
+/** Returns the width of the placement column of the tables, fitting every placement of a sweep
+ *
+ * @param[in] results Sweep results
+ *
+ * @return Width of the column, separator included
+ */
+inline int placement_column_width(const std::vector<SweepResult> &results)
+{
+    size_t width = std::string("placement").size();
+    for(const auto &result : results)
+    {
+        width = std::max(width, placement_name(result.placement).size());
+    }
+    return static_cast<int>(width) + 2;
+}
+
+/** Prints one line per variant and placement
+ *
+ * The variant is printed with every option it was built with. A "+" after the warm-up count marks a
+ * variant whose latency did not settle before the cap.
+ *
+ * @param[out] os      Output stream
+ * @param[in]  results Sweep results
+ */
+inline void print_sweep_results(std::ostream &os, const std::vector<SweepResult> &results)
+{
+    const std::ios_base::fmtflags flags           = os.flags();
+    const int                     variant_width   = variant_column_width(results);
+    const int                     placement_width = placement_column_width(results);
+    os << std::left << std::setw(variant_width) << "variant" << std::setw(placement_width) << "placement"
+       << std::right << std::setw(12) << "setup(ms)" << std::setw(8) << "warmup" << std::setw(10) << "min" << std::setw(10) << "median" << std::setw(10) << "p90"
+       << std::setw(10) << "p99" << std::setw(10) << "stddev" << std::setw(10) << "MMACs" << std::setw(10) << "Mparams" << std::setw(10) << "GFLOP/s"
+       << std::setw(10) << "img/s" << std::setw(22) << "mean [95% CI]" << std::endl;
+    for(const auto &result : results)
+    {
+        const LatencyStats &s = result.stats;
+        os << std::left << std::setw(variant_width) << to_string(result.variant) << std::setw(placement_width) << placement_name(result.placement)
+           << std::right << std::fixed << std::setprecision(3)
+           << std::setw(12) << result.setup_time_ms
+           << std::setw(8) << (std::to_string(result.warmup_iterations) + (result.warmup_converged ? "" : "+")) << std::setw(10) << s.min << std::setw(10) << s.median
+           << std::setw(10) << s.p90 << std::setw(10) << s.p99 << std::setw(10) << s.stddev
+           << std::setw(10) << result.cost.macs / 1e6 << std::setw(10) << result.cost.params / 1e6 << std::setw(10) << gflops_per_second(result.cost.macs, s.median)
+           << std::setw(10) << images_per_second(result.variant.batch, s.median) << std::setw(10) << s.mean << " [" << s.ci95_low << ", " << s.ci95_high << "]" << std::endl;
+        os.flags(flags);
+    }
+    os.flags(flags);
+}
+
+/** Prints the memory used by every variant and placement
+ *
+ * The estimate, made before allocating the graph, is the one compared with the memory budget. A "+"
+ * after the peak resident set size marks a peak that could not be reset and covers the whole process.
+ *
+ * @param[out] os      Output stream
+ * @param[in]  results Sweep results
+ */
+inline void print_memory_usage(std::ostream &os, const std::vector<SweepResult> &results)
+{
+    const std::ios_base::fmtflags flags           = os.flags();
+    const int                     variant_width   = variant_column_width(results);
+    const int                     placement_width = placement_column_width(results);
+    os << "Memory (MB):" << std::endl;
+    os << std::left << std::setw(variant_width) << "variant" << std::setw(placement_width) << "placement"
+       << std::right << std::setw(10) << "estimate" << std::setw(10) << "weights" << std::setw(14) << "intermediate" << std::setw(10) << "heap" << std::setw(8) << "reuse"
+       << std::setw(12) << "peak RSS" << std::setw(10) << "RSS" << std::endl;
+    for(const auto &result : results)
+    {
+        const MemoryUsage &m = result.memory;
+        os << std::left << std::setw(variant_width) << to_string(result.variant) << std::setw(placement_width) << placement_name(result.placement)
+           << std::right << std::fixed << std::setprecision(1)
+           << std::setw(10) << m.estimated_bytes / 1e6 << std::setw(10) << m.weight_bytes / 1e6 << std::setw(14) << m.intermediate_bytes / 1e6
+           << std::setw(10) << m.graph_heap_bytes / 1e6 << std::setprecision(2) << std::setw(8) << m.reuse_ratio() << std::setprecision(1)
+           << std::setw(11) << m.peak_rss_bytes / 1e6 << (m.peak_reset ? " " : "+") << std::setw(10) << m.rss_bytes / 1e6 << std::endl;
+        os.flags(flags);
+    }
+    os << std::endl;
+    os.flags(flags);
+}
+
+/** Value printed for a variant and for its baseline in a comparison table */
+struct ComparisonMetric
+{
+    /** Constructor
+     *
+     * @param[in] name  Header of the column of the variant
+     * @param[in] base  Header of the column of the baseline
+     * @param[in] value Value of a result
+     */
+    ComparisonMetric(std::string name, std::string base, std::function<double(const SweepResult &)> value)
+        : name(std::move(name)), base(std::move(base)), value(std::move(value))
+    {
+    }
+
+    std::string                                name;  /**< Header of the column of the variant */
+    std::string                                base;  /**< Header of the column of the baseline */
+    std::function<double(const SweepResult &)> value; /**< Value of a result */
+};
+
+/** Prints, for every variant of a sweep, its latency against its baseline on the same placement
+ *
+ * The baseline of a variant, returned by make_base, is the variant otherwise built the same way; it is
+ * looked up in the sweep with the same placement. Variants that are their own baseline and variants whose
+ * baseline is not in the sweep are skipped; nothing is printed when no variant is left. The tables of
+ * variants computing the same function as their baseline pass print_output_check as details, so that
+ * every variant is followed by the agreement of its output with the baseline one.
+ *
+ * @param[out] os        Output stream
+ * @param[in]  results   Sweep results
+ * @param[in]  title     Title of the table
+ * @param[in]  baseline  Header of the latency column of the baselines
+ * @param[in]  make_base Returns the baseline of a variant
+ * @param[in]  metrics   (Optional) Values printed for both variants before their latencies
+ * @param[in]  details   (Optional) Prints rows after the row of a variant, given the variant and its baseline
+ */
+inline void print_comparison(std::ostream &os, const std::vector<SweepResult> &results, const std::string &title, const std::string &baseline,
+                             const std::function<GraphVariant(GraphVariant)> &make_base, const std::vector<ComparisonMetric> &metrics = std::vector<ComparisonMetric>(),
+                             const std::function<void(std::ostream &, const SweepResult &, const SweepResult &)> &details = nullptr)
+{
+    const std::ios_base::fmtflags flags           = os.flags();
+    const int                     variant_width   = variant_column_width(results);
+    const int                     placement_width = placement_column_width(results);
+    bool                          header          = false;
+    for(const auto &result : results)
+    {
+        const GraphVariant base = make_base(result.variant);
+        if(base == result.variant)
+        {
+            continue;
+        }
+        const auto reference = std::find_if(results.begin(), results.end(), [&](const SweepResult & r)
+        {
+            return r.variant == base && r.placement == result.placement;
+        });
+        if(reference == results.end())
+        {
+            continue;
+        }
+        if(!header)
+        {
+            os << title << std::endl;
+            os << std::left << std::setw(variant_width) << "variant" << std::setw(placement_width) << "placement" << std::right;
+            for(const auto &metric : metrics)
+            {
+                os << std::setw(12) << metric.name << std::setw(12) << metric.base;
+            }
+            os << std::setw(12) << "median" << std::setw(12) << baseline << std::setw(12) << "saved(ms)" << std::setw(12) << "speed-up" << std::endl;
+            header = true;
+        }
+        const double median      = result.stats.median;
+        const double base_median = reference->stats.median;
+        os << std::left << std::setw(variant_width) << to_string(result.variant) << std::setw(placement_width) << placement_name(result.placement)
+           << std::right << std::fixed << std::setprecision(3);
+        for(const auto &metric : metrics)
+        {
+            os << std::setw(12) << metric.value(result) << std::setw(12) << metric.value(*reference);
+        }
+        os << std::setw(12) << median << std::setw(12) << base_median << std::setw(12) << base_median - median << std::setw(12) << (median > 0 ? base_median / median : 0.0)
+           << std::endl;
+        os.flags(flags);
+        if(details)
+        {
+            details(os, result, *reference);
+            os.flags(flags);
+        }
+    }
+    if(header)
+    {
+        os << std::endl;
+    }
+    os.flags(flags);
+}
+
+/** Prints, under the row of a variant, the agreement of its output with the output of its baseline
+ *
+ * Used as the details of the comparisons whose variant computes the same function as its baseline in
+ * another way, so that a fast but wrong variant does not pass for a speed-up. The largest difference is
+ * relative to the largest value of the baseline output; above 1%, far beyond the rounding of another
+ * order of accumulation, the variant is flagged as a mismatch.
+ *
+ * @param[out] os     Output stream
+ * @param[in]  result Result of the variant
+ * @param[in]  base   Result of its baseline
+ */
+inline void print_output_check(std::ostream &os, const SweepResult &result, const SweepResult &base)
+{
+    if(result.output.empty() || result.output.size() != base.output.size())
+    {
+        os << "  output: MISMATCH, " << result.output.size() << " values against " << base.output.size() << " for the baseline" << std::endl;
+        return;
+    }
+    const OutputAgreement agreement = compare_outputs(result.output, base.output);
+    double                base_max  = 0;
+    for(float value : base.output)
+    {
+        base_max = std::max<double>(base_max, std::fabs(value));
+    }
+    const double relative = (base_max > 0) ? agreement.max_difference / base_max : agreement.max_difference;
+    os << "  output: top-1 " << agreement.top1 << " (baseline " << top_n(base.output, 1)[0] << "), top-5 overlap " << agreement.top5_overlap
+       << ", max difference " << std::scientific << std::setprecision(2) << agreement.max_difference << std::fixed << std::setprecision(2)
+       << " (" << relative * 100 << "%), distance " << std::setprecision(4) << agreement.distance << (relative > 0.01 ? "  MISMATCH" : "  ok") << std::endl;
+}
+
+/** Prints, for every variant with rounded channel counts, its cost and latency against the truncated counts
+ *
+ * @param[out] os      Output stream
+ * @param[in]  results Sweep results
+ */
+inline void print_rounding_comparison(std::ostream &os, const std::vector<SweepResult> &results)
+{
+    const ComparisonMetric macs("MMACs", "exact", [](const SweepResult & r)
+    {
+        return r.cost.macs / 1e6;
+    });
+    const ComparisonMetric ns_per_mmac("ns/MMAC", "exact", [](const SweepResult & r)
+    {
+        return r.cost.macs > 0 ? r.stats.median * 1e9 / r.cost.macs : 0.0;
+    });
+    print_comparison(os, results, "Channel rounding against the truncated channel counts:", "exact", [](GraphVariant base)
+    {
+        base.rounding = ChannelRounding();
+        return base;
+    },
+    { macs, ns_per_mmac });
+}
+
+/** Prints the throughput of every variant when the sweep has batch sizes other than 1
+ *
+ * The speed-up is the throughput against the batch size 1 variant of the same model, width,
+ * resolution, rounding and placement, when the sweep has it.
+ *
+ * @param[out] os      Output stream
+ * @param[in]  results Sweep results
+ */
+inline void print_batch_throughput(std::ostream &os, const std::vector<SweepResult> &results)
+{
+    const bool batched = std::any_of(results.begin(), results.end(), [](const SweepResult & r)
+    {
+        return r.variant.batch != 1U;
+    });
+    if(!batched)
+    {
+        return;
+    }
+    const std::ios_base::fmtflags flags = os.flags();
+    os << "Throughput per batch size:" << std::endl;
+    os << std::left << std::setw(12) << "model" << std::setw(8) << "width" << std::setw(12) << "resolution" << std::setw(19) << "rounding" << std::setw(7) << "batch"
+       << std::right << std::setw(12) << "ms/batch" << std::setw(12) << "ms/image" << std::setw(12) << "img/s" << std::setw(12) << "speed-up" << std::endl;
+    for(const auto &result : results)
+    {
+        const double median = result.stats.median;
+        const auto   single = std::find_if(results.begin(), results.end(), [&](const SweepResult & r)
+        {
+            return r.variant.model == result.variant.model && r.variant.width == result.variant.width && r.variant.resolution == result.variant.resolution
+                   && r.variant.rounding == result.variant.rounding && r.variant.batch_norm == result.variant.batch_norm && r.variant.dwsc_fusion == result.variant.dwsc_fusion
+                   && r.variant.channel_shuffle == result.variant.channel_shuffle && r.variant.grouped_conv == result.variant.grouped_conv
+                   && r.variant.asymmetric_conv == result.variant.asymmetric_conv && r.variant.batch == 1U
+                   && r.placement == result.placement;
+        });
+        os << std::left << std::setw(12) << result.variant.model << std::setw(8) << result.variant.width << std::setw(12) << result.variant.resolution
+           << std::setw(19) << to_string(result.variant.rounding) << std::setw(7) << result.variant.batch << std::right << std::fixed << std::setprecision(3)
+           << std::setw(12) << median << std::setw(12) << median / result.variant.batch << std::setw(12) << images_per_second(result.variant.batch, median);
+        if(single != results.end() && images_per_second(1U, single->stats.median) > 0)
+        {
+            os << std::setw(12) << images_per_second(result.variant.batch, median) / images_per_second(1U, single->stats.median);
+        }
+        else
+        {
+            os << std::setw(12) << "-";
+        }
+        os << std::endl;
+        os.flags(flags);
+    }
+    os << std::endl;
+    os.flags(flags);
+}
+
+/** Prints, for every variant with folded batch normalizations, its cost and latency against the unfused variant
+ *
+ * The activations are the bytes written by all the layers, which drop by one tensor per folded batch
+ * normalization.
+ *
+ * @param[out] os      Output stream
+ * @param[in]  results Sweep results
+ */
+inline void print_batch_norm_folding(std::ostream &os, const std::vector<SweepResult> &results)
+{
+    const ComparisonMetric activations("act(MB)", "unfused", [](const SweepResult & r)
+    {
+        return r.cost.activation_bytes / 1e6;
+    });
+    print_comparison(os, results, "Folded batch normalizations against unfused ones:", "unfused", [](GraphVariant base)
+    {
+        base.batch_norm = BatchNormMode::Unfused;
+        return base;
+    },
+    { activations }, print_output_check);
+}
+
+/** Prints, for every variant with fused depthwise-separable blocks, its latency against the variant without fusion
+ *
+ * @param[out] os      Output stream
+ * @param[in]  results Sweep results
+ */
+inline void print_dwsc_fusion(std::ostream &os, const std::vector<SweepResult> &results)
+{
+    print_comparison(os, results, "Fused depthwise-separable blocks against unfused ones:", "unfused", [](GraphVariant base)
+    {
+        base.dwsc_fusion = DwscFusion();
+        return base;
+    },
+    std::vector<ComparisonMetric>(), print_output_check);
+}
+
+/** Prints, for every variant whose channel shuffles run with the NEON kernel or fused, its latency against the variant running them with ACL
+ *
+ * @param[out] os      Output stream
+ * @param[in]  results Sweep results
+ */
+inline void print_channel_shuffle(std::ostream &os, const std::vector<SweepResult> &results)
+{
+    print_comparison(os, results, "NEON and fused channel shuffles against the ACL ones:", "acl", [](GraphVariant base)
+    {
+        base.channel_shuffle = ChannelShuffleMode::Acl;
+        return base;
+    },
+    std::vector<ComparisonMetric>(), print_output_check);
+}
+
+/** Prints, for every variant whose grouped 1x1 convolutions are batched, its latency against the variant running them split
+ *
+ * With the gconv_g<n> benchmarks, this gives the speed-up for every number of groups and width
+ * multiplier.
+ *
+ * @param[out] os      Output stream
+ * @param[in]  results Sweep results
+ */
+inline void print_grouped_conv(std::ostream &os, const std::vector<SweepResult> &results)
+{
+    print_comparison(os, results, "Batched grouped convolutions against split ones:", "split", [](GraphVariant base)
+    {
+        base.grouped_conv = GroupedConvMode::Split;
+        return base;
+    },
+    std::vector<ComparisonMetric>(), print_output_check);
+}
+
+/** Checks whether a profiled layer is a 1xK or Kx1 convolution
+ *
+ * @param[in] layer Profiled layer
+ *
+ * @return True if the kernel size of the layer is asymmetric
+ */
+inline bool is_asymmetric_layer(const LayerProfile &layer)
+{
+    const size_t x = layer.kernel.find('x');
+    if(x == std::string::npos)
+    {
+        return false;
+    }
+    return is_asymmetric_kernel(std::stoul(layer.kernel.substr(0, x)), std::stoul(layer.kernel.substr(x + 1)));
+}
+
+/** Prints, for every variant running its 1xK and Kx1 convolutions directly, its latency against the variant running them with GEMM
+ *
+ * When both variants were profiled, the output check of every variant is followed by every 1xK and
+ * Kx1 layer with its own median time in both modes.
+ *
+ * @param[out] os      Output stream
+ * @param[in]  results Sweep results
+ */
+inline void print_asymmetric_conv(std::ostream &os, const std::vector<SweepResult> &results)
+{
+    const auto print_details = [](std::ostream & out, const SweepResult & result, const SweepResult & gemm)
+    {
+        print_output_check(out, result, gemm);
+
+        // Per-layer times, the layers of both graphs having the same names
+        for(const auto &layer : result.layers)
+        {
+            if(!is_asymmetric_layer(layer))
+            {
+                continue;
+            }
+            const auto gemm_layer = std::find_if(gemm.layers.begin(), gemm.layers.end(), [&](const LayerProfile & l)
+            {
+                return l.name == layer.name;
+            });
+            if(gemm_layer == gemm.layers.end())
+            {
+                continue;
+            }
+            const double layer_median      = layer.stats.median;
+            const double gemm_layer_median = gemm_layer->stats.median;
+            out << std::left << "  " << std::setw(56) << layer.name << std::setw(10) << layer.kernel
+                << std::right << std::fixed << std::setprecision(3) << std::setw(12) << layer_median << std::setw(12) << gemm_layer_median << std::setw(12) << gemm_layer_median - layer_median
+                << std::setw(12) << (layer_median > 0 ? gemm_layer_median / layer_median : 0.0) << std::endl;
+        }
+    };
+    print_comparison(os, results, "Direct asymmetric convolutions against GEMM ones:", "gemm", [](GraphVariant base)
+    {
+        base.asymmetric_conv = AsymmetricConvMode::Gemm;
+        return base;
+    },
+    std::vector<ComparisonMetric>(), print_details);
+}
+
+/** Prints the scaling of every variant with the thread count on each CPU set, then the best placement of each variant
+ *
+ * The speed-up is the throughput against one thread on the same CPU set and the efficiency is the
+ * speed-up over the thread count, 1 being a linear scaling. The best placement is the fastest one; the
+ * frugal one is the placement with the fewest threads within 5% of its median latency. Nothing is
+ * printed unless the sweep ran on several placements.
+ *
+ * @param[out] os      Output stream
+ * @param[in]  results Sweep results
+ */
+inline void print_placement_scaling(std::ostream &os, const std::vector<SweepResult> &results)
+{
+    const bool placed = std::any_of(results.begin(), results.end(), [](const SweepResult & r)
+    {
+        return !r.placement.cpus.empty();
+    });
+    if(!placed)
+    {
+        return;
+    }
+    const std::ios_base::fmtflags flags = os.flags();
+    os << "Scaling per CPU set:" << std::endl;
+    os << std::left << std::setw(12) << "model" << std::setw(8) << "width" << std::setw(12) << "resolution" << std::setw(19) << "rounding" << std::setw(7) << "batch"
+       << std::setw(10) << "cpu set" << std::setw(9) << "cores" << std::setw(10) << "cpus" << std::right << std::setw(9) << "threads" << std::setw(12) << "median"
+       << std::setw(12) << "img/s" << std::setw(12) << "speed-up" << std::setw(12) << "efficiency" << std::endl;
+    for(const auto &result : results)
+    {
+        const double median = result.stats.median;
+        const auto   single = std::find_if(results.begin(), results.end(), [&](const SweepResult & r)
+        {
+            return r.variant == result.variant && r.placement.cpus == result.placement.cpus && r.placement.threads == 1U;
+        });
+        os << std::left << std::setw(12) << result.variant.model << std::setw(8) << result.variant.width << std::setw(12) << result.variant.resolution
+           << std::setw(19) << to_string(result.variant.rounding) << std::setw(7) << result.variant.batch << std::setw(10) << result.placement.name
+           << std::setw(9) << result.placement.core_type << std::setw(10) << cpu_list_to_string(result.placement.cpus) << std::right << std::setw(9) << result.placement.threads
+           << std::fixed << std::setprecision(3) << std::setw(12) << median << std::setw(12) << images_per_second(result.variant.batch, median);
+        if(single != results.end() && median > 0)
+        {
+            const double speed_up = single->stats.median / median;
+            os << std::setw(12) << speed_up << std::setw(12) << speed_up / std::max(result.placement.threads, 1U);
+        }
+        else
+        {
+            os << std::setw(12) << "-" << std::setw(12) << "-";
+        }
+        os << std::endl;
+        os.flags(flags);
+    }
+    os << std::endl;
+
+    os << "Best placement per variant:" << std::endl;
+    os << std::left << std::setw(12) << "model" << std::setw(8) << "width" << std::setw(12) << "resolution" << std::setw(19) << "rounding" << std::setw(7) << "batch"
+       << std::setw(22) << "fastest" << std::right << std::setw(12) << "median" << std::left << "  " << std::setw(22) << "frugal" << std::right << std::setw(12) << "median"
+       << std::endl;
+    for(auto it = results.begin(); it != results.end(); ++it)
+    {
+        // Once per variant, at its first result
+        const auto first = std::find_if(results.begin(), it, [&](const SweepResult & r)
+        {
+            return r.variant == it->variant;
+        });
+        if(first != it)
+        {
+            continue;
+        }
+        const SweepResult *fastest = nullptr;
+        for(const auto &result : results)
+        {
+            if(result.variant == it->variant && (fastest == nullptr || result.stats.median < fastest->stats.median))
+            {
+                fastest = &result;
+            }
+        }
+        const SweepResult *frugal = fastest;
+        for(const auto &result : results)
+        {
+            if(result.variant == it->variant && result.stats.median <= 1.05 * fastest->stats.median && result.placement.threads < frugal->placement.threads)
+            {
+                frugal = &result;
+            }
+        }
+        os << std::left << std::setw(12) << it->variant.model << std::setw(8) << it->variant.width << std::setw(12) << it->variant.resolution
+           << std::setw(19) << to_string(it->variant.rounding) << std::setw(7) << it->variant.batch << std::setw(22) << placement_name(fastest->placement)
+           << std::right << std::fixed << std::setprecision(3) << std::setw(12) << fastest->stats.median << std::left << "  " << std::setw(22) << placement_name(frugal->placement)
+           << std::right << std::setw(12) << frugal->stats.median << std::endl;
+        os.flags(flags);
+    }
+    os << std::endl;
+    os.flags(flags);
+}
+
+/** Returns the full width variant a variant's output is compared with
+ *
+ * @param[in] results Sweep results
+ * @param[in] result  Result to find the reference of
+ *
+ * @return The truncated 1.0 width variant otherwise built like the result, on the same placement, nullptr if none or if the weights are not trained
+ */
+inline const SweepResult *find_full_width_result(const std::vector<SweepResult> &results, const SweepResult &result)
+{
+    if(result.weights.tensors == 0 || result.output.empty())
+    {
+        return nullptr;
+    }
+    GraphVariant full_width = result.variant;
+    full_width.width        = 1.f;
+    full_width.rounding     = ChannelRounding();
+    const auto reference    = std::find_if(results.begin(), results.end(), [&](const SweepResult & r)
+    {
+        return r.variant == full_width && r.placement == result.placement && r.output.size() == result.output.size();
+    });
+    return (reference == results.end() || &*reference == &result) ? nullptr : &*reference;
+}
+
+/** Prints, for every variant with sliced trained weights, how its output agrees with the full width output
+ *
+ * The output of a single input is a rough accuracy signal: it tells how much slicing the weights
+ * changes the prediction, not how accurate the sliced model is. Nothing is printed without trained
+ * weights or without a full width variant in the sweep.
+ *
+ * @param[out] os      Output stream
+ * @param[in]  results Sweep results
+ */
+inline void print_output_agreement(std::ostream &os, const std::vector<SweepResult> &results)
+{
+    const std::ios_base::fmtflags flags  = os.flags();
+    bool                          header = false;
+    for(const auto &result : results)
+    {
+        const SweepResult *reference = find_full_width_result(results, result);
+        if(reference == nullptr)
+        {
+            continue;
+        }
+        if(!header)
+        {
+            os << "Output against the full width model:" << std::endl;
+            os << std::left << std::setw(12) << "model" << std::setw(8) << "width" << std::setw(12) << "resolution" << std::setw(19) << "rounding"
+               << std::right << std::setw(8) << "top-1" << std::setw(8) << "full" << std::setw(8) << "same" << std::setw(14) << "top-5 overlap"
+               << std::setw(12) << "distance" << std::setw(12) << "median" << std::endl;
+            header = true;
+        }
+        const OutputAgreement agreement = compare_outputs(result.output, reference->output);
+        os << std::left << std::setw(12) << result.variant.model << std::setw(8) << result.variant.width << std::setw(12) << result.variant.resolution
+           << std::setw(19) << to_string(result.variant.rounding) << std::right << std::setw(8) << agreement.top1 << std::setw(8) << top_n(reference->output, 1)[0]
+           << std::setw(8) << (agreement.top1_agrees ? "yes" : "no") << std::setw(14) << agreement.top5_overlap << std::fixed << std::setprecision(3)
+           << std::setw(12) << agreement.distance << std::setw(12) << result.stats.median << std::endl;
+        os.flags(flags);
+    }
+    if(header)
+    {
+        os << std::endl;
+    }
+    os.flags(flags);
+}
+
+/** Writes one summary row per variant as CSV
+ *
+ * @param[in] filename Output file
+ * @param[in] results  Sweep results
+ *
+ * @return True on success
+ */
+inline bool write_sweep_csv(const std::string &filename, const std::vector<SweepResult> &results)
+{
+    std::ofstream ofs(filename);
+    if(!ofs.is_open())
+    {
+        std::cerr << "Cannot open " << filename << " for writing" << std::endl;
+        return false;
+    }
+    ofs << "model,width,resolution,rounding,batch,batch_norm,fused_dwsc,channel_shuffle,grouped_conv,asymmetric_conv,setup_ms,warmup_iterations,warmup_converged,warmup_ms,iterations,min_ms,max_ms,mean_ms,median_ms,p90_ms,p99_ms,stddev_ms,ci95_low_ms,ci95_high_ms,macs,params,activation_bytes,weight_bytes,gflops,images_per_second,"
+        << "weights_load_ms,weights_copied_bytes,weights_mapped_bytes,weights_resident_bytes,top1,top1_agrees,top5_overlap,output_distance,cpu_set,core_type,cpus,threads,"
+        << "memory_estimated_bytes,memory_intermediate_bytes,memory_graph_heap_bytes,memory_reuse_ratio,peak_rss_bytes,peak_rss_reset,rss_bytes\n";
+    ofs << std::setprecision(6);
+    for(const auto &result : results)
+    {
+        const LatencyStats &s = result.stats;
+        ofs << result.variant.model << "," << result.variant.width << "," << result.variant.resolution << "," << result.variant.rounding << "," << result.variant.batch << ","
+            << result.variant.batch_norm << "," << result.variant.dwsc_fusion << "," << result.variant.channel_shuffle << "," << result.variant.grouped_conv << "," << result.variant.asymmetric_conv << "," << result.setup_time_ms << ","
+            << result.warmup_iterations << "," << (result.warmup_converged ? 1 : 0) << "," << result.warmup_time_ms << ","
+            << s.count << "," << s.min << "," << s.max << "," << s.mean << "," << s.median << "," << s.p90 << "," << s.p99 << ","
+            << s.stddev << "," << s.ci95_low << "," << s.ci95_high << "," << result.cost.macs << "," << result.cost.params << ","
+            << result.cost.activation_bytes << "," << result.cost.weight_bytes << "," << gflops_per_second(result.cost.macs, s.median) << ","
+            << images_per_second(result.variant.batch, s.median) << "," << result.weights.load_ms << "," << result.weights.copied_bytes << "," << result.weights.mapped_bytes << "," << result.weights.resident_bytes << ",";
+        // Output columns are left empty when there is no full width output to compare with
+        const SweepResult *reference = find_full_width_result(results, result);
+        if(reference != nullptr)
+        {
+            const OutputAgreement agreement = compare_outputs(result.output, reference->output);
+            ofs << agreement.top1 << "," << (agreement.top1_agrees ? 1 : 0) << "," << agreement.top5_overlap << "," << agreement.distance;
+        }
+        else
+        {
+            ofs << ",,,";
+        }
+        ofs << "," << result.placement.name << "," << result.placement.core_type << "," << cpu_list_to_string(result.placement.cpus) << "," << result.placement.threads << ","
+            << result.memory.estimated_bytes << "," << result.memory.intermediate_bytes << "," << result.memory.graph_heap_bytes << "," << result.memory.reuse_ratio() << ","
+            << result.memory.peak_rss_bytes << "," << (result.memory.peak_reset ? 1 : 0) << "," << result.memory.rss_bytes << "\n";
+    }
+    return ofs.good();
+}
+
+/** Writes every variant with its summary and per-iteration latencies as JSON
+ *
+ * @param[in] filename Output file
+ * @param[in] results  Sweep results
+ *
+ * @return True on success
+ */
+inline bool write_sweep_json(const std::string &filename, const std::vector<SweepResult> &results)
+{
+    std::ofstream ofs(filename);
+    if(!ofs.is_open())
+    {
+        std::cerr << "Cannot open " << filename << " for writing" << std::endl;
+        return false;
+    }
+    ofs << std::setprecision(6);
+    ofs << "[\n";
+    for(size_t i = 0; i < results.size(); ++i)
+    {
+        const SweepResult  &result = results[i];
+        const LatencyStats &s      = result.stats;
+        ofs << "  {\n";
+        ofs << "    \"model\": \"" << result.variant.model << "\",\n";
+        ofs << "    \"width\": " << result.variant.width << ",\n";
+        ofs << "    \"resolution\": " << result.variant.resolution << ",\n";
+        ofs << "    \"rounding\": \"" << result.variant.rounding << "\",\n";
+        ofs << "    \"batch\": " << result.variant.batch << ",\n";
+        ofs << "    \"batch_norm\": \"" << result.variant.batch_norm << "\",\n";
+        ofs << "    \"fused_dwsc\": \"" << result.variant.dwsc_fusion << "\",\n";
+        ofs << "    \"channel_shuffle\": \"" << result.variant.channel_shuffle << "\",\n";
+        ofs << "    \"grouped_conv\": \"" << result.variant.grouped_conv << "\",\n";
+        ofs << "    \"asymmetric_conv\": \"" << result.variant.asymmetric_conv << "\",\n";
+        ofs << "    \"placement\": { \"cpu_set\": \"" << result.placement.name << "\", \"core_type\": \"" << result.placement.core_type << "\", \"cpus\": \""
+            << cpu_list_to_string(result.placement.cpus) << "\", \"threads\": " << result.placement.threads << " },\n";
+        ofs << "    \"setup_ms\": " << result.setup_time_ms << ",\n";
+        ofs << "    \"warmup\": { \"iterations\": " << result.warmup_iterations << ", \"converged\": " << (result.warmup_converged ? "true" : "false")
+            << ", \"time_ms\": " << result.warmup_time_ms << " },\n";
+        ofs << "    \"stats\": { \"count\": " << s.count << ", \"min\": " << s.min << ", \"max\": " << s.max << ", \"mean\": " << s.mean
+            << ", \"median\": " << s.median << ", \"p90\": " << s.p90 << ", \"p99\": " << s.p99 << ", \"stddev\": " << s.stddev
+            << ", \"ci95\": [" << s.ci95_low << ", " << s.ci95_high << "] },\n";
+        ofs << "    \"cost\": { \"macs\": " << result.cost.macs << ", \"params\": " << result.cost.params << ", \"activation_bytes\": " << result.cost.activation_bytes
+            << ", \"weight_bytes\": " << result.cost.weight_bytes << ", \"gflops\": " << gflops_per_second(result.cost.macs, s.median)
+            << ", \"images_per_second\": " << images_per_second(result.variant.batch, s.median) << " },\n";
+        ofs << "    \"weights\": { \"load_ms\": " << result.weights.load_ms << ", \"tensors\": " << result.weights.tensors << ", \"copied_bytes\": " << result.weights.copied_bytes
+            << ", \"files\": " << result.weights.files << ", \"mapped_bytes\": " << result.weights.mapped_bytes << ", \"resident_bytes\": " << result.weights.resident_bytes << " },\n";
+        ofs << "    \"memory\": { \"estimated_bytes\": " << result.memory.estimated_bytes << ", \"weight_bytes\": " << result.memory.weight_bytes
+            << ", \"intermediate_bytes\": " << result.memory.intermediate_bytes << ", \"graph_heap_bytes\": " << result.memory.graph_heap_bytes
+            << ", \"reuse_ratio\": " << result.memory.reuse_ratio() << ", \"peak_rss_bytes\": " << result.memory.peak_rss_bytes
+            << ", \"peak_rss_reset\": " << (result.memory.peak_reset ? "true" : "false") << ", \"rss_bytes\": " << result.memory.rss_bytes << " },\n";
+        ofs << "    \"samples_ms\": [";
+        for(size_t j = 0; j < result.samples_ms.size(); ++j)
+        {
+            ofs << (j == 0 ? "" : ", ") << result.samples_ms[j];
+        }
+        ofs << "]\n";
+        ofs << "  }" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    ofs << "]\n";
+    return ofs.good();
+}
+
+/** Writes one row per layer of every profiled variant as CSV
+ *
+ * @param[in] filename Output file
+ * @param[in] results  Sweep results
+ *
+ * @return True on success
+ */
+inline bool write_layer_profile_csv(const std::string &filename, const std::vector<SweepResult> &results)
+{
+    std::ofstream ofs(filename);
+    if(!ofs.is_open())
+    {
+        std::cerr << "Cannot open " << filename << " for writing" << std::endl;
+        return false;
+    }
+    ofs << "model,width,resolution,rounding,batch,batch_norm,fused_dwsc,channel_shuffle,grouped_conv,asymmetric_conv,layer,type,output_shape,kernel,mean_ms,median_ms,share,macs,params,input_bytes,activation_bytes,weight_bytes,gflops\n";
+    ofs << std::setprecision(6);
+    for(const auto &result : results)
+    {
+        for(const auto &layer : result.layers)
+        {
+            ofs << result.variant.model << "," << result.variant.width << "," << result.variant.resolution << "," << result.variant.rounding << "," << result.variant.batch << ","
+                << result.variant.batch_norm << "," << result.variant.dwsc_fusion << "," << result.variant.channel_shuffle << "," << result.variant.grouped_conv << "," << result.variant.asymmetric_conv << "," << layer.name << "," << layer.type << "," << layer.output_shape << "," << layer.kernel << "," << layer.stats.mean << "," << layer.stats.median << "," << layer.share << ","
+                << layer.cost.macs << "," << layer.cost.params << "," << layer.cost.input_bytes << "," << layer.cost.activation_bytes << "," << layer.cost.weight_bytes << ","
+                << gflops_per_second(layer.cost.macs, layer.stats.median) << "\n";
+        }
+    }
+    return ofs.good();
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_SWEEP_REPORT_H__ */
@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_SWEEP_RUNNER_H__
+#define __WIDTH_MULTIPLIED_SWEEP_RUNNER_H__
+
+#include "arm_compute/graph.h"
+#include "arm_compute/runtime/CL/CLScheduler.h"
+#include "arm_compute/runtime/Scheduler.h"
+#include "utils/CommonGraphOptions.h"
+
+#include "common/CpuAffinity.h"
+#include "common/GraphBuilders.h"
+#include "common/GraphCost.h"
+#include "common/GraphExecutor.h"
+#include "common/LatencyStats.h"
+#include "common/LayerAnnotator.h"
+#include "common/LayerProfiler.h"
+#include "common/MemoryUsage.h"
+#include "common/Roofline.h"
+#include "common/SweepOptions.h"
+#include "common/SweepReport.h"
+#include "common/SweepUtils.h"
+#include "common/WarmupDetector.h"
+
+#include <streamline_annotate.h>
+
+#include <chrono>
+#include <memory>
+#include <ostream>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Builds, finalizes, times and tears down a sequence of graphs inside one process
+ *
+ * The backend scheduler, thread pool and allocators are initialized by the first graph and
+ * reused by every following one, so their start-up cost is only paid once per sweep.
+ * Each graph is warmed up until its latency is steady (see WarmupDetector) and every timed run is
+ * measured on its own, so the results carry the full latency distribution.
+ * When layer profiling is requested, extra runs time every layer after the timed runs, so the
+ * per-layer instrumentation does not affect the reported end-to-end latencies.
+ * The roofline ceilings are measured once, after all the variants, on the same target.
+ * When CPU sets or thread counts are requested, every variant runs once per placement. Resizing the
+ * backend's thread pool keeps the workers that already exist, with the CPUs they were created on, so
+ * the pool is first shrunk to the calling thread alone; the calling thread is then pinned to the CPUs of
+ * the placement, and the workers the graph finalization creates for its thread count inherit them.
+ * Before allocating a graph, its weights and intermediate tensors are compared with the memory
+ * budget, and a variant that would not fit is skipped instead of running the device out of memory.
+ */
+class SweepRunner
+{
+public:
+    /** Constructor
+     *
+     * @param[in] common_params Common graph parameters
+     * @param[in] sweep_params  Sweep parameters
+     */
+    SweepRunner(const arm_compute::utils::CommonGraphParams &common_params, const SweepParams &sweep_params)
+        : _common_params(common_params), _sweep_params(sweep_params), _results(), _skipped(), _total_time_ms(0), _ceilings()
+    {
+    }
+    /** Runs every variant in order, on every placement
+     *
+     * @param[in] variants Variants to measure
+     */
+    void run(const std::vector<GraphVariant> &variants)
+    {
+        using namespace arm_compute;
+        using namespace arm_compute::graph;
+
+        std::vector<CpuPlacement>       placements(1);
+        const std::vector<unsigned int> default_cpus = allowed_cpus();
+        if(!_sweep_params.cpu_sets.empty())
+        {
+            ARM_COMPUTE_EXIT_ON_MSG(_common_params.target != Target::NEON, "CPU sets and thread counts can only be swept with --target=NEON");
+            const std::vector<CpuCluster> clusters = detect_cpu_clusters();
+            std::cout << "CPU clusters :";
+            for(const auto &cluster : clusters)
+            {
+                std::cout << " " << cluster.name << " " << cpu_list_to_string(cluster.cpus) << " (capacity " << cluster.capacity << ")";
+            }
+            std::cout << std::endl;
+            placements = make_cpu_placements(_sweep_params.cpu_sets, _sweep_params.thread_counts, clusters);
+            ARM_COMPUTE_EXIT_ON_MSG(placements.empty(), "No valid CPU set and thread count to run on");
+        }
+
+        const auto sweep_start = std::chrono::steady_clock::now();
+        for(const auto &variant : variants)
+        {
+            for(const auto &placement : placements)
+            {
+                SweepResult result;
+                if(run_variant(variant, placement, result))
+                {
+                    _results.push_back(result);
+                }
+                else
+                {
+                    _skipped.push_back(result);
+                }
+            }
+        }
+        _total_time_ms = elapsed_ms(sweep_start);
+
+        // Back to the CPUs and thread count of the process for the roofline ceilings
+        if(!placements.front().cpus.empty())
+        {
+            Scheduler::get().set_num_threads(1);
+            set_cpu_affinity(default_cpus);
+            Scheduler::get().set_num_threads(_common_params.threads);
+        }
+
+        // The backend is initialized by the first graph, so the ceilings can only be measured now
+        if(_sweep_params.roofline && !_results.empty())
+        {
+            ANNOTATE("roofline-ceilings");
+            _ceilings = measure_roofline_ceilings(_common_params.target, _common_params.data_type);
+        }
+    }
+    /** Results of the variants run so far */
+    const std::vector<SweepResult> &results() const
+    {
+        return _results;
+    }
+    /** Prints one line per variant followed by the total sweep time, preceded by the layer profiles and roofline if any
+     *  and followed by the comparison of the channel roundings if several were swept
+     *
+     * @param[out] os Output stream
+     */
+    void print_results(std::ostream &os) const
+    {
+        for(const auto &result : _results)
+        {
+            if(!result.layers.empty())
+            {
+                os << "Layer profile of " << result.variant << std::endl;
+                print_layer_profile(os, result.layers);
+                os << std::endl;
+            }
+        }
+        if(_sweep_params.roofline)
+        {
+            print_roofline(os, _results, _ceilings);
+        }
+        print_sweep_results(os, _results);
+        os << std::endl;
+        print_memory_usage(os, _results);
+        for(const auto &result : _skipped)
+        {
+            os << "Skipped " << result.variant << ": needs about " << result.memory.estimated_bytes / 1e6 << " MB" << std::endl;
+        }
+        print_rounding_comparison(os, _results);
+        print_batch_throughput(os, _results);
+        print_batch_norm_folding(os, _results);
+        print_dwsc_fusion(os, _results);
+        print_channel_shuffle(os, _results);
+        print_grouped_conv(os, _results);
+        print_asymmetric_conv(os, _results);
+        print_placement_scaling(os, _results);
+        print_output_agreement(os, _results);
+        os << "Total sweep time (ms): " << _total_time_ms << std::endl;
+    }
+    /** Writes the results to the CSV and JSON files requested in the sweep parameters
+     *
+     * @return True if every requested file was written
+     */
+    bool write_results() const
+    {
+        bool success = true;
+        if(!_sweep_params.csv_file.empty())
+        {
+            success = write_sweep_csv(_sweep_params.csv_file, _results) && success;
+        }
+        if(!_sweep_params.json_file.empty())
+        {
+            success = write_sweep_json(_sweep_params.json_file, _results) && success;
+        }
+        if(!_sweep_params.layer_csv_file.empty())
+        {
+            success = write_layer_profile_csv(_sweep_params.layer_csv_file, _results) && success;
+        }
+        if(!_sweep_params.roofline_csv_file.empty())
+        {
+            success = write_roofline_csv(_sweep_params.roofline_csv_file, _results, _ceilings) && success;
+        }
+        return success;
+    }
+
+private:
+    static double elapsed_ms(std::chrono::steady_clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void sync() const
+    {
+        if(_common_params.target == arm_compute::graph::Target::CL)
+        {
+            arm_compute::CLScheduler::get().sync();
+        }
+    }
+
+    void warm_up(GraphExecutor &executor, SweepResult &result)
+    {
+        const auto warmup_start = std::chrono::steady_clock::now();
+        if(!_sweep_params.adaptive_warmup)
+        {
+            for(unsigned int i = 0; i < _sweep_params.warmup_iterations; ++i) // warming up
+            {
+                executor.run();
+            }
+            sync();
+            result.warmup_iterations = _sweep_params.warmup_iterations;
+            result.warmup_time_ms    = elapsed_ms(warmup_start);
+            return;
+        }
+
+        // Run until the median latency of two consecutive windows agrees within the tolerance
+        WarmupDetector detector(_sweep_params.warmup_window, _sweep_params.warmup_tolerance, _sweep_params.max_warmup_iterations);
+        while(!detector.done())
+        {
+            const auto run_start = std::chrono::steady_clock::now();
+            executor.run();
+            sync();
+            detector.add_sample(elapsed_ms(run_start));
+        }
+        result.warmup_iterations = detector.iterations();
+        result.warmup_converged  = detector.converged();
+        result.warmup_time_ms    = elapsed_ms(warmup_start);
+        if(!detector.converged())
+        {
+            std::cout << "Warning: latency did not settle within " << detector.iterations() << " warm-up runs" << std::endl;
+        }
+    }
+
+    uint64_t memory_budget_bytes() const
+    {
+        return (_sweep_params.memory_budget_mb > 0) ? static_cast<uint64_t>(_sweep_params.memory_budget_mb) * 1000000 : available_memory_bytes();
+    }
+
+    bool run_variant(const GraphVariant &variant, const CpuPlacement &placement, SweepResult &result)
+    {
+        using namespace arm_compute;
+        using namespace arm_compute::utils;
+        using namespace arm_compute::graph::frontend;
+
+        validate_variant(_common_params, variant, _sweep_params.channel_selection);
+        std::cout << "Running " << variant;
+        CommonGraphParams common_params = _common_params;
+        if(!placement.cpus.empty())
+        {
+            std::cout << " on CPUs " << cpu_list_to_string(placement.cpus) << " with " << placement.threads << " threads";
+            // Drop every worker of the previous placement so that none keeps running on its CPUs
+            Scheduler::get().set_num_threads(1);
+            if(!set_cpu_affinity(placement.cpus))
+            {
+                std::cerr << "Cannot run on CPUs " << cpu_list_to_string(placement.cpus) << std::endl;
+            }
+            common_params.threads = placement.threads;
+        }
+        std::cout << std::endl;
+
+        result.variant   = variant;
+        result.placement = placement;
+
+        ANNOTATE("graph-creation");
+        const auto setup_start = std::chrono::steady_clock::now();
+
+        // The stream, the executor and all their tensors are released at the end of this scope.
+        // The executor is declared last as its workload refers to the nodes owned by the stream.
+        // Restart the synthetic weights so that every variant gets the same weights whatever the sweep order
+        SyntheticWeights::get().configure(_sweep_params.weight_fill, _sweep_params.weight_seed);
+        WeightStore::get().set_channel_selection(_sweep_params.channel_selection);
+        QuantizationParams::get().configure(_sweep_params.quantization_file);
+        WeightStore::get().reset_stats();
+        const uint64_t heap_before = heap_in_use_bytes();
+        result.memory.peak_reset   = reset_peak_rss();
+        Stream graph(0, get_graph_name(variant.model));
+        std::unique_ptr<IWorkloadMutator> workload_mutator = create_graph(graph, common_params, variant);
+
+        // Nothing is allocated until the graph is finalized: skip the variant if it would not fit
+        const LayerCost estimate      = compute_graph_cost(graph.graph());
+        const uint64_t  budget        = memory_budget_bytes();
+        result.memory.estimated_bytes = estimate.weight_bytes + estimate.activation_bytes;
+        if(budget > 0 && result.memory.estimated_bytes > budget)
+        {
+            std::cout << "Skipped: needs about " << result.memory.estimated_bytes / 1e6 << " MB, the memory budget is " << budget / 1e6 << " MB" << std::endl;
+            return false;
+        }
+
+        GraphExecutor                   executor;
+        arm_compute::graph::PassManager pm = arm_compute::graph::create_default_pass_manager(_common_params.target);
+        executor.finalize(graph.graph(), _common_params.target, make_graph_config(common_params), pm, workload_mutator.get());
+        result.setup_time_ms = elapsed_ms(setup_start);
+        result.cost          = compute_graph_cost(graph.graph());
+
+        // The weights, intermediate tensors and workspaces of a NEON graph are on the heap
+        const uint64_t heap_after        = heap_in_use_bytes();
+        result.memory.graph_heap_bytes   = (heap_after > heap_before) ? heap_after - heap_before : 0;
+        result.memory.weight_bytes       = result.cost.weight_bytes;
+        result.memory.intermediate_bytes = result.cost.activation_bytes;
+        if(!_common_params.data_path.empty())
+        {
+            result.weights = WeightStore::get().stats();
+            std::cout << "Loaded " << result.weights.tensors << " weight tensors (" << result.weights.copied_bytes / 1e6 << " MB) in " << result.weights.load_ms
+                      << " ms, " << result.weights.files << " files mapped (" << result.weights.mapped_bytes / 1e6 << " MB, "
+                      << result.weights.resident_bytes / 1e6 << " MB in the page cache)" << std::endl;
+        }
+
+        warm_up(executor, result);
+
+        // Per-layer annotations, only created on request as they add a little overhead to every layer
+        std::unique_ptr<LayerAnnotator> annotator;
+        if(_sweep_params.annotate_layers)
+        {
+            annotator = arm_compute::support::cpp14::make_unique<LayerAnnotator>(executor.workload());
+        }
+
+        // Time every run on its own; OpenCL runs are synchronized so each sample covers the whole run
+        ANNOTATE("graph-run-start");
+        result.samples_ms.reserve(_sweep_params.iterations);
+        for(unsigned int i = 0; i < _sweep_params.iterations; ++i)
+        {
+            const auto run_start = std::chrono::steady_clock::now();
+            executor.run(annotator.get());
+            sync();
+            result.samples_ms.push_back(elapsed_ms(run_start));
+        }
+        ANNOTATE("graph-run-end");
+
+        // One more run to copy the output, compared with the full width one when the weights are trained
+        OutputRecorder::get().arm();
+        executor.run();
+        sync();
+        result.output = OutputRecorder::get().output();
+
+        // The peak covers the creation, the finalization and the runs of this graph, the pages of the mapped weights included
+        result.memory.peak_rss_bytes = peak_rss_bytes();
+        result.memory.rss_bytes      = rss_bytes();
+
+        if(_sweep_params.profile_layers)
+        {
+            ANNOTATE("layer-profile");
+            LayerProfiler     profiler(executor.workload(), _common_params.target);
+            TaskListenerGroup listeners;
+            listeners.add(annotator.get());
+            listeners.add(&profiler);
+            for(unsigned int i = 0; i < _sweep_params.iterations; ++i)
+            {
+                executor.run(&listeners);
+            }
+            result.layers = profiler.layers();
+        }
+
+        result.stats = compute_latency_stats(result.samples_ms);
+        return true;
+    }
+
+    const arm_compute::utils::CommonGraphParams &_common_params;
+    const SweepParams                           _sweep_params;
+    std::vector<SweepResult>                    _results;
+    std::vector<SweepResult>                    _skipped;
+    double                                      _total_time_ms;
+    RooflineCeilings                            _ceilings;
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_SWEEP_RUNNER_H__ */
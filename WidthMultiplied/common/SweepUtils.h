@@ -0,0 +1,306 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_SWEEP_UTILS_H__
+#define __WIDTH_MULTIPLIED_SWEEP_UTILS_H__
+
+#include "arm_compute/graph.h"
+#include "support/ToolchainSupport.h"
+#include "utils/CommonGraphOptions.h"
+#include "utils/GraphUtils.h"
+
+#include "common/AsymmetricConv.h"
+#include "common/BatchNormFolding.h"
+#include "common/ChannelRounding.h"
+#include "common/ChannelShuffle.h"
+#include "common/FusedDwsc.h"
+#include "common/GroupedPointwise.h"
+#include "common/OutputRecorder.h"
+#include "common/SyntheticWeights.h"
+#include "common/WeightStore.h"
+
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Accessor used in place of the trained weights
+ *
+ * Fills the tensor with synthetic weights, or leaves it as allocated when the fill is WeightFill::None.
+ */
+inline std::unique_ptr<arm_compute::graph::ITensorAccessor> Dummy()
+{
+    if(SyntheticWeights::get().fill() == WeightFill::None)
+    {
+        return arm_compute::support::cpp14::make_unique<arm_compute::graph_utils::DummyAccessor>(1);
+    }
+    return arm_compute::support::cpp14::make_unique<SyntheticWeightsAccessor>(SyntheticWeights::get().next_id());
+}
+
+/** Accessor of the trained weights of a tensor
+ *
+ * Same as get_weights_accessor() but reads the file through the memory mapped weight store, and uses
+ * the synthetic weights of Dummy() when no data path is given. The weights of the full width model
+ * are sliced to the channels of the tensor when the graph is narrower.
+ *
+ * @param[in] path        Path to the data files (a directory or an .npz archive)
+ * @param[in] data_file   Relative path to the .npy file from path
+ * @param[in] file_layout (Optional) Layout of the weights in the file
+ * @param[in] slice       (Optional) Channels kept when slicing, with ranking weights relative to path
+ *
+ * @return An appropriate tensor accessor
+ */
+inline std::unique_ptr<arm_compute::graph::ITensorAccessor> get_mapped_weights_accessor(const std::string &path, const std::string &data_file,
+                                                                                        arm_compute::DataLayout file_layout = arm_compute::DataLayout::NCHW, ChannelSlice slice = ChannelSlice())
+{
+    if(path.empty())
+    {
+        return Dummy();
+    }
+    slice.output_ranking = slice.output_ranking.empty() ? "" : path + slice.output_ranking;
+    slice.input_ranking  = slice.input_ranking.empty() ? "" : path + slice.input_ranking;
+    return arm_compute::support::cpp14::make_unique<MappedWeightsAccessor>(path + data_file, file_layout, std::move(slice));
+}
+
+/** Output accessor of the graphs
+ *
+ * Same as get_output_accessor() but also records the output for @ref OutputRecorder.
+ *
+ * @param[in] graph_parameters Graph parameters
+ * @param[in] top_n            (Optional) Number of output classes to print
+ *
+ * @return An appropriate tensor accessor
+ */
+inline std::unique_ptr<arm_compute::graph::ITensorAccessor> get_recorded_output_accessor(const arm_compute::utils::CommonGraphParams &graph_parameters, size_t top_n = 5)
+{
+    return arm_compute::support::cpp14::make_unique<RecordedOutputAccessor>(arm_compute::graph_utils::get_output_accessor(graph_parameters, top_n));
+}
+
+/** One point of a width/resolution sweep */
+struct GraphVariant
+{
+    std::string        model{ "mobilenet" };                        /**< Graph family (mobilenet, googlenet, resnet50, vgg16, squeezenext, sp_resnet, sp_shufflenet, sp_sqznext, gconv_g<n> or a .prototxt path) */
+    float              width{ 1.f };                                /**< Width multiplier applied to every channel count */
+    unsigned int       resolution{ 224U };                          /**< Input width and height */
+    ChannelRounding    rounding{};                                  /**< Rounding of the scaled channel counts */
+    unsigned int       batch{ 1U };                                 /**< Images per run */
+    BatchNormMode      batch_norm{ BatchNormMode::Unfused };        /**< Batch normalizations folded into the convolutions or not */
+    DwscFusion         dwsc_fusion{};                               /**< Depthwise separable blocks run as one fused function */
+    ChannelShuffleMode channel_shuffle{ ChannelShuffleMode::Acl };  /**< How the channel shuffles are executed */
+    GroupedConvMode    grouped_conv{ GroupedConvMode::Split };      /**< How the grouped 1x1 convolutions are executed */
+    AsymmetricConvMode asymmetric_conv{ AsymmetricConvMode::Gemm }; /**< How the 1xK and Kx1 convolutions are executed */
+};
+
+/** Stream operator to print a graph variant
+ *
+ * @param[out] os      Output stream
+ * @param[in]  variant Variant to print
+ *
+ * @return Modified output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, const GraphVariant &variant)
+{
+    os << variant.model << " width=" << variant.width << " resolution=" << variant.resolution;
+    if(variant.rounding.mode != ChannelRounding::Mode::Truncate)
+    {
+        os << " rounding=" << variant.rounding;
+    }
+    if(variant.batch != 1U)
+    {
+        os << " batch=" << variant.batch;
+    }
+    if(variant.batch_norm != BatchNormMode::Unfused)
+    {
+        os << " batch-norm=" << variant.batch_norm;
+    }
+    if(variant.dwsc_fusion.blocks != 0)
+    {
+        os << " fused-dwsc=" << variant.dwsc_fusion;
+    }
+    if(variant.channel_shuffle != ChannelShuffleMode::Acl)
+    {
+        os << " channel-shuffle=" << variant.channel_shuffle;
+    }
+    if(variant.grouped_conv != GroupedConvMode::Split)
+    {
+        os << " grouped-conv=" << variant.grouped_conv;
+    }
+    if(variant.asymmetric_conv != AsymmetricConvMode::Gemm)
+    {
+        os << " asymmetric-conv=" << variant.asymmetric_conv;
+    }
+    return os;
+}
+
+/** Converts a graph variant to a string
+ *
+ * @param[in] variant Variant to convert
+ *
+ * @return The variant as printed by its stream operator
+ */
+inline std::string to_string(const GraphVariant &variant)
+{
+    std::stringstream ss;
+    ss << variant;
+    return ss.str();
+}
+
+/** Compares two graph variants
+ *
+ * @param[in] a First variant
+ * @param[in] b Second variant
+ *
+ * @return True if both describe the same graph
+ */
+inline bool operator==(const GraphVariant &a, const GraphVariant &b)
+{
+    return a.model == b.model && a.width == b.width && a.resolution == b.resolution && a.rounding == b.rounding && a.batch == b.batch && a.batch_norm == b.batch_norm
+           && a.dwsc_fusion == b.dwsc_fusion && a.channel_shuffle == b.channel_shuffle
+           && a.grouped_conv == b.grouped_conv && a.asymmetric_conv == b.asymmetric_conv;
+}
+
+/** Checks whether a graph family has channel shuffles
+ *
+ * @param[in] model Graph family
+ *
+ * @return True for the ShuffleNet-like graphs: sp_shufflenet and the Caffe prototxts, which may have ShuffleChannel layers
+ */
+inline bool has_channel_shuffles(const std::string &model)
+{
+    return model == "sp_shufflenet" || model.find(".prototxt") != std::string::npos;
+}
+
+/** Checks whether a graph family has grouped 1x1 convolutions
+ *
+ * @param[in] model Graph family
+ *
+ * @return True for the grouped convolution benchmarks gconv_g<n> and the graphs with channel shuffles
+ */
+inline bool has_grouped_convolutions(const std::string &model)
+{
+    return model.compare(0, 7, "gconv_g") == 0 || has_channel_shuffles(model);
+}
+
+/** Checks whether a graph family has 1xK or Kx1 convolutions
+ *
+ * @param[in] model Graph family
+ *
+ * @return True for the SqueezeNext graphs, squeezenext and sp_sqznext, and the Caffe prototxts, which may have such convolutions
+ */
+inline bool has_asymmetric_convolutions(const std::string &model)
+{
+    return model == "squeezenext" || model == "sp_sqznext" || model.find(".prototxt") != std::string::npos;
+}
+
+/** Builds the grid of variants for the given models, widths, resolutions, channel roundings, batch sizes, batch normalization modes, fused blocks, channel shuffle, grouped and asymmetric convolution modes
+ *
+ * @param[in] models      Graph families
+ * @param[in] widths      Width multipliers
+ * @param[in] resolutions Input resolutions
+ * @param[in] roundings   (Optional) Channel roundings, truncation only by default
+ * @param[in] batches     (Optional) Batch sizes, 1 only by default
+ * @param[in] batch_norms (Optional) Batch normalization modes, unfused only by default
+ * @param[in] fusions     (Optional) Depthwise separable blocks to fuse, none by default. Only MobileNet has them, the other models are built once unfused
+ * @param[in] shuffles    (Optional) Channel shuffle modes, acl only by default. Only the models with channel shuffles use them, the others are built once with acl
+ * @param[in] grouped     (Optional) Grouped convolution modes, split only by default. Only the models with grouped convolutions use them, the others are built once split
+ * @param[in] asymmetric  (Optional) Asymmetric convolution modes, gemm only by default. Only the models with 1xK or Kx1 convolutions use them, the others are built once with gemm
+ *
+ * @return Every (model, width, resolution, rounding, batch, batch normalization, fused blocks, channel shuffle, grouped convolution, asymmetric convolution) combination in order
+ */
+inline std::vector<GraphVariant> make_variant_grid(const std::vector<std::string> &models, const std::vector<float> &widths, const std::vector<unsigned int> &resolutions,
+                                                   const std::vector<ChannelRounding> &roundings = std::vector<ChannelRounding>(1),
+                                                   const std::vector<unsigned int> &batches = std::vector<unsigned int>(1, 1U),
+                                                   const std::vector<BatchNormMode> &batch_norms = std::vector<BatchNormMode>(1, BatchNormMode::Unfused),
+                                                   const std::vector<DwscFusion> &fusions = std::vector<DwscFusion>(1),
+                                                   const std::vector<ChannelShuffleMode> &shuffles = std::vector<ChannelShuffleMode>(1, ChannelShuffleMode::Acl),
+                                                   const std::vector<GroupedConvMode> &grouped = std::vector<GroupedConvMode>(1, GroupedConvMode::Split),
+                                                   const std::vector<AsymmetricConvMode> &asymmetric = std::vector<AsymmetricConvMode>(1, AsymmetricConvMode::Gemm))
+{
+    std::vector<GraphVariant> variants;
+    for(const auto &model : models)
+    {
+        const std::vector<DwscFusion>         model_fusions    = (model == "mobilenet") ? fusions : std::vector<DwscFusion>(1);
+        const std::vector<ChannelShuffleMode> model_shuffles   = has_channel_shuffles(model) ? shuffles : std::vector<ChannelShuffleMode>(1, ChannelShuffleMode::Acl);
+        const std::vector<GroupedConvMode>    model_grouped    = has_grouped_convolutions(model) ? grouped : std::vector<GroupedConvMode>(1, GroupedConvMode::Split);
+        const std::vector<AsymmetricConvMode> model_asymmetric = has_asymmetric_convolutions(model) ? asymmetric : std::vector<AsymmetricConvMode>(1, AsymmetricConvMode::Gemm);
+        for(float width : widths)
+        {
+            for(unsigned int resolution : resolutions)
+            {
+                for(const auto &rounding : roundings)
+                {
+                    for(unsigned int batch : batches)
+                    {
+                        for(BatchNormMode batch_norm : batch_norms)
+                        {
+                            for(const auto &fusion : model_fusions)
+                            {
+                                for(ChannelShuffleMode shuffle : model_shuffles)
+                                {
+                                    for(GroupedConvMode grouped_conv : model_grouped)
+                                    {
+                                        for(AsymmetricConvMode asymmetric_conv : model_asymmetric)
+                                        {
+                                            GraphVariant variant;
+                                            variant.model           = model;
+                                            variant.width           = width;
+                                            variant.resolution      = resolution;
+                                            variant.rounding        = rounding;
+                                            variant.batch           = batch;
+                                            variant.batch_norm      = batch_norm;
+                                            variant.dwsc_fusion     = fusion;
+                                            variant.channel_shuffle = shuffle;
+                                            variant.grouped_conv    = grouped_conv;
+                                            variant.asymmetric_conv = asymmetric_conv;
+                                            variants.push_back(variant);
+                                        }
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    return variants;
+}
+
+/** Creates the graph configuration shared by every example
+ *
+ * @param[in] common_params Common graph parameters
+ *
+ * @return Graph configuration
+ */
+inline arm_compute::graph::GraphConfig make_graph_config(const arm_compute::utils::CommonGraphParams &common_params)
+{
+    arm_compute::graph::GraphConfig config;
+    config.num_threads = common_params.threads;
+    config.use_tuner   = common_params.enable_tuner;
+    config.tuner_file  = common_params.tuner_file;
+    return config;
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_SWEEP_UTILS_H__ */
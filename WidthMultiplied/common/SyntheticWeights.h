@@ -0,0 +1,402 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_SYNTHETIC_WEIGHTS_H__
+#define __WIDTH_MULTIPLIED_SYNTHETIC_WEIGHTS_H__
+
+#include "arm_compute/core/Helpers.h"
+#include "arm_compute/core/ITensor.h"
+#include "arm_compute/core/Types.h"
+#include "arm_compute/core/Window.h"
+#include "arm_compute/graph.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <map>
+#include <ostream>
+#include <random>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Values written by the synthetic weight accessor */
+enum class WeightFill
+{
+    None,   /**< Leave the tensors as allocated, as DummyAccessor does */
+    Random, /**< Seeded random values with a realistic distribution */
+};
+
+/** Stream operator to print a weight fill
+ *
+ * @param[out] os   Output stream
+ * @param[in]  fill Weight fill to print
+ *
+ * @return Modified output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, WeightFill fill)
+{
+    os << (fill == WeightFill::None ? "none" : "random");
+    return os;
+}
+
+/** Stream operator to read a weight fill
+ *
+ * @param[in]  is   Input stream
+ * @param[out] fill Weight fill read
+ *
+ * @return Modified input stream
+ */
+inline std::istream &operator>>(std::istream &is, WeightFill &fill)
+{
+    std::string value;
+    is >> value;
+    if(value == "none")
+    {
+        fill = WeightFill::None;
+    }
+    else if(value == "random")
+    {
+        fill = WeightFill::Random;
+    }
+    else
+    {
+        is.setstate(std::ios::failbit);
+    }
+    return is;
+}
+
+/** Kind of layer whose weights a synthetic tensor holds, which sets its fan-in */
+enum class WeightKind
+{
+    Other,       /**< Fully connected weights and per-channel parameters */
+    Convolution, /**< Weights of a convolution, or of all the groups of a grouped convolution */
+    Depthwise,   /**< Weights of a depthwise convolution */
+};
+
+/** Returns the kind of the weights of a layer
+ *
+ * @param[in] type Type of the layer
+ *
+ * @return The kind of its weights
+ */
+inline WeightKind weight_kind(arm_compute::graph::NodeType type)
+{
+    switch(type)
+    {
+        case arm_compute::graph::NodeType::ConvolutionLayer:
+            return WeightKind::Convolution;
+        case arm_compute::graph::NodeType::DepthwiseConvolutionLayer:
+            return WeightKind::Depthwise;
+        default:
+            return WeightKind::Other;
+    }
+}
+
+/** Returns the number of inputs of an output channel of a weight tensor
+ *
+ * Depthwise weights are [W, H, C] in NCHW and [C, W, H] in NHWC, so their fan-in is the kernel size
+ * whatever the layout. Convolution weights count their input channels too. Other tensors with
+ * several dimensions have the output channels outermost, and one-dimensional tensors have no fan-in.
+ *
+ * @param[in] shape  Shape of the weights
+ * @param[in] layout Layout of the weights
+ * @param[in] kind   Kind of the weights
+ *
+ * @return The fan-in, 0 for one-dimensional tensors
+ */
+inline size_t synthetic_fan_in(const arm_compute::TensorShape &shape, arm_compute::DataLayout layout, WeightKind kind)
+{
+    using namespace arm_compute;
+
+    const size_t kernel = shape[get_data_layout_dimension_index(layout, DataLayoutDimension::WIDTH)] * shape[get_data_layout_dimension_index(layout, DataLayoutDimension::HEIGHT)];
+    switch(kind)
+    {
+        case WeightKind::Depthwise:
+            return kernel;
+        case WeightKind::Convolution:
+            return kernel * shape[get_data_layout_dimension_index(layout, DataLayoutDimension::CHANNEL)];
+        default:
+            return (shape.num_dimensions() > 1) ? shape.total_size() / shape[shape.num_dimensions() - 1] : 0;
+    }
+}
+
+/** Process-wide generator of the synthetic weights of the graphs
+ *
+ * Tensors with several dimensions (convolution, depthwise and fully connected weights) get values
+ * drawn from a normal distribution of standard deviation sqrt(2 / fan_in), fan_in being the number
+ * of inputs of an output channel (see @ref synthetic_fan_in). One-dimensional tensors (biases and
+ * batch normalization parameters) get values uniform in [0.5, 1.5], which keeps the variances
+ * positive. QASYMM8 tensors get the same values quantized with their quantization info and S32
+ * biases small integers.
+ *
+ * The random values are generated once per data type, fan-in and quantization into a pool of
+ * pool_size elements shared by every tensor of that kind. A tensor is filled row by row with copies
+ * of the pool, starting at a position derived from the seed and the index of the tensor in the graph,
+ * so that tensors differ and a graph always gets the same weights for a given seed.
+ */
+class SyntheticWeights
+{
+public:
+    /** Number of elements of each pool of random values */
+    static constexpr size_t pool_size = 1 << 16;
+
+    /** Gets the process-wide generator
+     *
+     * @return The generator
+     */
+    static SyntheticWeights &get()
+    {
+        static SyntheticWeights instance;
+        return instance;
+    }
+    /** Sets the fill and the seed and restarts the tensor numbering, to call before building each graph
+     *
+     * @param[in] fill Values to write
+     * @param[in] seed Seed of the random values
+     */
+    void configure(WeightFill fill, unsigned int seed)
+    {
+        if(seed != _seed)
+        {
+            _pools.clear();
+        }
+        _fill    = fill;
+        _seed    = seed;
+        _next_id = 0;
+    }
+    /** Values written to the tensors */
+    WeightFill fill() const
+    {
+        return _fill;
+    }
+    /** Returns the index of the next tensor of the graph being built */
+    unsigned int next_id()
+    {
+        return _next_id++;
+    }
+    /** Total size of the pools of random values, in bytes */
+    size_t pool_bytes() const
+    {
+        size_t bytes = 0;
+        for(const auto &pool : _pools)
+        {
+            bytes += pool.second.size();
+        }
+        return bytes;
+    }
+    /** Fills a tensor
+     *
+     * @note Tensors of other data types than F32, F16, QASYMM8 and S32 are left untouched.
+     *
+     * @param[in,out] tensor Tensor to fill, mapped
+     * @param[in]     id     Index of the tensor in the graph
+     * @param[in]     kind   (Optional) Kind of the weights
+     */
+    void fill_tensor(arm_compute::ITensor &tensor, unsigned int id, WeightKind kind = WeightKind::Other)
+    {
+        using namespace arm_compute;
+
+        const ITensorInfo &info = *tensor.info();
+        if(_fill == WeightFill::None || tensor.buffer() == nullptr)
+        {
+            return;
+        }
+        const std::vector<uint8_t> &values = pool(info, synthetic_fan_in(info.tensor_shape(), info.data_layout(), kind));
+        if(values.empty())
+        {
+            return;
+        }
+
+        const size_t element_size = info.element_size();
+        const size_t pool_bytes   = values.size();
+        const size_t row_bytes    = info.dimension(0) * element_size;
+        size_t       position     = ((id * 2654435761U + _seed) % pool_size) * element_size;
+
+        // Copy the pool into every row of the tensor, wrapping around at its end
+        Window window;
+        window.use_tensor_dimensions(info.tensor_shape());
+        window.set(Window::DimX, Window::Dimension(0, 1, 1));
+        Iterator it(&tensor, window);
+        execute_window_loop(window, [&](const Coordinates &)
+        {
+            for(size_t done = 0; done < row_bytes;)
+            {
+                const size_t bytes = std::min(row_bytes - done, pool_bytes - position);
+                std::memcpy(it.ptr() + done, values.data() + position, bytes);
+                done += bytes;
+                position = (position + bytes) % pool_bytes;
+            }
+        },
+        it);
+    }
+
+private:
+    using PoolKey = std::tuple<arm_compute::DataType, size_t, float, int>;
+
+    SyntheticWeights()
+        : _fill(WeightFill::Random), _seed(0), _next_id(0), _pools()
+    {
+    }
+
+    const std::vector<uint8_t> &pool(const arm_compute::ITensorInfo &info, size_t fan_in)
+    {
+        using namespace arm_compute;
+
+        QuantizationInfo qinfo = info.quantization_info();
+        if(info.data_type() == DataType::QASYMM8 && qinfo.empty())
+        {
+            qinfo = QuantizationInfo(1.f / 128, 128);
+        }
+
+        const PoolKey key(info.data_type(), fan_in, qinfo.scale, qinfo.offset);
+        auto          it = _pools.find(key);
+        if(it != _pools.end())
+        {
+            return it->second;
+        }
+
+        std::seed_seq                         seq{ _seed, static_cast<unsigned int>(info.data_type()), static_cast<unsigned int>(fan_in) };
+        std::mt19937                          gen(seq);
+        std::normal_distribution<float>       weights(0.f, std::sqrt(2.f / std::max<size_t>(fan_in, 1)));
+        std::uniform_real_distribution<float> parameters(0.5f, 1.5f);
+        std::uniform_int_distribution<int>    biases(-64, 64);
+        auto                                  sample = [&]()
+        {
+            return (fan_in > 0) ? weights(gen) : parameters(gen);
+        };
+
+        std::vector<uint8_t> &values = _pools[key];
+        switch(info.data_type())
+        {
+            case DataType::F32:
+                values.resize(pool_size * sizeof(float));
+                std::generate_n(reinterpret_cast<float *>(values.data()), pool_size, sample);
+                break;
+            case DataType::F16:
+                values.resize(pool_size * sizeof(half));
+                std::generate_n(reinterpret_cast<half *>(values.data()), pool_size, [&]()
+                {
+                    return static_cast<half>(sample());
+                });
+                break;
+            case DataType::QASYMM8:
+                values.resize(pool_size);
+                std::generate_n(values.data(), pool_size, [&]()
+                {
+                    return qinfo.quantize(sample(), RoundingPolicy::TO_NEAREST_UP);
+                });
+                break;
+            case DataType::S32:
+                values.resize(pool_size * sizeof(int32_t));
+                std::generate_n(reinterpret_cast<int32_t *>(values.data()), pool_size, [&]()
+                {
+                    return biases(gen);
+                });
+                break;
+            default:
+                break;
+        }
+        return values;
+    }
+
+    WeightFill                              _fill;
+    unsigned int                            _seed;
+    unsigned int                            _next_id;
+    std::map<PoolKey, std::vector<uint8_t>> _pools;
+};
+
+/** Accessor filling a constant tensor with synthetic weights */
+class SyntheticWeightsAccessor final : public arm_compute::graph::ITensorAccessor
+{
+public:
+    /** Constructor
+     *
+     * @param[in] id Index of the tensor in the graph, seeds its values
+     */
+    SyntheticWeightsAccessor(unsigned int id)
+        : _id(id), _kind(WeightKind::Other)
+    {
+    }
+    /** Allow instances of this class to be move constructed */
+    SyntheticWeightsAccessor(SyntheticWeightsAccessor &&) = default;
+    /** Sets the kind of the weights, which sets their fan-in
+     *
+     * @param[in] kind Kind of the weights
+     */
+    void set_kind(WeightKind kind)
+    {
+        _kind = kind;
+    }
+
+    // Inherited methods overriden:
+    bool access_tensor(arm_compute::ITensor &tensor) override
+    {
+        SyntheticWeights::get().fill_tensor(tensor, _id, _kind);
+        return true;
+    }
+
+private:
+    unsigned int _id;
+    WeightKind   _kind;
+};
+
+/** Gives the synthetic weights of the convolutions and depthwise convolutions of a graph their kind
+ *
+ * The accessors do not know the layer of their tensor, so without it the fan-in of NHWC depthwise
+ * weights would be taken from their outermost dimension, the kernel height. The weights of a grouped
+ * convolution are found through the split feeding its groups. To call before the accessors are
+ * wrapped by the graph passes.
+ *
+ * @param[in,out] g Graph built by the frontend, not finalized yet
+ */
+inline void set_synthetic_weight_kinds(arm_compute::graph::Graph &g)
+{
+    using namespace arm_compute::graph;
+    for(auto &node : g.nodes())
+    {
+        const WeightKind kind = (node != nullptr) ? weight_kind(node->type()) : WeightKind::Other;
+        if(kind == WeightKind::Other)
+        {
+            continue;
+        }
+        const Edge *edge     = g.edge(node->input_edge_id(1));
+        INode      *producer = (edge != nullptr) ? edge->producer() : nullptr;
+        while(producer != nullptr && producer->type() == NodeType::SplitLayer)
+        {
+            edge     = g.edge(producer->input_edge_id(0));
+            producer = (edge != nullptr) ? edge->producer() : nullptr;
+        }
+        auto *accessor = (producer != nullptr && producer->type() == NodeType::Const) ? dynamic_cast<SyntheticWeightsAccessor *>(producer->output(0)->accessor()) : nullptr;
+        if(accessor != nullptr)
+        {
+            accessor->set_kind(kind);
+        }
+    }
+}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_SYNTHETIC_WEIGHTS_H__ */
@@ -21,55 +21,42 @@
  * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
  * SOFTWARE.
  */
+#ifndef __WIDTH_MULTIPLIED_VGG16_GRAPH_H__
+#define __WIDTH_MULTIPLIED_VGG16_GRAPH_H__
+
 #include "arm_compute/graph.h"
-#include "arm_compute/runtime/CL/CLScheduler.h"
 #include "support/ToolchainSupport.h"
 #include "utils/CommonGraphOptions.h"
 #include "utils/GraphUtils.h"
-#include "utils/Utils.h"
-#include <streamline_annotate.h>
-#include <time.h>
 
-using namespace arm_compute;
-using namespace arm_compute::utils;
-using namespace arm_compute::graph::frontend;
-using namespace arm_compute::graph_utils;
-std::unique_ptr<arm_compute::graph::ITensorAccessor> Dummy() {
-				    return arm_compute::support::cpp14::make_unique<DummyAccessor>(1);
-}
+#include "common/SweepUtils.h"
 
-/** Example demonstrating how to implement VGG16's network using the Compute Library's graph API
+namespace width_multiplied
+{
+/** Builds VGG16 into a graph stream for a given width and resolution multiplier
  *
- * @param[in] argc Number of arguments
- * @param[in] argv Arguments
+ * @note The width multiplier is also applied to the fc6 and fc7 layers.
  */
-class GraphVGG16Example : public Example
+class VGG16GraphBuilder
 {
 public:
-    GraphVGG16Example()
-        : cmd_parser(), common_opts(cmd_parser), common_params(), graph(0, "VGG16")
+    /** Constructor
+     *
+     * @param[in] graph         Stream to add the layers to
+     * @param[in] common_params Common graph parameters
+     */
+    VGG16GraphBuilder(arm_compute::graph::frontend::Stream &graph, const arm_compute::utils::CommonGraphParams &common_params)
+        : graph(graph), common_params(common_params)
     {
     }
-    bool do_setup(int argc, char **argv) override
+    /** Adds the whole network, from input to output layer, to the stream
+     *
+     * @param[in] variant Width, resolution and batch size to build
+     */
+    void create_graph(const GraphVariant &variant)
     {
-        // Parse arguments
-        cmd_parser.parse(argc, argv);
-
-        // Consume common parameters
-        common_params = consume_common_graph_parameters(common_opts);
-
-        // Return when help menu is requested
-        if(common_params.help)
-        {
-            cmd_parser.print_help(argv[0]);
-            return false;
-        }
-
-        // Checks
-        ARM_COMPUTE_EXIT_ON_MSG(arm_compute::is_data_type_quantized_asymmetric(common_params.data_type), "QASYMM8 not supported for this graph");
-
-        // Print parameter values
-        std::cout << common_params << std::endl;
+        using namespace arm_compute::graph::frontend;
+        using namespace arm_compute::graph_utils;
 
         // Get trainable parameters data path
         std::string data_path = common_params.data_path;
@@ -79,12 +66,14 @@ public:
         std::unique_ptr<IPreprocessor> preprocessor = arm_compute::support::cpp14::make_unique<CaffePreproccessor>(mean_rgb);
 
         // Create input descriptor
-        const TensorShape tensor_shape     = permute_shape(TensorShape(224U, 224U, 3U, 1U), DataLayout::NCHW, common_params.data_layout);
+        const TensorShape tensor_shape     = permute_shape(TensorShape(variant.resolution, variant.resolution, 3U, variant.batch), DataLayout::NCHW, common_params.data_layout);
         TensorDescriptor  input_descriptor = TensorDescriptor(tensor_shape, common_params.data_type).set_layout(common_params.data_layout);
 
         // Set weights trained layout
         const DataLayout weights_layout = DataLayout::NCHW;
-				float depth_scale = 0.5f;
+
+        // Scale the channel counts by the width multiplier
+        const ChannelScaler depth_scale(variant.width, variant.rounding);
 
         // Create graph
         graph << common_params.target
@@ -92,182 +81,148 @@ public:
               << InputLayer(input_descriptor, get_input_accessor(common_params, std::move(preprocessor)))
               // Layer 1
               << ConvolutionLayer(
-                  3U, 3U, 64U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv1_1_w.npy", weights_layout),
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv1_1_b.npy"),
+                  3U, 3U, depth_scale(64U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv1_1_w.npy", weights_layout, slice("conv1_1", "")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv1_1_b.npy", weights_layout, slice("conv1_1")),
                   PadStrideInfo(1, 1, 1, 1))
               .set_name("conv1_1")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv1_1/Relu")
               // Layer 2
               << ConvolutionLayer(
-                  3U, 3U, 64U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv1_2_w.npy", weights_layout),
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv1_2_b.npy"),
+                  3U, 3U, depth_scale(64U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv1_2_w.npy", weights_layout, slice("conv1_2", "conv1_1")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv1_2_b.npy", weights_layout, slice("conv1_2")),
                   PadStrideInfo(1, 1, 1, 1))
               .set_name("conv1_2")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv1_2/Relu")
               << PoolingLayer(PoolingLayerInfo(PoolingType::MAX, 2, PadStrideInfo(2, 2, 0, 0))).set_name("pool1")
               // Layer 3
               << ConvolutionLayer(
-                  3U, 3U, 128U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv2_1_w.npy", weights_layout),
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv2_1_b.npy"),
+                  3U, 3U, depth_scale(128U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv2_1_w.npy", weights_layout, slice("conv2_1", "conv1_2")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv2_1_b.npy", weights_layout, slice("conv2_1")),
                   PadStrideInfo(1, 1, 1, 1))
               .set_name("conv2_1")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv2_1/Relu")
               // Layer 4
               << ConvolutionLayer(
-                  3U, 3U, 128U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv2_2_w.npy", weights_layout),
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv2_2_b.npy"),
+                  3U, 3U, depth_scale(128U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv2_2_w.npy", weights_layout, slice("conv2_2", "conv2_1")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv2_2_b.npy", weights_layout, slice("conv2_2")),
                   PadStrideInfo(1, 1, 1, 1))
               .set_name("conv2_2")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv2_2/Relu")
               << PoolingLayer(PoolingLayerInfo(PoolingType::MAX, 2, PadStrideInfo(2, 2, 0, 0))).set_name("pool2")
               // Layer 5
               << ConvolutionLayer(
-                  3U, 3U, 256U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv3_1_w.npy", weights_layout),
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv3_1_b.npy"),
+                  3U, 3U, depth_scale(256U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv3_1_w.npy", weights_layout, slice("conv3_1", "conv2_2")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv3_1_b.npy", weights_layout, slice("conv3_1")),
                   PadStrideInfo(1, 1, 1, 1))
               .set_name("conv3_1")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv3_1/Relu")
               // Layer 6
               << ConvolutionLayer(
-                  3U, 3U, 256U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv3_2_w.npy", weights_layout),
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv3_2_b.npy"),
+                  3U, 3U, depth_scale(256U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv3_2_w.npy", weights_layout, slice("conv3_2", "conv3_1")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv3_2_b.npy", weights_layout, slice("conv3_2")),
                   PadStrideInfo(1, 1, 1, 1))
               .set_name("conv3_2")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv3_2/Relu")
               // Layer 7
               << ConvolutionLayer(
-                  3U, 3U, 256U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv3_3_w.npy", weights_layout),
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv3_3_b.npy"),
+                  3U, 3U, depth_scale(256U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv3_3_w.npy", weights_layout, slice("conv3_3", "conv3_2")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv3_3_b.npy", weights_layout, slice("conv3_3")),
                   PadStrideInfo(1, 1, 1, 1))
               .set_name("conv3_3")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv3_3/Relu")
               << PoolingLayer(PoolingLayerInfo(PoolingType::MAX, 2, PadStrideInfo(2, 2, 0, 0))).set_name("pool3")
               // Layer 8
               << ConvolutionLayer(
-                  3U, 3U, 512U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv4_1_w.npy", weights_layout),
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv4_1_b.npy"),
+                  3U, 3U, depth_scale(512U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv4_1_w.npy", weights_layout, slice("conv4_1", "conv3_3")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv4_1_b.npy", weights_layout, slice("conv4_1")),
                   PadStrideInfo(1, 1, 1, 1))
               .set_name("conv4_1")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv4_1/Relu")
               // Layer 9
               << ConvolutionLayer(
-                  3U, 3U, 512U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv4_2_w.npy", weights_layout),
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv4_2_b.npy"),
+                  3U, 3U, depth_scale(512U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv4_2_w.npy", weights_layout, slice("conv4_2", "conv4_1")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv4_2_b.npy", weights_layout, slice("conv4_2")),
                   PadStrideInfo(1, 1, 1, 1))
               .set_name("conv4_2")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv4_2/Relu")
               // Layer 10
               << ConvolutionLayer(
-                  3U, 3U, 512U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv4_3_w.npy", weights_layout),
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv4_3_b.npy"),
+                  3U, 3U, depth_scale(512U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv4_3_w.npy", weights_layout, slice("conv4_3", "conv4_2")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv4_3_b.npy", weights_layout, slice("conv4_3")),
                   PadStrideInfo(1, 1, 1, 1))
               .set_name("conv4_3")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv4_3/Relu")
               << PoolingLayer(PoolingLayerInfo(PoolingType::MAX, 2, PadStrideInfo(2, 2, 0, 0))).set_name("pool4")
               // Layer 11
               << ConvolutionLayer(
-                  3U, 3U, 512U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv5_1_w.npy", weights_layout),
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv5_1_b.npy"),
+                  3U, 3U, depth_scale(512U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv5_1_w.npy", weights_layout, slice("conv5_1", "conv4_3")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv5_1_b.npy", weights_layout, slice("conv5_1")),
                   PadStrideInfo(1, 1, 1, 1))
               .set_name("conv5_1")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv5_1/Relu")
               // Layer 12
               << ConvolutionLayer(
-                  3U, 3U, 512U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv5_2_w.npy", weights_layout),
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv5_2_b.npy"),
+                  3U, 3U, depth_scale(512U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv5_2_w.npy", weights_layout, slice("conv5_2", "conv5_1")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv5_2_b.npy", weights_layout, slice("conv5_2")),
                   PadStrideInfo(1, 1, 1, 1))
               .set_name("conv5_2")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv5_2/Relu")
               // Layer 13
               << ConvolutionLayer(
-                  3U, 3U, 512U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv5_3_w.npy", weights_layout),
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/conv5_3_b.npy"),
+                  3U, 3U, depth_scale(512U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv5_3_w.npy", weights_layout, slice("conv5_3", "conv5_2")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/conv5_3_b.npy", weights_layout, slice("conv5_3")),
                   PadStrideInfo(1, 1, 1, 1))
               .set_name("conv5_3")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("conv5_3/Relu")
               << PoolingLayer(PoolingLayerInfo(PoolingType::MAX, 2, PadStrideInfo(2, 2, 0, 0))).set_name("pool5")
               // Layer 14
               << FullyConnectedLayer(
-                  4096U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/fc6_w.npy", weights_layout),
-                  Dummy())//get_weights_accessor(data_path, "/cnn_data/vgg16_model/fc6_b.npy"))
+                  depth_scale(4096U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/fc6_w.npy", weights_layout, slice("fc6", "conv5_3")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/fc6_b.npy", weights_layout, slice("fc6")))
               .set_name("fc6")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("Relu")
               // Layer 15
               << FullyConnectedLayer(
-                  4096U* depth_scale,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/fc7_w.npy", weights_layout),
-                  Dummy())//get_weights_accessor(data_path, "/cnn_data/vgg16_model/fc7_b.npy")
+                  depth_scale(4096U),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/fc7_w.npy", weights_layout, slice("fc7", "fc6")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/fc7_b.npy", weights_layout, slice("fc7")))
               .set_name("fc7")
               << ActivationLayer(ActivationLayerInfo(ActivationLayerInfo::ActivationFunction::RELU)).set_name("Relu_1")
               // Layer 16
               << FullyConnectedLayer(
                   1000U,
-                  Dummy(),//get_weights_accessor(data_path, "/cnn_data/vgg16_model/fc8_w.npy", weights_layout),
-                  Dummy()) //get_weights_accessor(data_path, "/cnn_data/vgg16_model/fc8_b.npy")
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/fc8_w.npy", weights_layout, slice("fc8", "fc7")),
+                  get_mapped_weights_accessor(data_path, "/cnn_data/vgg16_model/fc8_b.npy", weights_layout, slice("fc8")))
               .set_name("fc8")
               // Softmax
               << SoftmaxLayer().set_name("prob")
-              << OutputLayer(get_output_accessor(common_params, 5));
-
-        // Finalize graph
-        GraphConfig config;
-        config.num_threads = common_params.threads;
-        config.use_tuner   = common_params.enable_tuner;
-        config.tuner_file  = common_params.tuner_file;
+              << OutputLayer(get_recorded_output_accessor(common_params, 5));
+    }
 
-        graph.finalize(common_params.target, config);
+private:
+    arm_compute::graph::frontend::Stream        &graph;
+    const arm_compute::utils::CommonGraphParams &common_params;
 
-        return true;
-    }
-    void do_run() override
+    /** Channels kept when slicing the trained weights of a layer, ranked by its own filters and by those of its input layer */
+    static ChannelSlice slice(const std::string &layer, const std::string &input_layer = "")
     {
-        // Run graph
-				//struct timespec t0, t1;
-				//float t;
-				ANNOTATE_SETUP;
-				ANNOTATE_DEFINE;
-				for (int i=0; i<10; i++)  // warming up 
-								graph.run();
-				ANNOTATE("graph-run-start");
-				//clock_gettime(CLOCK_REALTIME, &t0);
-				for (int i=0; i<20; i++)
-        	graph.run();
-				CLScheduler::get().sync();
-				//clock_gettime(CLOCK_REALTIME, &t1);
-				ANNOTATE("graph-run-end");
-				//t = (float)(t1.tv_sec-t0.tv_sec)+(float)(t1.tv_nsec-t0.tv_nsec)/1e9;
-				//printf("Time spent: %.4f\n",t);
+        const std::string model_path = "/cnn_data/vgg16_model/";
+        return ChannelSlice(model_path + layer + "_w.npy", input_layer.empty() ? "" : model_path + input_layer + "_w.npy");
     }
-
-private:
-    CommandLineParser  cmd_parser;
-    CommonGraphOptions common_opts;
-    CommonGraphParams  common_params;
-    Stream             graph;
 };
-
-/** Main program for VGG16
- *
- * @note To list all the possible arguments execute the binary appended with the --help option
- *
- * @param[in] argc Number of arguments
- * @param[in] argv Arguments
- */
-int main(int argc, char **argv)
-{
-    return arm_compute::utils::run_example<GraphVGG16Example>(argc, argv);
-}
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_VGG16_GRAPH_H__ */
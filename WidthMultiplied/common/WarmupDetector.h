@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_WARMUP_DETECTOR_H__
+#define __WIDTH_MULTIPLIED_WARMUP_DETECTOR_H__
+
+#include "common/LatencyStats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace width_multiplied
+{
+/** Detects when the latency of repeated graph runs has reached a steady state
+ *
+ * Samples are grouped in two consecutive sliding windows. The warm-up is over once the
+ * medians of the two windows differ by no more than the relative tolerance, or once the
+ * iteration cap is reached.
+ */
+class WarmupDetector
+{
+public:
+    /** Constructor
+     *
+     * @param[in] window         Number of samples per sliding window
+     * @param[in] tolerance      Maximum relative difference between the medians of two consecutive windows
+     * @param[in] max_iterations Maximum number of warm-up iterations
+     */
+    WarmupDetector(unsigned int window, double tolerance, unsigned int max_iterations)
+        : _window(std::max(window, 1U)), _tolerance(tolerance), _max_iterations(max_iterations), _samples(), _steady(false)
+    {
+    }
+    /** Adds the latency of one more warm-up run
+     *
+     * @param[in] latency_ms Latency of the run in milliseconds
+     *
+     * @return True if the warm-up is over (steady state or cap reached)
+     */
+    bool add_sample(double latency_ms)
+    {
+        _samples.push_back(latency_ms);
+        if(_samples.size() >= 2 * _window)
+        {
+            const double previous = window_median(_samples.size() - 2 * _window);
+            const double current  = window_median(_samples.size() - _window);
+            _steady               = previous > 0.0 && std::abs(current - previous) / previous <= _tolerance;
+        }
+        return done();
+    }
+    /** Whether the warm-up is over */
+    bool done() const
+    {
+        return _steady || _samples.size() >= _max_iterations;
+    }
+    /** Whether the steady state was detected before hitting the cap */
+    bool converged() const
+    {
+        return _steady;
+    }
+    /** Number of warm-up iterations run so far */
+    unsigned int iterations() const
+    {
+        return static_cast<unsigned int>(_samples.size());
+    }
+    /** Latencies of the warm-up runs */
+    const std::vector<double> &samples() const
+    {
+        return _samples;
+    }
+
+private:
+    double window_median(size_t start) const
+    {
+        std::vector<double> window(_samples.begin() + start, _samples.begin() + start + _window);
+        std::sort(window.begin(), window.end());
+        return percentile(window, 50.0);
+    }
+
+    unsigned int        _window;
+    double              _tolerance;
+    unsigned int        _max_iterations;
+    std::vector<double> _samples;
+    bool                _steady;
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_WARMUP_DETECTOR_H__ */
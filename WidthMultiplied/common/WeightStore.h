@@ -0,0 +1,745 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef __WIDTH_MULTIPLIED_WEIGHT_STORE_H__
+#define __WIDTH_MULTIPLIED_WEIGHT_STORE_H__
+
+#include "arm_compute/core/Error.h"
+#include "arm_compute/core/Helpers.h"
+#include "arm_compute/core/ITensor.h"
+#include "arm_compute/core/Types.h"
+#include "arm_compute/core/Window.h"
+#include "arm_compute/graph.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace width_multiplied
+{
+/** Statistics of the trained weights loaded from a weight store */
+struct WeightLoadStats
+{
+    unsigned int files{ 0 };          /**< Files mapped so far */
+    uint64_t     mapped_bytes{ 0 };   /**< Size of the mapped files */
+    uint64_t     resident_bytes{ 0 }; /**< Bytes of the mapped files that are in the page cache */
+    unsigned int tensors{ 0 };        /**< Tensors loaded since the last reset */
+    uint64_t     copied_bytes{ 0 };   /**< Bytes copied into the tensors since the last reset */
+    double       load_ms{ 0 };        /**< Time spent mapping files and copying weights since the last reset */
+};
+
+/** Array of a .npy file, pointing into a mapped file */
+struct NpyArray
+{
+    const uint8_t      *data{ nullptr };        /**< First element */
+    size_t              size{ 0 };              /**< Size of the elements in bytes */
+    std::string         descr{};                /**< NumPy type descriptor, e.g. "<f4" */
+    bool                fortran_order{ false }; /**< True if the array is stored column-major */
+    std::vector<size_t> shape{};                /**< Shape, outermost dimension first */
+};
+
+/** Channels kept when the weights of a full width model are sliced for a narrower graph */
+enum class ChannelSelection
+{
+    Leading, /**< The first channels of every layer */
+    L1,      /**< The channels whose filters have the largest L1 norm */
+};
+
+/** Stream operator to print a channel selection
+ *
+ * @param[out] os        Output stream
+ * @param[in]  selection Channel selection to print
+ *
+ * @return Modified output stream
+ */
+inline std::ostream &operator<<(std::ostream &os, ChannelSelection selection)
+{
+    os << (selection == ChannelSelection::Leading ? "leading" : "l1");
+    return os;
+}
+
+/** Stream operator to read a channel selection
+ *
+ * @param[in]  is        Input stream
+ * @param[out] selection Channel selection read
+ *
+ * @return Modified input stream
+ */
+inline std::istream &operator>>(std::istream &is, ChannelSelection &selection)
+{
+    std::string value;
+    is >> value;
+    if(value == "leading")
+    {
+        selection = ChannelSelection::Leading;
+    }
+    else if(value == "l1")
+    {
+        selection = ChannelSelection::L1;
+    }
+    else
+    {
+        is.setstate(std::ios::failbit);
+    }
+    return is;
+}
+
+/** Where the channels of a sliced tensor come from
+ *
+ * The output channels are the outermost dimension of the weights (the only one of biases and batch
+ * normalization parameters), the input channels the third dimension of convolution weights and the
+ * inner one of fully connected weights. A tensor and the tensors consuming its channels must name
+ * the same ranking weights, so that they keep the same channels.
+ */
+struct ChannelSlice
+{
+    /** Constructor
+     *
+     * @param[in] output_ranking (Optional) Weights whose filters rank the output channels
+     * @param[in] input_ranking  (Optional) Weights whose filters rank the input channels
+     * @param[in] input_groups   (Optional) Full and kept channel counts of each concatenated input
+     */
+    ChannelSlice(std::string output_ranking = "", std::string input_ranking = "", std::vector<std::pair<size_t, size_t>> input_groups = {})
+        : output_ranking(std::move(output_ranking)), input_ranking(std::move(input_ranking)), input_groups(std::move(input_groups))
+    {
+    }
+    std::string                            output_ranking; /**< Ranking weights of the output channels, empty to keep the leading ones */
+    std::string                            input_ranking;  /**< Ranking weights of the input channels, empty to keep the leading ones */
+    std::vector<std::pair<size_t, size_t>> input_groups;   /**< Leading channels kept in each concatenated input, empty for a single input */
+};
+
+namespace detail
+{
+inline uint64_t read_le(const uint8_t *p, size_t bytes)
+{
+    uint64_t value = 0;
+    for(size_t i = 0; i < bytes; ++i)
+    {
+        value |= static_cast<uint64_t>(p[i]) << (8 * i);
+    }
+    return value;
+}
+
+/** Returns the quoted or parenthesized value following a key of a .npy header dictionary */
+inline std::string npy_header_value(const std::string &header, const std::string &key)
+{
+    const size_t key_pos = header.find("'" + key + "'");
+    if(key_pos == std::string::npos)
+    {
+        return "";
+    }
+    const size_t start = header.find_first_not_of(" :", key_pos + key.size() + 2);
+    if(start == std::string::npos)
+    {
+        return "";
+    }
+    const char   close = (header[start] == '(') ? ')' : (header[start] == '\'') ? '\'' : ',';
+    const size_t end   = header.find(close, start + 1);
+    return (end == std::string::npos) ? "" : header.substr(start + 1, end - start - 1);
+}
+
+/** Parses a .npy file held in memory
+ *
+ * @param[in]  data  Start of the file
+ * @param[in]  size  Size of the file
+ * @param[out] array Parsed array
+ *
+ * @return True if the file is a valid .npy file
+ */
+inline bool parse_npy(const uint8_t *data, size_t size, NpyArray &array)
+{
+    if(size < 10 || std::memcmp(data, "\x93NUMPY", 6) != 0)
+    {
+        return false;
+    }
+    const bool   version1    = data[6] == 1;
+    const size_t header_size = version1 ? read_le(data + 8, 2) : read_le(data + 8, 4);
+    const size_t data_offset = (version1 ? 10 : 12) + header_size;
+    if(data_offset > size)
+    {
+        return false;
+    }
+    const std::string header(reinterpret_cast<const char *>(data) + (version1 ? 10 : 12), header_size);
+
+    array.descr         = npy_header_value(header, "descr");
+    array.fortran_order = npy_header_value(header, "fortran_order").find("True") != std::string::npos;
+    array.shape.clear();
+    const std::string shape = npy_header_value(header, "shape");
+    for(size_t pos = 0; pos < shape.size();)
+    {
+        const size_t next  = shape.find(',', pos);
+        const size_t digit = shape.find_first_of("0123456789", pos);
+        if(digit != std::string::npos && digit < next)
+        {
+            array.shape.push_back(std::stoul(shape.substr(digit, next - digit)));
+        }
+        pos = (next == std::string::npos) ? shape.size() : next + 1;
+    }
+    if(array.descr.size() < 3 || array.descr.find_first_not_of("0123456789", 2) != std::string::npos)
+    {
+        return false;
+    }
+    size_t elements = 1;
+    for(size_t dim : array.shape)
+    {
+        elements *= dim;
+    }
+    array.data = data + data_offset;
+    array.size = elements * std::stoul(array.descr.substr(2));
+    return array.size <= size - data_offset;
+}
+} // namespace detail
+
+/** Read-only memory mapping of a whole file */
+class MappedFile
+{
+public:
+    /** Constructor
+     *
+     * @param[in] filename File to map. Check @ref is_open() for success
+     */
+    MappedFile(const std::string &filename)
+        : _data(nullptr), _size(0)
+    {
+        const int fd = ::open(filename.c_str(), O_RDONLY);
+        if(fd < 0)
+        {
+            return;
+        }
+        struct stat st;
+        if(::fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            void *data = ::mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(data != MAP_FAILED)
+            {
+                _data = static_cast<const uint8_t *>(data);
+                _size = st.st_size;
+            }
+        }
+        ::close(fd);
+    }
+    /** Prevent instances of this class from being copied (As this class contains pointers) */
+    MappedFile(const MappedFile &) = delete;
+    /** Prevent instances of this class from being copied (As this class contains pointers) */
+    MappedFile &operator=(const MappedFile &) = delete;
+    /** Destructor */
+    ~MappedFile()
+    {
+        if(_data != nullptr)
+        {
+            ::munmap(const_cast<uint8_t *>(_data), _size);
+        }
+    }
+    /** Returns true if the file is mapped */
+    bool is_open() const
+    {
+        return _data != nullptr;
+    }
+    /** Start of the mapping */
+    const uint8_t *data() const
+    {
+        return _data;
+    }
+    /** Size of the mapping */
+    size_t size() const
+    {
+        return _size;
+    }
+    /** Returns the number of bytes of the mapping that are in the page cache */
+    size_t resident_bytes() const
+    {
+        if(_data == nullptr)
+        {
+            return 0;
+        }
+        const size_t               page_size = ::sysconf(_SC_PAGESIZE);
+        std::vector<unsigned char> pages((_size + page_size - 1) / page_size);
+        if(::mincore(const_cast<uint8_t *>(_data), _size, pages.data()) != 0)
+        {
+            return 0;
+        }
+        size_t resident = 0;
+        for(unsigned char page : pages)
+        {
+            resident += page & 1;
+        }
+        return std::min(resident * page_size, _size);
+    }
+
+private:
+    const uint8_t *_data;
+    size_t         _size;
+};
+
+/** Process-wide store of trained weights read through memory mappings
+ *
+ * A weights path either names a .npy file, as passed to get_weights_accessor(), or a member of an
+ * uncompressed .npz archive, written as "<archive>.npz/<member>.npy". The archive form packs every
+ * .npy file of a data directory in one file, e.g. with
+ * numpy.savez("weights.npz", **{ os.path.relpath(f, data)[:-4]: numpy.load(f) for f in files }),
+ * and is then used by passing weights.npz as the data path.
+ *
+ * Files are mapped on first use and stay mapped (and parsed) until the end of the process, so every
+ * graph built afterwards only copies from the page cache. The store also picks the channels kept
+ * when the weights of the full width model are sliced for a narrower graph.
+ */
+class WeightStore
+{
+public:
+    /** Gets the process-wide store
+     *
+     * @return The store
+     */
+    static WeightStore &get()
+    {
+        static WeightStore instance;
+        return instance;
+    }
+    /** Finds an array, exits with an error if it does not exist
+     *
+     * @param[in] path Path of the .npy file or of the .npz member
+     *
+     * @return The array
+     */
+    const NpyArray &find(const std::string &path)
+    {
+        const auto it = _arrays.find(path);
+        if(it != _arrays.end())
+        {
+            return it->second;
+        }
+
+        const size_t archive_end = path.find(".npz/");
+        if(archive_end != std::string::npos)
+        {
+            map_archive(path.substr(0, archive_end + 4));
+        }
+        else
+        {
+            const MappedFile &file = map_file(path);
+            NpyArray          array;
+            ARM_COMPUTE_EXIT_ON_MSG(!file.is_open() || !detail::parse_npy(file.data(), file.size(), array), "Cannot map the weights file %s", path.c_str());
+            _arrays[path] = array;
+        }
+        const auto array = _arrays.find(path);
+        ARM_COMPUTE_EXIT_ON_MSG(array == _arrays.end(), "Weights not found: %s", path.c_str());
+        return array->second;
+    }
+    /** Records the copy of an array into a tensor
+     *
+     * @param[in] bytes Bytes copied
+     * @param[in] ms    Time spent finding the array and copying it
+     */
+    void add_load(size_t bytes, double ms)
+    {
+        _stats.tensors++;
+        _stats.copied_bytes += bytes;
+        _stats.load_ms += ms;
+    }
+    /** Sets how channels are kept when slicing the weights for a narrower graph
+     *
+     * @param[in] selection Channel selection
+     */
+    void set_channel_selection(ChannelSelection selection)
+    {
+        _selection = selection;
+    }
+    /** Returns how channels are kept when slicing the weights for a narrower graph */
+    ChannelSelection channel_selection() const
+    {
+        return _selection;
+    }
+    /** Returns the output channels kept when slicing weights to fewer channels
+     *
+     * @param[in] ranking Weights whose output filters rank the channels, empty to keep the leading channels
+     * @param[in] kept    Number of channels kept
+     *
+     * @return Indices of the kept channels, in increasing order
+     */
+    const std::vector<size_t> &kept_channels(const std::string &ranking, size_t kept)
+    {
+        const auto           key      = std::make_pair(_selection == ChannelSelection::Leading ? std::string() : ranking, kept);
+        std::vector<size_t> &channels = _kept_channels[key];
+        if(!channels.empty() || kept == 0)
+        {
+            return channels;
+        }
+        if(key.first.empty())
+        {
+            channels.resize(kept);
+            std::iota(channels.begin(), channels.end(), 0);
+            return channels;
+        }
+
+        // Rank the output filters by the sum of their absolute values
+        const NpyArray &array = find(key.first);
+        ARM_COMPUTE_EXIT_ON_MSG(array.descr != "<f4" || array.shape.empty() || kept > array.shape[0],
+                                "Cannot rank %zu channels by the F32 filters of %s", kept, key.first.c_str());
+        const size_t        filters     = array.shape[0];
+        const size_t        filter_size = array.size / sizeof(float) / filters;
+        const float        *data        = reinterpret_cast<const float *>(array.data);
+        std::vector<double> norms(filters, 0.0);
+        for(size_t i = 0; i < filters * filter_size; ++i)
+        {
+            norms[i / filter_size] += std::fabs(data[i]);
+        }
+        std::vector<size_t> order(filters);
+        std::iota(order.begin(), order.end(), 0);
+        std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b)
+        {
+            return norms[a] > norms[b];
+        });
+        order.resize(kept);
+        std::sort(order.begin(), order.end());
+        channels = order;
+        return channels;
+    }
+    /** Resets the per-graph statistics, to call before building each graph */
+    void reset_stats()
+    {
+        _stats.tensors      = 0;
+        _stats.copied_bytes = 0;
+        _stats.load_ms      = 0;
+    }
+    /** Returns the load statistics, with the current page cache residency of the mapped files */
+    WeightLoadStats stats() const
+    {
+        WeightLoadStats stats = _stats;
+        stats.files           = _files.size();
+        stats.mapped_bytes    = 0;
+        stats.resident_bytes  = 0;
+        for(const auto &file : _files)
+        {
+            stats.mapped_bytes += file.second->size();
+            stats.resident_bytes += file.second->resident_bytes();
+        }
+        return stats;
+    }
+
+private:
+    WeightStore()
+        : _files(), _arrays(), _stats(), _selection(ChannelSelection::Leading), _kept_channels()
+    {
+    }
+
+    const MappedFile &map_file(const std::string &filename)
+    {
+        auto &file = _files[filename];
+        if(file == nullptr)
+        {
+            file = std::unique_ptr<MappedFile>(new MappedFile(filename));
+        }
+        return *file;
+    }
+
+    void map_archive(const std::string &archive)
+    {
+        if(_files.count(archive) != 0)
+        {
+            return;
+        }
+        const MappedFile &file = map_file(archive);
+        ARM_COMPUTE_EXIT_ON_MSG(!file.is_open(), "Cannot map the weights archive %s", archive.c_str());
+        const uint8_t *data = file.data();
+        const size_t   size = file.size();
+
+        // Find the end of central directory record, and its zip64 version if present
+        size_t eocd = std::string::npos;
+        if(size >= 22)
+        {
+            const size_t search_end = (size > 22 + 0xFFFF) ? size - 22 - 0xFFFF : 0;
+            for(size_t pos = size - 22 + 1; pos-- > search_end;)
+            {
+                if(detail::read_le(data + pos, 4) == 0x06054b50)
+                {
+                    eocd = pos;
+                    break;
+                }
+            }
+        }
+        ARM_COMPUTE_EXIT_ON_MSG(eocd == std::string::npos, "Not a zip archive: %s", archive.c_str());
+        uint64_t entries   = detail::read_le(data + eocd + 10, 2);
+        uint64_t cd_offset = detail::read_le(data + eocd + 16, 4);
+        if((entries == 0xFFFF || cd_offset == 0xFFFFFFFF) && eocd >= 20 && detail::read_le(data + eocd - 20, 4) == 0x07064b50)
+        {
+            const uint64_t eocd64 = detail::read_le(data + eocd - 20 + 8, 8);
+            ARM_COMPUTE_EXIT_ON_MSG(eocd64 + 56 > size || detail::read_le(data + eocd64, 4) != 0x06064b50, "Invalid zip64 archive: %s", archive.c_str());
+            entries   = detail::read_le(data + eocd64 + 32, 8);
+            cd_offset = detail::read_le(data + eocd64 + 48, 8);
+        }
+
+        // Index every stored member of the central directory
+        size_t entry = cd_offset;
+        for(uint64_t i = 0; i < entries; ++i)
+        {
+            ARM_COMPUTE_EXIT_ON_MSG(entry + 46 > size || detail::read_le(data + entry, 4) != 0x02014b50, "Invalid zip archive: %s", archive.c_str());
+            const uint64_t    method       = detail::read_le(data + entry + 10, 2);
+            const size_t      name_size    = detail::read_le(data + entry + 28, 2);
+            const size_t      extra_size   = detail::read_le(data + entry + 30, 2);
+            const size_t      comment_size = detail::read_le(data + entry + 32, 2);
+            uint64_t          local        = detail::read_le(data + entry + 42, 4);
+            const std::string name(reinterpret_cast<const char *>(data) + entry + 46, name_size);
+
+            // Zip64 extra field: the 64-bit sizes come first, the local header offset last
+            if(local == 0xFFFFFFFF)
+            {
+                for(size_t extra = entry + 46 + name_size; extra + 4 <= entry + 46 + name_size + extra_size;)
+                {
+                    const size_t field_size = detail::read_le(data + extra + 2, 2);
+                    if(detail::read_le(data + extra, 2) == 0x0001)
+                    {
+                        size_t field = extra + 4;
+                        field += (detail::read_le(data + entry + 24, 4) == 0xFFFFFFFF) ? 8 : 0;
+                        field += (detail::read_le(data + entry + 20, 4) == 0xFFFFFFFF) ? 8 : 0;
+                        local = detail::read_le(data + field, 8);
+                    }
+                    extra += 4 + field_size;
+                }
+            }
+            entry += 46 + name_size + extra_size + comment_size;
+
+            ARM_COMPUTE_EXIT_ON_MSG(local + 30 > size, "Invalid zip archive: %s", archive.c_str());
+            if(method != 0)
+            {
+                std::cerr << "Skipping compressed member " << name << " of " << archive << ", write the archive with numpy.savez" << std::endl;
+                continue;
+            }
+            const size_t member = local + 30 + detail::read_le(data + local + 26, 2) + detail::read_le(data + local + 28, 2);
+            NpyArray     array;
+            if(member < size && detail::parse_npy(data + member, size - member, array))
+            {
+                _arrays[archive + "/" + name] = array;
+            }
+        }
+    }
+
+    std::map<std::string, std::unique_ptr<MappedFile>>            _files;
+    std::map<std::string, NpyArray>                               _arrays;
+    WeightLoadStats                                               _stats;
+    ChannelSelection                                              _selection;
+    std::map<std::pair<std::string, size_t>, std::vector<size_t>> _kept_channels;
+};
+
+/** Accessor copying trained weights from the weight store into a tensor
+ *
+ * A tensor with fewer channels than the array, as built with a width multiplier below 1, gets a
+ * slice of the array: the channels picked by the weight store for the rankings of its @ref ChannelSlice.
+ * Only the kept channels are read, so only the pages holding them are faulted in from the mapping.
+ */
+class MappedWeightsAccessor final : public arm_compute::graph::ITensorAccessor
+{
+public:
+    /** Constructor
+     *
+     * @param[in] path        Path of the .npy file or of the .npz member
+     * @param[in] file_layout (Optional) Layout of the weights in the file
+     * @param[in] slice       (Optional) Channels kept when the tensor is narrower than the array
+     */
+    MappedWeightsAccessor(std::string path, arm_compute::DataLayout file_layout = arm_compute::DataLayout::NCHW, ChannelSlice slice = ChannelSlice())
+        : _path(std::move(path)), _file_layout(file_layout), _slice(std::move(slice))
+    {
+    }
+    /** Allow instances of this class to be move constructed */
+    MappedWeightsAccessor(MappedWeightsAccessor &&) = default;
+
+    // Inherited methods overriden:
+    bool access_tensor(arm_compute::ITensor &tensor) override
+    {
+        using namespace arm_compute;
+
+        const auto         start = std::chrono::steady_clock::now();
+        const NpyArray    &array = WeightStore::get().find(_path);
+        const ITensorInfo &info  = *tensor.info();
+
+        // Check the type, and the shape against NumPy's one which is the reverse of ACL's
+        ARM_COMPUTE_EXIT_ON_MSG(array.fortran_order, "Fortran ordered arrays are not supported: %s", _path.c_str());
+        ARM_COMPUTE_EXIT_ON_MSG(std::stoul(array.descr.substr(2)) != info.element_size()
+                                || array.descr[1] != expected_type(info.data_type()),
+                                "Data type mismatch: %s", _path.c_str());
+        const size_t dims    = array.shape.size();
+        const bool   permute = _file_layout == DataLayout::NCHW && info.data_layout() == DataLayout::NHWC && dims >= 3;
+        TensorShape  file_shape;
+        for(size_t i = 0; i < dims; ++i)
+        {
+            file_shape.set(i, array.shape[dims - 1 - i]);
+        }
+        TensorShape shape = info.tensor_shape();
+        if(permute)
+        {
+            // Back to the layout of the file: (C, W, H, N) -> (W, H, C, N)
+            shape = TensorShape(shape[1], shape[2], shape[0], shape[3]);
+        }
+        size_t elements = 1;
+        for(size_t i = 0; i < dims; ++i)
+        {
+            ARM_COMPUTE_EXIT_ON_MSG(shape[i] > file_shape[i], "Shape mismatch: %s", _path.c_str());
+            elements *= shape[i];
+        }
+        ARM_COMPUTE_EXIT_ON_MSG(elements != shape.total_size(), "Shape mismatch: %s", _path.c_str());
+
+        // Offset in the array of each kept index of each dimension
+        const size_t                     element_size = info.element_size();
+        std::vector<std::vector<size_t>> offsets(dims);
+        size_t                           stride = element_size;
+        for(size_t i = 0; i < dims; ++i)
+        {
+            const std::vector<size_t> kept = kept_indices(i, dims, shape, file_shape);
+            for(size_t index : kept)
+            {
+                offsets[i].push_back(index * stride);
+            }
+            stride *= file_shape[i];
+        }
+        offsets.resize(4, std::vector<size_t>(1, 0));
+
+        Window window;
+        window.use_tensor_dimensions(info.tensor_shape());
+        const bool contiguous_rows = !permute && offsets[0].back() - offsets[0].front() == (shape[0] - 1) * element_size;
+        if(contiguous_rows)
+        {
+            // Rows are contiguous in the file
+            const size_t row_bytes = info.dimension(0) * element_size;
+            window.set(Window::DimX, Window::Dimension(0, 1, 1));
+            Iterator it(&tensor, window);
+            execute_window_loop(window, [&](const Coordinates & id)
+            {
+                std::memcpy(it.ptr(), array.data + offsets[0][0] + offsets[1][id[1]] + offsets[2][id[2]] + offsets[3][id[3]], row_bytes);
+            },
+            it);
+        }
+        else
+        {
+            // Gather every element from its position in the file
+            Iterator it(&tensor, window);
+            execute_window_loop(window, [&](const Coordinates & id)
+            {
+                const size_t offset = permute ? offsets[0][id[1]] + offsets[1][id[2]] + offsets[2][id[0]] + offsets[3][id[3]]
+                                      : offsets[0][id[0]] + offsets[1][id[1]] + offsets[2][id[2]] + offsets[3][id[3]];
+                std::memcpy(it.ptr(), array.data + offset, element_size);
+            },
+            it);
+        }
+
+        WeightStore::get().add_load(elements * element_size, std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count());
+        return true;
+    }
+
+private:
+    static char expected_type(arm_compute::DataType data_type)
+    {
+        switch(data_type)
+        {
+            case arm_compute::DataType::F16:
+            case arm_compute::DataType::F32:
+                return 'f';
+            case arm_compute::DataType::S32:
+                return 'i';
+            default:
+                return 'u';
+        }
+    }
+
+    /** Returns the indices of the array kept in a dimension, in the layout of the file */
+    std::vector<size_t> kept_indices(size_t dim, size_t dims, const arm_compute::TensorShape &shape, const arm_compute::TensorShape &file_shape) const
+    {
+        const bool output = dim == dims - 1;
+        const bool input  = (dims == 4 && dim == 2) || (dims == 2 && dim == 0);
+        ARM_COMPUTE_EXIT_ON_MSG(!output && !input && shape[dim] != file_shape[dim], "Only the channels can be sliced: %s", _path.c_str());
+        if(output)
+        {
+            return WeightStore::get().kept_channels(_slice.output_ranking, shape[dim]);
+        }
+        if(!input || (shape[dim] == file_shape[dim] && _slice.input_groups.empty()))
+        {
+            std::vector<size_t> indices(shape[dim]);
+            std::iota(indices.begin(), indices.end(), 0);
+            return indices;
+        }
+
+        // Fully connected weights after a flatten hold a block of elements per input channel
+        size_t channels = file_shape[dim];
+        if(!_slice.input_groups.empty())
+        {
+            channels = 0;
+            for(const auto &group : _slice.input_groups)
+            {
+                channels += group.first;
+            }
+        }
+        else if(!_slice.input_ranking.empty() && WeightStore::get().channel_selection() != ChannelSelection::Leading)
+        {
+            channels = WeightStore::get().find(_slice.input_ranking).shape.at(0);
+        }
+        const size_t block = file_shape[dim] / channels;
+        ARM_COMPUTE_EXIT_ON_MSG(block * channels != file_shape[dim] || shape[dim] % block != 0, "Cannot split the input channels of %s", _path.c_str());
+
+        std::vector<size_t> kept_channels;
+        if(_slice.input_groups.empty())
+        {
+            kept_channels = WeightStore::get().kept_channels(_slice.input_ranking, shape[dim] / block);
+        }
+        else
+        {
+            // Leading channels of each concatenated input
+            size_t group_start = 0;
+            for(const auto &group : _slice.input_groups)
+            {
+                for(size_t i = 0; i < group.second; ++i)
+                {
+                    kept_channels.push_back(group_start + i);
+                }
+                group_start += group.first;
+            }
+        }
+        ARM_COMPUTE_EXIT_ON_MSG(kept_channels.size() * block != shape[dim], "Input channel mismatch: %s", _path.c_str());
+
+        std::vector<size_t> indices;
+        for(size_t channel : kept_channels)
+        {
+            for(size_t i = 0; i < block; ++i)
+            {
+                indices.push_back(channel * block + i);
+            }
+        }
+        return indices;
+    }
+
+    std::string             _path;
+    arm_compute::DataLayout _file_layout;
+    ChannelSlice            _slice;
+};
+} // namespace width_multiplied
+#endif /* __WIDTH_MULTIPLIED_WEIGHT_STORE_H__ */
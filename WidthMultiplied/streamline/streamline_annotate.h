@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2017-2018 ARM Limited.
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to
+ * deal in the Software without restriction, including without limitation the
+ * rights to use, copy, modify, merge, publish, distribute, sublicense, and/or
+ * sell copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef STREAMLINE_ANNOTATE_H
+#define STREAMLINE_ANNOTATE_H
+
+/** Drop-in replacement of gator's streamline_annotate.h
+ *
+ * Put this directory on the include path instead of gator's to build the examples without
+ * libstreamline_annotate. The annotations are not sent to gatord but written to a local trace
+ * file, one CSV line per event: "time_ns,thread,event,channel,color,value,text".
+ * The file is named after the STREAMLINE_TRACE_FILE environment variable, or
+ * streamline_trace.csv in the working directory when it is not set.
+ *
+ * Timestamps are in nanoseconds since the first annotation of the process. Colours are written
+ * as #rrggbb, or "cycle" for ANNOTATE_COLOR_CYCLE.
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#define ANNOTATE_RED 0x0000ff1b
+#define ANNOTATE_BLUE 0xff00001b
+#define ANNOTATE_GREEN 0x00ff001b
+#define ANNOTATE_PURPLE 0xff00ff1b
+#define ANNOTATE_YELLOW 0x00ffff1b
+#define ANNOTATE_CYAN 0xffff001b
+#define ANNOTATE_WHITE 0xffffff1b
+#define ANNOTATE_LTGRAY 0xbbbbbb1b
+#define ANNOTATE_DKGRAY 0x5555551b
+#define ANNOTATE_BLACK 0x0000001b
+#define ANNOTATE_COLOR_CYCLE 0x00000000
+
+namespace streamline_annotate_stub
+{
+/** Trace file shared by all the annotation macros */
+class TraceLog
+{
+public:
+    /** Returns the process wide trace log */
+    static TraceLog &get()
+    {
+        static TraceLog log;
+        return log;
+    }
+    /** Prevent instances of this class from being copied */
+    TraceLog(const TraceLog &) = delete;
+    /** Prevent instances of this class from being copied */
+    TraceLog &operator=(const TraceLog &) = delete;
+    /** Closes the trace file */
+    ~TraceLog()
+    {
+        if(_file != nullptr)
+        {
+            std::fclose(_file);
+        }
+    }
+    /** Writes one event
+     *
+     * @param[in] event     Event name
+     * @param[in] channel   Channel (or counter id) of the event
+     * @param[in] color     Colour of the event, ignored if has_color is false
+     * @param[in] has_color True if the event is coloured
+     * @param[in] value     Counter value or group id
+     * @param[in] text      (Optional) Label of the event
+     */
+    void write(const char *event, uint32_t channel, uint32_t color, bool has_color, long long value, const char *text)
+    {
+        const long long time_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count();
+        const size_t    thread  = std::hash<std::thread::id>()(std::this_thread::get_id());
+        char            color_str[8]{};
+        if(has_color)
+        {
+            if(color == ANNOTATE_COLOR_CYCLE)
+            {
+                std::snprintf(color_str, sizeof(color_str), "cycle");
+            }
+            else
+            {
+                std::snprintf(color_str, sizeof(color_str), "#%02x%02x%02x", (color >> 8) & 0xff, (color >> 16) & 0xff, (color >> 24) & 0xff);
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        if(_file != nullptr)
+        {
+            std::fprintf(_file, "%lld,%zu,%s,%u,%s,%lld,\"%s\"\n", time_ns, thread, event, channel, color_str, value, (text != nullptr) ? text : "");
+        }
+    }
+
+private:
+    TraceLog()
+        : _mutex(), _start(std::chrono::steady_clock::now()), _file(nullptr)
+    {
+        const char *filename = std::getenv("STREAMLINE_TRACE_FILE");
+        _file                = std::fopen((filename != nullptr) ? filename : "streamline_trace.csv", "w");
+        if(_file != nullptr)
+        {
+            std::fprintf(_file, "time_ns,thread,event,channel,color,value,text\n");
+        }
+    }
+
+    std::mutex                            _mutex;
+    std::chrono::steady_clock::time_point _start;
+    std::FILE                            *_file;
+};
+
+/** Writes an event without colour */
+inline void annotate(const char *event, uint32_t channel, const char *text)
+{
+    TraceLog::get().write(event, channel, 0, false, 0, text);
+}
+
+/** Writes a coloured event */
+inline void annotate_color(const char *event, uint32_t channel, uint32_t color, const char *text)
+{
+    TraceLog::get().write(event, channel, color, true, 0, text);
+}
+
+/** Writes an event carrying a value */
+inline void annotate_value(const char *event, uint32_t channel, long long value, const char *text)
+{
+    TraceLog::get().write(event, channel, 0, false, value, text);
+}
+
+/** Writes the definition of a counter */
+inline void annotate_counter(uint32_t id, const char *title, const char *name, const char *event)
+{
+    const std::string text = std::string(title) + "/" + name;
+    TraceLog::get().write(event, id, 0, false, 0, text.c_str());
+}
+} // namespace streamline_annotate_stub
+
+/* A using-declaration is valid both at namespace and block scope, like gator's ANNOTATE_DEFINE */
+#define ANNOTATE_DEFINE using streamline_annotate_stub::TraceLog
+#define ANNOTATE_SETUP streamline_annotate_stub::TraceLog::get()
+
+#define ANNOTATE(str) streamline_annotate_stub::annotate("annotate", 0, (str))
+#define ANNOTATE_COLOR(color, str) streamline_annotate_stub::annotate_color("annotate", 0, (color), (str))
+#define ANNOTATE_END() streamline_annotate_stub::annotate("end", 0, nullptr)
+
+#define ANNOTATE_CHANNEL(channel, str) streamline_annotate_stub::annotate("annotate", (channel), (str))
+#define ANNOTATE_CHANNEL_COLOR(channel, color, str) streamline_annotate_stub::annotate_color("annotate", (channel), (color), (str))
+#define ANNOTATE_CHANNEL_END(channel) streamline_annotate_stub::annotate("end", (channel), nullptr)
+
+#define ANNOTATE_NAME_CHANNEL(channel, group, str) streamline_annotate_stub::annotate_value("name_channel", (channel), (group), (str))
+#define ANNOTATE_NAME_GROUP(group, str) streamline_annotate_stub::annotate_value("name_group", 0, (group), (str))
+
+#define ANNOTATE_VISUAL(data, length, str) streamline_annotate_stub::annotate("visual", 0, (str))
+
+#define ANNOTATE_MARKER() streamline_annotate_stub::annotate("marker", 0, nullptr)
+#define ANNOTATE_MARKER_STR(str) streamline_annotate_stub::annotate("marker", 0, (str))
+#define ANNOTATE_MARKER_COLOR(color) streamline_annotate_stub::annotate_color("marker", 0, (color), nullptr)
+#define ANNOTATE_MARKER_COLOR_STR(color, str) streamline_annotate_stub::annotate_color("marker", 0, (color), (str))
+
+#define ANNOTATE_DELTA_COUNTER(id, title, name) streamline_annotate_stub::annotate_counter((id), (title), (name), "delta_counter")
+#define ANNOTATE_ABSOLUTE_COUNTER(id, title, name) streamline_annotate_stub::annotate_counter((id), (title), (name), "absolute_counter")
+#define ANNOTATE_COUNTER_VALUE(id, value) streamline_annotate_stub::annotate_value("counter_value", (id), (value), nullptr)
+
+#endif /* STREAMLINE_ANNOTATE_H */